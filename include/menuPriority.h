@@ -0,0 +1,16 @@
+/* menuPriority.h generated from menuPriority.dbd */
+
+#ifndef INC_menuPriority_H
+#define INC_menuPriority_H
+
+#ifndef menuPriority_NUM_CHOICES
+typedef enum {
+    menuPriorityLOW                 /* LOW */,
+    menuPriorityMEDIUM              /* MEDIUM */,
+    menuPriorityHIGH                /* HIGH */
+} menuPriority;
+#define menuPriority_NUM_CHOICES 3
+#endif
+
+
+#endif /* INC_menuPriority_H */
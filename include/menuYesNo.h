@@ -0,0 +1,15 @@
+/* menuYesNo.h generated from menuYesNo.dbd */
+
+#ifndef INC_menuYesNo_H
+#define INC_menuYesNo_H
+
+#ifndef menuYesNo_NUM_CHOICES
+typedef enum {
+    menuYesNoNO                     /* NO */,
+    menuYesNoYES                    /* YES */
+} menuYesNo;
+#define menuYesNo_NUM_CHOICES 2
+#endif
+
+
+#endif /* INC_menuYesNo_H */
@@ -0,0 +1,26 @@
+/*************************************************************************\
+* Copyright (c) 2007 The University of Chicago, as Operator of Argonne
+*     National Laboratory.
+* Copyright (c) 2002 The Regents of the University of California, as
+*     Operator of Los Alamos National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#ifndef INC_miscIocRegister_H
+#define INC_miscIocRegister_H
+
+#include "shareLib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+epicsShareFunc void miscIocRegister(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_miscIocRegister_H */
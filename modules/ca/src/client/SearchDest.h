@@ -33,6 +33,21 @@ struct SearchDest :
     };
     virtual void searchRequest ( epicsGuard < epicsMutex > &,
         const char * pbuf, size_t len ) = 0;
+    // A search reply from addr was received. Unless groupOnly is
+    // set, the reply is credited to this destination if addr is its
+    // address. If groupOnly is set the reply is credited to broadcast
+    // and multicast destinations. Returns true if it was credited.
+    virtual bool searchReplyNotify ( epicsGuard < epicsMutex > &,
+        const osiSockAddr &, bool, const epicsTime & )
+    {
+        return false;
+    }
+    // true if this is a name server whose circuit is able to
+    // answer search requests now
+    virtual bool nameServerReady ( epicsGuard < epicsMutex > & ) const
+    {
+        return false;
+    }
     virtual void show ( epicsGuard < epicsMutex > &, unsigned level ) const = 0;
 };
 
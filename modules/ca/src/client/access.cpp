@@ -183,7 +183,7 @@ int epicsStdCall ca_context_create (
 
         pcac = ( ca_client_context * ) epicsThreadPrivateGet ( caClientContextId );
         if ( pcac ) {
-            if ( premptiveCallbackSelect == ca_enable_preemptive_callback &&
+            if ( premptiveCallbackSelect != ca_disable_preemptive_callback &&
                 ! pcac->preemptiveCallbakIsEnabled() ) {
                 return ECA_NOTTHREADED;
             }
@@ -191,7 +191,8 @@ int epicsStdCall ca_context_create (
         }
 
         pcac = new ca_client_context (
-            premptiveCallbackSelect == ca_enable_preemptive_callback );
+            premptiveCallbackSelect != ca_disable_preemptive_callback,
+            premptiveCallbackSelect == ca_enable_preemptive_callback_io_pool );
         if ( ! pcac ) {
             return ECA_ALLOCMEM;
         }
@@ -353,6 +354,101 @@ int epicsStdCall ca_create_channel (
     return ECA_NORMAL;
 }
 
+// extern "C"
+int epicsStdCall ca_create_channels (
+     const char * const * pChanNames, unsigned nChannels,
+     caCh * conn_func, void * const * pUserPrivates,
+     capri priority, chid * pChanIDs )
+{
+    ca_client_context * pcac;
+    int caStatus = fetchClientContext ( & pcac );
+    if ( caStatus != ECA_NORMAL ) {
+        return caStatus;
+    }
+
+    if ( nChannels == 0u ) {
+        return ECA_NORMAL;
+    }
+    if ( ! pChanNames ) {
+        return ECA_BADSTR;
+    }
+    if ( ! pChanIDs ) {
+        return ECA_INTERNAL;
+    }
+
+    {
+        CAFDHANDLER * pFunc = 0;
+        void * pArg = 0;
+        {
+            epicsGuard < epicsMutex >
+                guard ( pcac->mutex );
+            if ( pcac->fdRegFuncNeedsToBeCalled ) {
+                pFunc = pcac->fdRegFunc;
+                pArg = pcac->fdRegArg;
+                pcac->fdRegFuncNeedsToBeCalled = false;
+            }
+        }
+        if ( pFunc ) {
+            ( *pFunc ) ( pArg, pcac->sock, true );
+        }
+    }
+
+    unsigned nCreated = 0u;
+    try {
+        epicsGuard < epicsMutex > guard ( pcac->mutex );
+        pcac->reserveChannels ( guard, nChannels );
+        while ( nCreated < nChannels ) {
+            void * puser = pUserPrivates ? pUserPrivates[nCreated] : 0;
+            pChanIDs[nCreated] =
+                new ( pcac->oldChannelNotifyFreeList )
+                    oldChannelNotify ( guard, *pcac, pChanNames[nCreated],
+                        conn_func, puser, priority );
+            nCreated++;
+        }
+        // all of their chan pointers are set, and the lock has not
+        // been released, prior to starting any of the connect sequences
+        for ( unsigned i = 0u; i < nChannels; i++ ) {
+            pChanIDs[i]->initiateConnect ( guard );
+        }
+        // the search requests are packed into as few datagrams as
+        // possible so there is no reason to wait for the search timer
+        pcac->expediteSearch ( guard );
+        return ECA_NORMAL;
+    }
+    catch ( cacChannel::badString & ) {
+        caStatus = ECA_BADSTR;
+    }
+    catch ( std::bad_alloc & ) {
+        caStatus = ECA_ALLOCMEM;
+    }
+    catch ( cacChannel::badPriority & ) {
+        caStatus = ECA_BADPRIORITY;
+    }
+    catch ( cacChannel::unsupportedByService & ) {
+        caStatus = ECA_UNAVAILINSERV;
+    }
+    catch ( std :: exception & except ) {
+        pcac->printFormated (
+            "ca_create_channels: "
+            "unexpected exception was \"%s\"",
+            except.what () );
+        caStatus = ECA_INTERNAL;
+    }
+    catch ( ... ) {
+        caStatus = ECA_INTERNAL;
+    }
+
+    // all or nothing, the connect sequence was not started for
+    // any of the channels created before the failure
+    for ( unsigned i = 0u; i < nCreated; i++ ) {
+        ca_clear_channel ( pChanIDs[i] );
+    }
+    for ( unsigned i = 0u; i < nChannels; i++ ) {
+        pChanIDs[i] = 0;
+    }
+    return caStatus;
+}
+
 /*
  *  ca_clear_channel ()
  *
@@ -364,6 +460,7 @@ int epicsStdCall ca_create_channel (
 int epicsStdCall ca_clear_channel ( chid pChan )
 {
     ca_client_context & cac = pChan->getClientCtx ();
+    bool held = cac.holdSubscriptionDelivery ();
     {
         epicsGuard < epicsMutex > guard ( cac.mutex );
         try {
@@ -393,6 +490,9 @@ int epicsStdCall ca_clear_channel ( chid pChan )
         pChan->destructor ( *cac.pCallbackGuard.get(), guard );
         cac.oldChannelNotifyFreeList.release ( pChan );
     }
+    if ( held ) {
+        cac.releaseSubscriptionDelivery ();
+    }
     return ECA_NORMAL;
 }
 
@@ -3410,6 +3410,9 @@ int acctst ( const char * pName, unsigned interestLevel, unsigned channelCount,
     if ( select == ca_enable_preemptive_callback ) {
         printf ( "Preemptive call back is enabled.\n" );
     }
+    else if ( select == ca_enable_preemptive_callback_io_pool ) {
+        printf ( "Preemptive call back from the event loop threads is enabled.\n" );
+    }
 
     {
         char tmpString[32];
@@ -3485,7 +3488,7 @@ int acctst ( const char * pName, unsigned interestLevel, unsigned channelCount,
     verifyHighThroughputWriteCallback ( chan, interestLevel );
     verifyBadString ( chan, interestLevel );
     verifyMultithreadSubscr ( pName, interestLevel );
-    if ( select != ca_enable_preemptive_callback ) {
+    if ( select == ca_disable_preemptive_callback ) {
         fdManagerVerify ( pName, interestLevel );
     }
 
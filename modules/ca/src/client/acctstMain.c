@@ -25,7 +25,8 @@ int main ( int argc, char **argv )
 
     if ( argc < 2 || argc > 6 ) {
         printf ("usage: %s <PV name> [progress logging level] [channel count] "
-                "[repetition count] [enable preemptive callback]\n",
+                "[repetition count] [enable preemptive callback, "
+                "2 for event loop threads]\n",
                 argv[0] );
         return 1;
     }
@@ -57,7 +58,10 @@ int main ( int argc, char **argv )
     else {
         aBoolean = 0;
     }
-    if ( aBoolean ) {
+    if ( aBoolean == 2 ) {
+        preempt = ca_enable_preemptive_callback_io_pool;
+    }
+    else if ( aBoolean ) {
         preempt = ca_enable_preemptive_callback;
     }
     else {
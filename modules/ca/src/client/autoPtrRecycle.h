@@ -30,7 +30,7 @@ template < class T >
 class autoPtrRecycle {
 public:
     autoPtrRecycle (
-        epicsGuard < epicsMutex > &, chronIntIdResTable < baseNMIU > &,
+        epicsGuard < epicsMutex > &, chronIntIdOpenResTable < baseNMIU > &,
         cacRecycle &, T * );
     ~autoPtrRecycle ();
     T & operator * () const;
@@ -40,7 +40,7 @@ public:
 private:
     T * p;
     cacRecycle & r;
-    chronIntIdResTable < baseNMIU > & ioTable;
+    chronIntIdOpenResTable < baseNMIU > & ioTable;
     epicsGuard < epicsMutex > & guard;
     // not implemented
     autoPtrRecycle ( const autoPtrRecycle & );
@@ -49,7 +49,7 @@ private:
 
 template < class T >
 inline autoPtrRecycle<T>::autoPtrRecycle (
-    epicsGuard < epicsMutex > & guardIn, chronIntIdResTable < baseNMIU > & tbl,
+    epicsGuard < epicsMutex > & guardIn, chronIntIdOpenResTable < baseNMIU > & tbl,
         cacRecycle & rIn, T * pIn ) :
     p ( pIn ), r ( rIn ), ioTable ( tbl ), guard ( guardIn ) {}
 
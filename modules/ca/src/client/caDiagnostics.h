@@ -24,6 +24,57 @@ int acctst ( const char *pname, unsigned logggingInterestLevel,
             unsigned channelCount, unsigned repetitionCount,
             enum ca_preemptive_callback_select select );
 
+/*
+ * the number of send system calls made so far by all of the
+ * virtual circuits in this process
+ */
+LIBCA_API size_t epicsStdCall ca_tcp_send_call_count ( void );
+
+/*
+ * search statistics for all of the client contexts in this process
+ */
+struct ca_search_stats {
+    size_t requestsSent;        /* channel name search requests sent */
+    size_t requestsUnanswered;  /* requests not answered before a retry */
+    size_t repliesAnswered;     /* replies which located a channel */
+    size_t repliesWasted;       /* replies for channels already located,
+                                   or cleared, and duplicate replies */
+    size_t datagramsSent;       /* counted once for each destination */
+    size_t datagramsDeferred;   /* withheld by a destination's pacing */
+};
+LIBCA_API void epicsStdCall ca_search_statistics (
+    struct ca_search_stats * pStats );
+
+/*
+ * latency histograms for all of the client contexts in this process,
+ * bin N counts delays of at least 2^N and less than 2^(N+1) micro
+ * seconds, except that bin 0 also counts shorter delays and the last
+ * bin also counts longer delays
+ */
+#define CA_LATENCY_BINS 32
+struct ca_latency_hist {
+    size_t count;               /* number of samples */
+    size_t sumMicroSec;         /* sum of the delays, for the mean */
+    size_t maxMicroSec;         /* longest delay */
+    size_t bin[CA_LATENCY_BINS];
+};
+struct ca_client_stats {
+    struct ca_latency_hist searchReply;  /* search request to reply */
+    struct ca_latency_hist connect;      /* channel created, or
+                                            disconnected, to connected */
+    struct ca_latency_hist getRoundTrip; /* get request to response */
+    struct ca_latency_hist putRoundTrip; /* put callback request
+                                            to response */
+    struct ca_latency_hist sendStall;    /* time a caller was blocked
+                                            by a full send queue */
+};
+/*
+ * the histograms are updated independently, so the copy is not an
+ * atomic snapshot, they are also printed by ca_client_status()
+ */
+LIBCA_API void epicsStdCall ca_client_stats (
+    struct ca_client_stats * pStats );
+
 #define CATIME_OK 0
 #define CATIME_ERROR -1
 
@@ -0,0 +1,126 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+
+#include "epicsAtomic.h"
+#include "caLatency.h"
+
+caLatencyHistogram caSearchLatency;
+caLatencyHistogram caConnectLatency;
+caLatencyHistogram caGetLatency;
+caLatencyHistogram caPutLatency;
+caLatencyHistogram caSendStallLatency;
+
+void caLatencyHistogram::sample ( epicsUInt64 startTime )
+{
+    const epicsUInt64 now = epicsMonotonicGet ();
+    this->sampleMicroSec ( now > startTime ? ( now - startTime ) / 1000u : 0u );
+}
+
+void caLatencyHistogram::sampleSeconds ( double delay )
+{
+    if ( delay > 0.0 ) {
+        this->sampleMicroSec ( static_cast < epicsUInt64 > ( delay * 1e6 ) );
+    }
+    else {
+        this->sampleMicroSec ( 0u );
+    }
+}
+
+void caLatencyHistogram::sampleMicroSec ( epicsUInt64 delay )
+{
+    unsigned bin = 0u;
+    while ( bin < CA_LATENCY_BINS - 1u && ( delay >> ( bin + 1u ) ) ) {
+        bin++;
+    }
+    const size_t delayMicroSec = static_cast < size_t > ( delay );
+    epicsAtomicIncrSizeT ( & this->bins[bin] );
+    epicsAtomicIncrSizeT ( & this->count );
+    epicsAtomicAddSizeT ( & this->sumMicroSec, delayMicroSec );
+    size_t max = epicsAtomicGetSizeT ( & this->maxMicroSec );
+    while ( delayMicroSec > max ) {
+        const size_t prev = epicsAtomicCmpAndSwapSizeT (
+            & this->maxMicroSec, max, delayMicroSec );
+        if ( prev == max ) {
+            break;
+        }
+        max = prev;
+    }
+}
+
+void caLatencyHistogram::get ( struct ca_latency_hist & hist ) const
+{
+    hist.count = epicsAtomicGetSizeT ( & this->count );
+    hist.sumMicroSec = epicsAtomicGetSizeT ( & this->sumMicroSec );
+    hist.maxMicroSec = epicsAtomicGetSizeT ( & this->maxMicroSec );
+    for ( unsigned i = 0u; i < CA_LATENCY_BINS; i++ ) {
+        hist.bin[i] = epicsAtomicGetSizeT ( & this->bins[i] );
+    }
+}
+
+// upper bound of the bin where the fraction of samples is reached
+static double percentile ( const struct ca_latency_hist & hist,
+                          size_t total, double fraction )
+{
+    const double target = total * fraction;
+    double sum = 0.0;
+    for ( unsigned i = 0u; i < CA_LATENCY_BINS; i++ ) {
+        sum += hist.bin[i];
+        if ( sum >= target ) {
+            return ldexp ( 2.0, i );
+        }
+    }
+    return static_cast < double > ( hist.maxMicroSec );
+}
+
+void caLatencyHistogram::show ( const char * pName, unsigned level ) const
+{
+    struct ca_latency_hist hist;
+    this->get ( hist );
+    size_t total = 0u;
+    for ( unsigned i = 0u; i < CA_LATENCY_BINS; i++ ) {
+        total += hist.bin[i];
+    }
+    if ( total == 0u ) {
+        ::printf ( "\t%-16s no samples\n", pName );
+        return;
+    }
+    ::printf ( "\t%-16s %lu samples, mean %.0f uS, max %lu uS, "
+        "50%% < %.0f uS, 99%% < %.0f uS\n", pName,
+        static_cast < unsigned long > ( total ),
+        static_cast < double > ( hist.sumMicroSec ) / hist.count,
+        static_cast < unsigned long > ( hist.maxMicroSec ),
+        percentile ( hist, total, 0.5 ), percentile ( hist, total, 0.99 ) );
+    if ( level > 0u ) {
+        for ( unsigned i = 0u; i < CA_LATENCY_BINS; i++ ) {
+            if ( hist.bin[i] ) {
+                ::printf ( "\t\t< %10.0f uS %lu\n", ldexp ( 2.0, i ),
+                    static_cast < unsigned long > ( hist.bin[i] ) );
+            }
+        }
+    }
+}
+
+void caLatencyShow ( unsigned level )
+{
+    ::printf ( "Latency for all CA client contexts in this process:\n" );
+    caSearchLatency.show ( "search reply", level );
+    caConnectLatency.show ( "connect", level );
+    caGetLatency.show ( "get round trip", level );
+    caPutLatency.show ( "put round trip", level );
+    caSendStallLatency.show ( "send queue stall", level );
+}
+
+void epicsStdCall ca_client_stats ( struct ca_client_stats * pStats )
+{
+    caSearchLatency.get ( pStats->searchReply );
+    caConnectLatency.get ( pStats->connect );
+    caGetLatency.get ( pStats->getRoundTrip );
+    caPutLatency.get ( pStats->putRoundTrip );
+    caSendStallLatency.get ( pStats->sendStall );
+}
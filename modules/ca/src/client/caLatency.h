@@ -0,0 +1,46 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Latency histograms shared by all of the client contexts in this
+ * process. They are updated with atomic operations only, so they may
+ * be sampled from any thread, with or without the context lock held,
+ * and they are read by ca_client_stats() without any locking.
+ */
+
+#ifndef INC_caLatency_H
+#define INC_caLatency_H
+
+#include "epicsTime.h"
+#include "caDiagnostics.h"
+
+class caLatencyHistogram {
+public:
+    // the elapsed time since a start time from epicsMonotonicGet()
+    void sample ( epicsUInt64 startTime );
+    void sampleSeconds ( double delay );
+    void get ( struct ca_latency_hist & ) const;
+    void show ( const char * pName, unsigned level ) const;
+private:
+    // instances have static storage duration, and are therefore
+    // zeroed, so there is no constructor which might run after
+    // the first samples are taken
+    size_t count;
+    size_t sumMicroSec;
+    size_t maxMicroSec;
+    size_t bins[CA_LATENCY_BINS];
+    void sampleMicroSec ( epicsUInt64 delay );
+};
+
+extern caLatencyHistogram caSearchLatency;
+extern caLatencyHistogram caConnectLatency;
+extern caLatencyHistogram caGetLatency;
+extern caLatencyHistogram caPutLatency;
+extern caLatencyHistogram caSendStallLatency;
+
+void caLatencyShow ( unsigned level );
+
+#endif // ifndef INC_caLatency_H
@@ -0,0 +1,603 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+/*
+ *
+ *  CA name server, run by the caNameServer executable
+ *
+ *  PURPOSE:
+ *  Servers (RSRV with EPICS_CAS_NAME_SERVERS set) connect at boot and
+ *  push the names of all of their PVs with CA_PROTO_NAME_REGISTER
+ *  messages, keeping the circuit open. Clients list this server in
+ *  EPICS_CA_NAME_SERVERS and search over a persistent TCP circuit.
+ *  Each search for a registered name is answered with the address
+ *  of the server which registered it, so large numbers of channels
+ *  are resolved without UDP broadcasts.
+ *
+ *  NOTES:
+ *  1) The names registered over a circuit are withdrawn when that
+ *     circuit closes, so a server which has exited is not advertised.
+ *  2) Searches for names which are not registered are not answered,
+ *     and the client falls back to its other search destinations.
+ *  3) A name which includes a field name, or a server side filter,
+ *     is looked up by its record name.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "epicsAssert.h"
+#include "errlog.h"
+#include "fdManager.h"
+#include "osiSock.h"
+#include "osiWireFormat.h"
+#include "resourceLib.h"
+#include "tsDLList.h"
+
+#include "caProto.h"
+#include "nciu.h" // for CA_MINOR_PROTOCOL_REVISION
+#include "caNameServer.h"
+
+class nsCircuit;
+class nsServer;
+
+//
+// a name registered by a server
+//
+class nsName : public stringId,
+    public tsSLNode < nsName >, public tsDLNode < nsName > {
+public:
+    nsName ( const char * pName, nsCircuit & ownerIn ) :
+        stringId ( pName ), owner ( & ownerIn ) {}
+    nsCircuit * owner;
+private:
+    nsName ( const nsName & );
+    nsName & operator = ( const nsName & );
+};
+
+class nsCircuitReadReg : public fdReg {
+public:
+    nsCircuitReadReg ( nsCircuit & circIn, SOCKET sockIn ) :
+        fdReg ( sockIn, fdrRead ), circ ( circIn ) {}
+private:
+    nsCircuit & circ;
+    void callBack ();
+};
+
+//
+// installed while replies are pending, and removed by
+// flush() once they have all been sent. This is not a one
+// shot registration because fdManager keeps those installed
+// until their call back returns, so one could not be replaced
+// from within the call back.
+//
+class nsCircuitWriteReg : public fdReg {
+public:
+    nsCircuitWriteReg ( nsCircuit & circIn, SOCKET sockIn ) :
+        fdReg ( sockIn, fdrWrite ), circ ( circIn ) {}
+private:
+    nsCircuit & circ;
+    void callBack ();
+};
+
+//
+// a TCP circuit from either a client or a registering server
+//
+class nsCircuit : public tsDLNode < nsCircuit > {
+public:
+    nsCircuit ( nsServer &, SOCKET, const osiSockAddr & );
+    ~nsCircuit ();
+    void readReady ();
+    void writeReady ();
+    void show ( unsigned level ) const;
+private:
+    // replies are not read from circuits with more than this pending
+    static const unsigned sendHighWater = 1024u * 1024u;
+    static const unsigned recvBufSize = 2u * MAX_TCP;
+    tsDLList < nsName > names; // registered over this circuit
+    osiSockAddr peer;
+    nsServer & server;
+    nsCircuitReadReg * pReadReg;
+    nsCircuitWriteReg * pWriteReg;
+    char * pSend;
+    unsigned sendSize;
+    unsigned sendCapacity;
+    unsigned recvSize;
+    SOCKET sock;
+    unsigned long nSearch;
+    unsigned long nFound;
+    char recvBuf[recvBufSize];
+    bool processInput ();
+    bool dispatch ( const caHdr &, ca_uint32_t postsize,
+        ca_uint32_t count, char * pPayload );
+    void registerNames ( const caHdr &, ca_uint32_t postsize,
+        ca_uint32_t count, char * pPayload );
+    void search ( const caHdr &, ca_uint32_t postsize, char * pPayload );
+    void reply ( ca_uint16_t cmmd, ca_uint16_t dataType, ca_uint16_t count,
+        ca_uint32_t cid, ca_uint32_t available );
+    bool flush ();
+    nsCircuit ( const nsCircuit & );
+    nsCircuit & operator = ( const nsCircuit & );
+    friend class nsCircuitWriteReg;
+};
+
+class nsServer : public caNameServer, public fdReg {
+public:
+    nsServer ( SOCKET, bool verbose );
+    ~nsServer ();
+    nsName * lookup ( const char * pName ) const;
+    void install ( nsName & );
+    void uninstall ( nsName & );
+    void destroyCircuit ( nsCircuit & );
+    void searchNotify ( bool found );
+    void report ();
+    const bool verbose;
+private:
+    openResTable < nsName, stringId > nameTable;
+    tsDLList < nsCircuit > circuits;
+    SOCKET sock;
+    unsigned long nSearch;
+    unsigned long nFound;
+    void callBack ();
+    nsServer ( const nsServer & );
+    nsServer & operator = ( const nsServer & );
+};
+
+void nsCircuitReadReg::callBack ()
+{
+    this->circ.readReady ();
+}
+
+void nsCircuitWriteReg::callBack ()
+{
+    this->circ.writeReady ();
+}
+
+nsCircuit::nsCircuit ( nsServer & serverIn, SOCKET sockIn,
+        const osiSockAddr & peerIn ) :
+    peer ( peerIn ), server ( serverIn ), pReadReg ( 0 ), pWriteReg ( 0 ),
+    pSend ( 0 ), sendSize ( 0u ), sendCapacity ( 0u ), recvSize ( 0u ),
+    sock ( sockIn ), nSearch ( 0u ), nFound ( 0u )
+{
+    this->pReadReg = new nsCircuitReadReg ( *this, this->sock );
+
+    // identify ourselves as a V4.13 server, which also
+    // tells clients that search requests may be sent over TCP
+    this->reply ( CA_PROTO_VERSION, 0u, CA_MINOR_PROTOCOL_REVISION, 0u, 0u );
+    this->flush ();
+}
+
+nsCircuit::~nsCircuit ()
+{
+    unsigned nNames = this->names.count ();
+    while ( nsName * pName = this->names.get () ) {
+        this->server.uninstall ( *pName );
+        delete pName;
+    }
+    if ( this->server.verbose ) {
+        char buf[64];
+        ipAddrToDottedIP ( & this->peer.ia, buf, sizeof ( buf ) );
+        if ( nNames ) {
+            ::printf ( "caNameServer: %s disconnected, withdrew %u names\n",
+                buf, nNames );
+        }
+        else {
+            ::printf ( "caNameServer: %s disconnected after %lu searches, %lu found\n",
+                buf, this->nSearch, this->nFound );
+        }
+    }
+    delete this->pReadReg;
+    delete this->pWriteReg;
+    free ( this->pSend );
+    epicsSocketDestroy ( this->sock );
+}
+
+void nsCircuit::readReady ()
+{
+    while ( true ) {
+        int status = ::recv ( this->sock, & this->recvBuf[this->recvSize],
+            static_cast < int > ( recvBufSize - this->recvSize ), 0 );
+        if ( status == 0 ) {
+            this->server.destroyCircuit ( *this );
+            return;
+        }
+        if ( status < 0 ) {
+            int errnoCpy = SOCKERRNO;
+            if ( errnoCpy == SOCK_EWOULDBLOCK || errnoCpy == SOCK_EINTR ) {
+                break;
+            }
+            if ( errnoCpy != SOCK_ECONNRESET && errnoCpy != SOCK_ECONNABORTED ) {
+                char sockErrBuf[64];
+                epicsSocketConvertErrnoToString (
+                    sockErrBuf, sizeof ( sockErrBuf ) );
+                errlogPrintf ( "caNameServer: recv error was \"%s\"\n",
+                    sockErrBuf );
+            }
+            this->server.destroyCircuit ( *this );
+            return;
+        }
+        this->recvSize += static_cast < unsigned > ( status );
+        if ( ! this->processInput () ) {
+            this->server.destroyCircuit ( *this );
+            return;
+        }
+        if ( this->sendSize >= sendHighWater ) {
+            break;
+        }
+    }
+
+    if ( ! this->flush () ) {
+        this->server.destroyCircuit ( *this );
+        return;
+    }
+
+    // stop reading until the client catches up
+    if ( this->sendSize >= sendHighWater ) {
+        delete this->pReadReg;
+        this->pReadReg = 0;
+    }
+}
+
+void nsCircuit::writeReady ()
+{
+    if ( ! this->flush () ) {
+        this->server.destroyCircuit ( *this );
+        return;
+    }
+    if ( ! this->pReadReg && this->sendSize < sendHighWater / 2u ) {
+        this->pReadReg = new nsCircuitReadReg ( *this, this->sock );
+    }
+}
+
+//
+// send as much as the socket will take, and arrange to be called
+// back while replies remain. Returns false if the circuit failed.
+//
+bool nsCircuit::flush ()
+{
+    unsigned sent = 0u;
+    while ( sent < this->sendSize ) {
+        int status = ::send ( this->sock, & this->pSend[sent],
+            static_cast < int > ( this->sendSize - sent ), 0 );
+        if ( status < 0 ) {
+            int errnoCpy = SOCKERRNO;
+            if ( errnoCpy == SOCK_EWOULDBLOCK || errnoCpy == SOCK_EINTR ) {
+                break;
+            }
+            return false;
+        }
+        sent += static_cast < unsigned > ( status );
+    }
+    if ( sent ) {
+        this->sendSize -= sent;
+        memmove ( this->pSend, & this->pSend[sent], this->sendSize );
+    }
+    if ( this->sendSize && ! this->pWriteReg ) {
+        this->pWriteReg = new nsCircuitWriteReg ( *this, this->sock );
+    }
+    else if ( ! this->sendSize && this->pWriteReg ) {
+        // fdManager allows a registration to be deleted
+        // from within its own call back
+        delete this->pWriteReg;
+        this->pWriteReg = 0;
+    }
+    return true;
+}
+
+void nsCircuit::reply ( ca_uint16_t cmmd, ca_uint16_t dataType,
+    ca_uint16_t count, ca_uint32_t cid, ca_uint32_t available )
+{
+    if ( this->sendSize + sizeof ( caHdr ) > this->sendCapacity ) {
+        unsigned newCapacity = this->sendCapacity ?
+            2u * this->sendCapacity : MAX_TCP;
+        char * pNew = static_cast < char * > (
+            realloc ( this->pSend, newCapacity ) );
+        if ( ! pNew ) {
+            errlogPrintf ( "caNameServer: reply buffer allocation failed\n" );
+            return;
+        }
+        this->pSend = pNew;
+        this->sendCapacity = newCapacity;
+    }
+    caHdr msg;
+    AlignedWireRef < epicsUInt16 > ( msg.m_cmmd ) = cmmd;
+    AlignedWireRef < epicsUInt16 > ( msg.m_postsize ) = 0u;
+    AlignedWireRef < epicsUInt16 > ( msg.m_dataType ) = dataType;
+    AlignedWireRef < epicsUInt16 > ( msg.m_count ) = count;
+    AlignedWireRef < epicsUInt32 > ( msg.m_cid ) = cid;
+    AlignedWireRef < epicsUInt32 > ( msg.m_available ) = available;
+    memcpy ( & this->pSend[this->sendSize], & msg, sizeof ( msg ) );
+    this->sendSize += sizeof ( msg );
+}
+
+//
+// dispatch all complete messages in the receive buffer,
+// returns false if the circuit should be disconnected
+//
+bool nsCircuit::processInput ()
+{
+    unsigned pos = 0u;
+    while ( this->recvSize - pos >= sizeof ( caHdr ) ) {
+        caHdr msg;
+        memcpy ( & msg, & this->recvBuf[pos], sizeof ( msg ) );
+        ca_uint32_t postsize = AlignedWireRef < epicsUInt16 > ( msg.m_postsize );
+        ca_uint32_t count = AlignedWireRef < epicsUInt16 > ( msg.m_count );
+        unsigned hdrSize = sizeof ( caHdr );
+        if ( postsize == 0xffff && count == 0u ) {
+            // large array header
+            if ( this->recvSize - pos < sizeof ( caHdr ) + 2 * sizeof ( ca_uint32_t ) ) {
+                break;
+            }
+            ca_uint32_t ext[2];
+            memcpy ( ext, & this->recvBuf[pos + sizeof ( caHdr )], sizeof ( ext ) );
+            postsize = AlignedWireRef < epicsUInt32 > ( ext[0] );
+            count = AlignedWireRef < epicsUInt32 > ( ext[1] );
+            hdrSize += sizeof ( ext );
+        }
+        if ( postsize > recvBufSize - hdrSize ) {
+            char buf[64];
+            ipAddrToDottedIP ( & this->peer.ia, buf, sizeof ( buf ) );
+            errlogPrintf ( "caNameServer: %u byte message from %s is too large\n",
+                postsize, buf );
+            return false;
+        }
+        if ( this->recvSize - pos < hdrSize + postsize ) {
+            break;
+        }
+        if ( ! this->dispatch ( msg, postsize, count,
+                & this->recvBuf[pos + hdrSize] ) ) {
+            return false;
+        }
+        pos += hdrSize + postsize;
+    }
+    this->recvSize -= pos;
+    memmove ( this->recvBuf, & this->recvBuf[pos], this->recvSize );
+    return true;
+}
+
+bool nsCircuit::dispatch ( const caHdr & msg, ca_uint32_t postsize,
+    ca_uint32_t count, char * pPayload )
+{
+    ca_uint16_t cmmd = AlignedWireRef < const epicsUInt16 > ( msg.m_cmmd );
+    switch ( cmmd ) {
+    case CA_PROTO_SEARCH:
+        this->search ( msg, postsize, pPayload );
+        break;
+    case CA_PROTO_NAME_REGISTER:
+        this->registerNames ( msg, postsize, count, pPayload );
+        break;
+    case CA_PROTO_ECHO:
+        this->reply ( CA_PROTO_ECHO, 0u, 0u, 0u, 0u );
+        break;
+    case CA_PROTO_VERSION:
+    case CA_PROTO_HOST_NAME:
+    case CA_PROTO_CLIENT_NAME:
+    case CA_PROTO_EVENTS_ON:
+    case CA_PROTO_EVENTS_OFF:
+        break;
+    default:
+        {
+            char buf[64];
+            ipAddrToDottedIP ( & this->peer.ia, buf, sizeof ( buf ) );
+            errlogPrintf ( "caNameServer: unsupported request %u from %s\n",
+                cmmd, buf );
+        }
+        return false;
+    }
+    return true;
+}
+
+void nsCircuit::registerNames ( const caHdr & msg, ca_uint32_t postsize,
+    ca_uint32_t count, char * pPayload )
+{
+    osiSockAddr serverAddr;
+    memset ( & serverAddr, 0, sizeof ( serverAddr ) );
+    serverAddr.ia.sin_family = AF_INET;
+    serverAddr.ia.sin_port = htons (
+        AlignedWireRef < const epicsUInt16 > ( msg.m_dataType ) );
+    ca_uint32_t ip = AlignedWireRef < const epicsUInt32 > ( msg.m_cid );
+    if ( ip == 0u ) {
+        serverAddr.ia.sin_addr = this->peer.ia.sin_addr;
+    }
+    else {
+        serverAddr.ia.sin_addr.s_addr = htonl ( ip );
+    }
+
+    unsigned nDuplicate = 0u;
+    const char * pCur = pPayload;
+    const char * pEnd = pPayload + postsize;
+    for ( ca_uint32_t i = 0u; i < count && pCur < pEnd; i++ ) {
+        const char * pNul = static_cast < const char * > (
+            memchr ( pCur, '\0', pEnd - pCur ) );
+        if ( ! pNul ) {
+            break;
+        }
+        if ( pNul > pCur ) {
+            nsName * pName = this->server.lookup ( pCur );
+            if ( ! pName ) {
+                pName = new nsName ( pCur, *this );
+                this->server.install ( *pName );
+                this->names.add ( *pName );
+            }
+            else if ( pName->owner != this ) {
+                // a server which has restarted may register again
+                // before its old circuit is known to be dead, but
+                // other servers on the same host have other ports
+                const osiSockAddr & prev = pName->owner->peer;
+                if ( prev.ia.sin_addr.s_addr == serverAddr.ia.sin_addr.s_addr &&
+                        prev.ia.sin_port == serverAddr.ia.sin_port ) {
+                    pName->owner->names.remove ( *pName );
+                    pName->owner = this;
+                    this->names.add ( *pName );
+                }
+                else {
+                    nDuplicate++;
+                }
+            }
+        }
+        pCur = pNul + 1;
+    }
+
+    // the server address is recorded once per circuit
+    this->peer.ia.sin_port = serverAddr.ia.sin_port;
+    this->peer.ia.sin_addr = serverAddr.ia.sin_addr;
+
+    if ( nDuplicate ) {
+        char buf[64];
+        ipAddrToDottedIP ( & serverAddr.ia, buf, sizeof ( buf ) );
+        errlogPrintf ( "caNameServer: %u names from %s are already registered by another server\n",
+            nDuplicate, buf );
+    }
+}
+
+void nsCircuit::search ( const caHdr & msg, ca_uint32_t postsize,
+    char * pPayload )
+{
+    if ( postsize <= 1u ) {
+        return;
+    }
+    pPayload[postsize - 1u] = '\0';
+
+    nsName * pName = this->server.lookup ( pPayload );
+    if ( ! pName ) {
+        // look up "record.FIELD{filter}" by its record name
+        char * pDot = strchr ( pPayload, '.' );
+        if ( pDot ) {
+            *pDot = '\0';
+            pName = this->server.lookup ( pPayload );
+        }
+    }
+
+    this->nSearch++;
+    this->server.searchNotify ( pName != 0 );
+    if ( ! pName ) {
+        return;
+    }
+    this->nFound++;
+
+    // the type field carries the server's port number
+    const osiSockAddr & addr = pName->owner->peer;
+    this->reply ( CA_PROTO_SEARCH, ntohs ( addr.ia.sin_port ), 0u,
+        ntohl ( addr.ia.sin_addr.s_addr ),
+        AlignedWireRef < const epicsUInt32 > ( msg.m_available ) );
+}
+
+void nsCircuit::show ( unsigned level ) const
+{
+    char buf[64];
+    ipAddrToDottedIP ( & this->peer.ia, buf, sizeof ( buf ) );
+    if ( this->names.count () ) {
+        ::printf ( "  server %s with %u names\n", buf, this->names.count () );
+    }
+    else if ( level > 0u ) {
+        ::printf ( "  client %s with %lu searches, %lu found, %u bytes pending\n",
+            buf, this->nSearch, this->nFound, this->sendSize );
+    }
+}
+
+nsServer::nsServer ( SOCKET sockIn, bool verboseIn ) :
+    fdReg ( sockIn, fdrRead ), verbose ( verboseIn ), sock ( sockIn ),
+    nSearch ( 0u ), nFound ( 0u )
+{
+}
+
+nsServer::~nsServer ()
+{
+    while ( nsCircuit * pCirc = this->circuits.get () ) {
+        delete pCirc;
+    }
+}
+
+nsName * nsServer::lookup ( const char * pName ) const
+{
+    stringId id ( pName, stringId::refString );
+    return this->nameTable.lookup ( id );
+}
+
+void nsServer::install ( nsName & name )
+{
+    int status = this->nameTable.add ( name );
+    assert ( status == 0 );
+}
+
+void nsServer::uninstall ( nsName & name )
+{
+    nsName * pName = this->nameTable.remove ( name );
+    assert ( pName == & name );
+}
+
+void nsServer::destroyCircuit ( nsCircuit & circ )
+{
+    this->circuits.remove ( circ );
+    delete & circ;
+}
+
+void nsServer::searchNotify ( bool found )
+{
+    this->nSearch++;
+    if ( found ) {
+        this->nFound++;
+    }
+}
+
+void nsServer::report ()
+{
+    ::printf ( "caNameServer: %u names, %u circuits, %lu searches, %lu found\n",
+        this->nameTable.numEntriesInstalled (), this->circuits.count (),
+        this->nSearch, this->nFound );
+    tsDLIter < nsCircuit > iter ( this->circuits.firstIter () );
+    while ( iter.valid () ) {
+        iter->show ( this->verbose ? 1u : 0u );
+        iter++;
+    }
+    fflush ( stdout );
+}
+
+void nsServer::callBack ()
+{
+    osiSockAddr addr;
+    osiSocklen_t addrSize = sizeof ( addr );
+    SOCKET newSock = epicsSocketAccept ( this->sock, & addr.sa, & addrSize );
+    if ( newSock == INVALID_SOCKET ) {
+        int errnoCpy = SOCKERRNO;
+        if ( errnoCpy != SOCK_EWOULDBLOCK && errnoCpy != SOCK_EINTR ) {
+            char sockErrBuf[64];
+            epicsSocketConvertErrnoToString (
+                sockErrBuf, sizeof ( sockErrBuf ) );
+            errlogPrintf ( "caNameServer: accept error was \"%s\"\n",
+                sockErrBuf );
+        }
+        return;
+    }
+
+    int intTrue = true;
+    osiSockIoctl_t yes = true;
+    if ( setsockopt ( newSock, SOL_SOCKET, SO_KEEPALIVE,
+            (char *) & intTrue, sizeof ( intTrue ) ) < 0 ||
+        setsockopt ( newSock, IPPROTO_TCP, TCP_NODELAY,
+            (char *) & intTrue, sizeof ( intTrue ) ) < 0 ||
+        socket_ioctl ( newSock, FIONBIO, & yes ) < 0 ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        errlogPrintf ( "caNameServer: circuit set up failed because \"%s\"\n",
+            sockErrBuf );
+        epicsSocketDestroy ( newSock );
+        return;
+    }
+
+    if ( this->verbose ) {
+        char buf[64];
+        ipAddrToDottedIP ( & addr.ia, buf, sizeof ( buf ) );
+        ::printf ( "caNameServer: %s connected\n", buf );
+    }
+    this->circuits.add ( * new nsCircuit ( *this, newSock, addr ) );
+}
+
+caNameServer * caNameServer::create ( SOCKET sock, bool verbose )
+{
+    return new nsServer ( sock, verbose );
+}
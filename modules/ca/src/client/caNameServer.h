@@ -0,0 +1,25 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#ifndef INC_caNameServer_H
+#define INC_caNameServer_H
+
+#include "osiSock.h"
+
+//
+// A CA name server which accepts circuits on a bound, listening,
+// non-blocking socket. All of its work is done from the call backs
+// of the fileDescriptorManager. The socket is not closed when the
+// name server is destroyed.
+//
+class caNameServer {
+public:
+    static caNameServer * create ( SOCKET listenSock, bool verbose );
+    virtual ~caNameServer () {}
+    virtual void report () = 0;
+};
+
+#endif // ifndef INC_caNameServer_H
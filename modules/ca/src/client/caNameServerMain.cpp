@@ -0,0 +1,112 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "epicsGetopt.h"
+#include "epicsTime.h"
+#include "envDefs.h"
+#include "fdManager.h"
+#include "osiSock.h"
+
+#include "caProto.h"
+#include "caNameServer.h"
+
+static void usage ( char * argv[] )
+{
+    fprintf ( stderr, "Usage: %s -hv [-p port] [-r seconds]\n"
+            "\n"
+            " -h - Print this message\n"
+            " -v - Report connects and disconnects\n"
+            " -p - TCP port, the default is EPICS_CA_SERVER_PORT\n"
+            " -r - Print a status report at this interval\n",
+            argv[0] );
+}
+
+int main ( int argc, char * argv[] )
+{
+    unsigned short port = envGetInetPortConfigParam (
+        & EPICS_CA_SERVER_PORT, static_cast < unsigned short > ( CA_SERVER_PORT ) );
+    double reportPeriod = 0.0;
+    bool verbose = false;
+
+    int opt;
+    while ( ( opt = getopt ( argc, argv, "hvp:r:" ) ) != -1 ) {
+        switch ( opt ) {
+        default:
+            usage ( argv );
+            fprintf ( stderr, "\nUnknown argument '%c'\n", opt );
+            return 1;
+        case 'h':
+            usage ( argv );
+            return 0;
+        case 'v':
+            verbose = true;
+            break;
+        case 'p':
+            port = static_cast < unsigned short > ( atoi ( optarg ) );
+            break;
+        case 'r':
+            reportPeriod = atof ( optarg );
+            break;
+        }
+    }
+
+    if ( ! osiSockAttach () ) {
+        fprintf ( stderr, "caNameServer: unable to attach to the network\n" );
+        return 1;
+    }
+
+    SOCKET sock = epicsSocketCreate ( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+    if ( sock == INVALID_SOCKET ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        fprintf ( stderr, "caNameServer: unable to create socket because \"%s\"\n",
+            sockErrBuf );
+        return 1;
+    }
+
+    epicsSocketEnableAddressReuseDuringTimeWaitState ( sock );
+
+    osiSockAddr addr;
+    memset ( & addr, 0, sizeof ( addr ) );
+    addr.ia.sin_family = AF_INET;
+    addr.ia.sin_addr.s_addr = htonl ( INADDR_ANY );
+    addr.ia.sin_port = htons ( port );
+    osiSockIoctl_t yes = true;
+    if ( bind ( sock, & addr.sa, sizeof ( addr.ia ) ) < 0 ||
+            listen ( sock, 64 ) < 0 ||
+            socket_ioctl ( sock, FIONBIO, & yes ) < 0 ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        fprintf ( stderr, "caNameServer: unable to listen on port %u because \"%s\"\n",
+            port, sockErrBuf );
+        epicsSocketDestroy ( sock );
+        return 1;
+    }
+
+    caNameServer * pServer = caNameServer::create ( sock, verbose );
+    if ( verbose ) {
+        ::printf ( "caNameServer: listening on port %u\n", port );
+        fflush ( stdout );
+    }
+
+    epicsTime lastReport = epicsTime::getCurrent ();
+    while ( true ) {
+        fileDescriptorManager.process ( 1.0 );
+        if ( reportPeriod > 0.0 ) {
+            epicsTime now = epicsTime::getCurrent ();
+            if ( now - lastReport >= reportPeriod ) {
+                pServer->report ();
+                lastReport = now;
+            }
+        }
+    }
+}
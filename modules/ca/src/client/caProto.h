@@ -53,6 +53,8 @@
 #define CA_PORT_BASE            IPPORT_USERRESERVED + 56U
 #define CA_SERVER_PORT          (CA_PORT_BASE+CA_MAJOR_PROTOCOL_REVISION*2u)
 #define CA_REPEATER_PORT        (CA_PORT_BASE+CA_MAJOR_PROTOCOL_REVISION*2u+1u)
+/* beacons sent to EPICS_CA_MCAST_GROUP, see "EPICS_CA_MCAST_BEACON_PORT" */
+#define CA_MCAST_BEACON_PORT    (CA_PORT_BASE+CA_MAJOR_PROTOCOL_REVISION*2u+2u)
 
 /*
  * 1500 (max of ethernet and 802.{2,3} MTU) - 20(IP) - 8(UDP)
@@ -112,6 +114,12 @@ typedef ca_uint32_t     caResId;
 
 #define CA_PROTO_LAST_CMMD CA_PROTO_SERVER_DISCONN
 
+/*
+ * sent only by a server to a CA name server (caNameServer), never
+ * seen by clients or by servers
+ */
+#define CA_PROTO_NAME_REGISTER  28u /* server registers its PV names */
+
 /*
  * for use with search and not_found (if search fails and
  * its not a broadcast tell the client to look elesewhere)
@@ -30,14 +30,17 @@
 #include <stdexcept>
 #include <string> // vxWorks 6.0 requires this include
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "epicsExit.h"
 #include "errlog.h"
+#include "envDefs.h"
 #include "locationException.h"
 
 #include "iocinf.h"
 #include "oldAccess.h"
 #include "cac.h"
+#include "caLatency.h"
 
 epicsThreadPrivateId caClientCallbackThreadId;
 
@@ -58,15 +61,18 @@ extern epicsThreadPrivateId caClientContextId;
 cacService * ca_client_context::pDefaultService = 0;
 epicsMutex * ca_client_context::pDefaultServiceInstallMutex;
 
-ca_client_context::ca_client_context ( bool enablePreemptiveCallback ) :
+ca_client_context::ca_client_context (
+        bool enablePreemptiveCallback, bool enableIOPool ) :
     mutex(__FILE__, __LINE__),
     cbMutex(__FILE__, __LINE__),
+    pSubscrDelivering ( 0 ), subscrDeliveringThread ( 0 ),
+    subscrDeliveryHold ( 0u ), subscrDestroyPending ( false ),
     createdByThread ( epicsThreadGetIdSelf () ),
     ca_exception_func ( 0 ), ca_exception_arg ( 0 ),
     pVPrintfFunc ( errlogVprintf ), fdRegFunc ( 0 ), fdRegArg ( 0 ),
     pndRecvCnt ( 0u ), ioSeqNo ( 0u ), callbackThreadsPending ( 0u ),
     localPort ( 0 ), fdRegFuncNeedsToBeCalled ( false ),
-    noWakeupSincePend ( true )
+    noWakeupSincePend ( true ), subscrQueueExit ( false )
 {
     static const unsigned short PORT_ANY = 0u;
 
@@ -83,7 +89,21 @@ ca_client_context::ca_client_context ( bool enablePreemptiveCallback ) :
                     this->mutex, this->cbMutex, *this ) );
         }
         else {
-            this->pServiceContext.reset ( new cac ( this->mutex, this->cbMutex, *this ) );
+            // the event loop threads call callbacks so they are
+            // only used when callbacks are preemptive
+            unsigned nIOThreads = 0u;
+            if ( enableIOPool && enablePreemptiveCallback ) {
+                long nThreads;
+                if ( envGetLongConfigParam ( & EPICS_CA_IO_THREADS, & nThreads ) ||
+                        nThreads < 1 ) {
+                    nThreads = 2;
+                    errlogPrintf ( "EPICS \"%s\" was not a positive integer, "
+                        "using %ld\n", EPICS_CA_IO_THREADS.name, nThreads );
+                }
+                nIOThreads = static_cast < unsigned > ( nThreads );
+            }
+            this->pServiceContext.reset (
+                new cac ( this->mutex, this->cbMutex, *this, nIOThreads ) );
         }
     }
 
@@ -164,6 +184,15 @@ ca_client_context::ca_client_context ( bool enablePreemptiveCallback ) :
 
 ca_client_context::~ca_client_context ()
 {
+    if ( this->pSubscrQueueThread.get () ) {
+        {
+            epicsGuard < epicsMutex > guard ( this->mutex );
+            this->subscrQueueExit = true;
+        }
+        this->subscrQueueEvent.signal ();
+        this->pSubscrQueueThread.reset ( 0 );
+    }
+
     if ( this->fdRegFunc ) {
         ( *this->fdRegFunc )
             ( this->fdRegArg, this->sock, false );
@@ -214,10 +243,199 @@ void ca_client_context::destroySubscription (
     epicsGuard < epicsMutex > & guard, oldSubscription & os )
 {
     guard.assertIdenticalMutex ( this->mutex );
+    if ( os.onReadyList ) {
+        this->subscrReadyList.remove ( os );
+    }
+    if ( this->pSubscrDelivering == & os ) {
+        this->pSubscrDelivering = 0;
+        if ( this->subscrDeliveringThread != epicsThreadGetIdSelf () ) {
+            // its callback is running in the delivery thread,
+            // which destroys it when the callback returns
+            this->subscrDestroyPending = true;
+            return;
+        }
+    }
     os.~oldSubscription ();
     this->subscriptionFreeList.release ( & os );
 }
 
+int ca_client_context::setSubscriptionQueue (
+    oldSubscription & os, unsigned depth )
+{
+    // with preemptive callback a thread calls the queued
+    // callbacks, otherwise ca_pend_event () does
+    if ( depth && ! this->pCallbackGuard.get () ) {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        if ( ! this->pSubscrQueueThread.get () ) {
+            try {
+                this->pSubscrQueueThread.reset (
+                    new subscriptionQueueThread ( *this,
+                        epicsThreadGetPrioritySelf () ) );
+            }
+            catch ( ... ) {
+                return ECA_ALLOCMEM;
+            }
+            this->pSubscrQueueThread->start ();
+        }
+    }
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    int status = os.setQueueDepth ( guard, depth );
+    if ( os.onReadyList && ! os.queuePending ( guard ) ) {
+        this->subscrReadyList.remove ( os );
+        os.onReadyList = false;
+    }
+    return status;
+}
+
+void ca_client_context::subscriptionUpdateQueued (
+    epicsGuard < epicsMutex > & guard, oldSubscription & os )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    bool signalNeeded = this->subscrReadyList.count () == 0u;
+    this->subscrReadyList.add ( os );
+    os.onReadyList = true;
+    if ( signalNeeded ) {
+        this->subscrQueueEvent.signal ();
+    }
+}
+
+//
+// Deliver the oldest update of the first subscription on the ready
+// list, which then moves to the back of the list if it has more so
+// that subscriptions take turns. Returns false if there was nothing
+// to deliver.
+//
+bool ca_client_context::deliverQueuedUpdate (
+    epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    oldSubscription * pSubscr = this->subscrReadyList.get ();
+    if ( ! pSubscr ) {
+        return false;
+    }
+    queuedUpdate * pUpdate = pSubscr->popQueued ( guard );
+    if ( pSubscr->queuePending ( guard ) ) {
+        this->subscrReadyList.add ( *pSubscr );
+    }
+    else {
+        pSubscr->onReadyList = false;
+    }
+    if ( pUpdate ) {
+        // the callback might destroy the subscription
+        this->pSubscrDelivering = pSubscr;
+        this->subscrDeliveringThread = epicsThreadGetIdSelf ();
+        pSubscr->deliver ( guard, *pUpdate );
+        if ( this->subscrDestroyPending ) {
+            this->subscrDestroyPending = false;
+            pSubscr->~oldSubscription ();
+            this->subscriptionFreeList.release ( pSubscr );
+            free ( pUpdate );
+        }
+        else if ( this->pSubscrDelivering == pSubscr ) {
+            pSubscr->recycle ( guard, pUpdate );
+        }
+        else {
+            free ( pUpdate );
+        }
+        this->pSubscrDelivering = 0;
+        this->subscrDeliveringThread = 0;
+        if ( this->subscrDeliveryHold ) {
+            this->subscrDeliveryDone.signal ();
+        }
+    }
+    return true;
+}
+
+//
+// The delivery thread calls the callbacks without the callback lock.
+// Before clearing a channel or subscription, an application thread
+// stops it from starting new callbacks, and waits for the running one
+// to return. A CA callback holds the callback lock, and must not wait
+// because the callback it waits for might need that lock. Returns true
+// if releaseSubscriptionDelivery () must be called.
+//
+bool ca_client_context::holdSubscriptionDelivery ()
+{
+    if ( epicsThreadPrivateGet ( caClientCallbackThreadId ) ) {
+        return false;
+    }
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    if ( ! this->pSubscrQueueThread.get () ) {
+        return false;
+    }
+    this->subscrDeliveryHold++;
+    while ( this->subscrDeliveringThread ) {
+        epicsGuardRelease < epicsMutex > unguard ( guard );
+        this->subscrDeliveryDone.wait ();
+    }
+    // another thread may be waiting too
+    this->subscrDeliveryDone.signal ();
+    return true;
+}
+
+void ca_client_context::releaseSubscriptionDelivery ()
+{
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        this->subscrDeliveryHold--;
+    }
+    this->subscrQueueEvent.signal ();
+}
+
+// called by ca_pend_event () when preemptive callback is disabled
+void ca_client_context::deliverQueuedUpdates ()
+{
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    if ( this->subscrReadyList.count () ) {
+        // calls to ca_pend_event () etc are not allowed in the callbacks
+        epicsThreadPrivateSet ( caClientCallbackThreadId, this );
+        while ( this->deliverQueuedUpdate ( guard ) ) {
+        }
+        epicsThreadPrivateSet ( caClientCallbackThreadId, 0 );
+    }
+}
+
+subscriptionQueueThread::subscriptionQueueThread (
+        ca_client_context & ctxIn, unsigned priority ) :
+    thread ( *this, "CAC-subscr-queue",
+        epicsThreadGetStackSize ( epicsThreadStackSmall ), priority ),
+    ctx ( ctxIn )
+{
+}
+
+subscriptionQueueThread::~subscriptionQueueThread ()
+{
+    this->thread.exitWait ();
+}
+
+void subscriptionQueueThread::start ()
+{
+    this->thread.start ();
+}
+
+void subscriptionQueueThread::run ()
+{
+    epicsThreadPrivateSet ( caClientCallbackThreadId, this );
+    ca_attach_context ( & this->ctx );
+    while ( true ) {
+        this->ctx.subscrQueueEvent.wait ();
+        bool more = true;
+        while ( more ) {
+            // the callbacks are called without the callback lock so
+            // that a slow one does not stall the receive threads
+            epicsGuard < epicsMutex > guard ( this->ctx.mutex );
+            if ( this->ctx.subscrQueueExit ) {
+                return;
+            }
+            if ( this->ctx.subscrDeliveryHold ) {
+                // releaseSubscriptionDelivery () wakes us
+                break;
+            }
+            more = this->ctx.deliverQueuedUpdate ( guard );
+        }
+    }
+}
+
 void ca_client_context::changeExceptionEvent (
     caExceptionHandler * pfunc, void * arg )
 {
@@ -428,6 +646,7 @@ void ca_client_context::show ( unsigned level ) const
         this->ioDone.show ( level - 1u );
         ::printf ( "Synchronous group identifier hash table:\n" );
         this->sgTable.show ( level - 1u );
+        caLatencyShow ( level - 1u );
     }
 }
 
@@ -563,6 +782,10 @@ int ca_client_context::pendEvent ( const double & timeout )
         this->noWakeupSincePend = true;
     }
 
+    if ( this->pCallbackGuard.get() ) {
+        this->deliverQueuedUpdates ();
+    }
+
     double elapsed = epicsTime::getCurrent() - current;
     double delay;
 
@@ -575,8 +798,23 @@ int ca_client_context::pendEvent ( const double & timeout )
 
     if ( delay >= CAC_SIGNIFICANT_DELAY ) {
         if ( this->pCallbackGuard.get() ) {
-            epicsGuardRelease < epicsMutex > unguard ( *this->pCallbackGuard );
-            epicsThreadSleep ( delay );
+            // queued subscription updates are delivered as they arrive
+            epicsTime deadline = epicsTime::getCurrent () + delay;
+            while ( true ) {
+                bool queued;
+                {
+                    epicsGuardRelease < epicsMutex > unguard ( *this->pCallbackGuard );
+                    queued = this->subscrQueueEvent.wait ( delay );
+                }
+                if ( ! queued ) {
+                    break;
+                }
+                this->deliverQueuedUpdates ();
+                delay = deadline - epicsTime::getCurrent ();
+                if ( delay < CAC_SIGNIFICANT_DELAY ) {
+                    break;
+                }
+            }
         }
         else {
             epicsThreadSleep ( delay );
@@ -662,6 +900,20 @@ cacChannel & ca_client_context::createChannel (
         guard, pChannelName, chan, pri );
 }
 
+void ca_client_context::reserveChannels (
+    epicsGuard < epicsMutex > & guard, unsigned nChannels )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    this->pServiceContext->reserveChannels ( guard, nChannels );
+}
+
+void ca_client_context::expediteSearch (
+    epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    this->pServiceContext->expediteSearch ( guard );
+}
+
 void ca_client_context::flush ( epicsGuard < epicsMutex > & guard )
 {
     this->pServiceContext->flush ( guard );
@@ -745,6 +997,7 @@ LIBCA_API int epicsStdCall ca_clear_subscription ( evid pMon )
 {
     oldChannelNotify & chan = pMon->channel ();
     ca_client_context & cac = chan.getClientCtx ();
+    bool held = cac.holdSubscriptionDelivery ();
     // !!!! the order in which we take the mutex here prevents deadlocks
     {
         epicsGuard < epicsMutex > guard ( cac.mutex );
@@ -776,9 +1029,26 @@ LIBCA_API int epicsStdCall ca_clear_subscription ( evid pMon )
       epicsGuard < epicsMutex > guard ( cac.mutex );
       pMon->cancel ( cbGuard, guard );
     }
+    if ( held ) {
+        cac.releaseSubscriptionDelivery ();
+    }
     return ECA_NORMAL;
 }
 
+LIBCA_API int epicsStdCall ca_set_subscription_queue (
+    evid pMon, unsigned depth )
+{
+    ca_client_context & cac = pMon->channel ().getClientCtx ();
+    return cac.setSubscriptionQueue ( *pMon, depth );
+}
+
+LIBCA_API unsigned long epicsStdCall ca_subscription_overflows ( evid pMon )
+{
+    ca_client_context & cac = pMon->channel ().getClientCtx ();
+    epicsGuard < epicsMutex > guard ( cac.mutex );
+    return pMon->queueOverflows ( guard );
+}
+
 void ca_client_context :: eliminateExcessiveSendBacklog (
     epicsGuard < epicsMutex > & guard, cacChannel & chan )
 {
@@ -128,7 +128,7 @@ const cac::pExcepProtoStubTCP cac::tcpExcepJumpTableCAC [] =
 cac::cac (
     epicsMutex & mutualExclusionIn,
     epicsMutex & callbackControlIn,
-    cacContextNotify & notifyIn ) :
+    cacContextNotify & notifyIn, unsigned nIOThreads ) :
     _refLocalHostName ( localHostNameCache.getReference () ),
     programBeginTime ( epicsTime::getCurrent() ),
     connTMO ( CA_CONN_VERIFY_PERIOD ),
@@ -139,6 +139,7 @@ cac::cac (
         lowestPriorityLevelAbove(epicsThreadGetPrioritySelf()) ) ),
     pUserName ( 0 ),
     pudpiiu ( 0 ),
+    pReactor ( 0 ),
     tcpSmallRecvBufFreeList ( 0 ),
     tcpLargeRecvBufFreeList ( 0 ),
     notify ( notifyIn ),
@@ -234,6 +235,11 @@ cac::cac (
             maxContigFrames = bufsPerArray *
                 contiguousMsgCountWhichTriggersFlowControl;
         }
+
+        // circuits use their own receive and send threads
+        // if this returns NULL
+        this->pReactor = tcpReactor::create ( *this, nIOThreads,
+            highestPriorityLevelBelow ( this->initializingThreadsPriority ) );
     }
     catch ( ... ) {
         osiSockRelease ();
@@ -327,6 +333,8 @@ cac::~cac ()
         delete this->pudpiiu;
     }
 
+    delete this->pReactor;
+
     freeListCleanup ( this->tcpSmallRecvBufFreeList );
     if ( this->tcpLargeRecvBufFreeList ) {
         freeListCleanup ( this->tcpLargeRecvBufFreeList );
@@ -424,6 +432,9 @@ void cac::show (
         if ( this->pudpiiu ) {
             this->pudpiiu->show ( level - 2u );
         }
+        if ( this->pReactor ) {
+            this->pReactor->show ( level - 2u );
+        }
     }
 
     if ( level > 2u ) {
@@ -452,7 +463,7 @@ void cac::show (
 /*
  *  cac::beaconNotify
  */
-void cac::beaconNotify ( const inetAddrID & addr, const epicsTime & currentTime,
+void cac::beaconNotify ( const struct sockaddr_in & addr, const epicsTime & currentTime,
                         ca_uint32_t beaconNumber, unsigned protocolRevision  )
 {
     epicsGuard < epicsMutex > guard ( this->mutex );
@@ -495,12 +506,12 @@ void cac::beaconNotify ( const inetAddrID & addr, const epicsTime & currentTime,
 
     this->beaconAnomalyCount++;
 
-    this->pudpiiu->beaconAnomalyNotify ( guard );
+    this->pudpiiu->beaconAnomalyNotify ( guard, addr );
 
 #   ifdef DEBUG
     {
         char buf[128];
-        addr.name ( buf, sizeof ( buf ) );
+        inetAddrID ( addr ).name ( buf, sizeof ( buf ) );
         ::printf ( "New server available: %s\n", buf );
     }
 #   endif
@@ -553,7 +564,8 @@ bool cac::findOrCreateVirtCircuit (
                     new ( this->freeListVirtualCircuit ) tcpiiu (
                         *this, this->mutex, this->cbMutex, this->notify, this->connTMO,
                         this->timerQueue, addr, this->comBufMemMgr, minorVersionNumber,
-                        this->ipToAEngine, priority, pSearchDest ) );
+                        this->ipToAEngine, priority, pSearchDest,
+                        this->pReactor ) );
 
             bhe * pBHE = this->beaconTable.lookup ( addr.ia );
             if ( ! pBHE ) {
@@ -585,14 +597,14 @@ bool cac::findOrCreateVirtCircuit (
     return newIIU;
 }
 
-void cac::transferChanToVirtCircuit (
+bool cac::transferChanToVirtCircuit (
     unsigned cid, unsigned sid,
     ca_uint16_t typeCode, arrayElementCount count,
     unsigned minorVersionNumber, const osiSockAddr & addr,
     const epicsTime & currentTime )
 {
     if ( addr.sa.sa_family != AF_INET ) {
-        return;
+        return false;
     }
 
     epicsGuard < epicsMutex > guard ( this->mutex );
@@ -601,7 +613,7 @@ void cac::transferChanToVirtCircuit (
      * Do not open new circuits while the cac is shutting down
      */
     if ( this->cacShutdownInProgress ) {
-        return;
+        return false;
     }
 
     /*
@@ -609,7 +621,7 @@ void cac::transferChanToVirtCircuit (
      */
     nciu * pChan = this->chanTable.lookup ( cid );
     if ( ! pChan ) {
-        return;
+        return false;
     }
 
     /*
@@ -634,12 +646,20 @@ void cac::transferChanToVirtCircuit (
             epicsGuardRelease < epicsMutex > unguard ( guard );
             pMsg->ioInitiate ( addr );
         }
-        return;
+        return false;
     }
 
     caServerID servID ( addr.ia, pChan->getPriority(guard) );
     tcpiiu * piiu = this->serverTable.lookup ( servID );
 
+    // A circuit which is shutting down, because its last channel
+    // was cleared, can't accept a new channel. Ignore the reply
+    // so that the channel continues to be searched for until the
+    // circuit has been destroyed.
+    if ( piiu && ! piiu->alive ( guard ) ) {
+        return false;
+    }
+
     bool newIIU = findOrCreateVirtCircuit (
         guard, addr,
         pChan->getPriority(guard), piiu, minorVersionNumber );
@@ -655,6 +675,7 @@ void cac::transferChanToVirtCircuit (
             piiu->start ( guard );
         }
     }
+    return piiu != 0;
 }
 
 void cac::destroyChannel (
@@ -957,15 +978,25 @@ bool cac::eventRespAction ( callbackManager &, tcpiiu &iiu,
     baseNMIU * pmiu = this->ioTable.lookup ( hdr.m_available );
     if ( pmiu ) {
         /*
-         * convert the data buffer from net format to host format
+         * convert the data buffer from net format to host format,
+         * either in place or into the subscriber's own buffer
          */
+        void * pData = pMsgBdy;
         if ( caStatus == ECA_NORMAL ) {
+            netSubscription * pSubscr = pmiu->isSubscription ();
+            if ( pSubscr && ! INVALID_DB_REQ ( hdr.m_dataType ) ) {
+                void * pDest = pSubscr->updateDestination (
+                    guard, hdr.m_dataType, hdr.m_count );
+                if ( pDest ) {
+                    pData = pDest;
+                }
+            }
             caStatus = caNetConvert (
-                hdr.m_dataType, pMsgBdy, pMsgBdy, false, hdr.m_count );
+                hdr.m_dataType, pMsgBdy, pData, false, hdr.m_count );
         }
         if ( caStatus == ECA_NORMAL ) {
             pmiu->completion ( guard, *this,
-                hdr.m_dataType, hdr.m_count, pMsgBdy );
+                hdr.m_dataType, hdr.m_count, pData );
         }
         else {
             pmiu->exception ( guard, *this, caStatus,
@@ -1298,6 +1329,25 @@ void cac::initiateConnect (
     this->pudpiiu->installNewChannel ( guard, chan, piiu );
 }
 
+void cac::reserveChannels (
+    epicsGuard < epicsMutex > & guard, unsigned nChannels )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    // grow the hash table once instead of splitting buckets
+    // one at a time while the channels are installed
+    this->chanTable.setTableSize (
+        this->chanTable.numEntriesInstalled () + nChannels );
+}
+
+void cac::expediteSearch (
+    epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    if ( this->pudpiiu ) {
+        this->pudpiiu->expediteSearch ( guard );
+    }
+}
+
 void *cacComBufMemoryManager::allocate ( size_t size )
 {
     return this->freeList.allocate ( size );
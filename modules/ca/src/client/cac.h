@@ -104,11 +104,11 @@ public:
     cac (
         epicsMutex & mutualExclusion,
         epicsMutex & callbackControl,
-        cacContextNotify & );
+        cacContextNotify &, unsigned nIOThreads = 0u );
     virtual ~cac ();
 
     // beacon management
-    void beaconNotify ( const inetAddrID & addr, const epicsTime & currentTime,
+    void beaconNotify ( const struct sockaddr_in & addr, const epicsTime & currentTime,
         ca_uint32_t beaconNumber, unsigned protocolRevision );
     unsigned beaconAnomaliesSinceProgramStart (
         epicsGuard < epicsMutex > & ) const;
@@ -119,7 +119,8 @@ public:
         const epicsTime & currentTime, caHdrLargeArray &, char *pMsgBody );
 
     // channel routines
-    void transferChanToVirtCircuit (
+    // returns false if the search reply was ignored
+    bool transferChanToVirtCircuit (
         unsigned cid, unsigned sid,
         ca_uint16_t typeCode, arrayElementCount count,
         unsigned minorVersionNumber, const osiSockAddr &,
@@ -131,6 +132,10 @@ public:
         epicsGuard < epicsMutex > &, nciu & );
     void initiateConnect (
         epicsGuard < epicsMutex > &, nciu &, netiiu * & );
+    void reserveChannels (
+        epicsGuard < epicsMutex > &, unsigned nChannels );
+    void expediteSearch (
+        epicsGuard < epicsMutex > & );
     nciu * lookupChannel (
         epicsGuard < epicsMutex > &, const cacChannel::ioid & );
 
@@ -206,7 +211,7 @@ public:
 
 private:
     epicsSingleton < localHostName > :: reference _refLocalHostName;
-    chronIntIdResTable < nciu > chanTable;
+    chronIntIdOpenResTable < nciu > chanTable;
     //
     // !!!! There is at this point no good reason
     // !!!! to maintain one IO table for all types of
@@ -219,7 +224,7 @@ private:
     // !!!! approach would also probably be safer in
     // !!!! terms of detecting damaged protocol.
     //
-    chronIntIdResTable < baseNMIU > ioTable;
+    chronIntIdOpenResTable < baseNMIU > ioTable;
     resTable < bhe, inetAddrID > beaconTable;
     resTable < tcpiiu, caServerID > serverTable;
     tsDLList < tcpiiu > circuitList;
@@ -257,6 +262,7 @@ private:
     epicsTimerQueueActive & timerQueue;
     char * pUserName;
     class udpiiu * pudpiiu;
+    class tcpReactor * pReactor;
     void * tcpSmallRecvBufFreeList;
     void * tcpLargeRecvBufFreeList;
     cacContextNotify & notify;
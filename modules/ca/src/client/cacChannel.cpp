@@ -139,6 +139,18 @@ const char * cacChannel::pHostName (
 
 cacContext::~cacContext () {}
 
+// the default is to ignore the hint
+void cacContext::reserveChannels (
+    epicsGuard < epicsMutex > &, unsigned )
+{
+}
+
+// the default is to assume that there is no search delay
+void cacContext::expediteSearch (
+    epicsGuard < epicsMutex > & )
+{
+}
+
 cacService::~cacService () {}
 
 
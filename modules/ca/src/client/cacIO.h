@@ -100,6 +100,12 @@ public:
         epicsGuard < epicsMutex > &, int status,
         const char *pContext, unsigned type,
         arrayElementCount count ) = 0;
+    // a subscription may supply the destination of the next update,
+    // which is then converted into it directly from the receive
+    // buffer, by default the update is converted in place
+    virtual void * updateDestination (
+        epicsGuard < epicsMutex > &, unsigned type,
+        arrayElementCount count );
 };
 
 class caAccessRights {
@@ -276,6 +282,13 @@ public:
         epicsGuard < epicsMutex > &,
         const char * pChannelName, cacChannelNotify &,
         cacChannel::priLev = cacChannel::priorityDefault ) = 0;
+    // hint that nChannels more channels are about to be created
+    virtual void reserveChannels (
+        epicsGuard < epicsMutex > &, unsigned nChannels );
+    // begin searching for recently created channels now instead
+    // of when the search timer next expires
+    virtual void expediteSearch (
+        epicsGuard < epicsMutex > & );
     virtual void flush (
         epicsGuard < epicsMutex > & ) = 0;
     virtual unsigned circuitCount (
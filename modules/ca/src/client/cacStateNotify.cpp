@@ -26,3 +26,9 @@
 cacStateNotify::~cacStateNotify ()
 {
 }
+
+void * cacStateNotify::updateDestination (
+    epicsGuard < epicsMutex > &, unsigned, arrayElementCount )
+{
+    return 0;
+}
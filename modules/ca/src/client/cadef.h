@@ -174,7 +174,8 @@ LIBCA_API enum channel_state epicsStdCall ca_state (chid chan);
 /************************************************************************/
 LIBCA_API int epicsStdCall ca_task_initialize (void);
 enum ca_preemptive_callback_select
-{ ca_disable_preemptive_callback, ca_enable_preemptive_callback };
+{ ca_disable_preemptive_callback, ca_enable_preemptive_callback,
+  ca_enable_preemptive_callback_io_pool };
 LIBCA_API int epicsStdCall 
         ca_context_create (enum ca_preemptive_callback_select select);
 LIBCA_API void epicsStdCall ca_detach_context (); 
@@ -217,6 +218,35 @@ LIBCA_API int epicsStdCall ca_create_channel
      chid           *pChanID
 );
 
+/*
+ * ca_create_channels ()
+ *
+ * Create many channels at once. This is equivalent to calling
+ * ca_create_channel() for each name, except that the client library's
+ * lock is taken once, its channel table is sized once, and the search
+ * requests for all of the channels are sent immediately packed into as
+ * few UDP frames as possible. Either all of the channels are created,
+ * or none are and the channel ids are set to NULL.
+ *
+ * pChanNames           R   array of nChannels channel name strings
+ * nChannels            R   number of channels to create
+ * pConnStateCallback   R   address of connection state change
+ *                          callback function used for all channels
+ * pUserPrivates        R   array of nChannels user private values,
+ *                          or NULL if they are all to be NULL
+ * priority             R   priority level in the server 0 - 100
+ * pChanIDs             RW  array of nChannels, channel ids written here
+ */
+LIBCA_API int epicsStdCall ca_create_channels
+(
+     const char * const *   pChanNames,
+     unsigned               nChannels,
+     caCh                   *pConnStateCallback,
+     void * const *         pUserPrivates,
+     capri                  priority,
+     chid                   *pChanIDs
+);
+
 /*
  * ca_change_connection_event()
  *
@@ -468,6 +498,10 @@ LIBCA_API int epicsStdCall ca_array_get_callback
 /*                                                                      */
 /*  2)  An array count of zero specifies the native db count            */
 /*                                                                      */
+/*  3)  The update passed to the callback is a read only view of the    */
+/*      library's receive buffer, converted in place to host format,    */
+/*      which is valid only until the callback returns                  */
+/*                                                                      */
 /************************************************************************/
 
 /*
@@ -492,6 +526,45 @@ LIBCA_API int epicsStdCall ca_create_subscription
      evid *                 pEventID
 );
 
+/*
+ * ca_create_subscription_buffer ()
+ *
+ * Same as ca_create_subscription () except that, unless pBuffer is NULL, updates arriving over
+ * the network are converted from network format directly into the
+ * buffer supplied, which is then passed to the callback in args.dbr.
+ * The same buffer is reused for every update so the latest value
+ * remains available after the callback returns without copying it.
+ * An update which does not fit, or one from a process variable in the
+ * same address space, is passed as with ca_create_subscription ().
+ * The buffer is written immediately before the callback is called; if
+ * preemptive callback is disabled this only happens from within
+ * ca_pend_event (), ca_pend_io (), ca_poll () etc.
+ *
+ * type     R   data type from db_access.h
+ * count    R   array element count
+ * chan     R   channel identifier
+ * mask     R   event mask - one of {DBE_VALUE, DBE_ALARM, DBE_LOG}
+ * pFunc    R   pointer to call-back function
+ * pArg     R   copy of this pointer passed to pFunc
+ * pBuffer  R   destination of updates, at least dbr_size_n(type, count)
+ *              bytes, owned by the caller until the subscription is
+ *              cleared, or NULL
+ * bufferSize R size of the destination in bytes
+ * pEventID W   event id written at specified address
+ */
+LIBCA_API int epicsStdCall ca_create_subscription_buffer
+(
+     chtype                 type,
+     unsigned long          count,
+     chid                   chanId,
+     long                   mask,
+     caEventCallBackFunc *  pFunc,
+     void *                 pArg,
+     void *                 pBuffer,
+     unsigned long          bufferSize,
+     evid *                 pEventID
+);
+
 /************************************************************************/
 /*  Remove a function from a list of those specified to run             */
 /*  whenever significant changes occur to a channel                     */
@@ -509,6 +582,44 @@ LIBCA_API int epicsStdCall ca_clear_subscription
 
 LIBCA_API chid epicsStdCall ca_evid_to_chid ( evid id );
 
+/*
+ * ca_set_subscription_queue ()
+ *
+ * Queue up to depth updates of a subscription for delivery to its
+ * callback instead of calling it from the thread which received the
+ * update. When the queue is full a new update replaces the newest one
+ * pending, so that the latest value is always delivered, and the
+ * overflow count is incremented. Subscriptions with pending updates
+ * take turns having one callback called, so that a subscription with
+ * a slow callback doesn't delay the others. The callbacks are called
+ * by an auxiliary thread if preemptive callback is enabled, without
+ * the callback lock so that a slow one does not stall the receive
+ * threads, and otherwise from within ca_pend_event () and ca_poll ().
+ * A depth of zero restores immediate callbacks; pending updates
+ * beyond a new depth are discarded and counted as overflows.
+ *
+ * eventID  R   event id
+ * depth    R   maximum number of pending updates
+ */
+LIBCA_API int epicsStdCall ca_set_subscription_queue
+(
+     evid       eventID,
+     unsigned   depth
+);
+
+/*
+ * ca_subscription_overflows ()
+ *
+ * the number of queued updates of a subscription which were replaced
+ * by a later update or discarded
+ *
+ * eventID  R   event id
+ */
+LIBCA_API unsigned long epicsStdCall ca_subscription_overflows
+(
+     evid       eventID
+);
+
 
 /************************************************************************/
 /*                                                                      */
@@ -405,6 +405,116 @@ static void measure_get_latency (ti *pItems, unsigned iterations)
         min * 1e6, max * 1e6 );
 }
 
+/*
+ * connect_all ()
+ *
+ * returns the seconds needed to create and connect the first
+ * n channels, one at a time or with one bulk request
+ */
+static double connect_all ( const char **pNames,
+    chid *pChans, unsigned n, int bulk )
+{
+    epicsTimeStamp end_time;
+    epicsTimeStamp start_time;
+    unsigned i;
+    int status;
+
+    epicsTimeGetCurrent ( &start_time );
+    if ( bulk ) {
+        status = ca_create_channels ( pNames, n, 0, NULL,
+            CA_PRIORITY_DEFAULT, pChans );
+        SEVCHK ( status, NULL );
+    }
+    else {
+        for ( i = 0u; i < n; i++ ) {
+            status = ca_create_channel ( pNames[i], 0, 0,
+                CA_PRIORITY_DEFAULT, &pChans[i] );
+            SEVCHK ( status, NULL );
+        }
+    }
+    status = ca_pend_io ( 100.0 );
+    SEVCHK ( status, NULL );
+    epicsTimeGetCurrent ( &end_time );
+
+    for ( i = 0u; i < n; i++ ) {
+        status = ca_clear_channel ( pChans[i] );
+        SEVCHK ( status, NULL );
+    }
+    status = ca_flush_io ();
+    SEVCHK ( status, NULL );
+
+    return epicsTimeDiffInSeconds ( &end_time, &start_time );
+}
+
+/*
+ * measure_connect_scaling ()
+ *
+ * time to connect all channels against the number of channels
+ */
+static void measure_connect_scaling ( ti *pItems, unsigned channelCount )
+{
+    const char **pNames;
+    chid *pChans;
+    chid holdOpen;
+    unsigned n, i;
+    int status;
+
+    pNames = (const char **) calloc ( channelCount, sizeof ( *pNames ) );
+    pChans = (chid *) calloc ( channelCount, sizeof ( *pChans ) );
+    assert ( pNames && pChans );
+    for ( i = 0u; i < channelCount; i++ ) {
+        pNames[i] = pItems[i].name;
+    }
+
+    /*
+     * keep the circuit open so that each measurement isn't
+     * delayed by the shutdown of the circuit used by the
+     * previous measurement
+     */
+    status = ca_create_channel ( pNames[0], 0, 0,
+        CA_PRIORITY_DEFAULT, &holdOpen );
+    SEVCHK ( status, NULL );
+    status = ca_pend_io ( 100.0 );
+    SEVCHK ( status, NULL );
+
+    printf ( "%10s %16s %16s\n", "channels", "one at a time", "bulk" );
+    n = 1u;
+    while ( 1 ) {
+        double single, bulk;
+        if ( n > channelCount ) {
+            n = channelCount;
+        }
+        single = connect_all ( pNames, pChans, n, 0 );
+        bulk = connect_all ( pNames, pChans, n, 1 );
+        printf ( "%10u %14.3f mS %14.3f mS\n", n,
+            single * 1e3, bulk * 1e3 );
+        if ( n >= channelCount ) {
+            break;
+        }
+        n *= 10u;
+    }
+
+    status = ca_clear_channel ( holdOpen );
+    SEVCHK ( status, NULL );
+
+    {
+        struct ca_search_stats stats;
+        ca_search_statistics ( &stats );
+        printf ( "Search requests sent = %lu, unanswered = %lu, "
+            "replies answered = %lu, wasted = %lu\n",
+            (unsigned long) stats.requestsSent,
+            (unsigned long) stats.requestsUnanswered,
+            (unsigned long) stats.repliesAnswered,
+            (unsigned long) stats.repliesWasted );
+        printf ( "Search datagrams sent = %lu, deferred = %lu\n",
+            (unsigned long) stats.datagramsSent,
+            (unsigned long) stats.datagramsDeferred );
+    }
+
+    free ( pChans );
+    free ( pNames );
+}
+
 /*
  * printSearchStat()
  */
@@ -451,23 +561,27 @@ void timeIt ( tf *pfunc, ti *pItems, unsigned iterations,
     epicsTimeStamp      start_time;
     double              delay;
     unsigned            inlineIter;
+    size_t              sendCallsStart;
+    size_t              sendCalls;
 
+    sendCallsStart = ca_tcp_send_call_count ();
     epicsTimeGetCurrent ( &start_time );
     (*pfunc) ( pItems, iterations, &inlineIter );
     epicsTimeGetCurrent ( &end_time );
+    sendCalls = ca_tcp_send_call_count () - sendCallsStart;
     delay = epicsTimeDiffInSeconds ( &end_time, &start_time );
     if ( delay > 0.0 ) {
         double freq = ( iterations * inlineIter ) / delay;
         printf ( "Per Op, %8.4f uS ( %8.4f MHz )",
             1e6 / freq, freq / 1e6 );
         if ( pItems != NULL ) {
-            printf(", %8.4f snd Mbps, %8.4f rcv Mbps\n",
+            printf(", %8.4f snd Mbps, %8.4f rcv Mbps",
                 (inlineIter*nBytesSent*CHAR_BIT)/(delay*1e6),
                 (inlineIter*nBytesRecv*CHAR_BIT)/(delay*1e6) );
         }
-        else {
-            printf ("\n");
-        }
+        printf ( ", %8.4f sends",
+            ( (double) sendCalls ) / ( iterations * inlineIter ) );
+        printf ("\n");
     }
 }
 
@@ -669,6 +783,10 @@ int catime ( const char * channelName,
     printf ( "-----------------\n" );
     timeIt ( test_free, pItemList, channelCount, 0, 0 );
 
+    printf ( "Connect All Test\n" );
+    printf ( "----------------\n" );
+    measure_connect_scaling ( pItemList, channelCount );
+
     SEVCHK ( ca_task_exit (), "Unable to free resources at exit" );
 
     for ( i = 0; i < channelCount; i++ ) {
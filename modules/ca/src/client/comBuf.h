@@ -97,6 +97,8 @@ public:
     unsigned copyOutBytes ( void *pBuf, unsigned nBytes );
     bool copyOutAllBytes ( void *pBuf, unsigned nBytes );
     unsigned removeBytes ( unsigned nBytes );
+    // committed bytes not yet consumed start here
+    const epicsUInt8 * occupiedBytesStart () const;
     bool flushToWire ( wireSendAdapter &, const epicsTime & currentTime );
     void fillFromWire ( wireRecvAdapter &, statusWireIO & );
     struct popStatus {
@@ -309,6 +311,11 @@ inline unsigned comBuf :: removeBytes ( unsigned nBytes )
     return nBytes;
 }
 
+inline const epicsUInt8 * comBuf :: occupiedBytesStart () const
+{
+    return & this->buf[this->nextReadIndex];
+}
+
 template < class T >
 comBuf :: popStatus comBuf :: pop ( T & returnVal )
 {
@@ -37,6 +37,7 @@
 #include "cadef.h"
 #include "db_access.h" // for INVALID_DB_REQ
 #include "noopiiu.h"
+#include "caLatency.h"
 
 nciu::nciu ( cac & cacIn, netiiu & iiuIn, cacChannelNotify & chanIn,
             const char *pNameIn, cacChannel::priLev pri ) :
@@ -46,6 +47,8 @@ nciu::nciu ( cac & cacIn, netiiu & iiuIn, cacChannelNotify & chanIn,
     sid ( UINT_MAX ),
     count ( 0 ),
     retry ( 0u ),
+    connectStartTime ( epicsMonotonicGet () ),
+    lastServerIP ( 0u ),
     nameLength ( 0u ),
     typeCode ( USHRT_MAX ),
     priority ( static_cast <ca_uint8_t> ( pri ) )
@@ -125,6 +128,7 @@ void nciu::connect ( unsigned nativeType,
     this->typeCode = static_cast < unsigned short > ( nativeType );
     this->count = nativeCount;
     this->sid = sidIn;
+    caConnectLatency.sample ( this->connectStartTime );
 
     /*
      * if less than v4.1 then the server will never
@@ -185,8 +189,13 @@ void nciu::setServerAddressUnknown ( netiiu & newiiu,
                                 epicsGuard < epicsMutex > & guard )
 {
     guard.assertIdenticalMutex ( this->cacCtx.mutexRef () );
+    osiSockAddr addr = this->piiu->getNetworkAddress ( guard );
+    if ( addr.sa.sa_family == AF_INET ) {
+        this->lastServerIP = addr.ia.sin_addr.s_addr;
+    }
     this->piiu = & newiiu;
     this->retry = 0;
+    this->connectStartTime = epicsMonotonicGet ();
     this->typeCode = USHRT_MAX;
     this->count = 0u;
     this->sid = UINT_MAX;
@@ -194,6 +203,23 @@ void nciu::setServerAddressUnknown ( netiiu & newiiu,
     this->accessRightState.clrWritePermit();
 }
 
+//
+// A channel which has never been connected might be served by any
+// server, otherwise we assume that it will reappear on the host
+// which last served it. The port is not compared, as a restarted
+// IOC usually gets a new ephemeral port.
+//
+bool nciu::mightBeServedBy (
+    epicsGuard < epicsMutex > & guard,
+    const struct sockaddr_in & server ) const
+{
+    guard.assertIdenticalMutex ( this->cacCtx.mutexRef () );
+    if ( this->lastServerIP == 0u ) {
+        return true;
+    }
+    return this->lastServerIP == server.sin_addr.s_addr;
+}
+
 void nciu::accessRightsStateChange (
     const caAccessRights & arIn, epicsGuard < epicsMutex > & /* cbGuard */,
     epicsGuard < epicsMutex > & guard )
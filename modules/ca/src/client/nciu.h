@@ -148,6 +148,8 @@ public:
         epicsGuard < epicsMutex > & guard );
     void setServerAddressUnknown (
         netiiu & newiiu, epicsGuard < epicsMutex > & guard );
+    bool mightBeServedBy (
+        epicsGuard < epicsMutex > &, const struct sockaddr_in & ) const;
     bool searchMsg (
         epicsGuard < epicsMutex > & );
     void serviceShutdownNotify (
@@ -209,6 +211,8 @@ private:
     ca_uint32_t sid; // server id
     unsigned count;
     unsigned retry; // search retry number
+    epicsUInt64 connectStartTime; // when created or disconnected
+    ca_uint32_t lastServerIP; // network byte order, zero if never connected
     unsigned short nameLength; // channel name length
     ca_uint16_t typeCode;
     ca_uint8_t priority;
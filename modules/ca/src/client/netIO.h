@@ -92,6 +92,9 @@ public:
         epicsGuard < epicsMutex > & guard, nciu & chan );
     void unsubscribeIfRequired (
         epicsGuard < epicsMutex > & guard, nciu & chan );
+    void * updateDestination (
+        epicsGuard < epicsMutex > &, unsigned type,
+        arrayElementCount count );
 protected:
     netSubscription (
         class privateInterfaceForIO &, unsigned type,
@@ -146,6 +149,7 @@ protected:
 private:
     cacReadNotify & notify;
     class privateInterfaceForIO & privateChanForIO;
+    epicsUInt64 startTime;
     void operator delete ( void * );
     void * operator new ( size_t,
         tsFreeList < class netReadNotifyIO, 1024, epicsMutexNOOP > & );
@@ -188,6 +192,7 @@ protected:
 private:
     cacWriteNotify & notify;
     privateInterfaceForIO & privateChanForIO;
+    epicsUInt64 startTime;
     void operator delete ( void * );
     void * operator new ( size_t,
         tsFreeList < class netWriteNotifyIO, 1024, epicsMutexNOOP > & );
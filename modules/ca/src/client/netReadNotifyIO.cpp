@@ -28,11 +28,13 @@
 #include "iocinf.h"
 #include "nciu.h"
 #include "cac.h"
+#include "caLatency.h"
 
 netReadNotifyIO::netReadNotifyIO (
     privateInterfaceForIO & ioComplIntfIn,
         cacReadNotify & notify ) :
-    notify ( notify ), privateChanForIO ( ioComplIntfIn )
+    notify ( notify ), privateChanForIO ( ioComplIntfIn ),
+    startTime ( epicsMonotonicGet () )
 {
 }
 
@@ -65,6 +67,7 @@ void netReadNotifyIO::completion (
     arrayElementCount count, const void * pData )
 {
     //guard.assertIdenticalMutex ( this->mutex );
+    caGetLatency.sample ( this->startTime );
     this->privateChanForIO.ioCompletionNotify ( guard, *this );
     this->notify.completion ( guard, type, count, pData );
     this->~netReadNotifyIO ();
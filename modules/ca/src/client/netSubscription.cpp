@@ -142,6 +142,13 @@ void netSubscription::completion (
     }
 }
 
+void * netSubscription::updateDestination (
+    epicsGuard < epicsMutex > & guard,
+    unsigned typeIn, arrayElementCount countIn )
+{
+    return this->notify.updateDestination ( guard, typeIn, countIn );
+}
+
 void netSubscription::subscribeIfRequired (
     epicsGuard < epicsMutex > & guard, nciu & chan )
 {
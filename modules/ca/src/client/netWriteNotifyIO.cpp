@@ -28,10 +28,12 @@
 #include "iocinf.h"
 #include "nciu.h"
 #include "cac.h"
+#include "caLatency.h"
 
 netWriteNotifyIO::netWriteNotifyIO (
     privateInterfaceForIO & ioComplIntf, cacWriteNotify & notifyIn ) :
-    notify ( notifyIn ), privateChanForIO ( ioComplIntf )
+    notify ( notifyIn ), privateChanForIO ( ioComplIntf ),
+    startTime ( epicsMonotonicGet () )
 {
 }
 
@@ -64,6 +66,7 @@ void netWriteNotifyIO::completion (
     epicsGuard < epicsMutex > & guard,
     cacRecycle & recycle )
 {
+    caPutLatency.sample ( this->startTime );
     this->privateChanForIO.ioCompletionNotify ( guard, *this );
     this->notify.completion ( guard );
     this->~netWriteNotifyIO ();
@@ -29,6 +29,9 @@
 #include <memory>
 
 #include "tsFreeList.h"
+#include "tsDLList.h"
+#include "epicsThread.h"
+#include "epicsEvent.h"
 #include "compilerDependencies.h"
 #include "osiSock.h"
 
@@ -100,10 +103,11 @@ public:
         chid pChan );
     friend int epicsStdCall ca_v42_ok (
         chid pChan );
-    friend int epicsStdCall ca_create_subscription (
+    friend int epicsStdCall ca_create_subscription_buffer (
         chtype type, arrayElementCount count, chid pChan,
         long mask, caEventCallBackFunc * pCallBack,
-        void * pCallBackArg, evid * monixptr );
+        void * pCallBackArg, void * pBuffer,
+        arrayElementCount bufferSize, evid * monixptr );
     friend enum channel_state epicsStdCall ca_state (
         chid pChan );
     friend double epicsStdCall ca_receive_watchdog_delay (
@@ -250,14 +254,27 @@ private:
     void operator delete ( void * );
 };
 
-struct oldSubscription : private cacStateNotify {
+// an update held by a subscription with a queue until the
+// application's callback can be called, the data follows
+struct queuedUpdate {
+    static queuedUpdate * create ( size_t nBytes );
+    size_t capacity;
+    arrayElementCount count;
+    unsigned type;
+    int status;
+    bool hasData;
+    epicsFloat64 data[1];
+};
+
+struct oldSubscription : public tsDLNode < oldSubscription >,
+        private cacStateNotify {
 public:
     oldSubscription (
         epicsGuard < epicsMutex > & guard,
         oldChannelNotify & chanIn, cacChannel & io,
         unsigned type, arrayElementCount nElem, unsigned mask,
         caEventCallBackFunc * pFuncIn, void * pPrivateIn,
-        evid * );
+        evid *, void * pBufferIn = 0, size_t bufferSizeIn = 0u );
     ~oldSubscription ();
     oldChannelNotify & channel () const;
     // The primary mutex must be released when calling the user's
@@ -270,6 +287,19 @@ public:
     void cancel (
         CallbackGuard & callbackGuard,
         epicsGuard < epicsMutex > & mutualExclusionGuard );
+    // updates beyond the queue depth replace the newest one pending
+    int setQueueDepth (
+        epicsGuard < epicsMutex > &, unsigned depth );
+    unsigned long queueOverflows (
+        epicsGuard < epicsMutex > & ) const;
+    bool queuePending (
+        epicsGuard < epicsMutex > & ) const;
+    queuedUpdate * popQueued (
+        epicsGuard < epicsMutex > & );
+    void deliver (
+        epicsGuard < epicsMutex > &, const queuedUpdate & );
+    void recycle (
+        epicsGuard < epicsMutex > &, queuedUpdate * );
     void * operator new ( size_t size,
         tsFreeList < struct oldSubscription, 1024, epicsMutexNOOP > & );
     epicsPlacementDeleteOperator (( void *,
@@ -279,15 +309,47 @@ private:
     cacChannel::ioid id;
     caEventCallBackFunc * pFunc;
     void * pPrivate;
+    void * pBuffer;
+    size_t bufferSize;
+    queuedUpdate ** ppQueue;
+    queuedUpdate * pSpare;
+    unsigned queueDepth;
+    unsigned queueFirst;
+    unsigned queueCount;
+    unsigned long overflows;
+    bool onReadyList;
+    void enqueue (
+        epicsGuard < epicsMutex > &, unsigned type,
+        arrayElementCount count, int status, const void * pData );
     void current (
         epicsGuard < epicsMutex > &, unsigned type,
         arrayElementCount count, const void *pData );
     void exception (
         epicsGuard < epicsMutex > &, int status,
         const char *pContext, unsigned type, arrayElementCount count );
+    void * updateDestination (
+        epicsGuard < epicsMutex > &, unsigned type,
+        arrayElementCount count );
     oldSubscription ( const oldSubscription & );
     oldSubscription & operator = ( const oldSubscription & );
     void operator delete ( void * );
+    friend struct ca_client_context;
+};
+
+// calls the callbacks of queued subscriptions when
+// preemptive callback is enabled
+class subscriptionQueueThread : public epicsThreadRunable {
+public:
+    subscriptionQueueThread ( struct ca_client_context &,
+        unsigned priority );
+    ~subscriptionQueueThread ();
+    void start ();
+private:
+    epicsThread thread;
+    struct ca_client_context & ctx;
+    void run ();
+    subscriptionQueueThread ( const subscriptionQueueThread & );
+    subscriptionQueueThread & operator = ( const subscriptionQueueThread & );
 };
 
 extern "C" void cacOnceFunc ( void * );
@@ -295,7 +357,8 @@ extern "C" void cacOnceFunc ( void * );
 struct ca_client_context : public cacContextNotify
 {
 public:
-    ca_client_context ( bool enablePreemptiveCallback = false );
+    ca_client_context ( bool enablePreemptiveCallback = false,
+        bool enableIOPool = false );
     virtual ~ca_client_context ();
     void changeExceptionEvent (
         caExceptionHandler * pfunc, void * arg );
@@ -305,6 +368,9 @@ public:
     cacChannel & createChannel (
         epicsGuard < epicsMutex > &, const char * pChannelName,
         cacChannelNotify &, cacChannel::priLev pri );
+    void reserveChannels (
+        epicsGuard < epicsMutex > &, unsigned nChannels );
+    void expediteSearch ( epicsGuard < epicsMutex > & );
     void flush ( epicsGuard < epicsMutex > & );
     void eliminateExcessiveSendBacklog (
         epicsGuard < epicsMutex > &, cacChannel & );
@@ -346,6 +412,9 @@ public:
     void destroyGetCallback ( epicsGuard < epicsMutex > &, getCallback & );
     void destroyPutCallback ( epicsGuard < epicsMutex > &, putCallback & );
     void destroySubscription ( epicsGuard < epicsMutex > &, oldSubscription & );
+    int setSubscriptionQueue ( oldSubscription &, unsigned depth );
+    void subscriptionUpdateQueued (
+        epicsGuard < epicsMutex > &, oldSubscription & );
     epicsMutex & mutexRef () const;
 
     template < class T >
@@ -355,6 +424,10 @@ public:
     friend int epicsStdCall ca_create_channel (
         const char * name_str, caCh * conn_func, void * puser,
         capri priority, chid * chanptr );
+    friend int epicsStdCall ca_create_channels (
+        const char * const * pChanNames, unsigned nChannels,
+        caCh * conn_func, void * const * pUserPrivates,
+        capri priority, chid * pChanIDs );
     friend int epicsStdCall ca_clear_channel ( chid pChan );
     friend int epicsStdCall ca_array_get ( chtype type,
         arrayElementCount count, chid pChan, void * pValue );
@@ -366,12 +439,13 @@ public:
     friend int epicsStdCall ca_array_put_callback ( chtype type,
         arrayElementCount count, chid pChan, const void * pValue,
         caEventCallBackFunc *pfunc, void *usrarg );
-    friend int epicsStdCall ca_create_subscription (
+    friend int epicsStdCall ca_create_subscription_buffer (
         chtype type, arrayElementCount count, chid pChan,
         long mask, caEventCallBackFunc * pCallBack, void * pCallBackArg,
-        evid *monixptr );
+        void * pBuffer, arrayElementCount bufferSize, evid *monixptr );
     friend int epicsStdCall ca_flush_io ();
     friend int epicsStdCall ca_clear_subscription ( evid pMon );
+    friend unsigned long epicsStdCall ca_subscription_overflows ( evid pMon );
     friend int epicsStdCall ca_sg_create ( CA_SYNC_GID * pgid );
     friend int epicsStdCall ca_sg_delete ( const CA_SYNC_GID gid );
     friend int epicsStdCall ca_sg_block ( const CA_SYNC_GID gid, ca_real timeout );
@@ -401,6 +475,14 @@ private:
     tsFreeList < struct CASG, 128, epicsMutexNOOP > casgFreeList;
     mutable epicsMutex mutex;
     mutable epicsMutex cbMutex;
+    tsDLList < oldSubscription > subscrReadyList;
+    epicsEvent subscrQueueEvent;
+    ca::auto_ptr < subscriptionQueueThread > pSubscrQueueThread;
+    oldSubscription * pSubscrDelivering;
+    epicsThreadId subscrDeliveringThread;
+    epicsEvent subscrDeliveryDone;
+    unsigned subscrDeliveryHold;
+    bool subscrDestroyPending;
     epicsEvent ioDone;
     epicsEvent callbackThreadActivityComplete;
     epicsThreadId createdByThread;
@@ -418,6 +500,7 @@ private:
     ca_uint16_t localPort;
     bool fdRegFuncNeedsToBeCalled;
     bool noWakeupSincePend;
+    bool subscrQueueExit;
 
     void attachToClientCtx ();
     void callbackProcessingInitiateNotify ();
@@ -425,11 +508,16 @@ private:
     cacContext & createNetworkContext (
         epicsMutex & mutualExclusion, epicsMutex & callbackControl );
     void _sendWakeupMsg ();
+    bool deliverQueuedUpdate ( epicsGuard < epicsMutex > & );
+    void deliverQueuedUpdates ();
+    bool holdSubscriptionDelivery ();
+    void releaseSubscriptionDelivery ();
 
     ca_client_context ( const ca_client_context & );
     ca_client_context & operator = ( const ca_client_context & );
 
     friend void cacOnceFunc ( void * );
+    friend class subscriptionQueueThread;
     static cacService * pDefaultService;
     static epicsMutex * pDefaultServiceInstallMutex;
     static const unsigned flushBlockThreshold;
@@ -532,6 +532,15 @@ int epicsStdCall ca_create_subscription (
         chtype type, arrayElementCount count, chid pChan,
         long mask, caEventCallBackFunc * pCallBack, void * pCallBackArg,
         evid * monixptr )
+{
+    return ca_create_subscription_buffer ( type, count, pChan, mask,
+        pCallBack, pCallBackArg, 0, 0u, monixptr );
+}
+
+int epicsStdCall ca_create_subscription_buffer (
+        chtype type, arrayElementCount count, chid pChan,
+        long mask, caEventCallBackFunc * pCallBack, void * pCallBackArg,
+        void * pBuffer, arrayElementCount bufferSize, evid * monixptr )
 {
     if ( type < 0 ) {
         return ECA_BADTYPE;
@@ -546,6 +555,11 @@ int epicsStdCall ca_create_subscription (
         return ECA_BADFUNCPTR;
     }
 
+    // with count zero the update size is checked as each one arrives
+    if ( pBuffer && dbr_size_n ( tmpType, count ) > bufferSize ) {
+        return ECA_BADCOUNT;
+    }
+
     static const long maskMask = 0xffff;
     if ( ( mask & maskMask ) == 0) {
         return ECA_BADMASK;
@@ -570,7 +584,7 @@ int epicsStdCall ca_create_subscription (
         new ( pChan->getClientCtx().subscriptionFreeList )
             oldSubscription  (
                 guard, *pChan, pChan->io, tmpType, count, mask,
-                pCallBack, pCallBackArg, monixptr );
+                pCallBack, pCallBackArg, monixptr, pBuffer, bufferSize );
         // dont touch object created after above new because
         // the first callback might have canceled, and therefore
         // destroyed, it
@@ -21,6 +21,9 @@
 
 #include <stdexcept>
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "errlog.h"
 
 #include "iocinf.h"
@@ -31,9 +34,12 @@ oldSubscription::oldSubscription  (
     oldChannelNotify & chanIn, cacChannel & io,
     unsigned type, arrayElementCount nElem, unsigned mask,
     caEventCallBackFunc * pFuncIn, void * pPrivateIn,
-    evid * pEventId ) :
+    evid * pEventId, void * pBufferIn, size_t bufferSizeIn ) :
     chan ( chanIn ), id ( UINT_MAX ), pFunc ( pFuncIn ),
-        pPrivate ( pPrivateIn )
+        pPrivate ( pPrivateIn ), pBuffer ( pBufferIn ),
+        bufferSize ( bufferSizeIn ), ppQueue ( 0 ), pSpare ( 0 ),
+        queueDepth ( 0u ), queueFirst ( 0u ), queueCount ( 0u ),
+        overflows ( 0u ), onReadyList ( false )
 {
     // The users event id *must* be set prior to potentially
     // calling his callback from within subscribe.
@@ -48,12 +54,157 @@ oldSubscription::oldSubscription  (
 
 oldSubscription::~oldSubscription ()
 {
+    while ( this->queueCount ) {
+        free ( this->ppQueue[this->queueFirst] );
+        this->queueFirst = ( this->queueFirst + 1u ) % this->queueDepth;
+        this->queueCount--;
+    }
+    free ( this->ppQueue );
+    free ( this->pSpare );
+}
+
+queuedUpdate * queuedUpdate::create ( size_t nBytes )
+{
+    queuedUpdate * pUpdate = static_cast < queuedUpdate * >
+        ( malloc ( sizeof ( queuedUpdate ) + nBytes ) );
+    if ( pUpdate ) {
+        pUpdate->capacity = sizeof ( pUpdate->data ) + nBytes;
+    }
+    return pUpdate;
+}
+
+int oldSubscription::setQueueDepth (
+    epicsGuard < epicsMutex > &, unsigned depth )
+{
+    queuedUpdate ** ppNewQueue = 0;
+    if ( depth ) {
+        ppNewQueue = static_cast < queuedUpdate ** >
+            ( calloc ( depth, sizeof ( *ppNewQueue ) ) );
+        if ( ! ppNewQueue ) {
+            return ECA_ALLOCMEM;
+        }
+    }
+    // the oldest updates that no longer fit are discarded
+    while ( this->queueCount > depth ) {
+        free ( this->ppQueue[this->queueFirst] );
+        this->queueFirst = ( this->queueFirst + 1u ) % this->queueDepth;
+        this->queueCount--;
+        this->overflows++;
+    }
+    for ( unsigned i = 0u; i < this->queueCount; i++ ) {
+        ppNewQueue[i] = this->ppQueue[
+            ( this->queueFirst + i ) % this->queueDepth];
+    }
+    free ( this->ppQueue );
+    this->ppQueue = ppNewQueue;
+    this->queueDepth = depth;
+    this->queueFirst = 0u;
+    return ECA_NORMAL;
+}
+
+unsigned long oldSubscription::queueOverflows (
+    epicsGuard < epicsMutex > & ) const
+{
+    return this->overflows;
+}
+
+bool oldSubscription::queuePending (
+    epicsGuard < epicsMutex > & ) const
+{
+    return this->queueCount > 0u;
+}
+
+queuedUpdate * oldSubscription::popQueued (
+    epicsGuard < epicsMutex > & )
+{
+    if ( this->queueCount == 0u ) {
+        return 0;
+    }
+    queuedUpdate * pUpdate = this->ppQueue[this->queueFirst];
+    this->ppQueue[this->queueFirst] = 0;
+    this->queueFirst = ( this->queueFirst + 1u ) % this->queueDepth;
+    this->queueCount--;
+    return pUpdate;
+}
+
+void oldSubscription::recycle (
+    epicsGuard < epicsMutex > &, queuedUpdate * pUpdate )
+{
+    if ( this->pSpare ) {
+        free ( pUpdate );
+    }
+    else {
+        this->pSpare = pUpdate;
+    }
+}
+
+void oldSubscription::enqueue (
+    epicsGuard < epicsMutex > & guard, unsigned type,
+    arrayElementCount count, int status, const void * pData )
+{
+    size_t nBytes = pData ? dbr_size_n ( type, count ) : 0u;
+    unsigned slot;
+    queuedUpdate * pUpdate;
+    if ( this->queueCount < this->queueDepth ) {
+        slot = ( this->queueFirst + this->queueCount ) % this->queueDepth;
+        pUpdate = this->pSpare;
+        this->pSpare = 0;
+    }
+    else {
+        // keep the latest value by replacing the newest pending update
+        slot = ( this->queueFirst + this->queueCount - 1u ) % this->queueDepth;
+        pUpdate = this->ppQueue[slot];
+        this->ppQueue[slot] = 0;
+        this->queueCount--;
+        this->overflows++;
+    }
+    if ( ! pUpdate || pUpdate->capacity < nBytes ) {
+        free ( pUpdate );
+        pUpdate = queuedUpdate::create ( nBytes );
+        if ( ! pUpdate ) {
+            this->overflows++;
+            return;
+        }
+    }
+    pUpdate->type = type;
+    pUpdate->count = count;
+    pUpdate->status = status;
+    pUpdate->hasData = pData != 0;
+    if ( pData ) {
+        memcpy ( pUpdate->data, pData, nBytes );
+    }
+    this->ppQueue[slot] = pUpdate;
+    this->queueCount++;
+    if ( ! this->onReadyList ) {
+        this->chan.getClientCtx().subscriptionUpdateQueued ( guard, *this );
+    }
+}
+
+void oldSubscription::deliver (
+    epicsGuard < epicsMutex > & guard, const queuedUpdate & update )
+{
+    struct event_handler_args args;
+    args.usr = this->pPrivate;
+    args.chid = & this->chan;
+    args.type = static_cast < long > ( update.type );
+    args.count = static_cast < long > ( update.count );
+    args.status = update.status;
+    args.dbr = update.hasData ? update.data : 0;
+    caEventCallBackFunc * pFuncTmp = this->pFunc;
+    {
+        epicsGuardRelease < epicsMutex > unguard ( guard );
+        ( *pFuncTmp ) ( args );
+    }
 }
 
 void oldSubscription::current (
     epicsGuard < epicsMutex > & guard,
     unsigned type, arrayElementCount count, const void * pData )
 {
+    if ( this->queueDepth ) {
+        this->enqueue ( guard, type, count, ECA_NORMAL, pData );
+        return;
+    }
     struct event_handler_args args;
     args.usr = this->pPrivate;
     args.chid = & this->chan;
@@ -68,6 +219,19 @@ void oldSubscription::current (
     }
 }
 
+void * oldSubscription::updateDestination (
+    epicsGuard < epicsMutex > &,
+    unsigned type, arrayElementCount count )
+{
+    // updates that do not fit are passed in the library's buffer,
+    // and queued updates are copied into the queue instead
+    if ( this->pBuffer && ! this->queueDepth &&
+            dbr_size_n ( type, count ) <= this->bufferSize ) {
+        return this->pBuffer;
+    }
+    return 0;
+}
+
 void oldSubscription::exception (
     epicsGuard < epicsMutex > & guard,
     int status, const char * /* pContext */,
@@ -77,6 +241,9 @@ void oldSubscription::exception (
         ca_client_context & cac = this->chan.getClientCtx ();
         cac.destroySubscription ( guard, *this );
     }
+    else if ( status != ECA_DISCONN && this->queueDepth ) {
+        this->enqueue ( guard, type, count, status, 0 );
+    }
     else if ( status != ECA_DISCONN ) {
         struct event_handler_args args;
         args.usr = this->pPrivate;
@@ -29,9 +29,13 @@
 #include "iocinf.h"
 #include "udpiiu.h"
 #include "nciu.h"
+#include "caLatency.h"
 
 static const unsigned initialTriesPerFrame = 1u; // initial UDP frames per search try
 static const unsigned maxTriesPerFrame = 64u; // max UDP frames per search try
+// seconds without any reply before the first timer gives up
+// on the name servers and passes its channels on
+static const double nameServerHopTimeout = 1.0;
 
 //
 // searchTimer::searchTimer ()
@@ -43,6 +47,7 @@ searchTimer::searchTimer (
         epicsMutex & mutexIn,
         bool boostPossibleIn ) :
     timeAtLastSend ( epicsTime::getCurrent () ),
+    timeAtLastProgress ( timeAtLastSend ),
     timer ( queueIn.createTimer () ),
     iiu ( iiuIn ),
     mutex ( mutexIn ),
@@ -55,7 +60,8 @@ searchTimer::searchTimer (
     dgSeqNoAtTimerExpireBegin ( 0u ),
     dgSeqNoAtTimerExpireEnd ( 0u ),
     boostPossible ( boostPossibleIn ),
-    stopped ( false )
+    stopped ( false ),
+    nameServerHop ( false )
 {
 }
 
@@ -65,6 +71,17 @@ void searchTimer::start ( epicsGuard < epicsMutex > & guard )
     this->timer.start ( *this, this->period ( guard ) );
 }
 
+//
+// send the pending requests without waiting for the
+// period to elapse, the number of frames sent is still
+// limited by the congestion control in expire ()
+//
+void searchTimer::startNow ( epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    this->timer.start ( *this, 0.0 );
+}
+
 searchTimer::~searchTimer ()
 {
     assert ( this->chanListReqPending.count() == 0 );
@@ -104,17 +121,36 @@ void searchTimer::installChannel (
     chan.channelNode::setReqPendingState ( guard, this->index );
 }
 
+//
+// move only the channels which might be served by
+// the server that has just appeared or restarted
+//
 void searchTimer::moveChannels (
-    epicsGuard < epicsMutex > & guard, searchTimer & dest )
+    epicsGuard < epicsMutex > & guard, searchTimer & dest,
+    const struct sockaddr_in & server )
 {
-    while ( nciu * pChan = this->chanListRespPending.get () ) {
-        if ( this->searchAttempts > 0 ) {
-            this->searchAttempts--;
+    tsDLIter < nciu > pChan = this->chanListRespPending.firstIter ();
+    while ( pChan.valid () ) {
+        tsDLIter < nciu > pNext = pChan;
+        pNext++;
+        if ( pChan->mightBeServedBy ( guard, server ) ) {
+            this->chanListRespPending.remove ( *pChan );
+            if ( this->searchAttempts > 0 ) {
+                this->searchAttempts--;
+            }
+            dest.installChannel ( guard, *pChan );
         }
-        dest.installChannel ( guard, *pChan );
+        pChan = pNext;
     }
-    while ( nciu * pChan = this->chanListReqPending.get () ) {
-        dest.installChannel ( guard, *pChan );
+    pChan = this->chanListReqPending.firstIter ();
+    while ( pChan.valid () ) {
+        tsDLIter < nciu > pNext = pChan;
+        pNext++;
+        if ( pChan->mightBeServedBy ( guard, server ) ) {
+            this->chanListReqPending.remove ( *pChan );
+            dest.installChannel ( guard, *pChan );
+        }
+        pChan = pNext;
     }
 }
 
@@ -126,13 +162,38 @@ epicsTimerNotify::expireStatus searchTimer::expire (
 {
     epicsGuard < epicsMutex > guard ( this->mutex );
 
-    while ( nciu * pChan = this->chanListRespPending.get () ) {
+    searchTimerNotify::firstHop hop = searchTimerNotify::fhAll;
+    if ( this->index == 0u ) {
+        hop = this->iiu.firstHopState ( guard, currentTime );
+        if ( hop == searchTimerNotify::fhWait ) {
+            return expireStatus ( restart, this->period ( guard ) );
+        }
+    }
+
+    // a name server answers a large batch over TCP at its own
+    // pace, so channels are passed on only once it stops replying
+    bool passOn = true;
+    if ( this->nameServerHop && hop == searchTimerNotify::fhNameServers ) {
+        passOn = currentTime - this->timeAtLastProgress >=
+            nameServerHopTimeout;
+    }
+    this->nameServerHop = hop == searchTimerNotify::fhNameServers;
+
+    while ( passOn ) {
+        nciu * pChan = this->chanListRespPending.get ();
+        if ( ! pChan ) {
+            break;
+        }
         pChan->channelNode::listMember =
             channelNode::cs_none;
         this->iiu.noSearchRespNotify (
             guard, *pChan, this->index );
     }
 
+    if ( this->chanListRespPending.count () == 0u ) {
+        this->timeAtLastProgress = currentTime;
+    }
+
     this->timeAtLastSend = currentTime;
 
     // boost search period for channels not recently
@@ -244,9 +305,11 @@ epicsTimerNotify::expireStatus searchTimer::expire (
 
         bool success = pChan->searchMsg ( guard );
         if ( ! success ) {
-            if ( this->iiu.datagramFlush ( guard, currentTime ) ) {
+            if ( this->iiu.datagramFlush ( guard, currentTime,
+                                            this->nameServerHop ) ) {
                 nFrameSent++;
-                if ( nFrameSent < this->framesPerTry ) {
+                if ( nFrameSent < this->framesPerTry ||
+                        this->nameServerHop ) {
                     success = pChan->searchMsg ( guard );
                 }
             }
@@ -268,7 +331,8 @@ epicsTimerNotify::expireStatus searchTimer::expire (
     }
 
     // flush out the search request buffer
-    if ( this->iiu.datagramFlush ( guard, currentTime ) ) {
+    if ( this->iiu.datagramFlush ( guard, currentTime,
+                                    this->nameServerHop ) ) {
         nFrameSent++;
     }
 
@@ -343,7 +407,15 @@ void searchTimer::uninstallChanDueToSuccessfulSearchResponse (
     // reasonable timer period
     if ( validResponse ) {
         double measured = currentTime - this->timeAtLastSend;
-        this->iiu.updateRTTE ( guard, measured );
+        // a name server's reply time depends on the size of
+        // the batch, and says little about the UDP round trip
+        if ( this->nameServerHop ) {
+            this->timeAtLastProgress = currentTime;
+        }
+        else {
+            this->iiu.updateRTTE ( guard, measured );
+        }
+        caSearchLatency.sampleSeconds ( measured );
 
         if ( this->searchResponses < UINT_MAX ) {
             this->searchResponses++;
@@ -44,6 +44,14 @@ public:
     virtual double getRTTE ( epicsGuard < epicsMutex > & ) const = 0;
     virtual void updateRTTE ( epicsGuard < epicsMutex > &, double rtte ) = 0;
     virtual bool datagramFlush (
+        epicsGuard < epicsMutex > &,
+        const epicsTime & currentTime,
+        bool nameServersOnly ) = 0;
+    // where the first search timer sends its requests, to the
+    // name servers, to all destinations, or nowhere while the
+    // name server circuits are still connecting
+    enum firstHop { fhAll, fhNameServers, fhWait };
+    virtual firstHop firstHopState (
         epicsGuard < epicsMutex > &,
         const epicsTime & currentTime ) = 0;
     virtual ca_uint32_t datagramSeqNumber (
@@ -58,11 +66,13 @@ public:
         bool boostPossible );
     virtual ~searchTimer ();
     void start ( epicsGuard < epicsMutex > & );
+    void startNow ( epicsGuard < epicsMutex > & );
     void shutdown (
         epicsGuard < epicsMutex > & cbGuard,
         epicsGuard < epicsMutex > & guard );
     void moveChannels (
-        epicsGuard < epicsMutex > &, searchTimer & dest );
+        epicsGuard < epicsMutex > &, searchTimer & dest,
+        const struct sockaddr_in & server );
     void installChannel (
         epicsGuard < epicsMutex > &, nciu & );
     void uninstallChan (
@@ -76,6 +86,7 @@ private:
     tsDLList < nciu > chanListReqPending;
     tsDLList < nciu > chanListRespPending;
     epicsTime timeAtLastSend;
+    epicsTime timeAtLastProgress;
     epicsTimer & timer;
     searchTimerNotify & iiu;
     epicsMutex & mutex;
@@ -89,6 +100,7 @@ private:
     ca_uint32_t dgSeqNoAtTimerExpireEnd;
     const bool boostPossible;
     bool stopped;
+    bool nameServerHop;
 
     expireStatus expire ( const epicsTime & currentTime );
     double period ( epicsGuard < epicsMutex > & ) const;
@@ -0,0 +1,387 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <stdexcept>
+
+#include <string.h>
+#include <errno.h>
+
+#if defined ( __linux__ )
+#   include <sys/epoll.h>
+#   include <sys/eventfd.h>
+#   include <unistd.h>
+#   define CA_REACTOR_EPOLL
+#endif
+
+#include "errlog.h"
+#include "epicsThread.h"
+#include "epicsMutex.h"
+#include "epicsGuard.h"
+#include "epicsTypes.h"
+
+#include "iocinf.h"
+#include "cac.h"
+#include "virtualCircuit.h"
+#include "tcpReactor.h"
+
+tcpReactorNode::tcpReactorNode ( tcpiiu & iiuIn ) :
+    iiu ( iiuIn ), pThread ( 0 ), events ( 0u ),
+    queued ( false ), installed ( false ), writeInterest ( false )
+{
+}
+
+#if defined ( CA_REACTOR_EPOLL )
+
+class tcpReactorThread : private epicsThreadRunable {
+public:
+    tcpReactorThread ( cac &, int epfd, int evfd,
+        const char * pName, unsigned stackSize, unsigned priority );
+    ~tcpReactorThread ();
+    void start ();
+    void exitWait ();
+    void show ( unsigned level );
+    epicsMutex mutex;
+    tsDLList < tcpReactorNode > readyList;
+    cac & cacRef;
+    const int epfd;
+    const int evfd;
+    unsigned nCircuits;
+    bool wakeupPending;
+    bool exitRequested;
+    void wakeupThread ( epicsGuard < epicsMutex > & );
+private:
+    epicsThread thread;
+    void run ();
+    tcpReactorThread ( const tcpReactorThread & );
+    tcpReactorThread & operator = ( const tcpReactorThread & );
+};
+
+tcpReactorThread::tcpReactorThread ( cac & cacIn, int epfdIn, int evfdIn,
+        const char * pName, unsigned stackSize, unsigned priority ) :
+    mutex ( __FILE__, __LINE__ ), cacRef ( cacIn ),
+    epfd ( epfdIn ), evfd ( evfdIn ), nCircuits ( 0u ),
+    wakeupPending ( false ), exitRequested ( false ),
+    thread ( *this, pName, stackSize, priority )
+{
+}
+
+tcpReactorThread::~tcpReactorThread ()
+{
+    ::close ( this->evfd );
+    ::close ( this->epfd );
+}
+
+void tcpReactorThread::start ()
+{
+    this->thread.start ();
+}
+
+void tcpReactorThread::exitWait ()
+{
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        this->exitRequested = true;
+        this->wakeupThread ( guard );
+    }
+    this->thread.exitWait ();
+}
+
+// the eventfd is written at most once between passes of the loop
+void tcpReactorThread::wakeupThread ( epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    if ( ! this->wakeupPending ) {
+        this->wakeupPending = true;
+        epicsUInt64 one = 1u;
+        ssize_t status = ::write ( this->evfd, & one, sizeof ( one ) );
+        if ( status != sizeof ( one ) ) {
+            errlogPrintf ( "CAC: reactor wakeup failed \"%s\"\n",
+                strerror ( errno ) );
+        }
+    }
+}
+
+void tcpReactorThread::show ( unsigned level )
+{
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    ::printf ( "\tevent loop thread with %u circuits, %u ready\n",
+        this->nCircuits, this->readyList.count () );
+    if ( level > 1u ) {
+        this->thread.show ( level - 1u );
+    }
+}
+
+void tcpReactorThread::run ()
+{
+    // callbacks are called from this thread so it must not
+    // block in tcpiiu::flush
+    epicsThreadPrivateSet ( caClientCallbackThreadId, this );
+    this->cacRef.attachToClientCtx ();
+
+    static const int maxEvents = 64;
+    struct epoll_event events[maxEvents];
+
+    while ( true ) {
+        int timeout = -1;
+        {
+            epicsGuard < epicsMutex > guard ( this->mutex );
+            if ( this->exitRequested && this->nCircuits == 0u ) {
+                break;
+            }
+            if ( this->readyList.count () ) {
+                timeout = 0;
+            }
+        }
+
+        int nEvents = epoll_wait ( this->epfd, events, maxEvents, timeout );
+        if ( nEvents < 0 ) {
+            if ( errno != EINTR ) {
+                errlogPrintf ( "CAC: epoll_wait failed \"%s\"\n",
+                    strerror ( errno ) );
+                epicsThreadSleep ( 1.0 );
+            }
+            continue;
+        }
+
+        // Circuits are only destroyed from within reactorService ()
+        // below so none of the nodes in this batch can be stale.
+        unsigned nReady;
+        {
+            epicsGuard < epicsMutex > guard ( this->mutex );
+            for ( int i = 0; i < nEvents; i++ ) {
+                tcpReactorNode * pNode =
+                    static_cast < tcpReactorNode * > ( events[i].data.ptr );
+                if ( ! pNode ) {
+                    epicsUInt64 count;
+                    if ( ::read ( this->evfd, & count, sizeof ( count ) ) < 0 &&
+                            errno != EAGAIN ) {
+                        errlogPrintf ( "CAC: reactor wakeup read failed \"%s\"\n",
+                            strerror ( errno ) );
+                    }
+                    this->wakeupPending = false;
+                    continue;
+                }
+                if ( ! pNode->installed ) {
+                    continue;
+                }
+                if ( events[i].events & ( EPOLLIN | EPOLLHUP | EPOLLERR ) ) {
+                    pNode->events |= tcpReactorNode::evRead;
+                }
+                if ( events[i].events & ( EPOLLOUT | EPOLLHUP | EPOLLERR ) ) {
+                    pNode->events |= tcpReactorNode::evWrite;
+                }
+                if ( ! pNode->queued ) {
+                    pNode->queued = true;
+                    this->readyList.add ( *pNode );
+                }
+            }
+            nReady = this->readyList.count ();
+        }
+
+        // circuits that reschedule themselves go to the end of the
+        // list and are serviced after the next epoll_wait()
+        while ( nReady-- ) {
+            tcpReactorNode * pNode;
+            unsigned nodeEvents;
+            {
+                epicsGuard < epicsMutex > guard ( this->mutex );
+                pNode = this->readyList.get ();
+                if ( ! pNode ) {
+                    break;
+                }
+                pNode->queued = false;
+                nodeEvents = pNode->events;
+                pNode->events = 0u;
+            }
+            pNode->iiu.reactorService ( nodeEvents );
+        }
+    }
+}
+
+tcpReactor * tcpReactor::create ( cac & cacIn,
+    unsigned nThreadsIn, unsigned priority )
+{
+    if ( nThreadsIn == 0u ) {
+        return 0;
+    }
+    tcpReactorThread ** ppThreadsIn = new tcpReactorThread * [ nThreadsIn ];
+    unsigned nCreated = 0u;
+    try {
+        while ( nCreated < nThreadsIn ) {
+            int epfd = epoll_create1 ( EPOLL_CLOEXEC );
+            if ( epfd < 0 ) {
+                throw std::runtime_error ( strerror ( errno ) );
+            }
+            int evfd = eventfd ( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+            if ( evfd < 0 ) {
+                ::close ( epfd );
+                throw std::runtime_error ( strerror ( errno ) );
+            }
+            struct epoll_event ev;
+            memset ( & ev, 0, sizeof ( ev ) );
+            ev.events = EPOLLIN;
+            ev.data.ptr = 0;
+            if ( epoll_ctl ( epfd, EPOLL_CTL_ADD, evfd, & ev ) < 0 ) {
+                ::close ( evfd );
+                ::close ( epfd );
+                throw std::runtime_error ( strerror ( errno ) );
+            }
+            ppThreadsIn[nCreated] = new tcpReactorThread ( cacIn,
+                epfd, evfd, "CAC-TCP-io",
+                epicsThreadGetStackSize ( epicsThreadStackBig ), priority );
+            nCreated++;
+        }
+    }
+    catch ( std::exception & except ) {
+        errlogPrintf ( "CAC: unable to create event loop threads "
+            "\"%s\" - using per circuit threads\n", except.what () );
+        while ( nCreated > 0u ) {
+            delete ppThreadsIn[--nCreated];
+        }
+        delete [] ppThreadsIn;
+        return 0;
+    }
+    for ( unsigned i = 0u; i < nThreadsIn; i++ ) {
+        ppThreadsIn[i]->start ();
+    }
+    return new tcpReactor ( ppThreadsIn, nThreadsIn );
+}
+
+tcpReactor::tcpReactor ( tcpReactorThread ** ppThreadsIn,
+        unsigned nThreadsIn ) :
+    ppThreads ( ppThreadsIn ), nThreads ( nThreadsIn )
+{
+}
+
+// all circuits have been destroyed when ~cac calls this
+tcpReactor::~tcpReactor ()
+{
+    for ( unsigned i = 0u; i < this->nThreads; i++ ) {
+        this->ppThreads[i]->exitWait ();
+        delete this->ppThreads[i];
+    }
+    delete [] this->ppThreads;
+}
+
+void tcpReactor::attach ( tcpReactorNode & node )
+{
+    tcpReactorThread * pBest = 0;
+    unsigned bestCount = 0u;
+    for ( unsigned i = 0u; i < this->nThreads; i++ ) {
+        epicsGuard < epicsMutex > guard ( this->ppThreads[i]->mutex );
+        if ( ! pBest || this->ppThreads[i]->nCircuits < bestCount ) {
+            pBest = this->ppThreads[i];
+            bestCount = pBest->nCircuits;
+        }
+    }
+    epicsGuard < epicsMutex > guard ( pBest->mutex );
+    pBest->nCircuits++;
+    node.pThread = pBest;
+}
+
+bool tcpReactor::install ( tcpReactorNode & node, SOCKET sock )
+{
+    tcpReactorThread & thr = *node.pThread;
+    struct epoll_event ev;
+    memset ( & ev, 0, sizeof ( ev ) );
+    ev.events = EPOLLIN;
+    ev.data.ptr = & node;
+    int status = epoll_ctl ( thr.epfd, EPOLL_CTL_ADD, sock, & ev );
+    if ( status < 0 ) {
+        errlogPrintf ( "CAC: unable to register circuit with event loop \"%s\"\n",
+            strerror ( errno ) );
+    }
+    // the circuit is queued even if registration failed so
+    // that its owner thread can clean it up
+    epicsGuard < epicsMutex > guard ( thr.mutex );
+    node.installed = true;
+    if ( ! node.queued ) {
+        node.queued = true;
+        thr.readyList.add ( node );
+        thr.wakeupThread ( guard );
+    }
+    return status >= 0;
+}
+
+void tcpReactor::uninstall ( tcpReactorNode & node, SOCKET sock )
+{
+    tcpReactorThread & thr = *node.pThread;
+    // failure is expected here if install failed
+    epoll_ctl ( thr.epfd, EPOLL_CTL_DEL, sock, 0 );
+    epicsGuard < epicsMutex > guard ( thr.mutex );
+    if ( node.queued ) {
+        thr.readyList.remove ( node );
+        node.queued = false;
+    }
+    node.installed = false;
+    assert ( thr.nCircuits > 0u );
+    thr.nCircuits--;
+    if ( thr.exitRequested ) {
+        thr.wakeupThread ( guard );
+    }
+}
+
+void tcpReactor::writeInterest ( tcpReactorNode & node,
+    SOCKET sock, bool enable )
+{
+    if ( node.writeInterest != enable ) {
+        struct epoll_event ev;
+        memset ( & ev, 0, sizeof ( ev ) );
+        ev.events = enable ? ( EPOLLIN | EPOLLOUT ) : EPOLLIN;
+        ev.data.ptr = & node;
+        if ( epoll_ctl ( node.pThread->epfd, EPOLL_CTL_MOD, sock, & ev ) < 0 ) {
+            errlogPrintf ( "CAC: event loop interest change failed \"%s\"\n",
+                strerror ( errno ) );
+        }
+        node.writeInterest = enable;
+    }
+}
+
+void tcpReactor::wakeup ( tcpReactorNode & node )
+{
+    tcpReactorThread & thr = *node.pThread;
+    epicsGuard < epicsMutex > guard ( thr.mutex );
+    if ( node.installed && ! node.queued ) {
+        node.queued = true;
+        thr.readyList.add ( node );
+        thr.wakeupThread ( guard );
+    }
+}
+
+void tcpReactor::show ( unsigned level ) const
+{
+    ::printf ( "TCP event loop with %u threads\n", this->nThreads );
+    for ( unsigned i = 0u; i < this->nThreads; i++ ) {
+        this->ppThreads[i]->show ( level );
+    }
+}
+
+#else // CA_REACTOR_EPOLL
+
+tcpReactor * tcpReactor::create ( cac &, unsigned nThreadsIn, unsigned )
+{
+    if ( nThreadsIn ) {
+        errlogPrintf ( "CAC: no event loop on this OS - "
+            "using per circuit threads\n" );
+    }
+    return 0;
+}
+
+tcpReactor::tcpReactor ( tcpReactorThread ** ppThreadsIn,
+        unsigned nThreadsIn ) :
+    ppThreads ( ppThreadsIn ), nThreads ( nThreadsIn )
+{
+}
+
+tcpReactor::~tcpReactor () {}
+void tcpReactor::attach ( tcpReactorNode & ) {}
+bool tcpReactor::install ( tcpReactorNode &, SOCKET ) { return false; }
+void tcpReactor::uninstall ( tcpReactorNode &, SOCKET ) {}
+void tcpReactor::writeInterest ( tcpReactorNode &, SOCKET, bool ) {}
+void tcpReactor::wakeup ( tcpReactorNode & ) {}
+void tcpReactor::show ( unsigned ) const {}
+
+#endif // CA_REACTOR_EPOLL
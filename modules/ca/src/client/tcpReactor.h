@@ -0,0 +1,68 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * A small pool of event loop threads which service the TCP virtual
+ * circuits of a client context when it is created with
+ * ca_enable_preemptive_callback_io_pool. Each circuit is bound to one
+ * thread for its lifetime so that per circuit message ordering, and
+ * the single receiver assumptions in tcpiiu, are preserved.
+ */
+
+#ifndef INC_tcpReactor_H
+#define INC_tcpReactor_H
+
+#include "tsDLList.h"
+#include "osiSock.h"
+
+class tcpiiu;
+class cac;
+class tcpReactorThread;
+
+class tcpReactorNode : public tsDLNode < tcpReactorNode > {
+public:
+    // event summary handed to tcpiiu::reactorService
+    enum { evRead = 0x1, evWrite = 0x2 };
+    tcpReactorNode ( tcpiiu & );
+private:
+    tcpiiu & iiu;
+    tcpReactorThread * pThread;
+    unsigned events;
+    bool queued;
+    bool installed;
+    bool writeInterest;
+    friend class tcpReactor;
+    friend class tcpReactorThread;
+    tcpReactorNode ( const tcpReactorNode & );
+    tcpReactorNode & operator = ( const tcpReactorNode & );
+};
+
+class tcpReactor {
+public:
+    // returns NULL if the event loop is not available on this OS
+    static tcpReactor * create ( cac &, unsigned nThreads,
+        unsigned priority );
+    ~tcpReactor ();
+    // bind a new circuit to the least loaded thread
+    void attach ( tcpReactorNode & );
+    // start servicing the circuit, returns false if the socket
+    // could not be registered
+    bool install ( tcpReactorNode &, SOCKET );
+    // only called by the servicing thread
+    void uninstall ( tcpReactorNode &, SOCKET );
+    void writeInterest ( tcpReactorNode &, SOCKET, bool );
+    // schedule the circuit's send and receive labor
+    void wakeup ( tcpReactorNode & );
+    void show ( unsigned level ) const;
+private:
+    tcpReactorThread ** ppThreads;
+    unsigned nThreads;
+    tcpReactor ( tcpReactorThread ** ppThreadsIn, unsigned nThreadsIn );
+    tcpReactor ( const tcpReactor & );
+    tcpReactor & operator = ( const tcpReactor & );
+};
+
+#endif // ifndef INC_tcpReactor_H
@@ -29,6 +29,12 @@
 #include <string>
 
 #include <stdlib.h>
+#include <string.h>
+
+#if defined ( __unix__ ) || defined ( __APPLE__ )
+#   include <sys/uio.h>
+#   define CA_GATHER_SEND
+#endif
 
 #include "errlog.h"
 
@@ -44,6 +50,9 @@
 #include "epicsSignal.h"
 #include "caerr.h"
 #include "udpiiu.h"
+#include "epicsAtomic.h"
+#include "caDiagnostics.h"
+#include "caLatency.h"
 
 using namespace std;
 
@@ -91,79 +100,7 @@ void tcpSendThread::run ()
                 break;
             }
 
-            laborPending = false;
-            bool flowControlLaborNeeded =
-                this->iiu.busyStateDetected != this->iiu.flowControlActive;
-            bool echoLaborNeeded = this->iiu.echoRequestPending;
-            this->iiu.echoRequestPending = false;
-
-            if ( flowControlLaborNeeded ) {
-                if ( this->iiu.flowControlActive ) {
-                    this->iiu.disableFlowControlRequest ( guard );
-                    this->iiu.flowControlActive = false;
-                    debugPrintf ( ( "fc off\n" ) );
-                }
-                else {
-                    this->iiu.enableFlowControlRequest ( guard );
-                    this->iiu.flowControlActive = true;
-                    debugPrintf ( ( "fc on\n" ) );
-                }
-            }
-
-            if ( echoLaborNeeded ) {
-                this->iiu.echoRequest ( guard );
-            }
-
-            while ( nciu * pChan = this->iiu.createReqPend.get () ) {
-                this->iiu.createChannelRequest ( *pChan, guard );
-
-                if ( CA_V42 ( this->iiu.minorProtocolVersion ) ) {
-                    this->iiu.createRespPend.add ( *pChan );
-                    pChan->channelNode::listMember =
-                        channelNode::cs_createRespPend;
-                }
-                else {
-                    // This wakes up the resp thread so that it can call
-                    // the connect callback. This isnt maximally efficent
-                    // but it has the excellent side effect of not requiring
-                    // that the UDP thread take the callback lock. There are
-                    // almost no V42 servers left at this point.
-                    this->iiu.v42ConnCallbackPend.add ( *pChan );
-                    pChan->channelNode::listMember =
-                        channelNode::cs_v42ConnCallbackPend;
-                    this->iiu.echoRequestPending = true;
-                    laborPending = true;
-                }
-
-                if ( this->iiu.sendQue.flushBlockThreshold () ) {
-                    laborPending = true;
-                    break;
-                }
-            }
-
-            while ( nciu * pChan = this->iiu.subscripReqPend.get () ) {
-                // this installs any subscriptions as needed
-                pChan->resubscribe ( guard );
-                this->iiu.connectedList.add ( *pChan );
-                pChan->channelNode::listMember =
-                    channelNode::cs_connected;
-                if ( this->iiu.sendQue.flushBlockThreshold () ) {
-                    laborPending = true;
-                    break;
-                }
-            }
-
-            while ( nciu * pChan = this->iiu.subscripUpdateReqPend.get () ) {
-                // this updates any subscriptions as needed
-                pChan->sendSubscriptionUpdateRequests ( guard );
-                this->iiu.connectedList.add ( *pChan );
-                pChan->channelNode::listMember =
-                    channelNode::cs_connected;
-                if ( this->iiu.sendQue.flushBlockThreshold () ) {
-                    laborPending = true;
-                    break;
-                }
-            }
+            laborPending = this->iiu.sendLabor ( guard );
 
             if ( ! this->iiu.sendThreadFlush ( guard ) ) {
                 break;
@@ -202,7 +139,7 @@ void tcpSendThread::run ()
     this->iiu.sendDog.cancel ();
     this->iiu.recvDog.shutdown ();
 
-    while ( ! this->iiu.recvThread.exitWait ( 30.0 ) ) {
+    while ( ! this->iiu.pRecvThread->exitWait ( 30.0 ) ) {
         // it is possible to get stuck here if the user calls
         // ca_context_destroy() when a circuit isnt known to
         // be unresponsive, but is. That situation is probably
@@ -229,72 +166,264 @@ void tcpSendThread::run ()
     this->iiu.cacRef.destroyIIU ( this->iiu );
 }
 
+//
+// tcpiiu::sendLabor ()
+//
+// queue the requests owed to the server, returns true if
+// labor remains because the send queue reached its threshold
+//
+bool tcpiiu::sendLabor ( epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+
+    bool laborPending = false;
+    bool flowControlLaborNeeded =
+        this->busyStateDetected != this->flowControlActive;
+    bool echoLaborNeeded = this->echoRequestPending;
+    this->echoRequestPending = false;
+
+    if ( flowControlLaborNeeded ) {
+        if ( this->flowControlActive ) {
+            this->disableFlowControlRequest ( guard );
+            this->flowControlActive = false;
+            debugPrintf ( ( "fc off\n" ) );
+        }
+        else {
+            this->enableFlowControlRequest ( guard );
+            this->flowControlActive = true;
+            debugPrintf ( ( "fc on\n" ) );
+        }
+    }
+
+    if ( echoLaborNeeded ) {
+        this->echoRequest ( guard );
+    }
+
+    while ( nciu * pChan = this->createReqPend.get () ) {
+        this->createChannelRequest ( *pChan, guard );
+
+        if ( CA_V42 ( this->minorProtocolVersion ) ) {
+            this->createRespPend.add ( *pChan );
+            pChan->channelNode::listMember =
+                channelNode::cs_createRespPend;
+        }
+        else {
+            // This wakes up the resp thread so that it can call
+            // the connect callback. This isnt maximally efficent
+            // but it has the excellent side effect of not requiring
+            // that the UDP thread take the callback lock. There are
+            // almost no V42 servers left at this point.
+            this->v42ConnCallbackPend.add ( *pChan );
+            pChan->channelNode::listMember =
+                channelNode::cs_v42ConnCallbackPend;
+            this->echoRequestPending = true;
+            laborPending = true;
+        }
+
+        if ( this->sendQue.flushBlockThreshold () ) {
+            return true;
+        }
+    }
+
+    while ( nciu * pChan = this->subscripReqPend.get () ) {
+        // this installs any subscriptions as needed
+        pChan->resubscribe ( guard );
+        this->connectedList.add ( *pChan );
+        pChan->channelNode::listMember =
+            channelNode::cs_connected;
+        if ( this->sendQue.flushBlockThreshold () ) {
+            return true;
+        }
+    }
+
+    while ( nciu * pChan = this->subscripUpdateReqPend.get () ) {
+        // this updates any subscriptions as needed
+        pChan->sendSubscriptionUpdateRequests ( guard );
+        this->connectedList.add ( *pChan );
+        pChan->channelNode::listMember =
+            channelNode::cs_connected;
+        if ( this->sendQue.flushBlockThreshold () ) {
+            return true;
+        }
+    }
+
+    return laborPending;
+}
+
+// send system calls made by all circuits, for benchmarks
+static size_t tcpSendCallCount;
+
+size_t epicsStdCall ca_tcp_send_call_count ( void )
+{
+    return epicsAtomicGetSizeT ( & tcpSendCallCount );
+}
+
+//
+// tcpiiu::sendRetryNeeded ()
+//
+// called when send () or sendmsg () transferred no bytes, returns
+// true if the call should be repeated
+//
+bool tcpiiu::sendRetryNeeded ( int status )
+{
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    if ( this->state != iiucs_connected &&
+        this->state != iiucs_clean_shutdown ) {
+        return false;
+    }
+    // winsock indicates disconnect by returning zero here
+    if ( status == 0 ) {
+        this->disconnectNotify ( guard );
+        return false;
+    }
+
+    int localError = SOCKERRNO;
+
+    if ( localError == SOCK_EINTR ) {
+        return true;
+    }
+
+    // only the event loop uses non-blocking sockets
+    if ( localError == SOCK_EWOULDBLOCK ) {
+        this->sendWouldBlock = true;
+        return false;
+    }
+
+    if ( localError == SOCK_ENOBUFS ) {
+        errlogPrintf (
+            "CAC: system low on network buffers "
+            "- send retry in 15 seconds\n" );
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            epicsThreadSleep ( 15.0 );
+        }
+        return true;
+    }
+
+    if (
+            localError != SOCK_EPIPE &&
+            localError != SOCK_ECONNRESET &&
+            localError != SOCK_ETIMEDOUT &&
+            localError != SOCK_ECONNABORTED &&
+            localError != SOCK_SHUTDOWN ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        errlogPrintf ( "CAC: unexpected TCP send error: %s\n",
+            sockErrBuf );
+    }
+
+    this->disconnectNotify ( guard );
+    return false;
+}
+
+//
+// the send watchdog is armed by the caller, once per flush,
+// and not here once per buffer
+//
 unsigned tcpiiu::sendBytes ( const void *pBuf,
-    unsigned nBytesInBuf, const epicsTime & currentTime )
+    unsigned nBytesInBuf, const epicsTime & /* currentTime */ )
 {
-    unsigned nBytes = 0u;
     assert ( nBytesInBuf <= INT_MAX );
 
-    this->sendDog.start ( currentTime );
-
     while ( true ) {
         int status = ::send ( this->sock,
             static_cast < const char * > (pBuf), (int) nBytesInBuf, 0 );
+        epicsAtomicIncrSizeT ( & tcpSendCallCount );
         if ( status > 0 ) {
-            nBytes = static_cast <unsigned> ( status );
             // printf("SEND: %u\n", nBytes );
-            break;
+            return static_cast <unsigned> ( status );
         }
-        else {
-            epicsGuard < epicsMutex > guard ( this->mutex );
-            if ( this->state != iiucs_connected &&
-                this->state != iiucs_clean_shutdown ) {
-                break;
-            }
-            // winsock indicates disconnect by returning zero here
-            if ( status == 0 ) {
-                this->disconnectNotify ( guard );
-                break;
-            }
-
-            int localError = SOCKERRNO;
-
-            if ( localError == SOCK_EINTR ) {
-                continue;
-            }
+        if ( ! this->sendRetryNeeded ( status ) ) {
+            return 0u;
+        }
+    }
+}
 
-            if ( localError == SOCK_ENOBUFS ) {
-                errlogPrintf (
-                    "CAC: system low on network buffers "
-                    "- send retry in 15 seconds\n" );
-                {
-                    epicsGuardRelease < epicsMutex > unguard ( guard );
-                    epicsThreadSleep ( 15.0 );
+//
+// tcpiiu::gatherSend ()
+//
+// send the committed bytes of several buffers, with one system
+// call for all of them when the OS supports gather writes,
+// returns false if the circuit has disconnected
+//
+bool tcpiiu::gatherSend ( comBuf * const * ppBufs,
+    unsigned nBufs, const epicsTime & currentTime )
+{
+#if defined ( CA_GATHER_SEND )
+    unsigned first = 0u;
+    while ( true ) {
+        while ( first < nBufs && ppBufs[first]->occupiedBytes () == 0u ) {
+            first++;
+        }
+        if ( first >= nBufs ) {
+            return true;
+        }
+        struct iovec iov [ maxGatherBufs ];
+        unsigned nIov = 0u;
+        for ( unsigned i = first; i < nBufs; i++ ) {
+            iov[nIov].iov_base = const_cast < epicsUInt8 * >
+                ( ppBufs[i]->occupiedBytesStart () );
+            iov[nIov].iov_len = ppBufs[i]->occupiedBytes ();
+            nIov++;
+        }
+        struct msghdr msg;
+        memset ( & msg, 0, sizeof ( msg ) );
+        msg.msg_iov = iov;
+        msg.msg_iovlen = nIov;
+        ssize_t status = ::sendmsg ( this->sock, & msg, 0 );
+        epicsAtomicIncrSizeT ( & tcpSendCallCount );
+        if ( status > 0 ) {
+            // consume what was sent, possibly ending part way
+            // through one of the buffers
+            unsigned nBytes = static_cast < unsigned > ( status );
+            while ( nBytes > 0u ) {
+                nBytes -= ppBufs[first]->removeBytes ( nBytes );
+                if ( ppBufs[first]->occupiedBytes () == 0u ) {
+                    first++;
                 }
-                continue;
-            }
-
-            if (
-                    localError != SOCK_EPIPE &&
-                    localError != SOCK_ECONNRESET &&
-                    localError != SOCK_ETIMEDOUT &&
-                    localError != SOCK_ECONNABORTED &&
-                    localError != SOCK_SHUTDOWN ) {
-                char sockErrBuf[64];
-                epicsSocketConvertErrnoToString (
-                    sockErrBuf, sizeof ( sockErrBuf ) );
-                errlogPrintf ( "CAC: unexpected TCP send error: %s\n",
-                    sockErrBuf );
             }
-
-            this->disconnectNotify ( guard );
-            break;
+        }
+        else if ( ! this->sendRetryNeeded ( static_cast < int > ( status ) ) ) {
+            return false;
         }
     }
+#else
+    for ( unsigned i = 0u; i < nBufs; i++ ) {
+        if ( ! ppBufs[i]->flushToWire ( *this, currentTime ) ) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
 
-    this->sendDog.cancel ();
-
-    return nBytes;
+//
+// tcpiiu::fillFromWire ()
+//
+// Once the header of a large response has been processed, and the
+// bytes already queued are consumed, the remainder of its body is
+// received directly into the message body cache instead of passing
+// through a comBuf. Only the receiving thread calls this, and it is
+// also the only user of the body cache. Returns true if the bytes
+// went directly into the body cache.
+//
+bool tcpiiu::fillFromWire ( comBuf & buf, statusWireIO & stat )
+{
+    if ( this->msgHeaderAvailable &&
+            this->curMsg.m_postsize <= this->curDataMax &&
+            this->recvQue.occupiedBytes () == 0u ) {
+        arrayElementCount bodyBytes =
+            this->curMsg.m_postsize - this->curDataBytes;
+        if ( bodyBytes >= comBuf::capacityBytes () ) {
+            this->recvBytes ( & this->pCurData[this->curDataBytes],
+                static_cast < unsigned > ( bodyBytes ), stat );
+            this->curDataBytes += stat.bytesCopied;
+            return true;
+        }
+    }
+    buf.fillFromWire ( *this, stat );
+    return false;
 }
 
 void tcpiiu::recvBytes (
@@ -343,6 +472,13 @@ void tcpiiu::recvBytes (
                 continue;
             }
 
+            // only the event loop uses non-blocking sockets
+            if ( localErrno == SOCK_EWOULDBLOCK ) {
+                stat.bytesCopied = 0u;
+                stat.circuitState = swioConnected;
+                return;
+            }
+
             if ( localErrno == SOCK_ENOBUFS ) {
                 errlogPrintf (
                     "CAC: system low on network buffers "
@@ -377,12 +513,10 @@ void tcpiiu::recvBytes (
 }
 
 tcpRecvThread::tcpRecvThread (
-    class tcpiiu & iiuIn, class epicsMutex & cbMutexIn,
-    cacContextNotify & ctxNotifyIn, const char * pName,
+    class tcpiiu & iiuIn, const char * pName,
     unsigned int stackSize, unsigned int priority  ) :
     thread ( *this, pName, stackSize, priority ),
-        iiu ( iiuIn ), cbMutex ( cbMutexIn ),
-        ctxNotify ( ctxNotifyIn ) {}
+        iiu ( iiuIn ) {}
 
 tcpRecvThread::~tcpRecvThread ()
 {
@@ -407,11 +541,11 @@ void tcpRecvThread::exitWait ()
     this->thread.exitWait ();
 }
 
-bool tcpRecvThread::validFillStatus (
+bool tcpiiu::validFillStatus (
     epicsGuard < epicsMutex > & guard, const statusWireIO & stat )
 {
-    if ( this->iiu.state != tcpiiu::iiucs_connected &&
-        this->iiu.state != tcpiiu::iiucs_clean_shutdown ) {
+    if ( this->state != iiucs_connected &&
+        this->state != iiucs_clean_shutdown ) {
         return false;
     }
     if ( stat.circuitState == swioConnected ) {
@@ -419,21 +553,106 @@ bool tcpRecvThread::validFillStatus (
     }
     if ( stat.circuitState == swioPeerHangup ||
         stat.circuitState == swioPeerAbort ) {
-        this->iiu.disconnectNotify ( guard );
+        this->disconnectNotify ( guard );
     }
     else if ( stat.circuitState == swioLinkFailure ) {
-        this->iiu.initiateAbortShutdown ( guard );
+        this->initiateAbortShutdown ( guard );
     }
     else if ( stat.circuitState == swioLocalAbort ) {
         // state change already occurred
     }
     else {
         errlogMessage ( "cac: invalid fill status - disconnecting" );
-        this->iiu.disconnectNotify ( guard );
+        this->disconnectNotify ( guard );
     }
     return false;
 }
 
+//
+// tcpiiu::processReceived ()
+//
+// dispatch the bytes most recently pushed onto the receive queue
+// and update the flow control state, returns false if the circuit
+// must be shut down
+//
+bool tcpiiu::processReceived (
+    const epicsTime & currentTime, bool & sendWakeupNeeded )
+{
+    {
+        // only one recv thread at a time may call callbacks
+        // - pendEvent() blocks until threads waiting for
+        // this lock get a chance to run
+        callbackManager mgr ( this->ctxNotify, this->cbMutex );
+
+        epicsGuard < epicsMutex > guard ( this->mutex );
+
+        // route legacy V42 channel connect through the recv thread -
+        // the only thread that should be taking the callback lock
+        while ( nciu * pChan = this->v42ConnCallbackPend.first () ) {
+            this->connectNotify ( guard, *pChan );
+            pChan->connect ( mgr.cbGuard, guard );
+        }
+
+        this->unacknowledgedSendBytes = 0u;
+
+        bool protocolOK = false;
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            // execute receive labor
+            protocolOK = this->processIncoming ( currentTime, mgr );
+        }
+
+        if ( ! protocolOK ) {
+            this->initiateAbortShutdown ( guard );
+            return false;
+        }
+        this->_receiveThreadIsBusy = false;
+        // reschedule connection activity watchdog
+        this->recvDog.messageArrivalNotify ( guard );
+        //
+        // if this thread has connected channels with subscriptions
+        // that need to be sent then wakeup the send thread
+        if ( this->subscripReqPend.count() ) {
+            sendWakeupNeeded = true;
+        }
+    }
+
+    //
+    // we dont feel comfortable calling this with a lock applied
+    // (it might block for longer than we like)
+    //
+    // we would prefer to improve efficency by trying, first, a
+    // recv with the new MSG_DONTWAIT flag set, but there isnt
+    // universal support
+    //
+    bool bytesArePending = this->bytesArePendingInOS ();
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        if ( bytesArePending ) {
+            if ( ! this->busyStateDetected ) {
+                this->contigRecvMsgCount++;
+                if ( this->contigRecvMsgCount >=
+                    this->cacRef.maxContiguousFrames ( guard ) ) {
+                    this->busyStateDetected = true;
+                    sendWakeupNeeded = true;
+                }
+            }
+        }
+        else {
+            // if no bytes are pending then we must immediately
+            // switch off flow control w/o waiting for more
+            // data to arrive
+            this->contigRecvMsgCount = 0u;
+            if ( this->busyStateDetected ) {
+                sendWakeupNeeded = true;
+                this->busyStateDetected = false;
+            }
+        }
+    }
+
+    return true;
+}
+
 void tcpRecvThread::run ()
 {
     try {
@@ -455,7 +674,7 @@ void tcpRecvThread::run ()
             }
         }
 
-        this->iiu.sendThread.start ();
+        this->iiu.pSendThread->start ();
         epicsThreadPrivateSet ( caClientCallbackThreadId, &this->iiu );
         this->iiu.cacRef.attachToClientCtx ();
 
@@ -474,97 +693,31 @@ void tcpRecvThread::run ()
             }
 
             statusWireIO stat;
-            pComBuf->fillFromWire ( this->iiu, stat );
+            bool direct = this->iiu.fillFromWire ( *pComBuf, stat );
 
             epicsTime currentTime = epicsTime::getCurrent ();
 
             {
                 epicsGuard < epicsMutex > guard ( this->iiu.mutex );
 
-                if ( ! this->validFillStatus ( guard, stat ) ) {
+                if ( ! this->iiu.validFillStatus ( guard, stat ) ) {
                     break;
                 }
                 if ( stat.bytesCopied == 0u ) {
                     continue;
                 }
 
-                this->iiu.recvQue.pushLastComBufReceived ( *pComBuf );
-                pComBuf = 0;
+                if ( ! direct ) {
+                    this->iiu.recvQue.pushLastComBufReceived ( *pComBuf );
+                    pComBuf = 0;
+                }
 
                 this->iiu._receiveThreadIsBusy = true;
             }
 
             bool sendWakeupNeeded = false;
-            {
-                // only one recv thread at a time may call callbacks
-                // - pendEvent() blocks until threads waiting for
-                // this lock get a chance to run
-                callbackManager mgr ( this->ctxNotify, this->cbMutex );
-
-                epicsGuard < epicsMutex > guard ( this->iiu.mutex );
-
-                // route legacy V42 channel connect through the recv thread -
-                // the only thread that should be taking the callback lock
-                while ( nciu * pChan = this->iiu.v42ConnCallbackPend.first () ) {
-                    this->iiu.connectNotify ( guard, *pChan );
-                    pChan->connect ( mgr.cbGuard, guard );
-                }
-
-                this->iiu.unacknowledgedSendBytes = 0u;
-
-                bool protocolOK = false;
-                {
-                    epicsGuardRelease < epicsMutex > unguard ( guard );
-                    // execute receive labor
-                    protocolOK = this->iiu.processIncoming ( currentTime, mgr );
-                }
-
-                if ( ! protocolOK ) {
-                    this->iiu.initiateAbortShutdown ( guard );
-                    break;
-                }
-                this->iiu._receiveThreadIsBusy = false;
-                // reschedule connection activity watchdog
-                this->iiu.recvDog.messageArrivalNotify ( guard );
-                //
-                // if this thread has connected channels with subscriptions
-                // that need to be sent then wakeup the send thread
-                if ( this->iiu.subscripReqPend.count() ) {
-                    sendWakeupNeeded = true;
-                }
-            }
-
-            //
-            // we dont feel comfortable calling this with a lock applied
-            // (it might block for longer than we like)
-            //
-            // we would prefer to improve efficency by trying, first, a
-            // recv with the new MSG_DONTWAIT flag set, but there isnt
-            // universal support
-            //
-            bool bytesArePending = this->iiu.bytesArePendingInOS ();
-            {
-                epicsGuard < epicsMutex > guard ( this->iiu.mutex );
-                if ( bytesArePending ) {
-                    if ( ! this->iiu.busyStateDetected ) {
-                        this->iiu.contigRecvMsgCount++;
-                        if ( this->iiu.contigRecvMsgCount >=
-                            this->iiu.cacRef.maxContiguousFrames ( guard ) ) {
-                            this->iiu.busyStateDetected = true;
-                            sendWakeupNeeded = true;
-                        }
-                    }
-                }
-                else {
-                    // if no bytes are pending then we must immediately
-                    // switch off flow control w/o waiting for more
-                    // data to arrive
-                    this->iiu.contigRecvMsgCount = 0u;
-                    if ( this->iiu.busyStateDetected ) {
-                        sendWakeupNeeded = true;
-                        this->iiu.busyStateDetected = false;
-                    }
-                }
+            if ( ! this->iiu.processReceived ( currentTime, sendWakeupNeeded ) ) {
+                break;
             }
 
             if ( sendWakeupNeeded ) {
@@ -660,6 +813,293 @@ void tcpRecvThread::connect (
     return;
 }
 
+//
+// tcpiiu::reactorService ()
+//
+// event loop counterpart of the receive and send threads, called
+// without any locks applied by the thread which owns this circuit
+//
+void tcpiiu::reactorService ( unsigned events )
+{
+    bool finished = true;
+    try {
+        finished = this->reactorLabor ( events );
+    }
+    catch ( std::exception & except ) {
+        errlogPrintf (
+            "CA client library event loop "
+            "disconnecting circuit due to C++ exception \"%s\"\n",
+            except.what () );
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        this->initiateAbortShutdown ( guard );
+    }
+    catch ( ... ) {
+        errlogPrintf (
+            "CA client library event loop "
+            "disconnecting circuit due to a non-standard C++ exception\n" );
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        this->initiateAbortShutdown ( guard );
+    }
+    if ( finished ) {
+        this->reactorFinalize ();
+    }
+}
+
+// returns true when the circuit has shut down
+bool tcpiiu::reactorLabor ( unsigned events )
+{
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        if ( this->state == iiucs_connecting ) {
+            if ( ! this->reactorConnect ( guard, events ) ) {
+                return false;
+            }
+        }
+        if ( this->state != iiucs_connected &&
+                this->state != iiucs_clean_shutdown ) {
+            return true;
+        }
+    }
+
+    if ( events & tcpReactorNode::evRead ) {
+        if ( ! this->reactorReceive () ) {
+            return true;
+        }
+    }
+
+    // while the socket is full we wait for it to become writable
+    if ( events & tcpReactorNode::evWrite ) {
+        this->sendWouldBlock = false;
+    }
+    if ( this->sendWouldBlock ) {
+        return false;
+    }
+
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    bool laborPending = false;
+    if ( this->state == iiucs_connected ) {
+        laborPending = this->sendLabor ( guard );
+        if ( ! this->reactorFlush ( guard ) ) {
+            return true;
+        }
+    }
+    else if ( this->state == iiucs_clean_shutdown ) {
+        if ( ! this->reactorFlush ( guard ) ) {
+            return true;
+        }
+        if ( ! this->sendWouldBlock && ! this->shutdownWriteComplete ) {
+            // this should cause the server to disconnect from
+            // the client
+            int status = ::shutdown ( this->sock, SHUT_WR );
+            if ( status ) {
+                char sockErrBuf[64];
+                epicsSocketConvertErrnoToString (
+                    sockErrBuf, sizeof ( sockErrBuf ) );
+                errlogPrintf ("CAC TCP clean socket shutdown error was %s\n",
+                    sockErrBuf );
+            }
+            this->shutdownWriteComplete = true;
+        }
+    }
+    else {
+        return true;
+    }
+
+    if ( laborPending && ! this->sendWouldBlock ) {
+        this->requestSendLabor ();
+    }
+    return false;
+}
+
+// returns true when the connect attempt has finished
+bool tcpiiu::reactorConnect (
+    epicsGuard < epicsMutex > & guard, unsigned events )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+
+    int errnoCpy = 0;
+    if ( ! this->connectInProgress ) {
+        osiSockAddr tmp = this->address ();
+        int status = ::connect ( this->sock,
+                        & tmp.sa, sizeof ( tmp.sa ) );
+        if ( status < 0 ) {
+            errnoCpy = SOCKERRNO;
+            if ( errnoCpy == SOCK_EINPROGRESS || errnoCpy == SOCK_EINTR ) {
+                this->connectInProgress = true;
+                this->pReactor->writeInterest (
+                    this->reactorNode, this->sock, true );
+                return false;
+            }
+        }
+    }
+    else if ( events & tcpReactorNode::evWrite ) {
+        osiSocklen_t len = sizeof ( errnoCpy );
+        int status = getsockopt ( this->sock, SOL_SOCKET, SO_ERROR,
+            reinterpret_cast < char * > ( & errnoCpy ), & len );
+        if ( status < 0 ) {
+            errnoCpy = SOCKERRNO;
+        }
+        this->connectInProgress = false;
+        this->pReactor->writeInterest (
+            this->reactorNode, this->sock, false );
+    }
+    else {
+        return false;
+    }
+
+    if ( errnoCpy == 0 ) {
+        // put the iiu into the connected state
+        this->state = iiucs_connected;
+        this->recvDog.connectNotify ( guard );
+    }
+    else {
+        char sockErrBuf[64];
+        epicsSocketConvertErrorToString (
+            sockErrBuf, sizeof ( sockErrBuf ), errnoCpy );
+        errlogPrintf ( "CAC: Unable to connect because \"%s\"\n",
+            sockErrBuf );
+        this->disconnectNotify ( guard );
+    }
+    return true;
+}
+
+// returns false when the circuit must shut down
+bool tcpiiu::reactorReceive ()
+{
+    if ( ! this->pRecvComBuf ) {
+        this->pRecvComBuf = new ( this->comBufMemMgr ) comBuf;
+    }
+
+    statusWireIO stat;
+    bool direct = this->fillFromWire ( *this->pRecvComBuf, stat );
+
+    epicsTime currentTime = epicsTime::getCurrent ();
+
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+
+        if ( ! this->validFillStatus ( guard, stat ) ) {
+            return false;
+        }
+        if ( stat.bytesCopied == 0u ) {
+            return true;
+        }
+
+        if ( ! direct ) {
+            this->recvQue.pushLastComBufReceived ( *this->pRecvComBuf );
+            this->pRecvComBuf = 0;
+        }
+
+        this->_receiveThreadIsBusy = true;
+    }
+
+    // the send labor always follows the receive labor
+    // in the event loop so no wakeup is needed here
+    bool sendWakeupNeeded = false;
+    return this->processReceived ( currentTime, sendWakeupNeeded );
+}
+
+//
+// tcpiiu::reactorFlush ()
+//
+// non-blocking counterpart of sendThreadFlush (), when the socket
+// is full the partially sent buffer is retained, sendWouldBlock is
+// set, and we ask to be woken up when the socket is writable
+//
+bool tcpiiu::reactorFlush ( epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+
+    while ( true ) {
+        comBuf * pBuf = this->pSendComBuf;
+        this->pSendComBuf = 0;
+        if ( ! pBuf ) {
+            pBuf = this->sendQue.popNextComBufToSend ();
+            if ( ! pBuf ) {
+                break;
+            }
+        }
+
+        epicsTime current = epicsTime::getCurrent ();
+
+        unsigned bytesToBeSent = pBuf->occupiedBytes ();
+        bool success = false;
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            success = pBuf->flushToWire ( *this, current );
+        }
+
+        this->unacknowledgedSendBytes +=
+            bytesToBeSent - pBuf->occupiedBytes ();
+        if ( this->unacknowledgedSendBytes >
+            this->socketLibrarySendBufferSize ) {
+            this->recvDog.sendBacklogProgressNotify ( guard );
+        }
+
+        if ( ! success && this->sendWouldBlock ) {
+            this->pSendComBuf = pBuf;
+            this->pReactor->writeInterest (
+                this->reactorNode, this->sock, true );
+            {
+                // must not hold lock when starting the timer
+                epicsGuardRelease < epicsMutex > unguard ( guard );
+                this->sendDog.start ( current );
+            }
+            this->sendDogRunning = true;
+            if ( this->blockingForFlush ) {
+                this->flushBlockEvent.signal ();
+            }
+            return true;
+        }
+
+        pBuf->~comBuf ();
+        this->comBufMemMgr.release ( pBuf );
+
+        if ( ! success ) {
+            while ( ( pBuf = this->sendQue.popNextComBufToSend () ) ) {
+                pBuf->~comBuf ();
+                this->comBufMemMgr.release ( pBuf );
+            }
+            return false;
+        }
+    }
+
+    this->pReactor->writeInterest (
+        this->reactorNode, this->sock, false );
+    if ( this->sendDogRunning ) {
+        epicsGuardRelease < epicsMutex > unguard ( guard );
+        this->sendDog.cancel ();
+        this->sendDogRunning = false;
+    }
+
+    this->earlyFlush = false;
+    if ( this->blockingForFlush ) {
+        this->flushBlockEvent.signal ();
+    }
+
+    return true;
+}
+
+void tcpiiu::reactorFinalize ()
+{
+    this->sendDog.cancel ();
+    this->recvDog.shutdown ();
+
+    // user threads blocking for send backlog to be reduced
+    // must finish prior to destroying the IIU, see the end
+    // of tcpSendThread::run ()
+    {
+        epicsGuard < epicsMutex > guard ( this->mutex );
+        while ( this->blockingForFlush ) {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            epicsThreadSleep ( 0.1 );
+        }
+    }
+
+    this->pReactor->uninstall ( this->reactorNode, this->sock );
+    this->cacRef.destroyIIU ( *this );
+}
+
 //
 // tcpiiu::tcpiiu ()
 //
@@ -670,16 +1110,13 @@ tcpiiu::tcpiiu (
         comBufMemoryManager & comBufMemMgrIn,
         unsigned minorVersion, ipAddrToAsciiEngine & engineIn,
         const cacChannel::priLev & priorityIn,
-        SearchDestTCP * pSearchDestIn ) :
+        SearchDestTCP * pSearchDestIn, tcpReactor * pReactorIn ) :
     caServerID ( addrIn.ia, priorityIn ),
     hostNameCacheInstance ( addrIn, engineIn ),
-    recvThread ( *this, cbMutexIn, ctxNotifyIn, "CAC-TCP-recv",
-        epicsThreadGetStackSize ( epicsThreadStackBig ),
-        cac::highestPriorityLevelBelow ( cac.getInitializingThreadsPriority() ) ),
-    sendThread ( *this, "CAC-TCP-send",
-        epicsThreadGetStackSize ( epicsThreadStackMedium ),
-        cac::lowestPriorityLevelAbove (
-            cac.getInitializingThreadsPriority() ) ),
+    pRecvThread ( 0 ),
+    pSendThread ( 0 ),
+    pReactor ( pReactorIn ),
+    reactorNode ( *this ),
     recvDog ( cbMutexIn, ctxNotifyIn, mutexIn,
         *this, connectionTimeout, timerQueue ),
     sendDog ( cbMutexIn, ctxNotifyIn, mutexIn,
@@ -692,8 +1129,11 @@ tcpiiu::tcpiiu (
     cacRef ( cac ),
     pCurData ( (char*) freeListMalloc(this->cacRef.tcpSmallRecvBufFreeList) ),
     pSearchDest ( pSearchDestIn ),
+    pRecvComBuf ( 0 ),
+    pSendComBuf ( 0 ),
     mutex ( mutexIn ),
     cbMutex ( cbMutexIn ),
+    ctxNotify ( ctxNotifyIn ),
     minorProtocolVersion ( minorVersion ),
     state ( iiucs_connecting ),
     sock ( INVALID_SOCKET ),
@@ -712,7 +1152,11 @@ tcpiiu::tcpiiu (
     recvProcessPostponedFlush ( false ),
     discardingPendingData ( false ),
     socketHasBeenClosed ( false ),
-    unresponsiveCircuit ( false )
+    unresponsiveCircuit ( false ),
+    sendWouldBlock ( false ),
+    sendDogRunning ( false ),
+    connectInProgress ( false ),
+    shutdownWriteComplete ( false )
 {
     if(!pCurData)
         throw std::bad_alloc();
@@ -808,6 +1252,45 @@ tcpiiu::tcpiiu (
         }
     }
 
+    // the event loop needs a non-blocking socket, name server circuits
+    // block in connect () while retrying so they always get threads
+    if ( this->pReactor && isNameService () ) {
+        this->pReactor = 0;
+    }
+    if ( this->pReactor ) {
+        osiSockIoctl_t yes = true;
+        status = socket_ioctl ( this->sock, FIONBIO, & yes );
+        if ( status < 0 ) {
+            char sockErrBuf[64];
+            epicsSocketConvertErrnoToString (
+                sockErrBuf, sizeof ( sockErrBuf ) );
+            errlogPrintf ( "CAC: non blocking IO set fail because \"%s\"\n",
+                sockErrBuf );
+            this->pReactor = 0;
+        }
+        else {
+            this->pReactor->attach ( this->reactorNode );
+        }
+    }
+    if ( ! this->pReactor ) {
+        try {
+            this->pRecvThread = new tcpRecvThread ( *this, "CAC-TCP-recv",
+                epicsThreadGetStackSize ( epicsThreadStackBig ),
+                cac::highestPriorityLevelBelow (
+                    cac.getInitializingThreadsPriority() ) );
+            this->pSendThread = new tcpSendThread ( *this, "CAC-TCP-send",
+                epicsThreadGetStackSize ( epicsThreadStackMedium ),
+                cac::lowestPriorityLevelAbove (
+                    cac.getInitializingThreadsPriority() ) );
+        }
+        catch ( ... ) {
+            delete this->pRecvThread;
+            epicsSocketDestroy ( this->sock );
+            freeListFree ( this->cacRef.tcpSmallRecvBufFreeList, this->pCurData );
+            throw;
+        }
+    }
+
     if ( isNameService() ) {
         pSearchDest->setCircuit ( this );
     }
@@ -821,7 +1304,14 @@ void tcpiiu::start (
     epicsGuard < epicsMutex > & guard )
 {
     guard.assertIdenticalMutex ( this->mutex );
-    this->recvThread.start ();
+    if ( this->pReactor ) {
+        if ( ! this->pReactor->install ( this->reactorNode, this->sock ) ) {
+            this->disconnectNotify ( guard );
+        }
+    }
+    else {
+        this->pRecvThread->start ();
+    }
 }
 
 void tcpiiu::initiateCleanShutdown (
@@ -835,7 +1325,7 @@ void tcpiiu::initiateCleanShutdown (
         }
         else {
             this->state = iiucs_clean_shutdown;
-            this->sendThreadFlushEvent.signal ();
+            this->requestSendLabor ();
             this->flushBlockEvent.signal ();
         }
     }
@@ -854,7 +1344,7 @@ void tcpiiu::disconnectNotify (
 {
     guard.assertIdenticalMutex ( this->mutex );
     this->state = iiucs_disconnected;
-    this->sendThreadFlushEvent.signal ();
+    this->requestSendLabor ();
     this->flushBlockEvent.signal ();
 }
 
@@ -872,7 +1362,7 @@ void tcpiiu::responsiveCircuitNotify (
                 channelNode::cs_subscripUpdateReqPend;
             pChan->connect ( cbGuard, guard );
         }
-        this->sendThreadFlushEvent.signal ();
+        this->requestSendLabor ();
     }
 }
 
@@ -906,7 +1396,7 @@ void tcpiiu::unresponsiveCircuitNotify (
     if ( ! this->unresponsiveCircuit ) {
         this->unresponsiveCircuit = true;
         this->echoRequestPending = true;
-        this->sendThreadFlushEvent.signal ();
+        this->requestSendLabor ();
         this->flushBlockEvent.signal ();
 
         // must not hold lock when canceling timer
@@ -994,8 +1484,10 @@ void tcpiiu::initiateAbortShutdown (
             }
             break;
         case esscimqi_socketSigAlarmRequired:
-            this->recvThread.interruptSocketRecv ();
-            this->sendThread.interruptSocketSend ();
+            if ( this->pRecvThread ) {
+                this->pRecvThread->interruptSocketRecv ();
+                this->pSendThread->interruptSocketSend ();
+            }
             break;
         default:
             break;
@@ -1004,7 +1496,7 @@ void tcpiiu::initiateAbortShutdown (
         //
         // wake up the send thread if it isnt blocking in send()
         //
-        this->sendThreadFlushEvent.signal ();
+        this->requestSendLabor ();
         this->flushBlockEvent.signal ();
     }
 }
@@ -1018,11 +1510,22 @@ tcpiiu :: ~tcpiiu ()
         this->pSearchDest->disable ();
     }
 
-    this->sendThread.exitWait ();
-    this->recvThread.exitWait ();
+    if ( this->pRecvThread ) {
+        this->pSendThread->exitWait ();
+        this->pRecvThread->exitWait ();
+    }
     this->sendDog.cancel ();
     this->recvDog.shutdown ();
 
+    if ( this->pRecvComBuf ) {
+        this->pRecvComBuf->~comBuf ();
+        this->comBufMemMgr.release ( this->pRecvComBuf );
+    }
+    if ( this->pSendComBuf ) {
+        this->pSendComBuf->~comBuf ();
+        this->comBufMemMgr.release ( this->pSendComBuf );
+    }
+
     if ( ! this->socketHasBeenClosed ) {
         epicsSocketDestroy ( this->sock );
     }
@@ -1039,6 +1542,11 @@ tcpiiu :: ~tcpiiu ()
             free ( this->pCurData );
         }
     }
+
+    // the classic threads may be deleting themselves here, see
+    // epicsThread::exitWait ()
+    delete this->pSendThread;
+    delete this->pRecvThread;
 }
 
 void tcpiiu::show ( unsigned level ) const
@@ -1059,12 +1567,17 @@ void tcpiiu::show ( unsigned level ) const
     }
     if ( level > 2u ) {
         ::printf ( "\tvirtual circuit socket identifier %d\n", this->sock );
-        ::printf ( "\tsend thread flush signal:\n" );
-        this->sendThreadFlushEvent.show ( level-2u );
-        ::printf ( "\tsend thread:\n" );
-        this->sendThread.show ( level-2u );
-        ::printf ( "\trecv thread:\n" );
-        this->recvThread.show ( level-2u );
+        if ( this->pReactor ) {
+            ::printf ( "\tserviced by an event loop thread\n" );
+        }
+        else {
+            ::printf ( "\tsend thread flush signal:\n" );
+            this->sendThreadFlushEvent.show ( level-2u );
+            ::printf ( "\tsend thread:\n" );
+            this->pSendThread->show ( level-2u );
+            ::printf ( "\trecv thread:\n" );
+            this->pRecvThread->show ( level-2u );
+        }
         ::printf ("\techo pending bool = %u\n", this->echoRequestPending );
         ::printf ( "IO identifier hash table:\n" );
 
@@ -1124,7 +1637,7 @@ bool tcpiiu::setEchoRequestPending ( epicsGuard < epicsMutex > & guard )
     guard.assertIdenticalMutex ( this->mutex );
 
     this->echoRequestPending = true;
-    this->sendThreadFlushEvent.signal ();
+    this->requestSendLabor ();
     if ( CA_V43 ( this->minorProtocolVersion ) ) {
         // we send an echo
         return true;
@@ -1668,34 +2181,71 @@ bool tcpiiu::sendThreadFlush ( epicsGuard < epicsMutex > & guard )
     guard.assertIdenticalMutex ( this->mutex );
 
     if ( this->sendQue.occupiedBytes() > 0 ) {
-        while ( comBuf * pBuf = this->sendQue.popNextComBufToSend () ) {
-            epicsTime current = epicsTime::getCurrent ();
+        // The watchdog is armed once for the whole flush, and rearmed
+        // only if a long flush is still making progress when half of
+        // the connection timeout has elapsed.
+        epicsTime dogStart = epicsTime::getCurrent ();
+        const double dogRearmDelay =
+            this->cacRef.connectionTimeout ( guard ) / 2.0;
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            this->sendDog.start ( dogStart );
+        }
+
+        bool success = true;
+        while ( success ) {
+            comBuf * bufs [ maxGatherBufs ];
+            unsigned nBufs = 0u;
+            unsigned bytesToBeSent = 0u;
+            while ( nBufs < maxGatherBufs ) {
+                comBuf * pBuf = this->sendQue.popNextComBufToSend ();
+                if ( ! pBuf ) {
+                    break;
+                }
+                bytesToBeSent += pBuf->occupiedBytes ();
+                bufs[nBufs++] = pBuf;
+            }
+            if ( nBufs == 0u ) {
+                break;
+            }
 
-            unsigned bytesToBeSent = pBuf->occupiedBytes ();
-            bool success = false;
+            epicsTime current = epicsTime::getCurrent ();
             {
                 // no lock while blocking to send
                 epicsGuardRelease < epicsMutex > unguard ( guard );
-                success = pBuf->flushToWire ( *this, current );
-                pBuf->~comBuf ();
-                this->comBufMemMgr.release ( pBuf );
+                if ( current - dogStart > dogRearmDelay ) {
+                    this->sendDog.start ( current );
+                    dogStart = current;
+                }
+                success = this->gatherSend ( bufs, nBufs, current );
+                for ( unsigned i = 0u; i < nBufs; i++ ) {
+                    bufs[i]->~comBuf ();
+                    this->comBufMemMgr.release ( bufs[i] );
+                }
             }
 
-            if ( ! success ) {
-                while ( ( pBuf = this->sendQue.popNextComBufToSend () ) ) {
-                    pBuf->~comBuf ();
-                    this->comBufMemMgr.release ( pBuf );
+            if ( success ) {
+                // set it here with this odd order because we must have
+                // the lock and we must have already sent the bytes
+                this->unacknowledgedSendBytes += bytesToBeSent;
+                if ( this->unacknowledgedSendBytes >
+                    this->socketLibrarySendBufferSize ) {
+                    this->recvDog.sendBacklogProgressNotify ( guard );
                 }
-                return false;
             }
+        }
 
-            // set it here with this odd order because we must have
-            // the lock and we must have already sent the bytes
-            this->unacknowledgedSendBytes += bytesToBeSent;
-            if ( this->unacknowledgedSendBytes >
-                this->socketLibrarySendBufferSize ) {
-                this->recvDog.sendBacklogProgressNotify ( guard );
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            this->sendDog.cancel ();
+        }
+
+        if ( ! success ) {
+            while ( comBuf * pBuf = this->sendQue.popNextComBufToSend () ) {
+                pBuf->~comBuf ();
+                this->comBufMemMgr.release ( pBuf );
             }
+            return false;
         }
     }
 
@@ -1722,7 +2272,11 @@ void tcpiiu :: flush ( epicsGuard < epicsMutex > & guard )
         // pointer to this cac might become invalid
         assert ( this->blockingForFlush < UINT_MAX );
         this->blockingForFlush++;
+        epicsUInt64 stallStart = 0u;
         while ( this->sendQue.flushBlockThreshold() ) {
+            if ( ! stallStart ) {
+                stallStart = epicsMonotonicGet ();
+            }
 
             bool userRequestsCanBeAccepted =
                 this->state == iiucs_connected ||
@@ -1739,6 +2293,9 @@ void tcpiiu :: flush ( epicsGuard < epicsMutex > & guard )
             epicsGuardRelease < epicsMutex > unguard ( guard );
             this->flushBlockEvent.wait ( 30.0 );
         }
+        if ( stallStart ) {
+            caSendStallLatency.sample ( stallStart );
+        }
         this->decrementBlockingForFlushCount ( guard );
     }
 }
@@ -1750,7 +2307,7 @@ unsigned tcpiiu::requestMessageBytesPending (
 #if 0
     if ( ! this->earlyFlush && this->sendQue.flushEarlyThreshold(0u) ) {
         this->earlyFlush = true;
-        this->sendThreadFlushEvent.signal ();
+        this->requestSendLabor ();
     }
 #endif
     return sendQue.occupiedBytes ();
@@ -1953,7 +2510,7 @@ void tcpiiu::installChannel (
     chan.searchReplySetUp ( *this, sidIn, typeIn, countIn, guard );
     // The tcp send thread runs at apriority below the udp thread
     // so that this will not send small packets
-    this->sendThreadFlushEvent.signal ();
+    this->requestSendLabor ();
 }
 
 bool tcpiiu :: connectNotify (
@@ -2039,7 +2596,7 @@ int tcpiiu :: printFormated (
 void tcpiiu::flushRequest ( epicsGuard < epicsMutex > & )
 {
     if ( this->sendQue.occupiedBytes () > 0 ) {
-        this->sendThreadFlushEvent.signal ();
+        this->requestSendLabor ();
     }
 }
 
@@ -2180,6 +2737,12 @@ void SearchDestTCP :: searchRequest (
     }
 }
 
+bool SearchDestTCP :: nameServerReady (
+    epicsGuard < epicsMutex > & ) const
+{
+    return _ptcpiiu && CA_V412 ( _ptcpiiu->minorProtocolVersion );
+}
+
 void SearchDestTCP :: show (
     epicsGuard < epicsMutex > & guard, unsigned level ) const
 {
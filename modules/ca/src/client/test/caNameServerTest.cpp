@@ -0,0 +1,286 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+//
+// Drives the CA name server over loopback circuits from a single
+// thread, calling fileDescriptorManager.process() whenever the
+// server must make progress.
+//
+
+#include <string.h>
+
+#include "epicsTime.h"
+#include "errlog.h"
+#include "fdManager.h"
+#include "osiSock.h"
+#include "osiWireFormat.h"
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+#include "caProto.h"
+#include "nciu.h" // for CA_MINOR_PROTOCOL_REVISION
+#include "caNameServer.h"
+
+static const unsigned short iocPort = 5100u;
+static const unsigned short otherIocPort = 5101u;
+
+static void pump ( unsigned n = 5u )
+{
+    for ( unsigned i = 0u; i < n; i++ ) {
+        fileDescriptorManager.process ( 0.01 );
+    }
+}
+
+static SOCKET circuitConnect ( const osiSockAddr & addr )
+{
+    SOCKET sock = epicsSocketCreate ( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+    if ( sock == INVALID_SOCKET ) {
+        testAbort ( "unable to create a client socket" );
+    }
+    if ( ::connect ( sock, & addr.sa, sizeof ( addr.ia ) ) < 0 ) {
+        testAbort ( "unable to connect to the name server" );
+    }
+    osiSockIoctl_t yes = true;
+    socket_ioctl ( sock, FIONBIO, & yes );
+    return sock;
+}
+
+static void sendAll ( SOCKET sock, const char * pBuf, unsigned size )
+{
+    epicsTime begin = epicsTime::getCurrent ();
+    while ( size ) {
+        int status = ::send ( sock, pBuf, static_cast < int > ( size ), 0 );
+        if ( status > 0 ) {
+            pBuf += status;
+            size -= static_cast < unsigned > ( status );
+        }
+        else if ( epicsTime::getCurrent () - begin > 10.0 ) {
+            testAbort ( "name server is not reading its circuit" );
+        }
+        else {
+            pump ( 1u );
+        }
+    }
+}
+
+static void sendMsg ( SOCKET sock, ca_uint16_t cmmd, ca_uint16_t dataType,
+    ca_uint16_t count, ca_uint32_t cid, ca_uint32_t available,
+    const char * pPayload = 0, unsigned payloadSize = 0u )
+{
+    char buf[sizeof ( caHdr ) + 256];
+    unsigned postsize = CA_MESSAGE_ALIGN ( payloadSize );
+    caHdr msg;
+    AlignedWireRef < epicsUInt16 > ( msg.m_cmmd ) = cmmd;
+    AlignedWireRef < epicsUInt16 > ( msg.m_postsize ) =
+        static_cast < epicsUInt16 > ( postsize );
+    AlignedWireRef < epicsUInt16 > ( msg.m_dataType ) = dataType;
+    AlignedWireRef < epicsUInt16 > ( msg.m_count ) = count;
+    AlignedWireRef < epicsUInt32 > ( msg.m_cid ) = cid;
+    AlignedWireRef < epicsUInt32 > ( msg.m_available ) = available;
+    memcpy ( buf, & msg, sizeof ( msg ) );
+    memset ( & buf[sizeof ( msg )], 0, postsize );
+    if ( payloadSize ) {
+        memcpy ( & buf[sizeof ( msg )], pPayload, payloadSize );
+    }
+    sendAll ( sock, buf, sizeof ( msg ) + postsize );
+}
+
+// names is a list of NUL terminated names
+static void registerNames ( SOCKET sock, unsigned short port,
+    const char * pNames, unsigned size, ca_uint16_t count )
+{
+    sendMsg ( sock, CA_PROTO_NAME_REGISTER, port, count, 0u, 0u,
+        pNames, size );
+    pump ();
+}
+
+static void search ( SOCKET sock, const char * pName, ca_uint32_t cid )
+{
+    sendMsg ( sock, CA_PROTO_SEARCH, DONTREPLY, CA_MINOR_PROTOCOL_REVISION,
+        cid, cid, pName, static_cast < unsigned > ( strlen ( pName ) + 1 ) );
+}
+
+// all replies from the name server are a bare header
+static bool recvMsg ( SOCKET sock, caHdr & msg )
+{
+    char * pBuf = reinterpret_cast < char * > ( & msg );
+    unsigned size = 0u;
+    epicsTime begin = epicsTime::getCurrent ();
+    while ( size < sizeof ( msg ) ) {
+        int status = ::recv ( sock, & pBuf[size],
+            static_cast < int > ( sizeof ( msg ) - size ), 0 );
+        if ( status > 0 ) {
+            size += static_cast < unsigned > ( status );
+        }
+        else if ( status == 0 ||
+                epicsTime::getCurrent () - begin > 10.0 ) {
+            return false;
+        }
+        else {
+            pump ( 1u );
+        }
+    }
+    return true;
+}
+
+static void testVersion ( SOCKET sock, const char * pWho )
+{
+    caHdr msg;
+    testOk ( recvMsg ( sock, msg ) &&
+        AlignedWireRef < epicsUInt16 > ( msg.m_cmmd ) == CA_PROTO_VERSION,
+        "%s circuit receives the version", pWho );
+}
+
+// the next reply must locate request cid at the loopback address and port
+static void testFound ( SOCKET sock, const char * pName, ca_uint32_t cid,
+    unsigned short port )
+{
+    caHdr msg;
+    if ( ! recvMsg ( sock, msg ) ) {
+        testFail ( "%s found, no reply", pName );
+        return;
+    }
+    ca_uint16_t cmmd = AlignedWireRef < epicsUInt16 > ( msg.m_cmmd );
+    ca_uint16_t replyPort = AlignedWireRef < epicsUInt16 > ( msg.m_dataType );
+    ca_uint32_t replyAddr = AlignedWireRef < epicsUInt32 > ( msg.m_cid );
+    ca_uint32_t replyCid = AlignedWireRef < epicsUInt32 > ( msg.m_available );
+    testOk ( cmmd == CA_PROTO_SEARCH && replyCid == cid &&
+        replyPort == port && replyAddr == INADDR_LOOPBACK,
+        "%s found at port %u (cmmd %u, cid %u, port %u, addr %08x)",
+        pName, port, cmmd, replyCid, replyPort, replyAddr );
+}
+
+// searches are not answered for unknown names, so
+// an echo is the next reply after this search
+static void testNotFound ( SOCKET sock, const char * pName, ca_uint32_t cid )
+{
+    search ( sock, pName, cid );
+    sendMsg ( sock, CA_PROTO_ECHO, 0u, 0u, 0u, 0u );
+    caHdr msg;
+    testOk ( recvMsg ( sock, msg ) &&
+        AlignedWireRef < epicsUInt16 > ( msg.m_cmmd ) == CA_PROTO_ECHO,
+        "%s not found", pName );
+}
+
+static void testBacklog ( const osiSockAddr & addr )
+{
+    static const unsigned nSearch = 20000u;
+
+    testDiag ( "Replies back up on a client which is not reading" );
+
+    SOCKET client = circuitConnect ( addr );
+    testVersion ( client, "slow client" );
+
+    for ( unsigned i = 0u; i < nSearch; i++ ) {
+        search ( client, "ns:c", i );
+        if ( i % 1000u == 0u ) {
+            pump ( 1u );
+        }
+    }
+
+    unsigned nFound = 0u;
+    caHdr msg;
+    while ( nFound < nSearch && recvMsg ( client, msg ) &&
+            AlignedWireRef < epicsUInt32 > ( msg.m_available ) == nFound ) {
+        nFound++;
+    }
+    testOk ( nFound == nSearch, "all %u searches answered in order (%u)",
+        nSearch, nFound );
+    epicsSocketDestroy ( client );
+    pump ();
+}
+
+MAIN(caNameServerTest)
+{
+    static const char iocNames[] = "ns:a\0ns:b";
+    static const char restartNames[] = "ns:a";
+    static const char otherNames[] = "ns:a\0ns:c";
+
+    testPlan ( 15 );
+
+    osiSockAttach ();
+
+    SOCKET listenSock = epicsSocketCreate ( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+    osiSockAddr addr;
+    memset ( & addr, 0, sizeof ( addr ) );
+    addr.ia.sin_family = AF_INET;
+    addr.ia.sin_addr.s_addr = htonl ( INADDR_LOOPBACK );
+    addr.ia.sin_port = 0;
+    osiSocklen_t addrSize = sizeof ( addr );
+    osiSockIoctl_t yes = true;
+    // accepted circuits inherit a small send buffer, so
+    // that replies back up in the name server quickly
+    int sendBufSize = 8192;
+    if ( listenSock == INVALID_SOCKET ||
+            setsockopt ( listenSock, SOL_SOCKET, SO_SNDBUF,
+                (char *) & sendBufSize, sizeof ( sendBufSize ) ) < 0 ||
+            bind ( listenSock, & addr.sa, sizeof ( addr.ia ) ) < 0 ||
+            getsockname ( listenSock, & addr.sa, & addrSize ) < 0 ||
+            listen ( listenSock, 10 ) < 0 ||
+            socket_ioctl ( listenSock, FIONBIO, & yes ) < 0 ) {
+        testAbort ( "unable to listen on the loopback interface" );
+    }
+
+    caNameServer * pServer = caNameServer::create ( listenSock, false );
+
+    testDiag ( "Registration and lookup" );
+
+    SOCKET ioc = circuitConnect ( addr );
+    testVersion ( ioc, "IOC" );
+    registerNames ( ioc, iocPort, iocNames, sizeof ( iocNames ), 2u );
+
+    SOCKET client = circuitConnect ( addr );
+    testVersion ( client, "client" );
+
+    search ( client, "ns:a", 1u );
+    testFound ( client, "ns:a", 1u, iocPort );
+    search ( client, "ns:b.VAL", 2u );
+    testFound ( client, "ns:b.VAL", 2u, iocPort );
+    search ( client, "ns:b.DESC{\"ts\":{}}", 3u );
+    testFound ( client, "ns:b.DESC{\"ts\":{}}", 3u, iocPort );
+    testNotFound ( client, "ns:none", 4u );
+
+    testDiag ( "Another IOC on the same host may not take over names" );
+
+    SOCKET otherIoc = circuitConnect ( addr );
+    testVersion ( otherIoc, "other IOC" );
+    eltc ( 0 );
+    registerNames ( otherIoc, otherIocPort, otherNames,
+        sizeof ( otherNames ), 2u );
+    eltc ( 1 );
+    search ( client, "ns:a", 5u );
+    testFound ( client, "ns:a", 5u, iocPort );
+    search ( client, "ns:c", 6u );
+    testFound ( client, "ns:c", 6u, otherIocPort );
+
+    testDiag ( "A restarted IOC takes over the names of its old circuit" );
+
+    SOCKET restartedIoc = circuitConnect ( addr );
+    testVersion ( restartedIoc, "restarted IOC" );
+    registerNames ( restartedIoc, iocPort, restartNames,
+        sizeof ( restartNames ), 1u );
+    epicsSocketDestroy ( ioc );
+    pump ();
+    search ( client, "ns:a", 7u );
+    testFound ( client, "ns:a", 7u, iocPort );
+    testNotFound ( client, "ns:b", 8u );
+
+    testDiag ( "Names are withdrawn when their circuit closes" );
+
+    epicsSocketDestroy ( restartedIoc );
+    pump ();
+    testNotFound ( client, "ns:a", 9u );
+
+    testBacklog ( addr );
+
+    epicsSocketDestroy ( client );
+    epicsSocketDestroy ( otherIoc );
+    delete pServer;
+    epicsSocketDestroy ( listenSock );
+    osiSockRelease ();
+
+    return testDone ();
+}
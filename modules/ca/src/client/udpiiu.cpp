@@ -40,6 +40,75 @@
 #include "inetAddrID.h"
 #include "cac.h"
 #include "disconnectGovernorTimer.h"
+#include "epicsAtomic.h"
+#include "caDiagnostics.h"
+
+// search statistics for all of the client contexts in this process
+static size_t searchRequestsSent;
+static size_t searchRequestsUnanswered;
+static size_t searchRepliesAnswered;
+static size_t searchRepliesWasted;
+static size_t searchDatagramsSent;
+static size_t searchDatagramsDeferred;
+
+void epicsStdCall ca_search_statistics ( struct ca_search_stats * pStats )
+{
+    pStats->requestsSent = epicsAtomicGetSizeT ( & searchRequestsSent );
+    pStats->requestsUnanswered =
+        epicsAtomicGetSizeT ( & searchRequestsUnanswered );
+    pStats->repliesAnswered = epicsAtomicGetSizeT ( & searchRepliesAnswered );
+    pStats->repliesWasted = epicsAtomicGetSizeT ( & searchRepliesWasted );
+    pStats->datagramsSent = epicsAtomicGetSizeT ( & searchDatagramsSent );
+    pStats->datagramsDeferred =
+        epicsAtomicGetSizeT ( & searchDatagramsDeferred );
+}
+
+static void searchReplyCount ( bool answered )
+{
+    if ( answered ) {
+        epicsAtomicIncrSizeT ( & searchRepliesAnswered );
+    }
+    else {
+        epicsAtomicIncrSizeT ( & searchRepliesWasted );
+    }
+}
+
+// update a round trip time estimate in the same way as TCP
+static void rtteUpdate ( double & mean, double & meanDev, double measured )
+{
+    if ( measured > maxRoundTripEstimate ) {
+        measured = maxRoundTripEstimate;
+    }
+    if ( measured < minRoundTripEstimate ) {
+        measured = minRoundTripEstimate;
+    }
+    double error = measured - mean;
+    mean += 0.125 * error;
+    if ( error < 0.0 ) {
+        error = - error;
+    }
+    meanDev = meanDev + .25 * ( error - meanDev );
+}
+
+// true if the address reaches more than one host
+static bool isGroupAddress (
+    const osiSockAddr & addr, ELLLIST & bcastList )
+{
+    epicsUInt32 ip = ntohl ( addr.ia.sin_addr.s_addr );
+    if ( ip == INADDR_BROADCAST || IN_MULTICAST ( ip ) ) {
+        return true;
+    }
+    osiSockAddrNode * pNode =
+        reinterpret_cast < osiSockAddrNode * > ( ellFirst ( & bcastList ) );
+    while ( pNode ) {
+        if ( pNode->addr.ia.sin_addr.s_addr == addr.ia.sin_addr.s_addr ) {
+            return true;
+        }
+        pNode = reinterpret_cast < osiSockAddrNode * >
+            ( ellNext ( & pNode->node ) );
+    }
+    return false;
+}
 
 // UDP protocol dispatch table
 const udpiiu::pProtoStubUDP udpiiu::udpJumpTableCAC [] =
@@ -144,14 +213,21 @@ udpiiu::udpiiu (
     sequenceNumber ( 0 ),
     lastReceivedSeqNo ( 0 ),
     sock ( 0 ),
+    beaconSock ( INVALID_SOCKET ),
     repeaterPort ( 0 ),
     serverPort ( port ),
     localPort ( 0 ),
+    mcastBeaconPort ( 0 ),
     shutdownCmd ( false ),
-    lastReceivedSeqNoIsValid ( false )
+    lastReceivedSeqNoIsValid ( false ),
+    nameServerFirst ( false ),
+    nameServerWaitStarted ( false )
 {
     cacGuard.assertIdenticalMutex ( cacMutex );
 
+    memset ( & this->mcastGroup, 0, sizeof ( this->mcastGroup ) );
+    this->mcastGroup.ia.sin_family = AF_UNSPEC;
+
     double powerOfTwo = log ( beaconAnomalySearchPeriod / minRoundTripEstimate ) / log ( 2.0 );
     this->beaconAnomalyTimerIndex = static_cast < unsigned > ( powerOfTwo + 1.0 );
     if ( this->beaconAnomalyTimerIndex >= this->nTimers ) {
@@ -284,18 +360,45 @@ udpiiu::udpiiu (
     ELLLIST dest;
     ellInit ( & dest );
     configureChannelAccessAddressList ( & dest, this->sock, this->serverPort );
+    ELLLIST bcastList;
+    ellInit ( & bcastList );
+    {
+        osiSockAddr match;
+        match.ia.sin_family = AF_UNSPEC;
+        osiSockDiscoverBroadcastAddresses ( & bcastList, this->sock, & match );
+    }
     while ( osiSockAddrNode *
         pNode = reinterpret_cast < osiSockAddrNode * > ( ellGet ( & dest ) ) ) {
         SearchDestUDP & searchDest = *
-            new SearchDestUDP ( pNode->addr, *this );
+            new SearchDestUDP ( pNode->addr, *this,
+                isGroupAddress ( pNode->addr, bcastList ) );
         _searchDestList.add ( searchDest );
         free ( pNode );
     }
+    ellFree ( & bcastList );
+
+    /*
+     * when a multicast group is configured search it directly, and
+     * receive beacons on it without the repeater hop
+     */
+    if ( this->joinBeaconGroup () ) {
+        osiSockAddr groupDest = this->mcastGroup;
+        groupDest.ia.sin_port = htons ( this->serverPort );
+        _searchDestList.add ( * new SearchDestUDP ( groupDest, *this, true ) );
+    }
 
     /* add list of tcp name service addresses */
+    if ( searchDestListIn.count () ) {
+        int flag;
+        if ( envGetBoolConfigParam ( &EPICS_CA_NAME_SERVER_FIRST, &flag ) == 0 ) {
+            this->nameServerFirst = flag != 0;
+        }
+    }
     _searchDestList.add ( searchDestListIn );
 
-    caStartRepeaterIfNotInstalled ( this->repeaterPort );
+    if ( this->beaconSock == INVALID_SOCKET ) {
+        caStartRepeaterIfNotInstalled ( this->repeaterPort );
+    }
 
     this->pushVersionMsg ();
 
@@ -304,10 +407,98 @@ udpiiu::udpiiu (
         this->ppSearchTmr[j]->start ( cacGuard );
     }
     this->govTmr.start ();
-    this->repeaterSubscribeTmr.start ();
+    if ( this->beaconSock == INVALID_SOCKET ) {
+        this->repeaterSubscribeTmr.start ();
+    }
     this->recvThread.start ();
 }
 
+/*
+ *  udpiiu::joinBeaconGroup ()
+ *
+ *  opt-in multicast mode, returns true if the beacon socket
+ *  was bound and joined to EPICS_CA_MCAST_GROUP
+ */
+bool udpiiu::joinBeaconGroup ()
+{
+#ifdef IP_ADD_MEMBERSHIP
+    const char * pGroup = envGetConfigParamPtr ( & EPICS_CA_MCAST_GROUP );
+    if ( ! pGroup ) {
+        return false;
+    }
+
+    this->mcastBeaconPort =
+        envGetInetPortConfigParam ( & EPICS_CA_MCAST_BEACON_PORT,
+            static_cast < unsigned short > ( CA_MCAST_BEACON_PORT ) );
+
+    osiSockAddr group;
+    memset ( & group, 0, sizeof ( group ) );
+    if ( aToIPAddr ( pGroup, this->mcastBeaconPort, & group.ia ) ||
+            ! IN_MULTICAST ( ntohl ( group.ia.sin_addr.s_addr ) ) ) {
+        errlogPrintf ( "CAC: %s=\"%s\" is not a multicast group address, ignored\n",
+            EPICS_CA_MCAST_GROUP.name, pGroup );
+        return false;
+    }
+    // beacons always arrive on the beacon port
+    group.ia.sin_port = htons ( this->mcastBeaconPort );
+
+    SOCKET bsock = epicsSocketCreate ( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+    if ( bsock == INVALID_SOCKET ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        errlogPrintf ( "CAC: unable to create beacon socket because = \"%s\"\n",
+            sockErrBuf );
+        return false;
+    }
+
+    // every client on this host binds the same beacon port
+    epicsSocketEnableAddressUseForDatagramFanout ( bsock );
+
+    osiSockAddr addr;
+    memset ( & addr, 0, sizeof ( addr ) );
+    addr.ia.sin_family = AF_INET;
+    addr.ia.sin_addr.s_addr = htonl ( INADDR_ANY );
+    addr.ia.sin_port = group.ia.sin_port;
+    if ( bind ( bsock, & addr.sa, sizeof ( addr.ia ) ) < 0 ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        errlogPrintf ( "CAC: unable to bind beacon socket to port %u because = \"%s\"\n",
+            this->mcastBeaconPort, sockErrBuf );
+        epicsSocketDestroy ( bsock );
+        return false;
+    }
+
+    struct ip_mreq mreq;
+    memset ( & mreq, 0, sizeof ( mreq ) );
+    mreq.imr_multiaddr = group.ia.sin_addr;
+    mreq.imr_interface.s_addr = htonl ( INADDR_ANY );
+    if ( setsockopt ( bsock, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+            (char *) & mreq, sizeof ( mreq ) ) != 0 ) {
+        char sockErrBuf[64];
+        char name[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        ipAddrToDottedIP ( & group.ia, name, sizeof ( name ) );
+        errlogPrintf ( "CAC: beacon socket join to %s failed because = \"%s\"\n",
+            name, sockErrBuf );
+        epicsSocketDestroy ( bsock );
+        return false;
+    }
+
+    this->beaconSock = bsock;
+    this->mcastGroup = group;
+    return true;
+#else
+    if ( envGetConfigParamPtr ( & EPICS_CA_MCAST_GROUP ) ) {
+        errlogPrintf ( "CAC: IPv4 multicast is not supported by this target, %s ignored\n",
+            EPICS_CA_MCAST_GROUP.name );
+    }
+    return false;
+#endif
+}
+
 /*
  *  udpiiu::~udpiiu ()
  */
@@ -328,6 +519,9 @@ udpiiu::~udpiiu ()
     }
 
     epicsSocketDestroy ( this->sock );
+    if ( this->beaconSock != INVALID_SOCKET ) {
+        epicsSocketDestroy ( this->beaconSock );
+    }
 }
 
 void udpiiu::shutdown (
@@ -404,9 +598,17 @@ void udpRecvThread::run ()
     }
 
     do {
+        SOCKET recvSock = this->iiu.sock;
+        if ( this->iiu.beaconSock != INVALID_SOCKET ) {
+            recvSock = this->iiu.readableSocket ();
+            if ( recvSock == INVALID_SOCKET ) {
+                continue;
+            }
+        }
+
         osiSockAddr src;
         osiSocklen_t src_size = sizeof ( src );
-        int status = recvfrom ( this->iiu.sock,
+        int status = recvfrom ( recvSock,
             this->iiu.recvBuf, sizeof ( this->iiu.recvBuf ), 0,
             & src.sa, & src_size );
 
@@ -433,7 +635,11 @@ void udpRecvThread::run ()
                 }
             }
         }
-        else if ( status > 0 ) {
+        else if ( recvSock == this->iiu.beaconSock ) {
+            this->iiu.postBeaconMsg ( src, this->iiu.recvBuf,
+                (arrayElementCount) status, epicsTime::getCurrent() );
+        }
+        else {
             this->iiu.postMsg ( src, this->iiu.recvBuf,
                 (arrayElementCount) status, epicsTime::getCurrent() );
         }
@@ -683,6 +889,8 @@ bool udpiiu :: searchRespAction (
         return true;
     }
 
+    this->searchReplyNotify ( addr, currentTime );
+
     /*
      * Starting with CA V4.1 the minor version number
      * is appended to the end of each UDP search reply.
@@ -728,16 +936,18 @@ bool udpiiu :: searchRespAction (
         serverAddr.ia.sin_addr = addr.ia.sin_addr;
     }
 
+    bool answered;
     if ( CA_V42 ( minorVersion ) ) {
-       cacRef.transferChanToVirtCircuit
+        answered = cacRef.transferChanToVirtCircuit
             ( msg.m_available, msg.m_cid, 0xffff,
                 0, minorVersion, serverAddr, currentTime );
     }
     else {
-        cacRef.transferChanToVirtCircuit
+        answered = cacRef.transferChanToVirtCircuit
             ( msg.m_available, msg.m_cid, msg.m_dataType,
                 msg.m_count, minorVersion, serverAddr, currentTime );
     }
+    searchReplyCount ( answered );
 
     return true;
 }
@@ -911,6 +1121,87 @@ void udpiiu::postMsg (
     }
 }
 
+/*
+ * udpiiu::readableSocket ()
+ *
+ * wait until either the search reply socket or the multicast
+ * beacon socket has a datagram; the search reply socket is
+ * preferred so that the shutdown wakeup message is never
+ * starved by beacons.
+ */
+SOCKET udpiiu::readableSocket ()
+{
+    fd_set readFds;
+    FD_ZERO ( & readFds );
+    FD_SET ( this->sock, & readFds );
+    FD_SET ( this->beaconSock, & readFds );
+    SOCKET maxSock = this->sock > this->beaconSock ?
+        this->sock : this->beaconSock;
+
+    int status = select ( static_cast < int > ( maxSock + 1 ),
+        & readFds, 0, 0, 0 );
+    if ( status < 0 ) {
+        int errnoCpy = SOCKERRNO;
+        if ( errnoCpy != SOCK_EINTR ) {
+            char sockErrBuf[64];
+            epicsSocketConvertErrnoToString (
+                sockErrBuf, sizeof ( sockErrBuf ) );
+            errlogPrintf ( "CAC: UDP select error was \"%s\"\n",
+                sockErrBuf );
+            epicsThreadSleep ( 0.1 );
+        }
+        return INVALID_SOCKET;
+    }
+    if ( FD_ISSET ( this->sock, & readFds ) ) {
+        return this->sock;
+    }
+    if ( FD_ISSET ( this->beaconSock, & readFds ) ) {
+        return this->beaconSock;
+    }
+    return INVALID_SOCKET;
+}
+
+/*
+ * udpiiu::postBeaconMsg ()
+ *
+ * Datagrams arriving on the multicast group may come from
+ * anyone, so only beacons are acted upon. Like the repeater,
+ * substitute the source address when the server left it unset.
+ * The search reply sequence number state is not touched.
+ */
+void udpiiu::postBeaconMsg (
+              const osiSockAddr & net_addr,
+              char * pInBuf, arrayElementCount blockSize,
+              const epicsTime & currentTime )
+{
+    while ( blockSize >= sizeof ( caHdr ) ) {
+        caHdr * pCurMsg = reinterpret_cast < caHdr * > ( pInBuf );
+
+        pCurMsg->m_postsize = AlignedWireRef < epicsUInt16 > ( pCurMsg->m_postsize );
+        pCurMsg->m_cmmd = AlignedWireRef < epicsUInt16 > ( pCurMsg->m_cmmd );
+        pCurMsg->m_dataType = AlignedWireRef < epicsUInt16 > ( pCurMsg->m_dataType );
+        pCurMsg->m_count = AlignedWireRef < epicsUInt16 > ( pCurMsg->m_count );
+        pCurMsg->m_available = AlignedWireRef < epicsUInt32 > ( pCurMsg->m_available );
+        pCurMsg->m_cid = AlignedWireRef < epicsUInt32 > ( pCurMsg->m_cid );
+
+        arrayElementCount size = pCurMsg->m_postsize + sizeof ( *pCurMsg );
+        if ( size > blockSize ) {
+            return;
+        }
+
+        if ( pCurMsg->m_cmmd == CA_PROTO_RSRV_IS_UP &&
+                net_addr.sa.sa_family == AF_INET ) {
+            if ( pCurMsg->m_available == 0u ) {
+                pCurMsg->m_available = ntohl ( net_addr.ia.sin_addr.s_addr );
+            }
+            this->beaconAction ( *pCurMsg, net_addr, currentTime );
+        }
+
+        blockSize -= size;
+        pInBuf += size;
+    }
+}
+
 bool udpiiu::pushVersionMsg ()
 {
     epicsGuard < epicsMutex > guard ( this->cacMutex );
@@ -960,22 +1251,73 @@ bool udpiiu::pushDatagramMsg ( epicsGuard < epicsMutex > & guard,
 }
 
 udpiiu :: SearchDestUDP :: SearchDestUDP (
-    const osiSockAddr & destAddr, udpiiu & udpiiuIn ) :
-    _lastError (0u), _destAddr ( destAddr ), _udpiiu ( udpiiuIn )
+    const osiSockAddr & destAddr, udpiiu & udpiiuIn, bool group ) :
+    _lastSendTime ( epicsTime::getCurrent () ),
+    _tokenTime ( _lastSendTime ),
+    _tokens ( searchBurstLimit ), _rtteMean ( minRoundTripEstimate ),
+    _rtteMeanDev ( 0 ), _nSent ( 0u ), _nDeferred ( 0u ), _nReplies ( 0u ),
+    _unanswered ( 0u ), _backoff ( 1u ), _lastError (0u),
+    _destAddr ( destAddr ), _udpiiu ( udpiiuIn ), _group ( group )
 {
 }
 
+//
+// A destination which is answering is limited only by the search
+// timer's congestion control, otherwise the datagrams sent to it are
+// paced by a token bucket which refills with searchBurstLimit tokens
+// per round trip time estimate, divided by the backoff.
+//
+bool udpiiu :: SearchDestUDP :: admit ( const epicsTime & currentTime )
+{
+    double elapsed = currentTime - _tokenTime;
+    _tokenTime = currentTime;
+    if ( _backoff == 1u ) {
+        _tokens = searchBurstLimit;
+        return true;
+    }
+    if ( elapsed > 0.0 ) {
+        double rtte = _rtteMean + 4 * _rtteMeanDev;
+        _tokens += elapsed * searchBurstLimit / ( rtte * _backoff );
+        if ( _tokens > searchBurstLimit ) {
+            _tokens = searchBurstLimit;
+        }
+    }
+    if ( _tokens < 1.0 ) {
+        return false;
+    }
+    _tokens -= 1.0;
+    return true;
+}
+
 void udpiiu :: SearchDestUDP :: searchRequest (
             epicsGuard < epicsMutex > & guard, const char * pBuf, size_t bufSize )
 {
     guard.assertIdenticalMutex ( _udpiiu.cacMutex );
     assert ( bufSize <= INT_MAX );
+    epicsTime currentTime = epicsTime::getCurrent ();
+    if ( ! this->admit ( currentTime ) ) {
+        // the channels in this datagram will be searched
+        // for here again when they are next retried
+        _nDeferred++;
+        epicsAtomicIncrSizeT ( & searchDatagramsDeferred );
+        return;
+    }
     int bufSizeAsInt = static_cast < int > ( bufSize );
     while ( true ) {
         // This const_cast is needed for vxWorks:
         int status = sendto ( _udpiiu.sock, const_cast<char *>(pBuf), bufSizeAsInt, 0,
                 & _destAddr.sa, sizeof ( _destAddr.sa ) );
         if ( status == bufSizeAsInt ) {
+            _nSent++;
+            epicsAtomicIncrSizeT ( & searchDatagramsSent );
+            if ( _unanswered == 0u ) {
+                _lastSendTime = currentTime;
+            }
+            _unanswered++;
+            if ( _unanswered % unsigned ( searchBurstLimit ) == 0u &&
+                    _backoff < maxSearchBackoff ) {
+                _backoff *= 2u;
+            }
             if ( _lastError ) {
                 char buf[64];
                 sockAddrToDottedIP ( &_destAddr.sa, buf, sizeof ( buf ) );
@@ -1028,13 +1370,67 @@ void udpiiu :: SearchDestUDP :: searchRequest (
     }
 }
 
+bool udpiiu :: SearchDestUDP :: searchReplyNotify (
+    epicsGuard < epicsMutex > & guard, const osiSockAddr & addr,
+    bool groupOnly, const epicsTime & currentTime )
+{
+    guard.assertIdenticalMutex ( _udpiiu.cacMutex );
+    if ( groupOnly ) {
+        if ( ! _group ) {
+            return false;
+        }
+    }
+    else if ( ! sockAddrAreIdentical ( & addr, & _destAddr ) ) {
+        return false;
+    }
+    _nReplies++;
+    // only the first reply after a send measures the round trip
+    if ( _unanswered ) {
+        rtteUpdate ( _rtteMean, _rtteMeanDev,
+            currentTime - _lastSendTime );
+        _unanswered = 0u;
+        _backoff = 1u;
+    }
+    return true;
+}
+
 void udpiiu :: SearchDestUDP :: show (
     epicsGuard < epicsMutex > & guard, unsigned level ) const
 {
     guard.assertIdenticalMutex ( _udpiiu.cacMutex );
     char buf[64];
     sockAddrToDottedIP ( &_destAddr.sa, buf, sizeof ( buf ) );
-    :: printf ( "UDP Search destination \"%s\"\n", buf );
+    :: printf ( "UDP Search destination \"%s\"%s\n", buf,
+        _group ? " (broadcast or multicast)" : "" );
+    if ( level > 0u ) {
+        :: printf ( "\tdatagrams sent %lu, deferred %lu, replies %lu\n",
+            static_cast < unsigned long > ( _nSent ),
+            static_cast < unsigned long > ( _nDeferred ),
+            static_cast < unsigned long > ( _nReplies ) );
+        :: printf ( "\tround trip estimate %f sec, rate divisor %u\n",
+            _rtteMean + 4 * _rtteMeanDev, _backoff );
+    }
+}
+
+void udpiiu :: searchReplyNotify (
+    const osiSockAddr & addr, const epicsTime & currentTime )
+{
+    epicsGuard < epicsMutex > guard ( this->cacMutex );
+    bool credited = false;
+    tsDLIter < SearchDest > iter ( _searchDestList.firstIter () );
+    while ( iter.valid () ) {
+        if ( iter->searchReplyNotify ( guard, addr, false, currentTime ) ) {
+            credited = true;
+        }
+        iter++;
+    }
+    if ( ! credited ) {
+        iter = _searchDestList.firstIter ();
+        while ( iter.valid () ) {
+            iter->searchReplyNotify ( guard, addr, true, currentTime );
+            iter++;
+        }
+    }
 }
 
 udpiiu :: SearchRespCallback :: SearchRespCallback ( udpiiu & udpiiuIn ) :
@@ -1098,16 +1494,18 @@ void udpiiu :: SearchRespCallback :: notify (
         serverAddr.ia.sin_addr = addr.ia.sin_addr;
     }
 
+    bool answered;
     if ( CA_V42 ( minorVersion ) ) {
-       _udpiiu.cacRef.transferChanToVirtCircuit
+        answered = _udpiiu.cacRef.transferChanToVirtCircuit
             ( msg.m_available, msg.m_cid, 0xffff,
                 0, minorVersion, serverAddr, currentTime );
     }
     else {
-        _udpiiu.cacRef.transferChanToVirtCircuit
+        answered = _udpiiu.cacRef.transferChanToVirtCircuit
             ( msg.m_available, msg.m_cid, msg.m_dataType,
                 msg.m_count, minorVersion, serverAddr, currentTime );
     }
+    searchReplyCount ( answered );
 }
 
 void udpiiu :: SearchRespCallback :: show (
@@ -1118,7 +1516,8 @@ void udpiiu :: SearchRespCallback :: show (
 }
 
 bool udpiiu :: datagramFlush (
-    epicsGuard < epicsMutex > & guard, const epicsTime & currentTime )
+    epicsGuard < epicsMutex > & guard, const epicsTime & currentTime,
+    bool nameServersOnly )
 {
     guard.assertIdenticalMutex ( cacMutex );
 
@@ -1130,7 +1529,9 @@ bool udpiiu :: datagramFlush (
     tsDLIter < SearchDest > iter ( _searchDestList.firstIter () );
     while ( iter.valid () )
     {
-        iter->searchRequest ( guard, this->xmitBuf, this->nBytesInXmitBuf );
+        if ( ! nameServersOnly || iter->nameServerReady ( guard ) ) {
+            iter->searchRequest ( guard, this->xmitBuf, this->nBytesInXmitBuf );
+        }
         iter++;
     }
 
@@ -1141,13 +1542,54 @@ bool udpiiu :: datagramFlush (
     return true;
 }
 
+//
+// When EPICS_CA_NAME_SERVER_FIRST is set, new channels are searched
+// for only on the name server circuits, which answer in large
+// batches, and UDP search is left to the later timers
+//
+searchTimerNotify::firstHop udpiiu :: firstHopState (
+    epicsGuard < epicsMutex > & guard, const epicsTime & currentTime )
+{
+    guard.assertIdenticalMutex ( cacMutex );
+
+    if ( ! this->nameServerFirst ) {
+        return fhAll;
+    }
+
+    tsDLIter < SearchDest > iter ( _searchDestList.firstIter () );
+    while ( iter.valid () ) {
+        if ( iter->nameServerReady ( guard ) ) {
+            return fhNameServers;
+        }
+        iter++;
+    }
+
+    // give the name server circuits, created with the
+    // context, a chance to connect before the first search
+    if ( ! this->nameServerWaitStarted ) {
+        this->nameServerWaitBegin = currentTime;
+        this->nameServerWaitStarted = true;
+    }
+    if ( currentTime - this->nameServerWaitBegin < nameServerConnectGrace ) {
+        return fhWait;
+    }
+    return fhAll;
+}
+
 void udpiiu :: show ( unsigned level ) const
 {
     epicsGuard < epicsMutex > guard ( this->cacMutex );
 
     ::printf ( "Datagram IO circuit (and disconnected channel repository)\n");
     if ( level > 1u ) {
-        ::printf ("\trepeater port %u\n", this->repeaterPort );
+        if ( this->beaconSock != INVALID_SOCKET ) {
+            char name[64];
+            ipAddrToDottedIP ( & this->mcastGroup.ia, name, sizeof ( name ) );
+            ::printf ("\tmulticast beacons from %s (no repeater)\n", name );
+        }
+        else {
+            ::printf ("\trepeater port %u\n", this->repeaterPort );
+        }
         ::printf ("\tdefault server port %u\n", this->serverPort );
         ::printf ( "Search Destination List with %u items\n",
             _searchDestList.count () );
@@ -1199,12 +1641,14 @@ bool udpiiu::wakeupMsg ()
 }
 
 void udpiiu::beaconAnomalyNotify (
-    epicsGuard < epicsMutex > & cacGuard )
+    epicsGuard < epicsMutex > & cacGuard,
+    const struct sockaddr_in & server )
 {
     for ( unsigned i = this->beaconAnomalyTimerIndex+1u;
             i < this->nTimers; i++ ) {
         this->ppSearchTmr[i]->moveChannels ( cacGuard,
-            *this->ppSearchTmr[this->beaconAnomalyTimerIndex] );
+            *this->ppSearchTmr[this->beaconAnomalyTimerIndex],
+            server );
     }
 }
 
@@ -1249,8 +1693,12 @@ bool udpiiu::searchMsg (
     AlignedWireRef < epicsUInt16 > ( msg.m_dataType ) = DONTREPLY;
     AlignedWireRef < epicsUInt16 > ( msg.m_count ) = CA_MINOR_PROTOCOL_REVISION;
     AlignedWireRef < epicsUInt32 > ( msg.m_cid ) = id;
-    return this->pushDatagramMsg (
+    bool success = this->pushDatagramMsg (
         guard, msg, pName, (ca_uint16_t) nameLength );
+    if ( success ) {
+        epicsAtomicIncrSizeT ( & searchRequestsSent );
+    }
+    return success;
 }
 
 void udpiiu::installNewChannel (
@@ -1260,6 +1708,12 @@ void udpiiu::installNewChannel (
     this->ppSearchTmr[0]->installChannel ( guard, chan );
 }
 
+void udpiiu::expediteSearch (
+    epicsGuard < epicsMutex > & guard )
+{
+    this->ppSearchTmr[0]->startNow ( guard );
+}
+
 void udpiiu::installDisconnectedChannel (
     epicsGuard < epicsMutex > & guard, nciu & chan )
 {
@@ -1270,6 +1724,7 @@ void udpiiu::installDisconnectedChannel (
 void udpiiu::noSearchRespNotify (
     epicsGuard < epicsMutex > & guard, nciu & chan, unsigned index )
 {
+    epicsAtomicIncrSizeT ( & searchRequestsUnanswered );
     const unsigned nTimersMinusOne = this->nTimers - 1;
     if ( index < nTimersMinusOne ) {
         index++;
@@ -1312,18 +1767,7 @@ int udpiiu :: M_repeaterTimerNotify :: printFormated (
 void udpiiu::updateRTTE ( epicsGuard < epicsMutex > & guard, double measured )
 {
     guard.assertIdenticalMutex ( this->cacMutex );
-    if ( measured > maxRoundTripEstimate ) {
-        measured = maxRoundTripEstimate;
-    }
-    if ( measured < minRoundTripEstimate ) {
-        measured = minRoundTripEstimate;
-    }
-    double error = measured - this->rtteMean;
-    this->rtteMean += 0.125 * error;
-    if ( error < 0.0 ) {
-        error = - error;
-    }
-    this->rtteMeanDev = this->rtteMeanDev + .25 * ( error - this->rtteMeanDev );
+    rtteUpdate ( this->rtteMean, this->rtteMeanDev, measured );
 }
 
 double udpiiu::getRTTE ( epicsGuard < epicsMutex > & guard ) const
@@ -87,6 +87,9 @@ static const double maxRoundTripEstimate = 30; // seconds
 static const double maxSearchPeriodDefault = 5.0 * 60.0; // seconds
 static const double maxSearchPeriodLowerLimit = 60.0; // seconds
 static const double beaconAnomalySearchPeriod = 5.0; // seconds
+static const double searchBurstLimit = 64.0; // datagrams per destination
+static const double nameServerConnectGrace = 1.0; // seconds
+static const unsigned maxSearchBackoff = 256u;
 
 class udpiiu :
     private netiiu,
@@ -107,8 +110,11 @@ public:
         epicsGuard < epicsMutex > &, nciu &, netiiu * & );
     void installDisconnectedChannel (
         epicsGuard < epicsMutex > &, nciu & );
+    void expediteSearch (
+        epicsGuard < epicsMutex > & );
     void beaconAnomalyNotify (
-        epicsGuard < epicsMutex > & guard );
+        epicsGuard < epicsMutex > & guard,
+        const struct sockaddr_in & server );
     void shutdown ( epicsGuard < epicsMutex > & cbGuard,
         epicsGuard < epicsMutex > & guard );
     void show ( unsigned level ) const;
@@ -120,15 +126,31 @@ private:
     class SearchDestUDP :
         public SearchDest {
     public:
-        SearchDestUDP ( const osiSockAddr &, udpiiu & );
+        SearchDestUDP ( const osiSockAddr &, udpiiu &, bool group );
         void searchRequest (
             epicsGuard < epicsMutex > &, const char * pBuf, size_t bufLen );
+        bool searchReplyNotify ( epicsGuard < epicsMutex > &,
+            const osiSockAddr &, bool groupOnly, const epicsTime & );
         void show (
             epicsGuard < epicsMutex > &, unsigned level ) const;
     private:
+        // The pacing rate is halved each time that a further
+        // searchBurstLimit datagrams are sent without a reply.
+        epicsTime _lastSendTime;
+        epicsTime _tokenTime;
+        double _tokens;
+        double _rtteMean;
+        double _rtteMeanDev;
+        size_t _nSent;
+        size_t _nDeferred;
+        size_t _nReplies;
+        unsigned _unanswered;
+        unsigned _backoff;
         int _lastError;
         osiSockAddr _destAddr;
         udpiiu & _udpiiu;
+        const bool _group;
+        bool admit ( const epicsTime & currentTime );
     };
     class SearchRespCallback :
         public SearchDest :: Callback {
@@ -186,18 +208,35 @@ private:
     ca_uint32_t sequenceNumber;
     ca_uint32_t lastReceivedSeqNo;
     SOCKET sock;
+    // joined to EPICS_CA_MCAST_GROUP when multicast beacons are enabled
+    SOCKET beaconSock;
     ca_uint16_t repeaterPort;
     ca_uint16_t serverPort;
     ca_uint16_t localPort;
+    ca_uint16_t mcastBeaconPort;
+    osiSockAddr mcastGroup;
+    // time at which the first search waited for a name server
+    epicsTime nameServerWaitBegin;
     bool shutdownCmd;
     bool lastReceivedSeqNoIsValid;
+    // EPICS_CA_NAME_SERVER_FIRST
+    bool nameServerFirst;
+    bool nameServerWaitStarted;
 
     bool wakeupMsg ();
+    void searchReplyNotify (
+        const osiSockAddr & addr, const epicsTime & currentTime );
 
     void postMsg (
             const osiSockAddr & net_addr,
             char *pInBuf, arrayElementCount blockSize,
             const epicsTime &currenTime );
+    void postBeaconMsg (
+            const osiSockAddr & net_addr,
+            char *pInBuf, arrayElementCount blockSize,
+            const epicsTime &currenTime );
+    bool joinBeaconGroup ();
+    SOCKET readableSocket ();
 
     bool pushDatagramMsg ( epicsGuard < epicsMutex > &,
         const caHdr & hdr, const void * pExt,
@@ -298,6 +337,9 @@ private:
     void noSearchRespNotify (
         epicsGuard < epicsMutex > &, nciu & chan, unsigned index );
     bool datagramFlush (
+        epicsGuard < epicsMutex > &, const epicsTime & currentTime,
+        bool nameServersOnly );
+    firstHop firstHopState (
         epicsGuard < epicsMutex > &, const epicsTime & currentTime );
     ca_uint32_t datagramSeqNumber (
         epicsGuard < epicsMutex > & ) const;
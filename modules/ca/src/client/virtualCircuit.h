@@ -37,6 +37,7 @@
 #include "tcpSendWatchdog.h"
 #include "hostNameCache.h"
 #include "SearchDest.h"
+#include "tcpReactor.h"
 #include "compilerDependencies.h"
 
 class callbackManager;
@@ -56,8 +57,8 @@ class ipAddrToAsciiEngine;
 class tcpRecvThread : private epicsThreadRunable {
 public:
     tcpRecvThread (
-        class tcpiiu & iiuIn, epicsMutex & cbMutexIn, cacContextNotify &,
-        const char * pName, unsigned int stackSize, unsigned int priority );
+        class tcpiiu & iiuIn, const char * pName,
+        unsigned int stackSize, unsigned int priority );
     virtual ~tcpRecvThread ();
     void start ();
     void exitWait ();
@@ -67,14 +68,9 @@ public:
 private:
     epicsThread thread;
     class tcpiiu & iiu;
-    epicsMutex & cbMutex;
-    cacContextNotify & ctxNotify;
     void run ();
     void connect (
         epicsGuard < epicsMutex > & guard );
-    bool validFillStatus (
-        epicsGuard < epicsMutex > & guard,
-        const statusWireIO & stat );
 };
 
 class tcpSendThread : private epicsThreadRunable {
@@ -98,6 +94,7 @@ public:
     SearchDestTCP ( cac &, const osiSockAddr & );
     void searchRequest ( epicsGuard < epicsMutex > & guard,
          const char * pbuf, size_t len );
+    bool nameServerReady ( epicsGuard < epicsMutex > & ) const;
     void show ( epicsGuard < epicsMutex > & guard, unsigned level ) const;
     void setCircuit ( tcpiiu * );
     void disable ();
@@ -115,12 +112,14 @@ class tcpiiu :
         private wireSendAdapter, private wireRecvAdapter {
     friend void SearchDestTCP::searchRequest ( epicsGuard < epicsMutex > & guard,
                                                const char * pbuf, size_t len );
+    friend bool SearchDestTCP::nameServerReady (
+        epicsGuard < epicsMutex > & ) const;
 public:
     tcpiiu ( cac & cac, epicsMutex & mutualExclusion, epicsMutex & callbackControl,
         cacContextNotify &, double connectionTimeout, epicsTimerQueue & timerQueue,
         const osiSockAddr & addrIn, comBufMemoryManager &, unsigned minorVersion,
         ipAddrToAsciiEngine & engineIn, const cacChannel::priLev & priorityIn,
-        SearchDestTCP * pSearchDestIn = NULL);
+        SearchDestTCP * pSearchDestIn = NULL, tcpReactor * pReactorIn = NULL );
     ~tcpiiu ();
     void start (
         epicsGuard < epicsMutex > & );
@@ -199,6 +198,9 @@ public:
         const epicsTime &, const caHdrLargeArray & );
     void versionRespNotify ( const caHdrLargeArray & );
 
+    // called only by this circuit's event loop thread
+    void reactorService ( unsigned events );
+
     void * operator new ( size_t size,
         tsFreeList < class tcpiiu, 32, epicsMutexNOOP >  & );
     epicsPlacementDeleteOperator (( void *,
@@ -206,8 +208,11 @@ public:
 
 private:
     hostNameCache hostNameCacheInstance;
-    tcpRecvThread recvThread;
-    tcpSendThread sendThread;
+    // the threads are not created when an event loop services this circuit
+    tcpRecvThread * pRecvThread;
+    tcpSendThread * pSendThread;
+    tcpReactor * pReactor;
+    tcpReactorNode reactorNode;
     tcpRecvWatchdog recvDog;
     tcpSendWatchdog sendDog;
     comQueSend sendQue;
@@ -228,8 +233,12 @@ private:
     cac & cacRef;
     char * pCurData;
     SearchDestTCP * pSearchDest;
+    // event loop buffers, partially received and partially sent
+    comBuf * pRecvComBuf;
+    comBuf * pSendComBuf;
     epicsMutex & mutex;
     epicsMutex & cbMutex;
+    cacContextNotify & ctxNotify;
     unsigned minorProtocolVersion;
     enum iiu_conn_state {
         iiucs_connecting, // pending circuit connect
@@ -257,13 +266,24 @@ private:
     bool discardingPendingData;
     bool socketHasBeenClosed;
     bool unresponsiveCircuit;
+    // only modified by the event loop thread
+    bool sendWouldBlock;
+    bool sendDogRunning;
+    bool connectInProgress;
+    bool shutdownWriteComplete;
 
     bool processIncoming (
         const epicsTime & currentTime, callbackManager & );
     unsigned sendBytes ( const void *pBuf,
         unsigned nBytesInBuf, const epicsTime & currentTime );
+    bool sendRetryNeeded ( int status );
+    // the most buffers handed to the OS in one gather write
+    enum { maxGatherBufs = 64u };
+    bool gatherSend ( comBuf * const * ppBufs,
+        unsigned nBufs, const epicsTime & currentTime );
     void recvBytes (
         void * pBuf, unsigned nBytesInBuf, statusWireIO & );
+    bool fillFromWire ( comBuf &, statusWireIO & );
     const char * pHostName (
         epicsGuard < epicsMutex > & ) const throw ();
     double receiveWatchdogDelay (
@@ -281,6 +301,21 @@ private:
     void decrementBlockingForFlushCount (
         epicsGuard < epicsMutex > & guard );
     bool isNameService () const;
+    void requestSendLabor ();
+    bool validFillStatus (
+        epicsGuard < epicsMutex > & guard,
+        const statusWireIO & stat );
+    bool processReceived (
+        const epicsTime & currentTime, bool & sendWakeupNeeded );
+    bool sendLabor (
+        epicsGuard < epicsMutex > & );
+    bool reactorLabor ( unsigned events );
+    bool reactorConnect (
+        epicsGuard < epicsMutex > &, unsigned events );
+    bool reactorReceive ();
+    bool reactorFlush (
+        epicsGuard < epicsMutex > & );
+    void reactorFinalize ();
 
     // send protocol stubs
     void echoRequest (
@@ -382,6 +417,16 @@ inline bool tcpiiu::connecting (
     return ( this->state == iiucs_connecting );
 }
 
+inline void tcpiiu::requestSendLabor ()
+{
+    if ( this->pReactor ) {
+        this->pReactor->wakeup ( this->reactorNode );
+    }
+    else {
+        this->sendThreadFlushEvent.signal ();
+    }
+}
+
 inline bool tcpiiu::receiveThreadIsBusy (
     epicsGuard < epicsMutex > & guard )
 {
@@ -0,0 +1,7 @@
+/* Generated file, do not edit! */
+
+/* Version determined from Git */
+
+#ifndef EPICS_VCS_VERSION
+  #define EPICS_VCS_VERSION "7f4c7b3db10569abf55c-dirty"
+#endif
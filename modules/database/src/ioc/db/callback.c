@@ -26,9 +26,10 @@
 #include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsInterrupt.h"
-#include "epicsRingPointer.h"
+#include "epicsRingBytes.h"
 #include "epicsString.h"
 #include "epicsThread.h"
+#include "epicsTime.h"
 #include "epicsTimer.h"
 #include "errlog.h"
 #include "errMdef.h"
@@ -40,7 +41,9 @@
 #include "dbAddr.h"
 #include "dbBase.h"
 #include "dbCommon.h"
+#include "dbCommonPvt.h"
 #include "dbFldTypes.h"
+#include "dbLatency.h"
 #include "dbLock.h"
 #include "dbStaticLib.h"
 #include "epicsExport.h"
@@ -53,14 +56,21 @@ static int callbackQueueSize = 2000;
 
 typedef struct cbQueueSet {
     epicsEventId semWakeUp;
-    epicsRingPointerId queue;
+    epicsRingBytesId queue;
     int queueOverflow;
     int queueOverflows;
     int shutdown; // use atomic
     int threadsConfigured;
     int threadsRunning;
+    dbLatencyHist latency;
 } cbQueueSet;
 
+/* Queue entries carry the time of the request */
+typedef struct cbQueueEntry {
+    epicsCallback *pcallback;
+    epicsUInt64 queued;
+} cbQueueEntry;
+
 static cbQueueSet callbackQueue[NUM_CALLBACK_PRIORITIES];
 
 int callbackThreadsDefault = 1;
@@ -116,9 +126,11 @@ int callbackQueueStatus(const int reset, callbackQueueStats *result)
         int prio;
         result->size = callbackQueueSize;
         for(prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
-            epicsRingPointerId qId = callbackQueue[prio].queue;
-            result->numUsed[prio] = epicsRingPointerGetUsed(qId);
-            result->maxUsed[prio] = epicsRingPointerGetHighWaterMark(qId);
+            epicsRingBytesId qId = callbackQueue[prio].queue;
+            result->numUsed[prio] =
+                epicsRingBytesUsedBytes(qId) / sizeof(cbQueueEntry);
+            result->maxUsed[prio] =
+                epicsRingBytesHighWaterMark(qId) / sizeof(cbQueueEntry);
             result->numOverflow[prio] = epicsAtomicGetIntT(&callbackQueue[prio].queueOverflows);
         }
         ret = 0;
@@ -128,7 +140,7 @@ int callbackQueueStatus(const int reset, callbackQueueStats *result)
     if (reset) {
         int prio;
         for(prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
-            epicsRingPointerResetHighWaterMark(callbackQueue[prio].queue);
+            epicsRingBytesResetHighWaterMark(callbackQueue[prio].queue);
         }
     }
     return ret;
@@ -212,15 +224,16 @@ static void callbackTask(void *arg)
     epicsEventSignal(startStopEvent);
 
     while(!epicsAtomicGetIntT(&mySet->shutdown)) {
-        void *ptr;
-        if (epicsRingPointerIsEmpty(mySet->queue))
+        cbQueueEntry ent;
+        if (epicsRingBytesIsEmpty(mySet->queue))
             epicsEventMustWait(mySet->semWakeUp);
 
-        while ((ptr = epicsRingPointerPop(mySet->queue))) {
-            epicsCallback *pcallback = (epicsCallback *)ptr;
-            if(!epicsRingPointerIsEmpty(mySet->queue))
+        while (epicsRingBytesGet(mySet->queue, (char *)&ent, sizeof(ent))) {
+            epicsCallback *pcallback = ent.pcallback;
+            if(!epicsRingBytesIsEmpty(mySet->queue))
                 epicsEventMustTrigger(mySet->semWakeUp);
             mySet->queueOverflow = FALSE;
+            dbLatencyAdd(&mySet->latency, epicsMonotonicGet() - ent.queued);
             (*pcallback->callback)(pcallback);
         }
     }
@@ -264,7 +277,8 @@ void callbackCleanup(void)
 
         assert(epicsAtomicGetIntT(&mySet->threadsRunning)==0);
         epicsEventDestroy(mySet->semWakeUp);
-        epicsRingPointerDelete(mySet->queue);
+        epicsRingBytesDelete(mySet->queue);
+        dbLatencyUnregister(&mySet->latency);
     }
 
     epicsTimerQueueRelease(timerQueue);
@@ -291,10 +305,12 @@ void callbackInit(void)
         epicsThreadId tid;
 
         callbackQueue[i].semWakeUp = epicsEventMustCreate(epicsEventEmpty);
-        callbackQueue[i].queue = epicsRingPointerLockedCreate(callbackQueueSize);
+        callbackQueue[i].queue = epicsRingBytesLockedCreate(
+            callbackQueueSize * sizeof(cbQueueEntry));
         if (callbackQueue[i].queue == 0)
-            cantProceed("epicsRingPointerLockedCreate failed for %s\n",
+            cantProceed("epicsRingBytesLockedCreate failed for %s\n",
                 threadNamePrefix[i]);
+        dbLatencyRegister(&callbackQueue[i].latency, threadNamePrefix[i]);
         callbackQueue[i].queueOverflow = FALSE;
         if (callbackQueue[i].threadsConfigured == 0)
             callbackQueue[i].threadsConfigured = callbackThreadsDefault;
@@ -323,6 +339,7 @@ int callbackRequest(epicsCallback *pcallback)
     int priority;
     int pushOK;
     cbQueueSet *mySet;
+    cbQueueEntry ent;
 
     if (!pcallback) {
         epicsInterruptContextMessage("callbackRequest: pcallback was NULL\n");
@@ -336,7 +353,9 @@ int callbackRequest(epicsCallback *pcallback)
     mySet = &callbackQueue[priority];
     if (mySet->queueOverflow) return S_db_bufFull;
 
-    pushOK = epicsRingPointerPush(mySet->queue, pcallback);
+    ent.pcallback = pcallback;
+    ent.queued = epicsMonotonicGet();
+    pushOK = epicsRingBytesPut(mySet->queue, (char *)&ent, sizeof(ent));
 
     if (!pushOK) {
         epicsInterruptContextMessage(fullMessage[priority]);
@@ -351,11 +370,15 @@ int callbackRequest(epicsCallback *pcallback)
 static void ProcessCallback(epicsCallback *pcallback)
 {
     dbCommon *pRec;
+    epicsUInt64 begin;
 
     callbackGetUser(pRec, pcallback);
     if (!pRec) return;
     dbScanLock(pRec);
+    begin = dbProfileEnabled ? epicsMonotonicGet() : 0;
     (*pRec->rset->process)(pRec);
+    if (begin)
+        dbProfileAddProcess(pRec, begin, 0);
     dbScanUnlock(pRec);
 }
 
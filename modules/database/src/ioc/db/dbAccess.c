@@ -470,6 +470,7 @@ long dbProcess(dbCommon *precord)
     int set_trace = FALSE;
     dbFldDes *pdbFldDes;
     int callNotifyCompletion = FALSE;
+    epicsUInt64 begin = 0;
 
     ptrace = dbLockSetAddrTrace(precord);
     /*
@@ -535,6 +536,9 @@ long dbProcess(dbCommon *precord)
     else
         precord->lcnt = 0;
 
+    if (dbProfileEnabled)
+        begin = epicsMonotonicGet();
+
     /*
      *  Check the record disable link.  A record will not be
      *    processed if the value retrieved through this link
@@ -594,6 +598,8 @@ long dbProcess(dbCommon *precord)
     }
 
 all_done:
+    if (begin)
+        dbProfileAddProcess(precord, begin, 1);
     if (set_trace)
         *ptrace = 0;
     if (callNotifyCompletion && precord->ppn)
@@ -1265,6 +1271,173 @@ long dbPutField(DBADDR *paddr, short dbrType,
     return status;
 }
 
+/* Would dbPutField() process the record after this put? */
+static int putFieldProcesses(const DBADDR *paddr, short dbrType)
+{
+    dbCommon *precord = paddr->precord;
+
+    return paddr->pfield == &precord->proc ||
+        (paddr->pfldDes->process_passive &&
+         precord->scan == 0 &&
+         dbrType < DBR_PUT_ACKT);
+}
+
+/* Make a run of puts which don't process any record, taking the lock
+ * sets of all their records once.  precs[] holds the records.
+ */
+static void putFieldRun(dbFieldRequest *preq, size_t n, dbCommon **precs)
+{
+    dbLocker *locker = dbLockerAlloc(precs, n, 0);
+    size_t i;
+
+    if (!locker) {
+        for (i = 0; i < n; i++) {
+            dbFieldRequest *req = &preq[i];
+
+            req->status = dbPutField(req->paddr, req->dbrType,
+                req->pbuffer, req->nRequest);
+        }
+        return;
+    }
+
+    dbScanLockMany(locker);
+    for (i = 0; i < n; i++) {
+        dbFieldRequest *req = &preq[i];
+        DBADDR *paddr = req->paddr;
+        dbCommon *precord = precs[i];
+
+        /* Check again as dbPutField() would, an earlier put in the
+         * run may have set DISP
+         */
+        if (paddr->special == SPC_ATTRIBUTE)
+            req->status = S_db_noMod;
+        else if (precord->disp && paddr->pfield != &precord->disp)
+            req->status = S_db_putDisabled;
+        else
+            req->status = dbPut(paddr, req->dbrType, req->pbuffer,
+                req->nRequest);
+        /* SCAN may have been set to Passive since the run was chosen */
+        if (req->status || !putFieldProcesses(req->paddr, req->dbrType))
+            precs[i] = NULL;
+    }
+    dbScanUnlockMany(locker);
+    dbLockerFree(locker);
+
+    /* Never process with the whole run locked, forward links
+     * could need other lock sets.
+     */
+    for (i = 0; i < n; i++) {
+        dbCommon *precord = precs[i];
+
+        if (!precord)
+            continue;
+        dbScanLock(precord);
+        if (precord->pact) {
+            if (dbAccessDebugPUTF && precord->tpro)
+                printf("%s: dbPutFieldMany to Active '%s', setting RPRO=1\n",
+                    epicsThreadGetNameSelf(), precord->name);
+            precord->rpro = TRUE;
+        } else {
+            precord->putf = TRUE;
+            preq[i].status = dbProcess(precord);
+        }
+        dbScanUnlock(precord);
+    }
+}
+
+long dbPutFieldMany(dbFieldRequest *preq, size_t nreq)
+{
+    dbCommon **precs = NULL;
+    size_t i = 0, n;
+    long status = 0;
+
+    if (nreq > 1)
+        precs = malloc(nreq * sizeof(*precs));
+
+    while (i < nreq) {
+        /* Collect consecutive puts which only change fields.  A put
+         * which processes a record, or needs its own locking, ends
+         * the run and is made by dbPutField().
+         */
+        for (n = 0; precs && i + n < nreq; n++) {
+            dbFieldRequest *req = &preq[i + n];
+            DBADDR *paddr = req->paddr;
+            dbCommon *precord = paddr->precord;
+            short dbfType = paddr->field_type;
+
+            if (paddr->special == SPC_ATTRIBUTE ||
+                (precord->disp && paddr->pfield != &precord->disp) ||
+                (dbfType >= DBF_INLINK && dbfType <= DBF_FWDLINK) ||
+                putFieldProcesses(paddr, req->dbrType))
+                break;
+            precs[n] = precord;
+        }
+
+        if (n > 1) {
+            putFieldRun(&preq[i], n, precs);
+            i += n;
+        } else {
+            dbFieldRequest *req = &preq[i++];
+
+            req->status = dbPutField(req->paddr, req->dbrType,
+                req->pbuffer, req->nRequest);
+        }
+    }
+    free(precs);
+
+    for (i = 0; i < nreq; i++) {
+        if (preq[i].status) {
+            status = preq[i].status;
+            break;
+        }
+    }
+    return status;
+}
+
+long dbGetFieldMany(dbFieldRequest *preq, size_t nreq)
+{
+    dbCommon **precs;
+    dbLocker *locker = NULL;
+    size_t i;
+    long status = 0;
+
+    if (nreq == 0)
+        return 0;
+
+    precs = malloc(nreq * sizeof(*precs));
+    if (precs) {
+        for (i = 0; i < nreq; i++)
+            precs[i] = preq[i].paddr->precord;
+        locker = dbLockerAlloc(precs, nreq, 0);
+    }
+    if (!locker) {
+        free(precs);
+        for (i = 0; i < nreq; i++) {
+            dbFieldRequest *req = &preq[i];
+
+            req->status = dbGetField(req->paddr, req->dbrType,
+                req->pbuffer, &req->options, &req->nRequest, NULL);
+            if (req->status && !status)
+                status = req->status;
+        }
+        return status;
+    }
+
+    dbScanLockMany(locker);
+    for (i = 0; i < nreq; i++) {
+        dbFieldRequest *req = &preq[i];
+
+        req->status = dbGet(req->paddr, req->dbrType, req->pbuffer,
+            &req->options, &req->nRequest, NULL);
+        if (req->status && !status)
+            status = req->status;
+    }
+    dbScanUnlockMany(locker);
+    dbLockerFree(locker);
+    free(precs);
+    return status;
+}
+
 static long putAckt(DBADDR *paddr, const void *pbuffer, long nRequest,
     long no_elements, long offset)
 {
@@ -17,6 +17,8 @@
 #   undef epicsExportSharedSymbols
 #endif
 
+#include <stddef.h>
+
 #include "epicsTypes.h"
 #include "epicsTime.h"
 
@@ -253,6 +255,35 @@ epicsShareFunc long dbPutField(
 epicsShareFunc long dbPut(
     struct dbAddr *,short dbrType,const void *pbuffer,long nRequest);
 
+/** One element of a batched dbPutFieldMany() or dbGetFieldMany() call.
+ * For puts nRequest is the element count to write; for gets it is the
+ * buffer capacity on entry and the number of elements read on return.
+ * status receives the result which the single-field call would return.
+ */
+typedef struct dbFieldRequest {
+    struct dbAddr *paddr;
+    short dbrType;
+    void *pbuffer;
+    long options;
+    long nRequest;
+    long status;
+} dbFieldRequest;
+
+/** Equivalent to calling dbPutField() for each request in order.
+ * Runs of consecutive puts which don't process any record are made
+ * with the lock sets of all their records taken once.  A put which
+ * processes a record is made like dbPutField(), with only that
+ * record's lock set held.
+ * Must not be called with any record locked.
+ * Returns 0, or the status of the first request which failed.
+ */
+epicsShareFunc long dbPutFieldMany(dbFieldRequest *preq, size_t nreq);
+/** Equivalent to calling dbGetField() for each request, with all
+ * lock sets involved taken once.  Must not be called with any record
+ * locked.  Returns 0, or the status of the first request which failed.
+ */
+epicsShareFunc long dbGetFieldMany(dbFieldRequest *preq, size_t nreq);
+
 typedef void(*SPC_ASCALLBACK)(struct dbCommon *);
 /*dbSpcAsRegisterCallback called by access security */
 epicsShareFunc void dbSpcAsRegisterCallback(SPC_ASCALLBACK func);
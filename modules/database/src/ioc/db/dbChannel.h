@@ -34,18 +34,19 @@ extern "C" {
  * event subscription
  */
 typedef struct evSubscrip {
+    /* what db_post_events() and the event task use, in one cache line */
     ELLNODE                 node;
     struct dbChannel        *chan;
-    EVENTFUNC               *user_sub;
-    void                    *user_arg;
     struct event_que        *ev_que;
     db_field_log            **pLastLog;
     unsigned long           npend;  /* n times this event is on the queue */
-    unsigned long           nreplace;  /* n times replacing event on the queue */
+    EVENTFUNC               *user_sub;
     unsigned char           select;
     char                    useValque;
     char                    callBackInProgress;
     char                    enabled;
+    void                    *user_arg;
+    unsigned long           nreplace;  /* n times replacing event on the queue */
 } evSubscrip;
 
 typedef struct chFilter chFilter;
@@ -60,6 +61,7 @@ typedef struct dbChannel {
     ELLLIST filters;          /* list of filters as created from JSON */
     ELLLIST pre_chain;        /* list of filters to be called pre-event-queue */
     ELLLIST post_chain;       /* list of filters to be called post-event-queue */
+    unsigned char ev_class;   /* subscription class set by a filter, or 0 */
 } dbChannel;
 
 /* Prototype for the channel event function that is called in filter stacks
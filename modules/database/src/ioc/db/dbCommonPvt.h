@@ -3,7 +3,9 @@
 
 #include <compilerDependencies.h>
 #include <dbDefs.h>
+#include <epicsTime.h>
 #include "dbCommon.h"
+#include "dbProfile.h"
 
 struct epicsThreadOSD;
 
@@ -15,6 +17,9 @@ typedef struct dbCommonPvt {
     /* Thread which is currently processing this record */
     struct epicsThreadOSD* procThread;
 
+    /* Profiling figures, only changed with the record locked */
+    dbProfileStats prof;
+
     struct dbCommon common;
 } dbCommonPvt;
 
@@ -24,4 +29,29 @@ dbCommonPvt* dbRec2Pvt(struct dbCommon *prec)
     return CONTAINER(prec, dbCommonPvt, common);
 }
 
+/* Non-zero when profiling, see dbProfile.h */
+extern int dbProfileEnabled;
+
+/* Add the time since begin to the record's process time,
+ * counting a process if count is set */
+static EPICS_ALWAYS_INLINE
+void dbProfileAddProcess(struct dbCommon *prec, epicsUInt64 begin, int count)
+{
+    dbProfileStats *pstats = &dbRec2Pvt(prec)->prof;
+    epicsUInt64 delay = epicsMonotonicGet() - begin;
+
+    pstats->nProcess += count;
+    pstats->processTime += delay;
+    if (delay > pstats->processMax)
+        pstats->processMax = delay;
+}
+
+/* Add the time since begin to the link time of the record which owns a link */
+static EPICS_ALWAYS_INLINE
+void dbProfileAddLink(struct dbCommon *prec, epicsUInt64 begin)
+{
+    if (prec)
+        dbRec2Pvt(prec)->prof.linkTime += epicsMonotonicGet() - begin;
+}
+
 #endif // DBCOMMONPVT_H
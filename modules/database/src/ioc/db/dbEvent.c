@@ -28,9 +28,13 @@
 #include "cantProceed.h"
 #include "dbDefs.h"
 #include "epicsAssert.h"
+#include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
+#include "epicsStdio.h"
+#include "epicsString.h"
 #include "epicsThread.h"
+#include "epicsTime.h"
 #include "errlog.h"
 #include "freeList.h"
 #include "taskwd.h"
@@ -61,22 +65,42 @@
 #define EVENTQUESIZE    (EVENTENTRIES  * EVENTSPERQUE)
 #define EVENTQEMPTY     ((struct evSubscrip *)NULL)
 
+/* The subscriptions, field logs and queues of different event tasks are
+ * allocated on separate cache lines so that they don't false-share.
+ */
+#define CACHE_LINE_SIZE 64
+
+#ifndef DB_EVENT_LOG_STRINGS
+STATIC_ASSERT(sizeof(db_field_log) <= CACHE_LINE_SIZE);
+#endif
+
+/* a subscription and its value, adjacent so they share a cache line */
+struct event_que_entry {
+    struct evSubscrip       *pevent;
+    db_field_log            *pLog;
+};
+
 /*
  * really a ring buffer
  */
 struct event_que {
     /* lock writers to the ring buffer only */
     /* readers must never slow up writers */
+    /* the posting threads and the event task take writelock in turn,
+     * so everything they change under it follows in the same line */
+    /* records are posted from threads of every priority, so this needs
+     * the priority inheritance of an epicsMutex */
     epicsMutexId            writelock;
-    db_field_log            *valque[EVENTQUESIZE];
-    struct evSubscrip       *evque[EVENTQUESIZE];
-    struct event_que        *nextque;       /* in case que quota exceeded */
-    struct event_user       *evUser;        /* event user parent struct */
     unsigned short          putix;
     unsigned short          getix;
     unsigned short          quota;          /* the number of assigned entries*/
     unsigned short          nDuplicates;    /* N events duplicated on this q */
     unsigned short          nCanceled;      /* the number of canceled entries */
+    unsigned char           evClass;        /* of all subscriptions on this q */
+    size_t                  queovr;         /* events replaced as que was full */
+    struct event_user       *evUser;        /* event user parent struct */
+    struct event_que        *nextque;       /* in case que quota exceeded */
+    struct event_que_entry  evque[EVENTQUESIZE];
 };
 
 struct event_user {
@@ -91,15 +115,27 @@ struct event_user {
 
     epicsThreadId       taskid;         /* event handler task id */
     struct evSubscrip   *pSuicideEvent; /* event that is deleteing itself */
-    unsigned            queovr;         /* event que overflow count */
     unsigned char       pendexit;       /* exit pend task */
     unsigned char       extra_labor;    /* if set call extra labor func */
     unsigned char       flowCtrlMode;   /* replace existing monitor */
     unsigned char       extraLaborBusy;
     void                (*init_func)();
     epicsThreadId       init_func_arg;
+
+    /* set when an event is queued on an empty que of the class */
+    int                 classWake[DB_EVENT_NCLASSES];
+    /* rate limit token buckets, used by the event task only */
+    double              tokens[DB_EVENT_NCLASSES];
+    epicsUInt64         tokenTime[DB_EVENT_NCLASSES];
+};
+
+static const char * const className[DB_EVENT_NCLASSES + 1u] = {
+    "default", "high", "normal", "low"
 };
 
+/* max events per second delivered by each event task, 0 for no limit */
+static double classMaxRate[DB_EVENT_NCLASSES];
+
 /*
  * Reliable intertask communication requires copying the current value of the
  * channel for later queing so 3 stepper motor steps of 10 each do not turn
@@ -125,7 +161,7 @@ static struct evSubscrip canceledEvent;
 
 static unsigned short ringSpace ( const struct event_que *pevq )
 {
-    if ( pevq->evque[pevq->putix] == EVENTQEMPTY ) {
+    if ( pevq->evque[pevq->putix].pevent == EVENTQEMPTY ) {
         if ( pevq->getix > pevq->putix ) {
             return ( unsigned short ) ( pevq->getix - pevq->putix );
         }
@@ -187,6 +223,10 @@ int dbel ( const char *pname, unsigned level )
             if ( pevent->select & DBE_PROPERTY ) printf( "PROPERTY " );
             printf ( "}" );
 
+            if ( pevent->ev_que->evClass != DB_EVENT_CLASS_NORMAL ) {
+                printf ( " class=%s", className[pevent->ev_que->evClass] );
+            }
+
             if ( pevent->npend ) {
                 printf ( " undelivered=%ld", pevent->npend );
             }
@@ -262,20 +302,20 @@ int dbel ( const char *pname, unsigned level )
 void db_init_event_freelists (void)
 {
     if (!dbevEventUserFreeList) {
-        freeListInitPvt(&dbevEventUserFreeList,
-            sizeof(struct event_user),8);
+        freeListInitAligned(&dbevEventUserFreeList,
+            sizeof(struct event_user),8,CACHE_LINE_SIZE);
     }
     if (!dbevEventQueueFreeList) {
-        freeListInitPvt(&dbevEventQueueFreeList,
-            sizeof(struct event_que),8);
+        freeListInitAligned(&dbevEventQueueFreeList,
+            sizeof(struct event_que),8,CACHE_LINE_SIZE);
     }
     if (!dbevEventSubscriptionFreeList) {
-        freeListInitPvt(&dbevEventSubscriptionFreeList,
-            sizeof(struct evSubscrip),256);
+        freeListInitAligned(&dbevEventSubscriptionFreeList,
+            sizeof(struct evSubscrip),256,CACHE_LINE_SIZE);
     }
     if (!dbevFieldLogFreeList) {
-        freeListInitPvt(&dbevFieldLogFreeList,
-            sizeof(struct db_field_log),2048);
+        freeListInitAligned(&dbevFieldLogFreeList,
+            sizeof(struct db_field_log),2048,CACHE_LINE_SIZE);
     }
 }
 
@@ -301,6 +341,7 @@ dbEventCtx db_init_events (void)
     }
 
     evUser->firstque.evUser = evUser;
+    evUser->firstque.evClass = DB_EVENT_CLASS_NORMAL;
     evUser->firstque.writelock = epicsMutexCreate();
     if (!evUser->firstque.writelock)
         goto fail;
@@ -323,7 +364,7 @@ fail:
     if(evUser->lock)
         epicsMutexDestroy (evUser->lock);
     if(evUser->firstque.writelock)
-        epicsMutexDestroy (evUser->firstque.writelock);
+        epicsMutexDestroy(evUser->firstque.writelock);
     if(evUser->ppendsem)
         epicsEventDestroy (evUser->ppendsem);
     if(evUser->pflush_sem)
@@ -405,6 +446,17 @@ static struct event_que * create_ev_que ( struct event_user * const evUser )
 dbEventSubscription db_add_event (
     dbEventCtx ctx, struct dbChannel *chan,
     EVENTFUNC *user_sub, void *user_arg, unsigned select)
+{
+    return db_add_event_class ( ctx, chan, user_sub, user_arg, select,
+        DB_EVENT_CLASS_DEFAULT );
+}
+
+/*
+ * DB_ADD_EVENT_CLASS()
+ */
+dbEventSubscription db_add_event_class (
+    dbEventCtx ctx, struct dbChannel *chan,
+    EVENTFUNC *user_sub, void *user_arg, unsigned select, unsigned evClass)
 {
     struct event_user * const evUser = (struct event_user *) ctx;
     struct event_que * ev_que;
@@ -417,20 +469,31 @@ dbEventSubscription db_add_event (
         return NULL;
     }
 
+    if ( evClass == DB_EVENT_CLASS_DEFAULT ) {
+        evClass = chan->ev_class ? chan->ev_class : DB_EVENT_CLASS_NORMAL;
+    }
+    if ( evClass > DB_EVENT_NCLASSES ) {
+        return NULL;
+    }
+
     pevent = freeListCalloc (dbevEventSubscriptionFreeList);
     if ( ! pevent ) {
         return NULL;
     }
 
-    /* find an event que block with enough quota */
+    /* find an event que block of the class with enough quota */
     /* otherwise add a new one to the list */
     epicsMutexMustLock ( evUser->lock );
     ev_que = & evUser->firstque;
     while ( TRUE ) {
         int success = 0;
         LOCKEVQUE ( ev_que );
-        success = ( ev_que->quota + ev_que->nCanceled <
-                                EVENTQUESIZE - EVENTENTRIES );
+        /* an unused que can take on any class */
+        if ( ev_que->quota == 0u && ev_que->nCanceled == 0u ) {
+            ev_que->evClass = (unsigned char) evClass;
+        }
+        success = ( ev_que->evClass == evClass &&
+            ev_que->quota + ev_que->nCanceled < EVENTQUESIZE - EVENTENTRIES );
         if ( success ) {
             ev_que->quota += EVENTENTRIES;
         }
@@ -522,10 +585,10 @@ void db_event_disable (dbEventSubscription event)
 static void event_remove ( struct event_que *ev_que,
     unsigned short index, struct evSubscrip *placeHolder )
 {
-    struct evSubscrip * const pevent = ev_que->evque[index];
+    struct evSubscrip * const pevent = ev_que->evque[index].pevent;
 
-    ev_que->evque[index] = placeHolder;
-    ev_que->valque[index] = NULL;
+    ev_que->evque[index].pevent = placeHolder;
+    ev_que->evque[index].pLog = NULL;
     if ( pevent->npend == 1u ) {
         pevent->pLastLog = NULL;
     }
@@ -572,8 +635,8 @@ void db_cancel_event (dbEventSubscription event)
      * would be possible.
      */
     for (   getix = pevent->ev_que->getix;
-            pevent->ev_que->evque[getix] != EVENTQEMPTY; ) {
-        if ( pevent->ev_que->evque[getix] == pevent ) {
+            pevent->ev_que->evque[getix].pevent != EVENTQEMPTY; ) {
+        if ( pevent->ev_que->evque[getix].pevent == pevent ) {
             assert ( pevent->ev_que->nCanceled < USHRT_MAX );
             pevent->ev_que->nCanceled++;
             event_remove ( pevent->ev_que, getix, &canceledEvent );
@@ -605,6 +668,74 @@ void db_cancel_event (dbEventSubscription event)
     return;
 }
 
+/*
+ * DB_EVENT_CLASS()
+ */
+unsigned db_event_class (dbEventSubscription event)
+{
+    struct evSubscrip * const pevent = (struct evSubscrip *) event;
+
+    return pevent->ev_que->evClass;
+}
+
+/*
+ * DB_EVENT_CLASS_NAME()
+ */
+const char * db_event_class_name (unsigned evClass)
+{
+    return evClass <= DB_EVENT_NCLASSES ? className[evClass] : "invalid";
+}
+
+/*
+ * DB_EVENT_CLASS_RATE()
+ */
+int db_event_class_rate (unsigned evClass, double maxRate)
+{
+    if ( evClass < DB_EVENT_CLASS_HIGH || evClass > DB_EVENT_NCLASSES ||
+            ! ( maxRate >= 0.0 ) ) {
+        return DB_EVENT_ERROR;
+    }
+    classMaxRate[evClass - 1u] = maxRate;
+    return DB_EVENT_OK;
+}
+
+/*
+ * dbEventClassRate ()
+ */
+int dbEventClassRate (const char *name, double maxRate)
+{
+    unsigned evClass;
+
+    if ( ! name || ! *name ) {
+        for ( evClass = DB_EVENT_CLASS_HIGH; evClass <= DB_EVENT_NCLASSES;
+                evClass++ ) {
+            double rate = classMaxRate[evClass - 1u];
+
+            if ( rate > 0.0 ) {
+                printf ( "%-8s %g events/sec per event task\n",
+                    className[evClass], rate );
+            }
+            else {
+                printf ( "%-8s unlimited\n", className[evClass] );
+            }
+        }
+        return DB_EVENT_OK;
+    }
+
+    for ( evClass = DB_EVENT_CLASS_HIGH; evClass <= DB_EVENT_NCLASSES;
+            evClass++ ) {
+        if ( epicsStrCaseCmp ( name, className[evClass] ) == 0 ) {
+            if ( db_event_class_rate ( evClass, maxRate ) ) {
+                printf ( "dbEventClassRate: rate must not be negative\n" );
+                return DB_EVENT_ERROR;
+            }
+            return DB_EVENT_OK;
+        }
+    }
+    printf ( "dbEventClassRate: class must be high, normal or low\n" );
+    return DB_EVENT_ERROR;
+}
+
 /*
  * DB_FLUSH_EXTRA_LABOR_EVENT()
  *
@@ -771,6 +902,8 @@ static void db_queue_event_log (evSubscrip *pevent, db_field_log *pLog)
             *pevent->pLastLog = pLog;
         }
         pevent->nreplace++;
+        if (!ev_que->evUser->flowCtrlMode)
+            ev_que->queovr++;
         /*
          * the event task has already been notified about
          * this so we dont need to post the semaphore
@@ -782,10 +915,10 @@ static void db_queue_event_log (evSubscrip *pevent, db_field_log *pLog)
      * Fill it in and advance the ring buffer.
      */
     else {
-        assert ( ev_que->evque[ev_que->putix] == EVENTQEMPTY );
-        ev_que->evque[ev_que->putix] = pevent;
-        ev_que->valque[ev_que->putix] = pLog;
-        pevent->pLastLog = &ev_que->valque[ev_que->putix];
+        assert ( ev_que->evque[ev_que->putix].pevent == EVENTQEMPTY );
+        ev_que->evque[ev_que->putix].pevent = pevent;
+        ev_que->evque[ev_que->putix].pLog = pLog;
+        pevent->pLastLog = &ev_que->evque[ev_que->putix].pLog;
         if (pevent->npend>0u) {
             ev_que->nDuplicates++;
         }
@@ -815,6 +948,7 @@ static void db_queue_event_log (evSubscrip *pevent, db_field_log *pLog)
         /*
          * notify the event handler
          */
+        epicsAtomicSetIntT(&ev_que->evUser->classWake[ev_que->evClass - 1u], 1);
         epicsEventSignal(ev_que->evUser->ppendsem);
     }
 }
@@ -876,14 +1010,34 @@ void db_post_single_event (dbEventSubscription event)
     dbScanUnlock (prec);
 }
 
+/* event_read() status */
+#define EVENT_READ_DONE         0   /* que empty or in flow control */
+#define EVENT_READ_LIMITED      1   /* out of budget with events left */
+#define EVENT_READ_PREEMPTED    2   /* a higher class has events queued */
+
+static int higherClassWaiting ( struct event_que *ev_que )
+{
+    unsigned i;
+
+    for ( i = 0u; i + 1u < ev_que->evClass; i++ ) {
+        if ( epicsAtomicGetIntT ( &ev_que->evUser->classWake[i] ) ) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
 /*
  * EVENT_READ()
+ *
+ * Deliver at most *pBudget events, or all of them if it is negative.
  */
-static int event_read ( struct event_que *ev_que )
+static int event_read ( struct event_que *ev_que, long *pBudget )
 {
     db_field_log *pfl;
     void ( *user_sub ) ( void *user_arg, struct dbChannel *chan,
             int eventsRemaining, db_field_log *pfl );
+    int status = EVENT_READ_DONE;
 
     /*
      * evUser ring buffer must be locked for the multiple
@@ -898,18 +1052,18 @@ static int event_read ( struct event_que *ev_que )
      */
     if ( ev_que->evUser->flowCtrlMode && ev_que->nDuplicates == 0u ) {
         UNLOCKEVQUE (ev_que);
-        return DB_EVENT_OK;
+        return EVENT_READ_DONE;
     }
 
-    while ( ev_que->evque[ev_que->getix] != EVENTQEMPTY ) {
-        struct evSubscrip *pevent = ev_que->evque[ev_que->getix];
+    while ( ev_que->evque[ev_que->getix].pevent != EVENTQEMPTY ) {
+        struct evSubscrip *pevent = ev_que->evque[ev_que->getix].pevent;
 
-        pfl = ev_que->valque[ev_que->getix];
+        pfl = ev_que->evque[ev_que->getix].pLog;
         if ( pevent == &canceledEvent ) {
-            ev_que->evque[ev_que->getix] = EVENTQEMPTY;
-            if (ev_que->valque[ev_que->getix]) {
-                db_delete_field_log(ev_que->valque[ev_que->getix]);
-                ev_que->valque[ev_que->getix] = NULL;
+            ev_que->evque[ev_que->getix].pevent = EVENTQEMPTY;
+            if (pfl) {
+                db_delete_field_log(pfl);
+                ev_que->evque[ev_que->getix].pLog = NULL;
             }
             ev_que->getix = RNGINC ( ev_que->getix );
             assert ( ev_que->nCanceled > 0 );
@@ -917,6 +1071,15 @@ static int event_read ( struct event_que *ev_que )
             continue;
         }
 
+        if ( *pBudget == 0 ) {
+            status = EVENT_READ_LIMITED;
+            break;
+        }
+        if ( higherClassWaiting ( ev_que ) ) {
+            status = EVENT_READ_PREEMPTED;
+            break;
+        }
+
         /*
          * Simple type values queued up for reliable interprocess
          * communication. (for other types they get whatever happens
@@ -925,6 +1088,9 @@ static int event_read ( struct event_que *ev_que )
 
         event_remove ( ev_que, ev_que->getix, EVENTQEMPTY );
         ev_que->getix = RNGINC ( ev_que->getix );
+        if ( *pBudget > 0 ) {
+            ( *pBudget )--;
+        }
 
         /*
          * create a local copy of the call back parameters while
@@ -957,7 +1123,8 @@ static int event_read ( struct event_que *ev_que )
             if (pfl) {
                 /* Issue user callback */
                 ( *user_sub ) ( pevent->user_arg, pevent->chan,
-                                ev_que->evque[ev_que->getix] != EVENTQEMPTY, pfl );
+                                ev_que->evque[ev_que->getix].pevent != EVENTQEMPTY &&
+                                *pBudget != 0, pfl );
             }
             LOCKEVQUE (ev_que);
 
@@ -986,7 +1153,86 @@ static int event_read ( struct event_que *ev_que )
 
     UNLOCKEVQUE (ev_que);
 
-    return DB_EVENT_OK;
+    return status;
+}
+
+/*
+ * Refill the token bucket of a rate limited class, which holds up to
+ * a tenth of a second of events, and at least one.
+ */
+static double class_tokens ( struct event_user *evUser, unsigned i,
+    double maxRate )
+{
+    epicsUInt64 now = epicsMonotonicGet ();
+    double burst = maxRate > 10.0 ? maxRate / 10.0 : 1.0;
+    double tokens = evUser->tokens[i] +
+        ( now - evUser->tokenTime[i] ) * 1e-9 * maxRate;
+
+    if ( evUser->tokenTime[i] == 0u || tokens > burst ) {
+        tokens = burst;
+    }
+    evUser->tokens[i] = tokens;
+    evUser->tokenTime[i] = now;
+    return tokens;
+}
+
+/*
+ * EVENT_DRAIN()
+ *
+ * Deliver the queued events, higher classes first and within the rate
+ * limits. Called with evUser->lock held. Returns the time until a rate
+ * limited class can deliver more, or zero if none is waiting for that.
+ */
+static double event_drain ( struct event_user *evUser )
+{
+    unsigned evClass = DB_EVENT_CLASS_HIGH;
+    double delay = 0.0;
+
+    while ( evClass <= DB_EVENT_NCLASSES ) {
+        const unsigned i = evClass - 1u;
+        const double maxRate = classMaxRate[i];
+        struct event_que * ev_que;
+        long allowed = -1, budget = -1;
+        int status = EVENT_READ_DONE, limited = FALSE;
+
+        epicsAtomicSetIntT ( &evUser->classWake[i], 0 );
+        if ( maxRate > 0.0 ) {
+            allowed = budget = (long) class_tokens ( evUser, i, maxRate );
+        }
+
+        for ( ev_que = &evUser->firstque; ev_que;
+                ev_que = ev_que->nextque ) {
+            if ( ev_que->evClass != evClass ) {
+                continue;
+            }
+            epicsMutexUnlock ( evUser->lock );
+            status = event_read ( ev_que, &budget );
+            epicsMutexMustLock ( evUser->lock );
+            if ( status == EVENT_READ_PREEMPTED ) {
+                break;
+            }
+            limited |= status == EVENT_READ_LIMITED;
+        }
+
+        if ( maxRate > 0.0 ) {
+            evUser->tokens[i] -= allowed - budget;
+            if ( limited ) {
+                double wait = ( 1.0 - evUser->tokens[i] ) / maxRate;
+
+                if ( delay == 0.0 || wait < delay ) {
+                    delay = wait;
+                }
+            }
+        }
+
+        if ( status == EVENT_READ_PREEMPTED ) {
+            evClass = DB_EVENT_CLASS_HIGH;
+        }
+        else {
+            evClass++;
+        }
+    }
+    return delay;
 }
 
 /*
@@ -997,6 +1243,7 @@ static void event_task (void *pParm)
     struct event_user * const evUser = (struct event_user *) pParm;
     struct event_que * ev_que;
     unsigned char pendexit;
+    double delay = 0.0;
 
     /* init hook */
     if (evUser->init_func) {
@@ -1008,7 +1255,14 @@ static void event_task (void *pParm)
     do {
         void (*pExtraLaborSub) (void *);
         void *pExtraLaborArg;
-        epicsEventMustWait(evUser->ppendsem);
+
+        if ( delay > 0.0 ) {
+            /* wake up to deliver more of a rate limited class */
+            epicsEventWaitWithTimeout ( evUser->ppendsem, delay );
+        }
+        else {
+            epicsEventMustWait(evUser->ppendsem);
+        }
 
         /*
          * check to see if the caller has offloaded
@@ -1032,12 +1286,7 @@ static void event_task (void *pParm)
         }
         evUser->extraLaborBusy = FALSE;
 
-        for ( ev_que = &evUser->firstque; ev_que;
-                ev_que = ev_que->nextque ) {
-            epicsMutexUnlock ( evUser->lock );
-            event_read (ev_que);
-            epicsMutexMustLock ( evUser->lock );
-        }
+        delay = event_drain ( evUser );
         pendexit = evUser->pendexit;
         epicsMutexUnlock ( evUser->lock );
 
@@ -1160,6 +1409,30 @@ void db_event_flow_ctrl_mode_off (dbEventCtx ctx)
 #endif
 }
 
+/*
+ * db_event_stats()
+ */
+void db_event_stats ( dbEventCtx ctx, dbEventStats *pstats )
+{
+    struct event_user * const evUser = (struct event_user *) ctx;
+    struct event_que *ev_que;
+
+    pstats->nQueued = 0u;
+    pstats->nSize = 0u;
+    pstats->nOverflow = 0u;
+
+    epicsMutexMustLock ( evUser->lock );
+    for ( ev_que = &evUser->firstque; ev_que; ev_que = ev_que->nextque ) {
+        LOCKEVQUE ( ev_que );
+        pstats->nQueued += EVENTQUESIZE - ringSpace ( ev_que );
+        pstats->nOverflow += ev_que->queovr;
+        UNLOCKEVQUE ( ev_que );
+        pstats->nSize += EVENTQUESIZE;
+    }
+    pstats->flowCtrlMode = evUser->flowCtrlMode;
+    epicsMutexUnlock ( evUser->lock );
+}
+
 /*
  * db_delete_field_log()
  */
@@ -20,6 +20,8 @@
 #ifndef INCLdbEventh
 #define INCLdbEventh
 
+#include <stddef.h>
+
 #ifdef epicsExportSharedSymbols
 #   undef epicsExportSharedSymbols
 #   define INCLdbEventhExporting
@@ -64,6 +66,15 @@ epicsShareFunc void db_flush_extra_labor_event (dbEventCtx);
 epicsShareFunc int db_post_extra_labor (dbEventCtx ctx);
 epicsShareFunc void db_event_change_priority ( dbEventCtx ctx, unsigned epicsPriority );
 
+/* the event queues of one context, for server diagnostics */
+typedef struct dbEventStats {
+    unsigned nQueued;           /* entries waiting to be delivered */
+    unsigned nSize;             /* entries the queues can hold */
+    size_t nOverflow;           /* events replaced because a queue was full */
+    int flowCtrlMode;           /* non-zero while flow control is on */
+} dbEventStats;
+epicsShareFunc void db_event_stats ( dbEventCtx ctx, dbEventStats *pstats );
+
 #ifdef EPICS_PRIVATE_API
 epicsShareFunc void db_cleanup_events(void);
 epicsShareFunc void db_init_event_freelists (void);
@@ -72,10 +83,29 @@ epicsShareFunc void db_init_event_freelists (void);
 typedef void EVENTFUNC (void *user_arg, struct dbChannel *chan,
     int eventsRemaining, struct db_field_log *pfl);
 
+/*
+ * Priority classes of subscriptions. The event task delivers the queued
+ * events of a higher class before those of a lower class, and may limit
+ * the rate at which it delivers each class, see db_event_class_rate().
+ */
+#define DB_EVENT_CLASS_DEFAULT  0u  /* set by the channel, else normal */
+#define DB_EVENT_CLASS_HIGH     1u
+#define DB_EVENT_CLASS_NORMAL   2u
+#define DB_EVENT_CLASS_LOW      3u
+#define DB_EVENT_NCLASSES       3u
+
 typedef void * dbEventSubscription;
 epicsShareFunc dbEventSubscription db_add_event (
     dbEventCtx ctx, struct dbChannel *chan,
     EVENTFUNC *user_sub, void *user_arg, unsigned select);
+epicsShareFunc dbEventSubscription db_add_event_class (
+    dbEventCtx ctx, struct dbChannel *chan,
+    EVENTFUNC *user_sub, void *user_arg, unsigned select, unsigned evClass);
+epicsShareFunc unsigned db_event_class (dbEventSubscription es);
+epicsShareFunc const char * db_event_class_name (unsigned evClass);
+/* max events per second each event task delivers of a class, 0 for no limit */
+epicsShareFunc int db_event_class_rate (unsigned evClass, double maxRate);
+epicsShareFunc int dbEventClassRate (const char *className, double maxRate);
 epicsShareFunc void db_cancel_event (dbEventSubscription es);
 epicsShareFunc void db_post_single_event (dbEventSubscription es);
 epicsShareFunc void db_event_enable (dbEventSubscription es);
@@ -18,8 +18,10 @@
 #include "dbEvent.h"
 #include "dbIocRegister.h"
 #include "dbJLink.h"
+#include "dbLatency.h"
 #include "dbLock.h"
 #include "dbNotify.h"
+#include "dbProfile.h"
 #include "dbScan.h"
 #include "dbServer.h"
 #include "dbState.h"
@@ -147,6 +149,21 @@ static void dbelCallFunc(const iocshArgBuf *args)
     dbel(args[0].sval, args[1].ival);
 }
 
+/* dbEventClassRate */
+static const iocshArg dbEventClassRateArg0 = { "class",iocshArgString};
+static const iocshArg dbEventClassRateArg1 = { "events/sec",iocshArgDouble};
+static const iocshArg * const dbEventClassRateArgs[2] =
+    {&dbEventClassRateArg0,&dbEventClassRateArg1};
+static const iocshFuncDef dbEventClassRateFuncDef = {"dbEventClassRate",2,
+    dbEventClassRateArgs,
+    "Limit the rate at which each event task delivers subscription updates\n"
+    "of a class (high, normal or low), 0 for no limit.\n"
+    "With no class, show the limits.\n"};
+static void dbEventClassRateCallFunc(const iocshArgBuf *args)
+{
+    dbEventClassRate(args[0].sval, args[1].dval);
+}
+
 /* dba */
 static const iocshArg dbaArg0 = { "record name",iocshArgString};
 static const iocshArg * const dbaArgs[1] = {&dbaArg0};
@@ -332,6 +349,51 @@ static const iocshFuncDef dbLockShowLockedFuncDef =
 static void dbLockShowLockedCallFunc(const iocshArgBuf *args)
 { dbLockShowLocked(args[0].ival);}
 
+/* dbProfileEnable */
+static const iocshArg dbProfileEnableArg0 = { "enable",iocshArgInt};
+static const iocshArg * const dbProfileEnableArgs[] = {&dbProfileEnableArg0};
+static const iocshFuncDef dbProfileEnableFuncDef = {"dbProfileEnable",1,dbProfileEnableArgs,
+                                                    "Enable (1) or disable (0) timing of record processing,\n"
+                                                    "lock set waits and links.  See dbProfileReport.\n"};
+static void dbProfileEnableCallFunc(const iocshArgBuf *args)
+{
+    dbProfileEnable(args[0].ival);
+}
+
+/* dbProfileReport */
+static const iocshArg dbProfileReportArg0 = { "count",iocshArgInt};
+static const iocshArg dbProfileReportArg1 = { "sort by",iocshArgString};
+static const iocshArg * const dbProfileReportArgs[] = {
+    &dbProfileReportArg0,&dbProfileReportArg1};
+static const iocshFuncDef dbProfileReportFuncDef = {"dbProfileReport",2,dbProfileReportArgs,
+                                                    "Print the records which took most time since profiling\n"
+                                                    "was enabled or reset.\n"
+                                                    "  count - number of records to print, 0 for all\n"
+                                                    "  sort by - time (default), self, max, count, lock or link\n"};
+static void dbProfileReportCallFunc(const iocshArgBuf *args)
+{
+    dbProfileReport(args[0].ival, args[1].sval);
+}
+
+/* dbProfileTypeReport */
+static const iocshArg dbProfileTypeReportArg0 = { "count",iocshArgInt};
+static const iocshArg * const dbProfileTypeReportArgs[] = {&dbProfileTypeReportArg0};
+static const iocshFuncDef dbProfileTypeReportFuncDef = {"dbProfileTypeReport",1,dbProfileTypeReportArgs,
+                                                        "Print the record types which took most time.\n"
+                                                        "  count - number of record types to print, 0 for all\n"};
+static void dbProfileTypeReportCallFunc(const iocshArgBuf *args)
+{
+    dbProfileTypeReport(args[0].ival);
+}
+
+/* dbProfileReset */
+static const iocshFuncDef dbProfileResetFuncDef = {"dbProfileReset",0,0,
+                                                   "Clear the profiling figures of every record.\n"};
+static void dbProfileResetCallFunc(const iocshArgBuf *args)
+{
+    dbProfileReset();
+}
+
 /* scanOnceSetQueueSize */
 static const iocshArg scanOnceSetQueueSizeArg0 = { "size",iocshArgInt};
 static const iocshArg * const scanOnceSetQueueSizeArgs[1] =
@@ -389,6 +451,30 @@ static const iocshFuncDef scanpiolFuncDef = {"scanpiol",0,0,
                                              "Print info for records with SCAN = \"I/O Intr\".\n"};
 static void scanpiolCallFunc(const iocshArgBuf *args) { scanpiol();}
 
+/* dbLatencyShow */
+static const iocshArg dbLatencyShowArg0 = { "pattern",iocshArgString};
+static const iocshArg dbLatencyShowArg1 = { "level",iocshArgInt};
+static const iocshArg * const dbLatencyShowArgs[] = {
+    &dbLatencyShowArg0,&dbLatencyShowArg1};
+static const iocshFuncDef dbLatencyShowFuncDef = {"dbLatencyShow",2,dbLatencyShowArgs,
+                                                  "Show latency histograms of the scan tasks and queues.\n"
+                                                  "  pattern - glob pattern of names, such as \"scan-*\" or \"cb*\"\n"
+                                                  "  level - 0 for a summary, 1 to add bucket counts\n"};
+static void dbLatencyShowCallFunc(const iocshArgBuf *args)
+{
+    dbLatencyShow(args[0].sval, args[1].ival);
+}
+
+/* dbLatencyReset */
+static const iocshArg dbLatencyResetArg0 = { "pattern",iocshArgString};
+static const iocshArg * const dbLatencyResetArgs[] = {&dbLatencyResetArg0};
+static const iocshFuncDef dbLatencyResetFuncDef = {"dbLatencyReset",1,dbLatencyResetArgs,
+                                                   "Clear latency histograms whose names match pattern.\n"};
+static void dbLatencyResetCallFunc(const iocshArgBuf *args)
+{
+    dbLatencyReset(args[0].sval);
+}
+
 /* callbackSetQueueSize */
 static const iocshArg callbackSetQueueSizeArg0 = { "bufsize",iocshArgInt};
 static const iocshArg * const callbackSetQueueSizeArgs[1] =
@@ -499,6 +585,7 @@ void dbIocRegister(void)
     iocshRegister(&dbsrFuncDef,dbsrCallFunc);
     iocshRegister(&dbcarFuncDef,dbcarCallFunc);
     iocshRegister(&dbelFuncDef,dbelCallFunc);
+    iocshRegister(&dbEventClassRateFuncDef,dbEventClassRateCallFunc);
     iocshRegister(&dbjlrFuncDef,dbjlrCallFunc);
 
     iocshRegister(&dbLoadDatabaseFuncDef,dbLoadDatabaseCallFunc);
@@ -526,6 +613,10 @@ void dbIocRegister(void)
     iocshRegister(&tpnFuncDef,tpnCallFunc);
     iocshRegister(&dblsrFuncDef,dblsrCallFunc);
     iocshRegister(&dbLockShowLockedFuncDef,dbLockShowLockedCallFunc);
+    iocshRegister(&dbProfileEnableFuncDef,dbProfileEnableCallFunc);
+    iocshRegister(&dbProfileReportFuncDef,dbProfileReportCallFunc);
+    iocshRegister(&dbProfileTypeReportFuncDef,dbProfileTypeReportCallFunc);
+    iocshRegister(&dbProfileResetFuncDef,dbProfileResetCallFunc);
 
     iocshRegister(&scanOnceSetQueueSizeFuncDef,scanOnceSetQueueSizeCallFunc);
     iocshRegister(&scanOnceQueueShowFuncDef,scanOnceQueueShowCallFunc);
@@ -533,6 +624,8 @@ void dbIocRegister(void)
     iocshRegister(&scanpelFuncDef,scanpelCallFunc);
     iocshRegister(&postEventFuncDef,postEventCallFunc);
     iocshRegister(&scanpiolFuncDef,scanpiolCallFunc);
+    iocshRegister(&dbLatencyShowFuncDef,dbLatencyShowCallFunc);
+    iocshRegister(&dbLatencyResetFuncDef,dbLatencyResetCallFunc);
 
     iocshRegister(&callbackSetQueueSizeFuncDef,callbackSetQueueSizeCallFunc);
     iocshRegister(&callbackQueueShowFuncDef,callbackQueueShowCallFunc);
@@ -0,0 +1,191 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Latency histograms of the scan tasks and queues, see dbLatency.h
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ellLib.h"
+#include "epicsAtomic.h"
+#include "epicsMutex.h"
+#include "epicsStdio.h"
+#include "epicsString.h"
+#include "epicsThread.h"
+
+#define epicsExportSharedSymbols
+#include "dbLatency.h"
+
+static ELLLIST histList = ELLLIST_INIT;
+static epicsMutexId histLock;
+
+static void histOnce(void *arg)
+{
+    histLock = epicsMutexMustCreate();
+}
+
+static void histInit(void)
+{
+    static epicsThreadOnceId onceId = EPICS_THREAD_ONCE_INIT;
+
+    epicsThreadOnce(&onceId, histOnce, NULL);
+}
+
+static void histReset(dbLatencyHist *phist)
+{
+    int i;
+
+    epicsAtomicSetSizeT(&phist->count, 0);
+    epicsAtomicSetSizeT(&phist->total, 0);
+    epicsAtomicSetSizeT(&phist->max, 0);
+    for (i = 0; i < DB_LATENCY_BUCKETS; i++)
+        epicsAtomicSetSizeT(&phist->bucket[i], 0);
+}
+
+void dbLatencyRegister(dbLatencyHist *phist, const char *name)
+{
+    histInit();
+    histReset(phist);
+    phist->name = name;
+    epicsMutexMustLock(histLock);
+    ellAdd(&histList, &phist->node);
+    epicsMutexUnlock(histLock);
+}
+
+void dbLatencyUnregister(dbLatencyHist *phist)
+{
+    histInit();
+    epicsMutexMustLock(histLock);
+    ellDelete(&histList, &phist->node);
+    epicsMutexUnlock(histLock);
+}
+
+dbLatencyHist * dbLatencyFind(const char *name)
+{
+    dbLatencyHist *phist;
+
+    histInit();
+    epicsMutexMustLock(histLock);
+    for (phist = (dbLatencyHist *)ellFirst(&histList); phist;
+         phist = (dbLatencyHist *)ellNext(&phist->node)) {
+        if (strcmp(phist->name, name) == 0)
+            break;
+    }
+    epicsMutexUnlock(histLock);
+    return phist;
+}
+
+void dbLatencyAdd(dbLatencyHist *phist, epicsUInt64 ns)
+{
+    size_t us = (size_t)(ns / 1000);
+    size_t max = epicsAtomicGetSizeT(&phist->max);
+    size_t width = us;
+    int i = 0;
+
+    while (width && i < DB_LATENCY_BUCKETS - 1) {
+        width >>= 1;
+        i++;
+    }
+    epicsAtomicIncrSizeT(&phist->bucket[i]);
+    epicsAtomicAddSizeT(&phist->total, us);
+    epicsAtomicIncrSizeT(&phist->count);
+
+    while (us > max) {
+        size_t prev = epicsAtomicCmpAndSwapSizeT(&phist->max, max, us);
+
+        if (prev == max)
+            break;
+        max = prev;
+    }
+}
+
+double dbLatencyPercentile(const dbLatencyHist *phist, double fraction)
+{
+    size_t count = epicsAtomicGetSizeT(&phist->count);
+    size_t max = epicsAtomicGetSizeT(&phist->max);
+    double target = fraction * count;
+    double sum = 0.0;
+    int i;
+
+    if (!count)
+        return 0.0;
+
+    for (i = 0; i < DB_LATENCY_BUCKETS - 1; i++) {
+        sum += epicsAtomicGetSizeT(&phist->bucket[i]);
+        if (sum >= target) {
+            size_t limit = (size_t)1 << i;
+
+            return (limit < max ? limit : max) * 1e-6;
+        }
+    }
+    return max * 1e-6;
+}
+
+void dbLatencyReset(const char *pattern)
+{
+    dbLatencyHist *phist;
+
+    histInit();
+    epicsMutexMustLock(histLock);
+    for (phist = (dbLatencyHist *)ellFirst(&histList); phist;
+         phist = (dbLatencyHist *)ellNext(&phist->node)) {
+        if (!pattern || !*pattern || epicsStrGlobMatch(phist->name, pattern))
+            histReset(phist);
+    }
+    epicsMutexUnlock(histLock);
+}
+
+static void histShow(const dbLatencyHist *phist, int level)
+{
+    size_t count = epicsAtomicGetSizeT(&phist->count);
+    size_t total = epicsAtomicGetSizeT(&phist->total);
+    int i;
+
+    printf("%-18s %10lu %10.1f %10.0f %10.0f %10lu\n", phist->name,
+        (unsigned long)count, count ? (double)total / count : 0.0,
+        dbLatencyPercentile(phist, 0.5) * 1e6,
+        dbLatencyPercentile(phist, 0.99) * 1e6,
+        (unsigned long)epicsAtomicGetSizeT(&phist->max));
+
+    if (level < 1)
+        return;
+
+    for (i = 0; i < DB_LATENCY_BUCKETS; i++) {
+        size_t n = epicsAtomicGetSizeT(&phist->bucket[i]);
+
+        if (!n)
+            continue;
+        if (i == 0)
+            printf("    %10s %10s us %10lu\n", "", "< 1",
+                (unsigned long)n);
+        else if (i < DB_LATENCY_BUCKETS - 1)
+            printf("    %10lu %10lu us %10lu\n",
+                (unsigned long)1 << (i - 1), (unsigned long)1 << i,
+                (unsigned long)n);
+        else
+            printf("    %10lu %10s us %10lu\n",
+                (unsigned long)1 << (i - 1), "and more", (unsigned long)n);
+    }
+}
+
+void dbLatencyShow(const char *pattern, int level)
+{
+    dbLatencyHist *phist;
+
+    histInit();
+    printf("%-18s %10s %10s %10s %10s %10s\n", "NAME", "COUNT",
+        "MEAN us", "50% us", "99% us", "MAX us");
+    epicsMutexMustLock(histLock);
+    for (phist = (dbLatencyHist *)ellFirst(&histList); phist;
+         phist = (dbLatencyHist *)ellNext(&phist->node)) {
+        if (!pattern || !*pattern || epicsStrGlobMatch(phist->name, pattern))
+            histShow(phist, level);
+    }
+    epicsMutexUnlock(histLock);
+}
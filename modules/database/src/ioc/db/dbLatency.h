@@ -0,0 +1,114 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#ifndef INCdbLatencyH
+#define INCdbLatencyH
+
+#include <stddef.h>
+
+#include "ellLib.h"
+#include "epicsTypes.h"
+#include "shareLib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file dbLatency.h
+ * @brief Latency histograms of the scan tasks and queues
+ *
+ * The scan and callback code keeps a histogram of each of these delays,
+ * named as shown:
+ *
+ * - "scan-<period>-wake" how late a periodic scan task woke up, and
+ *   "scan-<period>-exec" how long it took to process its scan list.
+ * - "scanOnce" the delay from scanOnce() to processing by the scanOnce task.
+ * - "cbLow", "cbMedium" and "cbHigh" the delay from callbackRequest() until
+ *   a callback task runs the callback.
+ * - "ioLow", "ioMedium" and "ioHigh" the delay from scanIoRequest() until
+ *   the I/O Intr scan list of that priority is processed.
+ *
+ * The counters are updated with atomic operations and read without any
+ * locking, so a histogram which is being updated may be slightly
+ * inconsistent. Times are held in microseconds, in buckets which double in
+ * width so bucket 0 counts times under 1us, bucket N counts times from
+ * 2^(N-1) to 2^N us, and the last bucket counts everything longer.
+ *
+ * A subset of this API is provided as IOC Shell commands, and the "Db
+ * Latency" device support reads the figures into ai records.
+ */
+
+#define DB_LATENCY_BUCKETS 24
+
+/** @brief A latency histogram */
+typedef struct dbLatencyHist {
+    ELLNODE node;
+    const char *name;
+    /** Number of times recorded */
+    size_t count;
+    /** Sum and maximum of the times, in microseconds */
+    size_t total;
+    size_t max;
+    size_t bucket[DB_LATENCY_BUCKETS];
+} dbLatencyHist;
+
+/** @brief Make a histogram visible to dbLatencyFind() and the reports.
+ *
+ * @param phist The histogram, which is cleared.
+ * @param name The name, which is not copied.
+ */
+epicsShareFunc void dbLatencyRegister(dbLatencyHist *phist, const char *name);
+
+/** @brief Remove a histogram added by dbLatencyRegister(). */
+epicsShareFunc void dbLatencyUnregister(dbLatencyHist *phist);
+
+/** @brief Find a histogram by name.
+ *
+ * @return The histogram, or NULL if there is no histogram of that name.
+ */
+epicsShareFunc dbLatencyHist * dbLatencyFind(const char *name);
+
+/** @brief Record one time.
+ *
+ * May be called by several threads at once.
+ *
+ * @param phist The histogram.
+ * @param ns The time in nanoseconds.
+ */
+epicsShareFunc void dbLatencyAdd(dbLatencyHist *phist, epicsUInt64 ns);
+
+/** @brief Estimate a percentile from the buckets.
+ *
+ * @param phist The histogram.
+ * @param fraction 0.5 for the median, 0.99 for the 99th percentile etc.
+ * @return The upper bound of the bucket which holds that percentile,
+ * limited to the maximum, in seconds.
+ */
+epicsShareFunc double dbLatencyPercentile(const dbLatencyHist *phist,
+    double fraction);
+
+/** @brief Clear the histograms whose names match a pattern.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ *
+ * @param pattern Glob pattern, NULL or "" for all.
+ */
+epicsShareFunc void dbLatencyReset(const char *pattern);
+
+/** @brief Print the histograms whose names match a pattern.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ *
+ * @param pattern Glob pattern, NULL or "" for all.
+ * @param level 0 for a summary line each, 1 to add the bucket counts.
+ */
+epicsShareFunc void dbLatencyShow(const char *pattern, int level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCdbLatencyH */
@@ -34,6 +34,7 @@
 #include "dbBase.h"
 #include "dbCa.h"
 #include "dbCommon.h"
+#include "dbCommonPvt.h"
 #include "dbConstLink.h"
 #include "dbDbLink.h"
 #include "db_field_log.h"
@@ -318,6 +319,7 @@ long dbGetLink(struct link *plink, short dbrType, void *pbuffer,
         long *poptions, long *pnRequest)
 {
     struct dbCommon *precord = plink->precord;
+    epicsUInt64 begin = dbProfileEnabled ? epicsMonotonicGet() : 0;
     long status;
 
     if (poptions && *poptions) {
@@ -326,6 +328,8 @@ long dbGetLink(struct link *plink, short dbrType, void *pbuffer,
     }
 
     status = dbTryGetLink(plink, dbrType, pbuffer, pnRequest);
+    if (begin)
+        dbProfileAddLink(precord, begin);
     if (status == S_db_noLSET)
         return -1;
     if (status)
@@ -410,12 +414,16 @@ long dbPutLink(struct link *plink, short dbrType, const void *pbuffer,
         long nRequest)
 {
     lset *plset = plink->lset;
+    epicsUInt64 begin;
     long status;
 
     if (!plset || !plset->putValue)
         return S_db_noLSET;
 
+    begin = dbProfileEnabled ? epicsMonotonicGet() : 0;
     status = plset->putValue(plink, dbrType, pbuffer, nRequest);
+    if (begin)
+        dbProfileAddLink(plink->precord, begin);
     if (status) {
         struct dbCommon *precord = plink->precord;
 
@@ -427,9 +435,13 @@ long dbPutLink(struct link *plink, short dbrType, const void *pbuffer,
 void dbLinkAsyncComplete(struct link *plink)
 {
     dbCommon *pdbCommon = plink->precord;
+    epicsUInt64 begin;
 
     dbScanLock(pdbCommon);
+    begin = dbProfileEnabled ? epicsMonotonicGet() : 0;
     pdbCommon->rset->process(pdbCommon);
+    if (begin)
+        dbProfileAddProcess(pdbCommon, begin, 0);
     dbScanUnlock(pdbCommon);
 }
 
@@ -437,12 +449,16 @@ long dbPutLinkAsync(struct link *plink, short dbrType, const void *pbuffer,
         long nRequest)
 {
     lset *plset = plink->lset;
+    epicsUInt64 begin;
     long status;
 
     if (!plset || !plset->putAsync)
         return S_db_noLSET;
 
+    begin = dbProfileEnabled ? epicsMonotonicGet() : 0;
     status = plset->putAsync(plink, dbrType, pbuffer, nRequest);
+    if (begin)
+        dbProfileAddLink(plink->precord, begin);
     if (status) {
         struct dbCommon *precord = plink->precord;
 
@@ -455,8 +471,13 @@ void dbScanFwdLink(struct link *plink)
 {
     lset *plset = plink->lset;
 
-    if (plset && plset->scanForward)
+    if (plset && plset->scanForward) {
+        epicsUInt64 begin = dbProfileEnabled ? epicsMonotonicGet() : 0;
+
         plset->scanForward(plink);
+        if (begin)
+            dbProfileAddLink(plink->precord, begin);
+    }
 }
 
 long dbLinkDoLocked(struct link *plink, dbLinkUserCallback rtn,
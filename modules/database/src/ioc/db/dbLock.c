@@ -31,6 +31,7 @@
 #include "dbBase.h"
 #include "dbLink.h"
 #include "dbCommon.h"
+#include "dbCommonPvt.h"
 #include "dbFldTypes.h"
 #include "dbLockPvt.h"
 #include "dbStaticLib.h"
@@ -189,6 +190,8 @@ void dbScanLock(dbCommon *precord)
     int cnt;
     lockRecord * const lr = precord->lset;
     lockSet *ls;
+    int profile = dbProfileEnabled;
+    epicsUInt64 wait = 0;
 
     assert(lr);
 
@@ -196,7 +199,15 @@ void dbScanLock(dbCommon *precord)
     assert(epicsAtomicGetIntT(&ls->refcount)>0);
 
 retry:
-    epicsMutexMustLock(ls->lock);
+    if (!profile) {
+        epicsMutexMustLock(ls->lock);
+    }
+    else if (epicsMutexTryLock(ls->lock) != epicsMutexLockOK) {
+        epicsUInt64 begin = epicsMonotonicGet();
+
+        epicsMutexMustLock(ls->lock);
+        wait += epicsMonotonicGet() - begin;
+    }
 
     epicsSpinLock(lr->spin);
     if(ls!=lr->plockSet) {
@@ -216,6 +227,9 @@ retry:
     }
     epicsSpinUnlock(lr->spin);
 
+    if (wait)
+        dbRec2Pvt(precord)->prof.lockWait += wait;
+
     /* Release reference taken within this
      * function.  The count will *never* fall to zero
      * as the lockRecords can't be changed while
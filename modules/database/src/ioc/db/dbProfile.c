@@ -0,0 +1,261 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Reports of the per-record processing time accounting done by
+ *  dbProcess(), dbScanLock() and the link routines, see dbProfile.h
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "epicsStdio.h"
+#include "epicsString.h"
+
+#define epicsExportSharedSymbols
+#include "dbAccessDefs.h"
+#include "dbBase.h"
+#include "dbCommonPvt.h"
+#include "dbProfile.h"
+#include "dbStaticLib.h"
+
+int dbProfileEnabled;
+
+typedef struct profileEntry {
+    const char *name;
+    const char *type;
+    unsigned nRecords;
+    dbProfileStats stats;
+} profileEntry;
+
+typedef int (*profileCompare)(const void *, const void *);
+
+#define PROFILE_COMPARE(NAME, EXPR) \
+static int NAME(const void *pa, const void *pb) \
+{ \
+    const dbProfileStats *a = &((const profileEntry *) pa)->stats; \
+    const dbProfileStats *b = &((const profileEntry *) pb)->stats; \
+    epicsUInt64 va = EXPR(a), vb = EXPR(b); \
+    return va < vb ? 1 : va > vb ? -1 : 0; \
+}
+
+#define TIME(p) ((p)->processTime)
+#define SELF(p) (selfTime(p))
+#define MAX(p) ((p)->processMax)
+#define COUNT(p) ((p)->nProcess)
+#define LOCK(p) ((p)->lockWait)
+#define LINK(p) ((p)->linkTime)
+
+/* the figures are read unlocked, so the link time may be ahead */
+static epicsUInt64 selfTime(const dbProfileStats *pstats)
+{
+    return pstats->processTime > pstats->linkTime ?
+        pstats->processTime - pstats->linkTime : 0;
+}
+
+PROFILE_COMPARE(compareTime, TIME)
+PROFILE_COMPARE(compareSelf, SELF)
+PROFILE_COMPARE(compareMax, MAX)
+PROFILE_COMPARE(compareCount, COUNT)
+PROFILE_COMPARE(compareLock, LOCK)
+PROFILE_COMPARE(compareLink, LINK)
+
+static const struct {
+    const char *name;
+    profileCompare compare;
+} sortKeys[] = {
+    {"time", compareTime},
+    {"self", compareSelf},
+    {"max", compareMax},
+    {"count", compareCount},
+    {"lock", compareLock},
+    {"link", compareLink},
+};
+
+void dbProfileEnable(int enable)
+{
+    dbProfileEnabled = enable;
+}
+
+int dbProfileIsEnabled(void)
+{
+    return dbProfileEnabled;
+}
+
+void dbProfileGet(struct dbCommon *prec, dbProfileStats *pstats)
+{
+    *pstats = dbRec2Pvt(prec)->prof;
+}
+
+static void addStats(dbProfileStats *ptotal, const dbProfileStats *pstats)
+{
+    ptotal->nProcess += pstats->nProcess;
+    ptotal->processTime += pstats->processTime;
+    if (pstats->processMax > ptotal->processMax)
+        ptotal->processMax = pstats->processMax;
+    ptotal->lockWait += pstats->lockWait;
+    ptotal->linkTime += pstats->linkTime;
+}
+
+/* Collect an entry for each record, or for each record type */
+static profileEntry * collect(int byType, unsigned *pcount)
+{
+    DBENTRY dbentry;
+    long status;
+    unsigned n = 0, nalloc = 0;
+    profileEntry *pentries = NULL;
+
+    if (!pdbbase) {
+        *pcount = 0;
+        return NULL;
+    }
+
+    dbInitEntry(pdbbase, &dbentry);
+    for (status = dbFirstRecordType(&dbentry); !status;
+         status = dbNextRecordType(&dbentry)) {
+        long rstatus;
+        int first = 1;
+
+        for (rstatus = dbFirstRecord(&dbentry); !rstatus;
+             rstatus = dbNextRecord(&dbentry)) {
+            struct dbCommon *prec = dbentry.precnode->precord;
+            dbProfileStats stats;
+
+            if (dbIsAlias(&dbentry) || !prec)
+                continue;
+            dbProfileGet(prec, &stats);
+            if (!stats.nProcess && !stats.processTime && !stats.lockWait)
+                continue;
+            if (first || !byType) {
+                if (n == nalloc) {
+                    profileEntry *pnew;
+
+                    nalloc = nalloc ? 2 * nalloc : 64;
+                    pnew = realloc(pentries, nalloc * sizeof(*pentries));
+                    if (!pnew) {
+                        free(pentries);
+                        dbFinishEntry(&dbentry);
+                        *pcount = 0;
+                        return NULL;
+                    }
+                    pentries = pnew;
+                }
+                memset(&pentries[n], 0, sizeof(*pentries));
+                pentries[n].name = prec->name;
+                pentries[n].type = dbGetRecordTypeName(&dbentry);
+                n++;
+                first = 0;
+            }
+            pentries[n - 1].nRecords++;
+            addStats(&pentries[n - 1].stats, &stats);
+        }
+    }
+    dbFinishEntry(&dbentry);
+    *pcount = n;
+    return pentries;
+}
+
+static void printEntries(profileEntry *pentries, unsigned n, unsigned count,
+    int byType)
+{
+    unsigned i;
+
+    if (count == 0 || count > n)
+        count = n;
+
+    printf("%10s %10s %10s %9s %9s %9s %9s  %s\n",
+        "count", "total ms", "self ms", "mean us", "max us",
+        "lock ms", "link ms", byType ? "record type (records)" : "record (type)");
+    for (i = 0; i < count; i++) {
+        const profileEntry *pentry = &pentries[i];
+        const dbProfileStats *p = &pentry->stats;
+
+        printf("%10llu %10.3f %10.3f %9.1f %9.1f %9.3f %9.3f  ",
+            (unsigned long long) p->nProcess,
+            p->processTime * 1e-6, selfTime(p) * 1e-6,
+            p->nProcess ? p->processTime * 1e-3 / p->nProcess : 0.0,
+            p->processMax * 1e-3, p->lockWait * 1e-6, p->linkTime * 1e-6);
+        if (byType)
+            printf("%s (%u)\n", pentry->type, pentry->nRecords);
+        else
+            printf("%s (%s)\n", pentry->name, pentry->type);
+    }
+}
+
+void dbProfileReport(unsigned count, const char *sortBy)
+{
+    profileCompare compare = compareTime;
+    profileEntry *pentries;
+    unsigned n, i;
+
+    if (sortBy && *sortBy) {
+        for (i = 0; i < NELEMENTS(sortKeys); i++) {
+            if (epicsStrCaseCmp(sortBy, sortKeys[i].name) == 0)
+                break;
+        }
+        if (i == NELEMENTS(sortKeys)) {
+            printf("dbProfileReport: sort by one of time, self, max, "
+                "count, lock or link\n");
+            return;
+        }
+        compare = sortKeys[i].compare;
+    }
+
+    if (!dbProfileEnabled)
+        printf("Profiling is disabled, see dbProfileEnable\n");
+    pentries = collect(0, &n);
+    if (!pentries) {
+        if (n)
+            printf("dbProfileReport: out of memory\n");
+        return;
+    }
+    qsort(pentries, n, sizeof(*pentries), compare);
+    printEntries(pentries, n, count, 0);
+    free(pentries);
+}
+
+void dbProfileTypeReport(unsigned count)
+{
+    profileEntry *pentries;
+    unsigned n;
+
+    if (!dbProfileEnabled)
+        printf("Profiling is disabled, see dbProfileEnable\n");
+    pentries = collect(1, &n);
+    if (!pentries)
+        return;
+    qsort(pentries, n, sizeof(*pentries), compareTime);
+    printEntries(pentries, n, count, 1);
+    free(pentries);
+}
+
+void dbProfileReset(void)
+{
+    DBENTRY dbentry;
+    long status;
+
+    if (!pdbbase)
+        return;
+
+    /* the records may be processing, so this is approximate */
+    dbInitEntry(pdbbase, &dbentry);
+    for (status = dbFirstRecordType(&dbentry); !status;
+         status = dbNextRecordType(&dbentry)) {
+        long rstatus;
+
+        for (rstatus = dbFirstRecord(&dbentry); !rstatus;
+             rstatus = dbNextRecord(&dbentry)) {
+            struct dbCommon *prec = dbentry.precnode->precord;
+
+            if (dbIsAlias(&dbentry) || !prec)
+                continue;
+            memset(&dbRec2Pvt(prec)->prof, 0, sizeof(dbProfileStats));
+        }
+    }
+    dbFinishEntry(&dbentry);
+}
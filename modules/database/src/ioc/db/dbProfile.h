@@ -0,0 +1,99 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#ifndef INCdbProfileH
+#define INCdbProfileH
+
+#include "epicsTypes.h"
+#include "shareLib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file dbProfile.h
+ * @brief Per-record processing time accounting
+ *
+ * When enabled, dbProcess() times each record it processes, dbScanLock()
+ * times waits for a lock set which is held by another thread, and the
+ * link routines time each link which a record reads, writes or forward
+ * links through. The process time of a record includes the time spent in
+ * its links, which may process other records, so the time spent in the
+ * record itself is the process time less the link time. The second phase
+ * of asynchronous processing is timed but not counted again.
+ *
+ * The figures are kept with each record and are only changed while the
+ * record is locked, so they are read without locking and may be
+ * slightly inconsistent. They are disabled by default.
+ *
+ * A subset of this API is provided as IOC Shell commands, and the "Db
+ * Profile" device support reads the figures into ai records.
+ */
+
+struct dbCommon;
+
+/** @brief The figures kept for each record, all times in nanoseconds.
+ */
+typedef struct dbProfileStats {
+    /** Number of times dbProcess() was called on the record */
+    epicsUInt64 nProcess;
+    /** Total and longest time in dbProcess(), including links */
+    epicsUInt64 processTime;
+    epicsUInt64 processMax;
+    /** Total time dbScanLock() waited for the record's lock set */
+    epicsUInt64 lockWait;
+    /** Total time spent in the record's links */
+    epicsUInt64 linkTime;
+} dbProfileStats;
+
+/** @brief Enable or disable profiling.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ *
+ * @param enable Non-zero to enable.
+ */
+epicsShareFunc void dbProfileEnable(int enable);
+
+/** @brief Returns non-zero if profiling is enabled. */
+epicsShareFunc int dbProfileIsEnabled(void);
+
+/** @brief Fetch the figures for one record.
+ *
+ * @param prec The record.
+ * @param pstats Receives the figures.
+ */
+epicsShareFunc void dbProfileGet(struct dbCommon *prec, dbProfileStats *pstats);
+
+/** @brief Print the records which took most time.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ *
+ * @param count Number of records to print, or 0 for all which have been
+ * processed.
+ * @param sortBy Column to sort by, one of "time" (the default), "self",
+ * "max", "count", "lock" or "link".
+ */
+epicsShareFunc void dbProfileReport(unsigned count, const char *sortBy);
+
+/** @brief Print the record types which took most time.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ *
+ * @param count Number of record types to print, or 0 for all.
+ */
+epicsShareFunc void dbProfileTypeReport(unsigned count);
+
+/** @brief Clear the figures of every record.
+ *
+ * <em>Also provided as an IOC Shell command.</em>
+ */
+epicsShareFunc void dbProfileReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCdbProfileH */
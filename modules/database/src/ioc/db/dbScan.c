@@ -44,6 +44,7 @@
 #include "dbBase.h"
 #include "dbCommon.h"
 #include "dbFldTypes.h"
+#include "dbLatency.h"
 #include "dbLock.h"
 #include "dbScan.h"
 #include "dbStaticLib.h"
@@ -68,6 +69,7 @@ static epicsRingBytesId onceQ;
 static int onceQOverruns = 0;
 static epicsThreadId onceTaskId;
 static void *exitOnce;
+static dbLatencyHist onceLatency;
 
 
 /* All other scan types */
@@ -95,6 +97,10 @@ typedef struct periodic_scan_list {
     unsigned long       overruns;
     volatile enum ctl   scanCtl;
     epicsEventId        loopEvent;
+    dbLatencyHist       wakeLatency;
+    dbLatencyHist       execTime;
+    char                wakeName[32];
+    char                execName[32];
 } periodic_scan_list;
 
 static int nPeriodic = 0;
@@ -123,6 +129,7 @@ static epicsMutexId event_lock;
 typedef struct io_scan_list {
     epicsCallback callback;
     scan_list scan_list;
+    size_t requested;   /* monotonic time in us, 0 if no request pending */
 } io_scan_list;
 
 typedef struct ioscan_head {
@@ -134,6 +141,10 @@ typedef struct ioscan_head {
 
 static ioscan_head *pioscan_list = NULL;
 static epicsMutexId ioscan_lock;
+static dbLatencyHist ioscanLatency[NUM_CALLBACK_PRIORITIES];
+static char *ioscanLatencyName[NUM_CALLBACK_PRIORITIES] = {
+    "ioLow", "ioMedium", "ioHigh"
+};
 
 /* Private routines */
 static void onceTask(void *);
@@ -176,11 +187,15 @@ void scanStop(void)
 
 void scanCleanup(void)
 {
+    int prio;
 
     deletePeriodic();
     ioscanDestroy();
 
     epicsRingBytesDelete(onceQ);
+    dbLatencyUnregister(&onceLatency);
+    for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++)
+        dbLatencyUnregister(&ioscanLatency[prio]);
 
     free(periodicTaskId);
     papPeriodic = NULL;
@@ -197,6 +212,8 @@ long scanInit(void)
 
     initPeriodic();
     initOnce();
+    for (i = 0; i < NUM_CALLBACK_PRIORITIES; i++)
+        dbLatencyRegister(&ioscanLatency[i], ioscanLatencyName[i]);
     buildScanLists();
     for (i = 0; i < nPeriodic; i++)
         spawnPeriodic(i);
@@ -610,16 +627,21 @@ unsigned int scanIoRequest(IOSCANPVT piosh)
 {
     int prio;
     unsigned int queued = 0;
+    size_t now;
 
     if (scanCtl != ctlRun)
         return 0;
 
+    now = (size_t)(epicsMonotonicGet() / 1000) | 1;
     for (prio = 0; prio < NUM_CALLBACK_PRIORITIES; prio++) {
         io_scan_list *piosl = &piosh->iosl[prio];
 
-        if (ellCount(&piosl->scan_list.list) > 0)
+        if (ellCount(&piosl->scan_list.list) > 0) {
+            /* Keep the time of the oldest request which is not served */
+            epicsAtomicCmpAndSwapSizeT(&piosl->requested, 0, now);
             if (!callbackRequest(&piosl->callback))
                 queued |= 1 << prio;
+        }
     }
 
     return queued;
@@ -662,6 +684,7 @@ typedef struct {
     struct dbCommon *prec;
     once_complete cb;
     void *usr;
+    epicsUInt64 queued;
 } onceEntry;
 
 int scanOnceCallback(struct dbCommon *precord, once_complete cb, void *usr)
@@ -673,6 +696,7 @@ int scanOnceCallback(struct dbCommon *precord, once_complete cb, void *usr)
     ent.prec = precord;
     ent.cb = cb;
     ent.usr = usr;
+    ent.queued = epicsMonotonicGet();
 
     pushOK = epicsRingBytesPut(onceQ, (void*)&ent, sizeof(ent));
 
@@ -707,6 +731,7 @@ static void onceTask(void *arg)
                 continue; /* what to do? */
             } else if (ent.prec == (void*)&exitOnce) goto shutdown;
 
+            dbLatencyAdd(&onceLatency, epicsMonotonicGet() - ent.queued);
             dbScanLock(ent.prec);
             dbProcess(ent.prec);
             dbScanUnlock(ent.prec);
@@ -767,6 +792,7 @@ static void initOnce(void)
     }
     if(!onceSem)
         onceSem = epicsEventMustCreate(epicsEventEmpty);
+    dbLatencyRegister(&onceLatency, "scanOnce");
     onceTaskId = epicsThreadCreate("scanOnce",
         epicsThreadPriorityScanLow + nPeriodic,
         epicsThreadGetStackSize(epicsThreadStackBig), onceTask, 0);
@@ -795,8 +821,12 @@ static void periodicTask(void *arg)
         double delay;
         epicsTimeStamp now;
 
-        if (ppsl->scanCtl == ctlRun)
+        if (ppsl->scanCtl == ctlRun) {
+            epicsUInt64 begin = epicsMonotonicGet();
+
             scanList(&ppsl->scan_list);
+            dbLatencyAdd(&ppsl->execTime, epicsMonotonicGet() - begin);
+        }
 
         epicsTimeAddSeconds(&next, ppsl->period);
         epicsTimeGetMonotonic(&now);
@@ -839,6 +869,15 @@ static void periodicTask(void *arg)
         }
 
         epicsEventWaitWithTimeout(ppsl->loopEvent, delay);
+
+        if (ppsl->scanCtl == ctlRun) {
+            epicsTimeGetMonotonic(&now);
+            delay = epicsTimeDiffInSeconds(&now, &next);
+            if (delay > 0.0)
+                dbLatencyAdd(&ppsl->wakeLatency, (epicsUInt64)(delay * 1e9));
+            else
+                dbLatencyAdd(&ppsl->wakeLatency, 0);
+        }
     }
 
     taskwdRemove(0);
@@ -899,6 +938,10 @@ static void initPeriodic(void)
         ppsl->name = choice;
         ppsl->scanCtl = ctlPause;
         ppsl->loopEvent = epicsEventMustCreate(epicsEventEmpty);
+        sprintf(ppsl->wakeName, "scan-%g-wake", ppsl->period);
+        sprintf(ppsl->execName, "scan-%g-exec", ppsl->period);
+        dbLatencyRegister(&ppsl->wakeLatency, ppsl->wakeName);
+        dbLatencyRegister(&ppsl->execTime, ppsl->execName);
 
         number = ppsl->period / quantum;
         if ((ppsl->period < 2 * quantum) ||
@@ -919,6 +962,8 @@ static void deletePeriodic(void)
         periodic_scan_list *ppsl = papPeriodic[i];
 
         if (!ppsl) continue;
+        dbLatencyUnregister(&ppsl->wakeLatency);
+        dbLatencyUnregister(&ppsl->execTime);
         ellFree(&ppsl->scan_list.list);
         epicsEventDestroy(ppsl->loopEvent);
         epicsMutexDestroy(ppsl->scan_list.lock);
@@ -948,11 +993,24 @@ static void spawnPeriodic(int ind)
 static void ioscanCallback(epicsCallback *pcallback)
 {
     ioscan_head *piosh;
+    io_scan_list *piosl;
+    size_t requested;
     int prio;
 
     callbackGetUser(piosh, pcallback);
     callbackGetPriority(prio, pcallback);
-    scanList(&piosh->iosl[prio].scan_list);
+    piosl = &piosh->iosl[prio];
+    /* Take the request time and clear it in one step, so that only one
+     * callback records the latency of each request */
+    do {
+        requested = epicsAtomicGetSizeT(&piosl->requested);
+    } while (requested &&
+        epicsAtomicCmpAndSwapSizeT(&piosl->requested, requested, 0) != requested);
+    if (requested) {
+        dbLatencyAdd(&ioscanLatency[prio],
+            ((size_t)(epicsMonotonicGet() / 1000) - requested) * 1000ull);
+    }
+    scanList(&piosl->scan_list);
     if (piosh->cb)
         piosh->cb(piosh->arg, piosh, prio);
 }
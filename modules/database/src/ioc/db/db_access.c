@@ -1010,6 +1010,55 @@ static int mapOldType (short oldtype)
     return dbrType;
 }
 
+/* Requests are passed to dbPutFieldMany() in runs of at most this many */
+#define PUT_MANY_RUN 64
+
+int dbChannel_put_many(struct dbChannel_put_request *preq, unsigned count)
+{
+    dbFieldRequest req[PUT_MANY_RUN];
+    unsigned i = 0, j, n;
+    int status = 0;
+
+    while (i < count) {
+        /* Collect a run of requests with DBR types which
+         * dbPutFieldMany() understands.
+         */
+        for (n = 0; n < PUT_MANY_RUN && i + n < count; n++) {
+            struct dbChannel_put_request *pput = &preq[i + n];
+            short dbfType = dbChannelFieldType(pput->chan);
+            int dbrType = mapOldType(pput->src_type);
+
+            if (dbrType < 0 ||
+                (dbfType >= DBF_INLINK && dbfType <= DBF_FWDLINK))
+                break;
+
+            req[n].paddr = &pput->chan->addr;
+            req[n].dbrType = dbrType;
+            req[n].pbuffer = (void *) pput->psrc;
+            req[n].options = 0;
+            req[n].nRequest = pput->no_elements;
+        }
+
+        if (n == 0) {
+            struct dbChannel_put_request *pput = &preq[i];
+
+            pput->status = dbChannel_put(pput->chan, pput->src_type,
+                pput->psrc, pput->no_elements);
+            if (pput->status)
+                status = -1;
+            i++;
+            continue;
+        }
+
+        if (dbPutFieldMany(req, n))
+            status = -1;
+        for (j = 0; j < n; j++)
+            preq[i + j].status = req[j].status ? -1 : 0;
+        i += n;
+    }
+    return status;
+}
+
 int db_put_process(processNotify *ppn, notifyPutType type,
     int src_type, const void *psrc, int no_elements)
 {
@@ -25,7 +25,6 @@ extern "C" {
 epicsShareExtern struct dbBase *pdbbase;
 epicsShareExtern volatile int interruptAccept;
 
-
 /*
  * Adaptors for db_access users
  */
@@ -37,6 +36,22 @@ epicsShareFunc int dbChannel_put(struct dbChannel *chan, int src_type,
 epicsShareFunc int dbChannel_get_count(struct dbChannel *chan,
     int buffer_type, void *pbuffer, long *nRequest, void *pfl);
 
+/* One element of a dbChannel_put_many() call */
+struct dbChannel_put_request {
+    struct dbChannel *chan;
+    int src_type;
+    const void *psrc;
+    long no_elements;
+    int status;     /* as dbChannel_put() would return */
+};
+
+/* Equivalent to dbChannel_put() on each request in order, with runs of
+ * consecutive requests made by dbPutFieldMany().
+ * Returns 0, or -1 if any request failed.
+ */
+epicsShareFunc int dbChannel_put_many(struct dbChannel_put_request *preq,
+    unsigned count);
+
 
 #ifdef __cplusplus
 }
@@ -24,6 +24,7 @@
 #include <stdarg.h>
 #include <limits.h>
 
+#include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsStdio.h"
@@ -427,6 +428,10 @@ static int events_on_action ( caHdrLargeArray *mp,
                        void *pPayload, struct client *pClient )
 {
     db_event_flow_ctrl_mode_off ( pClient->evuser );
+    if ( pClient->flowCtrl ) {
+        pClient->flowCtrl = FALSE;
+        epicsAtomicIncrSizeT ( &pClient->stats.flowCtrlOff );
+    }
     return RSRV_OK;
 }
 
@@ -437,6 +442,10 @@ static int events_off_action ( caHdrLargeArray *mp,
                        void *pPayload, struct client *pClient )
 {
     db_event_flow_ctrl_mode_on ( pClient->evuser );
+    if ( ! pClient->flowCtrl ) {
+        pClient->flowCtrl = TRUE;
+        epicsAtomicIncrSizeT ( &pClient->stats.flowCtrlOn );
+    }
     return RSRV_OK;
 }
 
@@ -748,6 +757,38 @@ static int read_notify_action ( caHdrLargeArray *mp, void *pPayload, struct clie
     return RSRV_OK;
 }
 
+/*
+ * rsrv_flush_put_batch()
+ *
+ * Apply the writes queued by write_action() in the order
+ * they were received, see dbPutFieldMany().
+ */
+static void rsrv_flush_put_batch ( struct client *client )
+{
+    unsigned i, n = client->putBatchCount;
+
+    if ( n == 0u ) {
+        return;
+    }
+    client->putBatchCount = 0u;
+
+    dbChannel_put_many ( client->putBatchReq, n );
+
+    for ( i = 0u; i < n; i++ ) {
+        struct rsrv_put_batch *pput = &client->putBatch[i];
+
+        if ( client->putBatchReq[i].status ) {
+            SEND_LOCK(client);
+            send_err(
+                &pput->msg,
+                ECA_PUTFAIL,
+                client,
+                RECORD_NAME ( pput->pciu->dbch ));
+            SEND_UNLOCK(client);
+        }
+    }
+}
+
 /*
  * write_action()
  */
@@ -755,6 +796,7 @@ static int write_action ( caHdrLargeArray *mp,
                         void *pPayload, struct client *client )
 {
     struct channel_in_use   *pciu;
+    struct rsrv_put_batch   *pput;
     int                     status;
     long                    dbStatus;
     void                    *asWritePvt;
@@ -792,27 +834,53 @@ static int write_action ( caHdrLargeArray *mp,
         return RSRV_ERROR;
     }
 
-    asWritePvt = asTrapWriteWithData ( pciu->asClientPVT,
-        pciu->client->pUserName ? pciu->client->pUserName : "",
-        pciu->client->pHostName ? pciu->client->pHostName : "",
-        pciu->dbch, mp->m_dataType, mp->m_count, pPayload );
+    /*
+     * Write trap listeners must see the value before and after
+     * this put, so it is made now, after any queued writes.
+     */
+    if ( asActive && pciu->asClientPVT->trapMask ) {
+        rsrv_flush_put_batch ( client );
+
+        asWritePvt = asTrapWriteWithData ( pciu->asClientPVT,
+            pciu->client->pUserName ? pciu->client->pUserName : "",
+            pciu->client->pHostName ? pciu->client->pHostName : "",
+            pciu->dbch, mp->m_dataType, mp->m_count, pPayload );
+
+        dbStatus = dbChannel_put(
+                      pciu->dbch,
+                      mp->m_dataType,
+                      pPayload,
+                      mp->m_count);
+
+        asTrapWriteAfter(asWritePvt);
+
+        if (dbStatus < 0) {
+            SEND_LOCK(client);
+            send_err(
+                mp,
+                ECA_PUTFAIL,
+                client,
+                RECORD_NAME ( pciu->dbch ));
+            SEND_UNLOCK(client);
+        }
+        return RSRV_OK;
+    }
 
-    dbStatus = dbChannel_put(
-                  pciu->dbch,
-                  mp->m_dataType,
-                  pPayload,
-                  mp->m_count);
+    /*
+     * Queue the write, the payload stays in the receive buffer
+     * until camessage() flushes the queue.
+     */
+    pput = &client->putBatch[client->putBatchCount];
+    pput->msg = *mp;
+    pput->pciu = pciu;
 
-    asTrapWriteAfter(asWritePvt);
+    client->putBatchReq[client->putBatchCount].chan = pciu->dbch;
+    client->putBatchReq[client->putBatchCount].src_type = mp->m_dataType;
+    client->putBatchReq[client->putBatchCount].psrc = pPayload;
+    client->putBatchReq[client->putBatchCount].no_elements = mp->m_count;
 
-    if (dbStatus < 0) {
-        SEND_LOCK(client);
-        send_err(
-            mp,
-            ECA_PUTFAIL,
-            client,
-            RECORD_NAME ( pciu->dbch ));
-        SEND_UNLOCK(client);
+    if ( ++client->putBatchCount >= RSRV_PUT_BATCH ) {
+        rsrv_flush_put_batch ( client );
     }
 
     return RSRV_OK;
@@ -2496,6 +2564,8 @@ int camessage ( struct client *client )
          *    after receiving the full message
          */
         if ( msgsize > client->recv.maxstk ) {
+            /* queued writes point into the buffer being replaced */
+            rsrv_flush_put_batch ( client );
             casExpandRecvBuffer ( client, msgsize );
             if ( msgsize > client->recv.maxstk ) {
                 if (client->proto==IPPROTO_TCP) {
@@ -2543,6 +2613,12 @@ int camessage ( struct client *client )
             }
         }
         else {
+            epicsAtomicIncrSizeT ( &client->stats.msgIn[
+                msg.m_cmmd < RSRV_NUM_CMMDS - 1 ? msg.m_cmmd : RSRV_NUM_CMMDS - 1] );
+            /* anything but another write sees the queued writes applied */
+            if ( msg.m_cmmd != CA_PROTO_WRITE ) {
+                rsrv_flush_put_batch ( client );
+            }
             if ( msg.m_cmmd < NELEMENTS(tcpJumpTable) ) {
                 status = ( *tcpJumpTable[msg.m_cmmd] ) ( &msg, pBody, client );
                 if ( status != RSRV_OK ) {
@@ -2551,13 +2627,17 @@ int camessage ( struct client *client )
                 }
             }
             else {
-                return bad_tcp_cmd_action ( &msg, pBody, client );
+                status = bad_tcp_cmd_action ( &msg, pBody, client );
+                break;
             }
         }
 
         client->recv.stk += msgsize;
     }
 
+    /* every exit from the loop above comes here */
+    rsrv_flush_put_batch ( client );
+
     return status;
 }
 
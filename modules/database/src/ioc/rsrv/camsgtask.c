@@ -21,6 +21,7 @@
 #include <errno.h>
 
 #include "dbDefs.h"
+#include "epicsAtomic.h"
 #include "epicsStdio.h"
 #include "epicsTime.h"
 #include "errlog.h"
@@ -113,6 +114,7 @@ void camsgtask ( void *pParm )
 
         epicsTimeGetCurrent ( &client->time_at_last_recv );
         client->recv.cnt += ( unsigned ) nchars;
+        epicsAtomicAddSizeT ( &client->stats.bytesIn, ( size_t ) nchars );
 
         status = camessage ( client );
         if (status == 0) {
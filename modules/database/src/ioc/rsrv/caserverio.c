@@ -22,6 +22,7 @@
 #include <limits.h>
 
 #include "dbDefs.h"
+#include "epicsAtomic.h"
 #include "epicsSignal.h"
 #include "epicsTime.h"
 #include "errlog.h"
@@ -65,9 +66,14 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
     }
 
     while ( pclient->send.stk && ! pclient->disconnect ) {
+        epicsUInt64 begin = epicsMonotonicGet ();
+
         status = send ( pclient->sock, pclient->send.buf, pclient->send.stk, 0 );
+        epicsAtomicAddSizeT ( &pclient->stats.sendTime,
+            (size_t) ( ( epicsMonotonicGet () - begin ) / 1000u ) );
         if ( status >= 0 ) {
             unsigned transferSize = (unsigned) status;
+            epicsAtomicAddSizeT ( &pclient->stats.bytesOut, transferSize );
             if ( transferSize >= pclient->send.stk ) {
                 pclient->send.stk = 0;
                 epicsTimeGetCurrent ( &pclient->time_at_last_send );
@@ -75,6 +81,7 @@ void cas_send_bs_msg ( struct client *pclient, int lock_needed )
             }
             else {
                 unsigned bytesLeft = pclient->send.stk - transferSize;
+                epicsAtomicIncrSizeT ( &pclient->stats.sendPartial );
                 memmove ( pclient->send.buf, &pclient->send.buf[transferSize],
                     bytesLeft );
                 pclient->send.stk = bytesLeft;
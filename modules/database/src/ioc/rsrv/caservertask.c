@@ -23,6 +23,7 @@
 #include <errno.h>
 
 #include "addrList.h"
+#include "epicsAtomic.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsSignal.h"
@@ -435,6 +436,48 @@ void rsrv_build_addr_lists(void)
         removeDuplicateAddresses(&beaconAddrList, &temp, 0);
     }
 
+    /* opt-in multicast name resolution.  Join the group for searches
+     * and beacon to it on a port of its own, so that clients joined to
+     * the group receive beacons without the CA repeater.
+     */
+    {
+        const char *pGroup = envGetConfigParamPtr(&EPICS_CA_MCAST_GROUP);
+        osiSockAddr group;
+
+        memset(&group, 0, sizeof(group));
+        if (!pGroup) {
+            /* disabled */
+        } else if (aToIPAddr(pGroup, ca_udp_port, &group.ia) ||
+                   (ntohl(group.ia.sin_addr.s_addr)>>24) < 224 ||
+                   (ntohl(group.ia.sin_addr.s_addr)>>24) > 239) {
+            errlogPrintf("CAS: %s=\"%s\" is not a multicast group address, ignored\n",
+                EPICS_CA_MCAST_GROUP.name, pGroup);
+        } else {
+            osiSockAddrNode *pNode;
+            int joined = 0;
+
+            for(pNode = (osiSockAddrNode*)ellFirst(&casMCastAddrList);
+                pNode;
+                pNode = (osiSockAddrNode*)ellNext(&pNode->node))
+            {
+                if (pNode->addr.ia.sin_addr.s_addr == group.ia.sin_addr.s_addr)
+                    joined = 1;
+            }
+            if (!joined) {
+                pNode = (osiSockAddrNode *) callocMustSucceed( 1, sizeof(*pNode), "rsrv_init" );
+                pNode->addr = group;
+                pNode->addr.ia.sin_port = htons(ca_udp_port);
+                ellAdd(&casMCastAddrList, &pNode->node);
+            }
+
+            pNode = (osiSockAddrNode *) callocMustSucceed( 1, sizeof(*pNode), "rsrv_init" );
+            pNode->addr = group;
+            pNode->addr.ia.sin_port = htons(envGetInetPortConfigParam(
+                &EPICS_CA_MCAST_BEACON_PORT, (unsigned short) CA_MCAST_BEACON_PORT));
+            ellAdd(&beaconAddrList, &pNode->node);
+        }
+    }
+
     if (ellCount(&beaconAddrList)==0)
         fprintf(stderr, "Warning: RSRV has empty beacon address list\n");
 
@@ -752,6 +795,8 @@ void rsrv_init (void)
             &rsrv_online_notify_task, NULL);
 
     epicsEventMustWait(beacon_startStopEvent);
+
+    rsrv_name_register_start();
 }
 
 static
@@ -807,6 +852,58 @@ static void showChanList (
     epicsMutexUnlock ( client->chanListLock );
 }
 
+static const char * const cmmdNames[RSRV_NUM_CMMDS] = {
+    "VERSION", "EVENT_ADD", "EVENT_CANCEL", "READ", "WRITE", "SNAPSHOT",
+    "SEARCH", "BUILD", "EVENTS_OFF", "EVENTS_ON", "READ_SYNC", "ERROR",
+    "CLEAR_CHANNEL", "RSRV_IS_UP", "NOT_FOUND", "READ_NOTIFY",
+    "READ_BUILD", "REPEATER_CONFIRM", "CREATE_CHAN", "WRITE_NOTIFY",
+    "CLIENT_NAME", "HOST_NAME", "ACCESS_RIGHTS", "ECHO",
+    "REPEATER_REGISTER", "SIGNAL", "CREATE_CH_FAIL", "SERVER_DISCONN",
+    "other"
+};
+
+/*
+ *  log_client_stats ()
+ */
+static void log_client_stats (struct client *client)
+{
+    const struct rsrv_client_stats *pstats = &client->stats;
+    unsigned i, n = 0u;
+
+    printf ( "\tBytes received = %lu, sent = %lu\n",
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->bytesIn ),
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->bytesOut ) );
+    printf ( "\t%.3f secs blocked in send, %lu partial sends\n",
+        epicsAtomicGetSizeT ( &pstats->sendTime ) * 1e-6,
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->sendPartial ) );
+
+    if ( client->evuser ) {
+        dbEventStats evStats;
+
+        db_event_stats ( client->evuser, &evStats );
+        printf ( "\tEvent queue %u of %u entries used, %lu overflows\n",
+            evStats.nQueued, evStats.nSize,
+            (unsigned long) evStats.nOverflow );
+        printf ( "\tFlow control %s, turned on %lu times\n",
+            evStats.flowCtrlMode ? "on" : "off",
+            (unsigned long) epicsAtomicGetSizeT ( &pstats->flowCtrlOn ) );
+    }
+
+    printf ( "\tRequests:" );
+    for ( i = 0u; i < RSRV_NUM_CMMDS; i++ ) {
+        size_t count = epicsAtomicGetSizeT ( &pstats->msgIn[i] );
+
+        if ( count ) {
+            if ( n && n % 4u == 0u ) {
+                printf ( "\n\t   " );
+            }
+            printf ( " %s=%lu", cmmdNames[i], (unsigned long) count );
+            n++;
+        }
+    }
+    printf ( "%s\n", n ? "" : " none" );
+}
+
 /*
  *  log_one_client ()
  */
@@ -866,6 +963,10 @@ static void log_one_client (struct client *client, unsigned level)
             client->recv.type == mbtLargeTCP ? " jumbo-recv-buf" : "");
     }
 
+    if ( level >= 2u && client->proto == IPPROTO_TCP ) {
+        log_client_stats ( client );
+    }
+
     if ( level >= 1u ) {
         showChanList ( client, level - 1u, & client->chanList );
         showChanList ( client, level - 1u, & client->chanPendingUpdateARList );
@@ -1541,6 +1642,125 @@ void casStatsFetch ( unsigned *pChanCount, unsigned *pCircuitCount )
     UNLOCK_CLIENTQ;
 }
 
+static void jsonString ( FILE *fp, const char *str )
+{
+    putc ( '"', fp );
+    for ( ; str && *str; str++ ) {
+        unsigned char c = (unsigned char) *str;
+
+        if ( c == '"' || c == '\\' ) {
+            fprintf ( fp, "\\%c", c );
+        }
+        else if ( c < 0x20u || c == 0x7fu ) {
+            fprintf ( fp, "\\u%04x", c );
+        }
+        else {
+            putc ( c, fp );
+        }
+    }
+    putc ( '"', fp );
+}
+
+static void jsonOneClient ( FILE *fp, struct client *client )
+{
+    const struct rsrv_client_stats *pstats = &client->stats;
+    char clientIP[40];
+    unsigned i, n = 0u;
+
+    ipAddrToDottedIP ( &client->addr, clientIP, sizeof(clientIP) );
+    fprintf ( fp, "{\"addr\":" );
+    jsonString ( fp, clientIP );
+    fprintf ( fp, ",\"host\":" );
+    jsonString ( fp, client->pHostName );
+    fprintf ( fp, ",\"user\":" );
+    jsonString ( fp, client->pUserName );
+    fprintf ( fp, ",\"priority\":%u,\"channels\":%d",
+        client->priority,
+        ellCount ( &client->chanList ) +
+            ellCount ( &client->chanPendingUpdateARList ) );
+    fprintf ( fp, ",\"bytesIn\":%lu,\"bytesOut\":%lu",
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->bytesIn ),
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->bytesOut ) );
+    fprintf ( fp, ",\"sendTime\":%.6f,\"sendPartial\":%lu",
+        epicsAtomicGetSizeT ( &pstats->sendTime ) * 1e-6,
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->sendPartial ) );
+    fprintf ( fp, ",\"flowCtrlOn\":%lu,\"flowCtrlOff\":%lu",
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->flowCtrlOn ),
+        (unsigned long) epicsAtomicGetSizeT ( &pstats->flowCtrlOff ) );
+
+    fprintf ( fp, ",\"requests\":{" );
+    for ( i = 0u; i < RSRV_NUM_CMMDS; i++ ) {
+        size_t count = epicsAtomicGetSizeT ( &pstats->msgIn[i] );
+
+        if ( count ) {
+            fprintf ( fp, "%s\"%s\":%lu", n++ ? "," : "",
+                cmmdNames[i], (unsigned long) count );
+        }
+    }
+    putc ( '}', fp );
+
+    if ( client->evuser ) {
+        dbEventStats evStats;
+
+        db_event_stats ( client->evuser, &evStats );
+        fprintf ( fp, ",\"eventQueue\":{\"used\":%u,\"size\":%u,"
+            "\"overflows\":%lu,\"flowControl\":%s}",
+            evStats.nQueued, evStats.nSize,
+            (unsigned long) evStats.nOverflow,
+            evStats.flowCtrlMode ? "true" : "false" );
+    }
+    putc ( '}', fp );
+}
+
+/*
+ *  casClientStats()
+ */
+int casClientStats ( const char *filename )
+{
+    FILE *fp = stdout;
+    struct client *client;
+    int first = 1;
+
+    if ( ! clientQlock ) {
+        return RSRV_OK;
+    }
+
+    if ( filename && *filename ) {
+        fp = fopen ( filename, "w" );
+        if ( ! fp ) {
+            errlogPrintf ( "casClientStats: Can't open \"%s\": %s\n",
+                filename, strerror ( errno ) );
+            return RSRV_ERROR;
+        }
+    }
+
+    putc ( '[', fp );
+    LOCK_CLIENTQ;
+    for ( client = (struct client *) ellFirst ( &clientQ ); client;
+          client = (struct client *) ellNext ( &client->node ) ) {
+        if ( ! first ) {
+            putc ( ',', fp );
+        }
+        fputs ( "\n  ", fp );
+        jsonOneClient ( fp, client );
+        first = 0;
+    }
+    UNLOCK_CLIENTQ;
+    fputs ( first ? "]\n" : "\n]\n", fp );
+
+    if ( fp != stdout ) {
+        if ( fclose ( fp ) ) {
+            errlogPrintf ( "casClientStats: Error writing \"%s\": %s\n",
+                filename, strerror ( errno ) );
+            return RSRV_ERROR;
+        }
+    }
+    else {
+        fflush ( fp );
+    }
+    return RSRV_OK;
+}
+
 
 static dbServer rsrv_server = {
     ELLNODE_INIT,
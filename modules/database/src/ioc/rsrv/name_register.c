@@ -0,0 +1,217 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS Base is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+/*
+ *  register the names of this server's records, and their aliases,
+ *  with each CA name server (caNameServer) listed in
+ *  EPICS_CAS_NAME_SERVERS
+ *
+ *  The circuit is kept open, since the name server withdraws the names
+ *  when it closes, and the names are registered again when the
+ *  circuit is reestablished.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "addrList.h"
+#include "cantProceed.h"
+#include "dbDefs.h"
+#include "envDefs.h"
+#include "epicsThread.h"
+#include "errlog.h"
+#include "osiSock.h"
+
+#include "dbAccessDefs.h"
+#include "dbStaticLib.h"
+
+#define epicsExportSharedSymbols
+#include "server.h"
+
+/* reconnect delays in seconds */
+static const double minRetryDelay = 1.0;
+static const double maxRetryDelay = 60.0;
+
+static
+int sendAll(SOCKET sock, const char *pBuf, size_t len)
+{
+    while (len) {
+        int status = send(sock, pBuf, (int) len, 0);
+        if (status <= 0)
+            return -1;
+        pBuf += status;
+        len -= status;
+    }
+    return 0;
+}
+
+/* pBuf holds a header followed by used bytes of names */
+static
+int sendNames(SOCKET sock, char *pBuf, size_t used, unsigned nNames)
+{
+    caHdr *pMsg = (caHdr *) pBuf;
+    size_t size = CA_MESSAGE_ALIGN(used);
+
+    memset(pBuf + sizeof(caHdr) + used, 0, size - used);
+    memset(pMsg, 0, sizeof(*pMsg));
+    pMsg->m_cmmd = htons(CA_PROTO_NAME_REGISTER);
+    pMsg->m_postsize = htons((ca_uint16_t) size);
+    pMsg->m_dataType = htons(ca_server_port);
+    pMsg->m_count = htons((ca_uint16_t) nNames);
+    /* zero, the name server uses the address of this circuit */
+    pMsg->m_cid = 0;
+    return sendAll(sock, pBuf, sizeof(caHdr) + size);
+}
+
+/* send one CA_PROTO_NAME_REGISTER message per buffer full of names */
+static
+int registerNames(SOCKET sock, unsigned *pCount)
+{
+    char *pBuf = mallocMustSucceed(sizeof(caHdr) + MAX_TCP, "rsrv_name_register");
+    char *pPayload = pBuf + sizeof(caHdr);
+    size_t used = 0;
+    unsigned nNames = 0, total = 0;
+    DBENTRY dbentry;
+    long status;
+    int err = 0;
+
+    {
+        caHdr msg;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.m_cmmd = htons(CA_PROTO_VERSION);
+        msg.m_dataType = htons(CA_PROTO_PRIORITY_MIN);
+        msg.m_count = htons(CA_MINOR_PROTOCOL_REVISION);
+        err = sendAll(sock, (char *) &msg, sizeof(msg));
+    }
+
+    dbInitEntry(pdbbase, &dbentry);
+    for (status = dbFirstRecordType(&dbentry); !status && !err;
+         status = dbNextRecordType(&dbentry)) {
+        long rstatus;
+
+        for (rstatus = dbFirstRecord(&dbentry); !rstatus;
+             rstatus = dbNextRecord(&dbentry)) {
+            const char *pName = dbGetRecordName(&dbentry);
+            size_t len = strlen(pName) + 1;
+
+            if (CA_MESSAGE_ALIGN(used + len) > MAX_TCP) {
+                if (sendNames(sock, pBuf, used, nNames)) {
+                    err = 1;
+                    break;
+                }
+                used = 0;
+                nNames = 0;
+            }
+            memcpy(pPayload + used, pName, len);
+            used += len;
+            nNames++;
+            total++;
+        }
+    }
+    dbFinishEntry(&dbentry);
+
+    if (!err && nNames)
+        err = sendNames(sock, pBuf, used, nNames);
+
+    free(pBuf);
+    *pCount = total;
+    return err ? -1 : 0;
+}
+
+/*
+ *  RSRV_NAME_REGISTER_TASK
+ *
+ *  one thread for each name server, so that one which is
+ *  unreachable does not delay registration with the others
+ */
+static
+void rsrv_name_register_task(void *pParm)
+{
+    osiSockAddrNode *pNode = (osiSockAddrNode *) pParm;
+    double delay = minRetryDelay;
+    int lastError = 0;
+    char name[40];
+
+    ipAddrToDottedIP(&pNode->addr.ia, name, sizeof(name));
+
+    /* register once the server is accepting circuits */
+    while (beacon_ctl != ctlRun) {
+        epicsThreadSleep(0.1);
+    }
+
+    while (TRUE) {
+        unsigned count = 0;
+        SOCKET sock = epicsSocketCreate(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+        if (sock == INVALID_SOCKET) {
+            errlogPrintf("CAS: name server socket allocation failed\n");
+        }
+        else if (connect(sock, &pNode->addr.sa, sizeof(pNode->addr.ia)) != 0) {
+            int err = SOCKERRNO;
+            if (err != lastError) {
+                char sockErrBuf[64];
+                epicsSocketConvertErrorToString(sockErrBuf, sizeof(sockErrBuf), err);
+                errlogPrintf("CAS: unable to connect to name server %s: %s\n",
+                    name, sockErrBuf);
+                lastError = err;
+            }
+        }
+        else {
+            int intTrue = 1;
+
+            lastError = 0;
+            setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE,
+                (char *) &intTrue, sizeof(intTrue));
+
+            if (registerNames(sock, &count) == 0) {
+                char buf[256];
+
+                errlogPrintf("CAS: registered %u names with name server %s\n",
+                    count, name);
+                delay = minRetryDelay;
+
+                /* discard replies until the name server goes away */
+                while (recv(sock, buf, sizeof(buf), 0) > 0)
+                    ;
+
+                errlogPrintf("CAS: lost circuit to name server %s\n", name);
+            }
+            else {
+                errlogPrintf("CAS: name registration with %s failed\n", name);
+            }
+        }
+
+        if (sock != INVALID_SOCKET)
+            epicsSocketDestroy(sock);
+
+        epicsThreadSleep(delay);
+        delay *= 2.0;
+        if (delay > maxRetryDelay)
+            delay = maxRetryDelay;
+    }
+}
+
+void rsrv_name_register_start(void)
+{
+    ELLLIST list = ELLLIST_INIT;
+    osiSockAddrNode *pNode;
+    unsigned short port;
+
+    if (!envGetConfigParamPtr(&EPICS_CAS_NAME_SERVERS))
+        return;
+
+    port = envGetInetPortConfigParam(&EPICS_CA_SERVER_PORT,
+        (unsigned short) CA_SERVER_PORT);
+    addAddrToChannelAccessAddressList(&list, &EPICS_CAS_NAME_SERVERS, port, 0);
+
+    while ((pNode = (osiSockAddrNode *) ellGet(&list))) {
+        epicsThreadMustCreate("CAS-nameserv", epicsThreadPriorityCAServerLow,
+            epicsThreadGetStackSize(epicsThreadStackSmall),
+            &rsrv_name_register_task, pNode);
+    }
+}
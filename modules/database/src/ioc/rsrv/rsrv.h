@@ -35,6 +35,7 @@ epicsShareFunc int casClientInitiatingCurrentThread (
                         char * pBuf, size_t bufSize );
 epicsShareFunc void casStatsFetch (
                         unsigned *pChanCount, unsigned *pConnCount );
+epicsShareFunc int casClientStats ( const char *filename );
 
 #ifdef __cplusplus
 }
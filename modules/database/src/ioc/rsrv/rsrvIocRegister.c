@@ -26,11 +26,22 @@ static void casrCallFunc(const iocshArgBuf *args)
     casr(args[0].ival);
 }
 
+/* casClientStats */
+static const iocshArg casClientStatsArg0 = { "file name",iocshArgString};
+static const iocshArg * const casClientStatsArgs[1] = {&casClientStatsArg0};
+static const iocshFuncDef casClientStatsFuncDef = {"casClientStats",1,
+    casClientStatsArgs};
+static void casClientStatsCallFunc(const iocshArgBuf *args)
+{
+    casClientStats(args[0].sval);
+}
+
 static
 void rsrvRegistrar(void)
 {
     rsrv_register_server();
     iocshRegister(&casrFuncDef,casrCallFunc);
+    iocshRegister(&casClientStatsFuncDef,casClientStatsCallFunc);
 }
 
 epicsExportAddress(int, CASDEBUG);
@@ -27,6 +27,7 @@
 #include "bucketLib.h"
 #include "asLib.h"
 #include "dbChannel.h"
+#include "db_access_routines.h"
 #include "dbNotify.h"
 #define CA_MINOR_PROTOCOL_REVISION 13
 #include "caProto.h"
@@ -72,6 +73,37 @@ struct message_buffer {
   enum messageBufferType    type;
 };
 
+/*
+ * Up to RSRV_PUT_BATCH consecutive CA_PROTO_WRITE requests from one
+ * receive buffer are queued by write_action() and applied in order
+ * with dbChannel_put_many().  Writes which access security traps are
+ * not queued.
+ */
+#define RSRV_PUT_BATCH 64
+
+struct rsrv_put_batch {
+    caHdrLargeArray         msg;
+    struct channel_in_use   *pciu;
+};
+
+/*
+ * Per-client telemetry shown by casr() and casClientStats().
+ * Each counter has a single writer, the receive thread or the holder
+ * of SEND_LOCK(), and is updated with epicsAtomic so that it can be
+ * read at any time.
+ */
+#define RSRV_NUM_CMMDS (CA_PROTO_LAST_CMMD + 2) /* last counts bad commands */
+
+struct rsrv_client_stats {
+    size_t      bytesIn;
+    size_t      bytesOut;
+    size_t      msgIn[RSRV_NUM_CMMDS];
+    size_t      flowCtrlOn;     /* transitions into flow control */
+    size_t      flowCtrlOff;
+    size_t      sendTime;       /* us spent in send() */
+    size_t      sendPartial;    /* sends which did not take the whole buffer */
+};
+
 extern epicsThreadPrivateId rsrvCurrentClient;
 
 typedef struct client {
@@ -102,6 +134,12 @@ typedef struct client {
   unsigned              recvBytesToDrain;
   unsigned              priority;
   char                  disconnect; /* disconnect detected */
+  char                  flowCtrl;   /* client asked for flow control */
+  struct rsrv_client_stats stats;
+  /*! queued writes, accessed by receive thread w/o locks cf. camessage() */
+  unsigned              putBatchCount;
+  struct rsrv_put_batch putBatch[RSRV_PUT_BATCH];
+  struct dbChannel_put_request putBatchReq[RSRV_PUT_BATCH];
 } client;
 
 /* Channel state shows which struct client list a
@@ -232,6 +270,7 @@ void camsgtask (void *client);
 void cas_send_bs_msg ( struct client *pclient, int lock_needed );
 void cas_send_dg_msg ( struct client *pclient );
 void rsrv_online_notify_task (void *);
+void rsrv_name_register_start (void);
 void cast_server (void *);
 struct client *create_client ( SOCKET sock, int proto );
 void destroy_client ( struct client * );
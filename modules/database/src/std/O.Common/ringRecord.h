@@ -0,0 +1,293 @@
+/* ringRecord.h generated from ringRecord.dbd */
+
+#ifndef INC_ringRecord_H
+#define INC_ringRecord_H
+
+#include "epicsTypes.h"
+#include "link.h"
+#include "epicsMutex.h"
+#include "ellLib.h"
+#include "devSup.h"
+#include "epicsTime.h"
+
+typedef struct ringRecord {
+    char                name[61];   /* Record Name */
+    char                desc[41];   /* Descriptor */
+    char                asg[29];    /* Access Security Group */
+    epicsEnum16         scan;       /* Scan Mechanism */
+    epicsEnum16         pini;       /* Process at iocInit */
+    epicsInt16          phas;       /* Scan Phase */
+    char                evnt[40];   /* Event Name */
+    epicsInt16          tse;        /* Time Stamp Event */
+    DBLINK              tsel;       /* Time Stamp Link */
+    epicsEnum16         dtyp;       /* Device Type */
+    epicsInt16          disv;       /* Disable Value */
+    epicsInt16          disa;       /* Disable */
+    DBLINK              sdis;       /* Scanning Disable */
+    epicsMutexId        mlok;       /* Monitor lock */
+    ELLLIST             mlis;       /* Monitor List */
+    ELLLIST             bklnk;      /* Backwards link tracking */
+    epicsUInt8          disp;       /* Disable putField */
+    epicsUInt8          proc;       /* Force Processing */
+    epicsEnum16         stat;       /* Alarm Status */
+    epicsEnum16         sevr;       /* Alarm Severity */
+    epicsEnum16         nsta;       /* New Alarm Status */
+    epicsEnum16         nsev;       /* New Alarm Severity */
+    epicsEnum16         acks;       /* Alarm Ack Severity */
+    epicsEnum16         ackt;       /* Alarm Ack Transient */
+    epicsEnum16         diss;       /* Disable Alarm Sevrty */
+    epicsUInt8          lcnt;       /* Lock Count */
+    epicsUInt8          pact;       /* Record active */
+    epicsUInt8          putf;       /* dbPutField process */
+    epicsUInt8          rpro;       /* Reprocess  */
+    struct asgMember    *asp;       /* Access Security Pvt */
+    struct processNotify *ppn;      /* pprocessNotify */
+    struct processNotifyRecord *ppnr; /* pprocessNotifyRecord */
+    struct scan_element *spvt;      /* Scan Private */
+    struct typed_rset   *rset;      /* Address of RSET */
+    unambiguous_dset    *dset;      /* DSET address */
+    void                *dpvt;      /* Device Private */
+    struct dbRecordType *rdes;      /* Address of dbRecordType */
+    struct lockRecord   *lset;      /* Lock Set */
+    epicsEnum16         prio;       /* Scheduling Priority */
+    epicsUInt8          tpro;       /* Trace Processing */
+    epicsUInt8          bkpt;       /* Break Point */
+    epicsUInt8          udf;        /* Undefined */
+    epicsEnum16         udfs;       /* Undefined Alarm Sevrty */
+    epicsTimeStamp      time;       /* Time */
+    DBLINK              flnk;       /* Forward Process Link */
+    void *		val;                    /* Appended Samples */
+    void *		win;                    /* Window */
+    DBLINK              inp;        /* Input Specification */
+    epicsInt16          res;        /* Reset */
+    epicsInt16          prec;       /* Display Precision */
+    char                egu[16];    /* Engineering Units */
+    epicsFloat64        hopr;       /* High Operating Range */
+    epicsFloat64        lopr;       /* Low Operating Range */
+    epicsUInt32         nelm;       /* Max Samples per Append */
+    epicsUInt32         nsam;       /* Window Size */
+    epicsEnum16         ftvl;       /* Field Type of Value */
+    epicsUInt32         nord;       /* Number Appended */
+    epicsUInt32         nuse;       /* Number in Window */
+    epicsUInt32         off;        /* Window Offset */
+    epicsUInt64         tot;        /* Total Samples Appended */
+    epicsUInt8          newv;       /* New Samples in VAL */
+    void *		bptr;                   /* Buffer Pointer */
+    void *		wptr;                   /* Window Pointer */
+} ringRecord;
+
+typedef enum {
+	ringRecordNAME = 0,
+	ringRecordDESC = 1,
+	ringRecordASG = 2,
+	ringRecordSCAN = 3,
+	ringRecordPINI = 4,
+	ringRecordPHAS = 5,
+	ringRecordEVNT = 6,
+	ringRecordTSE = 7,
+	ringRecordTSEL = 8,
+	ringRecordDTYP = 9,
+	ringRecordDISV = 10,
+	ringRecordDISA = 11,
+	ringRecordSDIS = 12,
+	ringRecordMLOK = 13,
+	ringRecordMLIS = 14,
+	ringRecordBKLNK = 15,
+	ringRecordDISP = 16,
+	ringRecordPROC = 17,
+	ringRecordSTAT = 18,
+	ringRecordSEVR = 19,
+	ringRecordNSTA = 20,
+	ringRecordNSEV = 21,
+	ringRecordACKS = 22,
+	ringRecordACKT = 23,
+	ringRecordDISS = 24,
+	ringRecordLCNT = 25,
+	ringRecordPACT = 26,
+	ringRecordPUTF = 27,
+	ringRecordRPRO = 28,
+	ringRecordASP = 29,
+	ringRecordPPN = 30,
+	ringRecordPPNR = 31,
+	ringRecordSPVT = 32,
+	ringRecordRSET = 33,
+	ringRecordDSET = 34,
+	ringRecordDPVT = 35,
+	ringRecordRDES = 36,
+	ringRecordLSET = 37,
+	ringRecordPRIO = 38,
+	ringRecordTPRO = 39,
+	ringRecordBKPT = 40,
+	ringRecordUDF = 41,
+	ringRecordUDFS = 42,
+	ringRecordTIME = 43,
+	ringRecordFLNK = 44,
+	ringRecordVAL = 45,
+	ringRecordWIN = 46,
+	ringRecordINP = 47,
+	ringRecordRES = 48,
+	ringRecordPREC = 49,
+	ringRecordEGU = 50,
+	ringRecordHOPR = 51,
+	ringRecordLOPR = 52,
+	ringRecordNELM = 53,
+	ringRecordNSAM = 54,
+	ringRecordFTVL = 55,
+	ringRecordNORD = 56,
+	ringRecordNUSE = 57,
+	ringRecordOFF = 58,
+	ringRecordTOT = 59,
+	ringRecordNEWV = 60,
+	ringRecordBPTR = 61,
+	ringRecordWPTR = 62
+} ringFieldIndex;
+
+#ifdef GEN_SIZE_OFFSET
+
+#include <epicsAssert.h>
+#include <epicsExport.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+static int ringRecordSizeOffset(dbRecordType *prt)
+{
+    ringRecord *prec = 0;
+
+    assert(prt->no_fields == 63);
+    prt->papFldDes[ringRecordNAME]->size = sizeof(prec->name);
+    prt->papFldDes[ringRecordDESC]->size = sizeof(prec->desc);
+    prt->papFldDes[ringRecordASG]->size = sizeof(prec->asg);
+    prt->papFldDes[ringRecordSCAN]->size = sizeof(prec->scan);
+    prt->papFldDes[ringRecordPINI]->size = sizeof(prec->pini);
+    prt->papFldDes[ringRecordPHAS]->size = sizeof(prec->phas);
+    prt->papFldDes[ringRecordEVNT]->size = sizeof(prec->evnt);
+    prt->papFldDes[ringRecordTSE]->size = sizeof(prec->tse);
+    prt->papFldDes[ringRecordTSEL]->size = sizeof(prec->tsel);
+    prt->papFldDes[ringRecordDTYP]->size = sizeof(prec->dtyp);
+    prt->papFldDes[ringRecordDISV]->size = sizeof(prec->disv);
+    prt->papFldDes[ringRecordDISA]->size = sizeof(prec->disa);
+    prt->papFldDes[ringRecordSDIS]->size = sizeof(prec->sdis);
+    prt->papFldDes[ringRecordMLOK]->size = sizeof(prec->mlok);
+    prt->papFldDes[ringRecordMLIS]->size = sizeof(prec->mlis);
+    prt->papFldDes[ringRecordBKLNK]->size = sizeof(prec->bklnk);
+    prt->papFldDes[ringRecordDISP]->size = sizeof(prec->disp);
+    prt->papFldDes[ringRecordPROC]->size = sizeof(prec->proc);
+    prt->papFldDes[ringRecordSTAT]->size = sizeof(prec->stat);
+    prt->papFldDes[ringRecordSEVR]->size = sizeof(prec->sevr);
+    prt->papFldDes[ringRecordNSTA]->size = sizeof(prec->nsta);
+    prt->papFldDes[ringRecordNSEV]->size = sizeof(prec->nsev);
+    prt->papFldDes[ringRecordACKS]->size = sizeof(prec->acks);
+    prt->papFldDes[ringRecordACKT]->size = sizeof(prec->ackt);
+    prt->papFldDes[ringRecordDISS]->size = sizeof(prec->diss);
+    prt->papFldDes[ringRecordLCNT]->size = sizeof(prec->lcnt);
+    prt->papFldDes[ringRecordPACT]->size = sizeof(prec->pact);
+    prt->papFldDes[ringRecordPUTF]->size = sizeof(prec->putf);
+    prt->papFldDes[ringRecordRPRO]->size = sizeof(prec->rpro);
+    prt->papFldDes[ringRecordASP]->size = sizeof(prec->asp);
+    prt->papFldDes[ringRecordPPN]->size = sizeof(prec->ppn);
+    prt->papFldDes[ringRecordPPNR]->size = sizeof(prec->ppnr);
+    prt->papFldDes[ringRecordSPVT]->size = sizeof(prec->spvt);
+    prt->papFldDes[ringRecordRSET]->size = sizeof(prec->rset);
+    prt->papFldDes[ringRecordDSET]->size = sizeof(prec->dset);
+    prt->papFldDes[ringRecordDPVT]->size = sizeof(prec->dpvt);
+    prt->papFldDes[ringRecordRDES]->size = sizeof(prec->rdes);
+    prt->papFldDes[ringRecordLSET]->size = sizeof(prec->lset);
+    prt->papFldDes[ringRecordPRIO]->size = sizeof(prec->prio);
+    prt->papFldDes[ringRecordTPRO]->size = sizeof(prec->tpro);
+    prt->papFldDes[ringRecordBKPT]->size = sizeof(prec->bkpt);
+    prt->papFldDes[ringRecordUDF]->size = sizeof(prec->udf);
+    prt->papFldDes[ringRecordUDFS]->size = sizeof(prec->udfs);
+    prt->papFldDes[ringRecordTIME]->size = sizeof(prec->time);
+    prt->papFldDes[ringRecordFLNK]->size = sizeof(prec->flnk);
+    prt->papFldDes[ringRecordVAL]->size = sizeof(prec->val);
+    prt->papFldDes[ringRecordWIN]->size = sizeof(prec->win);
+    prt->papFldDes[ringRecordINP]->size = sizeof(prec->inp);
+    prt->papFldDes[ringRecordRES]->size = sizeof(prec->res);
+    prt->papFldDes[ringRecordPREC]->size = sizeof(prec->prec);
+    prt->papFldDes[ringRecordEGU]->size = sizeof(prec->egu);
+    prt->papFldDes[ringRecordHOPR]->size = sizeof(prec->hopr);
+    prt->papFldDes[ringRecordLOPR]->size = sizeof(prec->lopr);
+    prt->papFldDes[ringRecordNELM]->size = sizeof(prec->nelm);
+    prt->papFldDes[ringRecordNSAM]->size = sizeof(prec->nsam);
+    prt->papFldDes[ringRecordFTVL]->size = sizeof(prec->ftvl);
+    prt->papFldDes[ringRecordNORD]->size = sizeof(prec->nord);
+    prt->papFldDes[ringRecordNUSE]->size = sizeof(prec->nuse);
+    prt->papFldDes[ringRecordOFF]->size = sizeof(prec->off);
+    prt->papFldDes[ringRecordTOT]->size = sizeof(prec->tot);
+    prt->papFldDes[ringRecordNEWV]->size = sizeof(prec->newv);
+    prt->papFldDes[ringRecordBPTR]->size = sizeof(prec->bptr);
+    prt->papFldDes[ringRecordWPTR]->size = sizeof(prec->wptr);
+    prt->papFldDes[ringRecordNAME]->offset = (unsigned short)((char *)&prec->name - (char *)prec);
+    prt->papFldDes[ringRecordDESC]->offset = (unsigned short)((char *)&prec->desc - (char *)prec);
+    prt->papFldDes[ringRecordASG]->offset = (unsigned short)((char *)&prec->asg - (char *)prec);
+    prt->papFldDes[ringRecordSCAN]->offset = (unsigned short)((char *)&prec->scan - (char *)prec);
+    prt->papFldDes[ringRecordPINI]->offset = (unsigned short)((char *)&prec->pini - (char *)prec);
+    prt->papFldDes[ringRecordPHAS]->offset = (unsigned short)((char *)&prec->phas - (char *)prec);
+    prt->papFldDes[ringRecordEVNT]->offset = (unsigned short)((char *)&prec->evnt - (char *)prec);
+    prt->papFldDes[ringRecordTSE]->offset = (unsigned short)((char *)&prec->tse - (char *)prec);
+    prt->papFldDes[ringRecordTSEL]->offset = (unsigned short)((char *)&prec->tsel - (char *)prec);
+    prt->papFldDes[ringRecordDTYP]->offset = (unsigned short)((char *)&prec->dtyp - (char *)prec);
+    prt->papFldDes[ringRecordDISV]->offset = (unsigned short)((char *)&prec->disv - (char *)prec);
+    prt->papFldDes[ringRecordDISA]->offset = (unsigned short)((char *)&prec->disa - (char *)prec);
+    prt->papFldDes[ringRecordSDIS]->offset = (unsigned short)((char *)&prec->sdis - (char *)prec);
+    prt->papFldDes[ringRecordMLOK]->offset = (unsigned short)((char *)&prec->mlok - (char *)prec);
+    prt->papFldDes[ringRecordMLIS]->offset = (unsigned short)((char *)&prec->mlis - (char *)prec);
+    prt->papFldDes[ringRecordBKLNK]->offset = (unsigned short)((char *)&prec->bklnk - (char *)prec);
+    prt->papFldDes[ringRecordDISP]->offset = (unsigned short)((char *)&prec->disp - (char *)prec);
+    prt->papFldDes[ringRecordPROC]->offset = (unsigned short)((char *)&prec->proc - (char *)prec);
+    prt->papFldDes[ringRecordSTAT]->offset = (unsigned short)((char *)&prec->stat - (char *)prec);
+    prt->papFldDes[ringRecordSEVR]->offset = (unsigned short)((char *)&prec->sevr - (char *)prec);
+    prt->papFldDes[ringRecordNSTA]->offset = (unsigned short)((char *)&prec->nsta - (char *)prec);
+    prt->papFldDes[ringRecordNSEV]->offset = (unsigned short)((char *)&prec->nsev - (char *)prec);
+    prt->papFldDes[ringRecordACKS]->offset = (unsigned short)((char *)&prec->acks - (char *)prec);
+    prt->papFldDes[ringRecordACKT]->offset = (unsigned short)((char *)&prec->ackt - (char *)prec);
+    prt->papFldDes[ringRecordDISS]->offset = (unsigned short)((char *)&prec->diss - (char *)prec);
+    prt->papFldDes[ringRecordLCNT]->offset = (unsigned short)((char *)&prec->lcnt - (char *)prec);
+    prt->papFldDes[ringRecordPACT]->offset = (unsigned short)((char *)&prec->pact - (char *)prec);
+    prt->papFldDes[ringRecordPUTF]->offset = (unsigned short)((char *)&prec->putf - (char *)prec);
+    prt->papFldDes[ringRecordRPRO]->offset = (unsigned short)((char *)&prec->rpro - (char *)prec);
+    prt->papFldDes[ringRecordASP]->offset = (unsigned short)((char *)&prec->asp - (char *)prec);
+    prt->papFldDes[ringRecordPPN]->offset = (unsigned short)((char *)&prec->ppn - (char *)prec);
+    prt->papFldDes[ringRecordPPNR]->offset = (unsigned short)((char *)&prec->ppnr - (char *)prec);
+    prt->papFldDes[ringRecordSPVT]->offset = (unsigned short)((char *)&prec->spvt - (char *)prec);
+    prt->papFldDes[ringRecordRSET]->offset = (unsigned short)((char *)&prec->rset - (char *)prec);
+    prt->papFldDes[ringRecordDSET]->offset = (unsigned short)((char *)&prec->dset - (char *)prec);
+    prt->papFldDes[ringRecordDPVT]->offset = (unsigned short)((char *)&prec->dpvt - (char *)prec);
+    prt->papFldDes[ringRecordRDES]->offset = (unsigned short)((char *)&prec->rdes - (char *)prec);
+    prt->papFldDes[ringRecordLSET]->offset = (unsigned short)((char *)&prec->lset - (char *)prec);
+    prt->papFldDes[ringRecordPRIO]->offset = (unsigned short)((char *)&prec->prio - (char *)prec);
+    prt->papFldDes[ringRecordTPRO]->offset = (unsigned short)((char *)&prec->tpro - (char *)prec);
+    prt->papFldDes[ringRecordBKPT]->offset = (unsigned short)((char *)&prec->bkpt - (char *)prec);
+    prt->papFldDes[ringRecordUDF]->offset = (unsigned short)((char *)&prec->udf - (char *)prec);
+    prt->papFldDes[ringRecordUDFS]->offset = (unsigned short)((char *)&prec->udfs - (char *)prec);
+    prt->papFldDes[ringRecordTIME]->offset = (unsigned short)((char *)&prec->time - (char *)prec);
+    prt->papFldDes[ringRecordFLNK]->offset = (unsigned short)((char *)&prec->flnk - (char *)prec);
+    prt->papFldDes[ringRecordVAL]->offset = (unsigned short)((char *)&prec->val - (char *)prec);
+    prt->papFldDes[ringRecordWIN]->offset = (unsigned short)((char *)&prec->win - (char *)prec);
+    prt->papFldDes[ringRecordINP]->offset = (unsigned short)((char *)&prec->inp - (char *)prec);
+    prt->papFldDes[ringRecordRES]->offset = (unsigned short)((char *)&prec->res - (char *)prec);
+    prt->papFldDes[ringRecordPREC]->offset = (unsigned short)((char *)&prec->prec - (char *)prec);
+    prt->papFldDes[ringRecordEGU]->offset = (unsigned short)((char *)&prec->egu - (char *)prec);
+    prt->papFldDes[ringRecordHOPR]->offset = (unsigned short)((char *)&prec->hopr - (char *)prec);
+    prt->papFldDes[ringRecordLOPR]->offset = (unsigned short)((char *)&prec->lopr - (char *)prec);
+    prt->papFldDes[ringRecordNELM]->offset = (unsigned short)((char *)&prec->nelm - (char *)prec);
+    prt->papFldDes[ringRecordNSAM]->offset = (unsigned short)((char *)&prec->nsam - (char *)prec);
+    prt->papFldDes[ringRecordFTVL]->offset = (unsigned short)((char *)&prec->ftvl - (char *)prec);
+    prt->papFldDes[ringRecordNORD]->offset = (unsigned short)((char *)&prec->nord - (char *)prec);
+    prt->papFldDes[ringRecordNUSE]->offset = (unsigned short)((char *)&prec->nuse - (char *)prec);
+    prt->papFldDes[ringRecordOFF]->offset = (unsigned short)((char *)&prec->off - (char *)prec);
+    prt->papFldDes[ringRecordTOT]->offset = (unsigned short)((char *)&prec->tot - (char *)prec);
+    prt->papFldDes[ringRecordNEWV]->offset = (unsigned short)((char *)&prec->newv - (char *)prec);
+    prt->papFldDes[ringRecordBPTR]->offset = (unsigned short)((char *)&prec->bptr - (char *)prec);
+    prt->papFldDes[ringRecordWPTR]->offset = (unsigned short)((char *)&prec->wptr - (char *)prec);
+    prt->rec_size = sizeof(*prec);
+    return 0;
+}
+epicsExportRegistrar(ringRecordSizeOffset);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* GEN_SIZE_OFFSET */
+
+#endif /* INC_ringRecord_H */
@@ -0,0 +1,395 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS Base is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+/* aSubArrayFunctions.c */
+
+/*
+ * Array math subroutines for the aSub record.
+ *
+ * Array arguments and the VALA output must all have the same field type,
+ * either DOUBLE or FLOAT, which selects the kernel used.  Scalar
+ * arguments may have any numeric type.  The number of elements processed
+ * is the smallest of the NE* of the array inputs and NOVA; NEVA is set
+ * to the number of output elements.
+ *
+ *   aSubAxpy          VALA[i] = A * B[i] + C[i]
+ *   aSubLinear        VALA[i] = A[i] * B + C
+ *   aSubPolynomial    VALA[i] = B[0] + B[1]*A[i] + ... + B[NEB-1]*A[i]^(NEB-1)
+ *   aSubClip          VALA[i] = A[i] limited to the range [B, C]
+ *   aSubThreshold     VALA[i] = A[i] >= B ? A[i] : C
+ *   aSubMovingAverage VALA[i] = mean of the last B elements of A up to A[i],
+ *                     where 1 <= B <= NEA
+ *   aSubDot           VALA = sum of A[i] * B[i]
+ *   aSubReduce        VALA = sum, VALB = mean, VALC = min, VALD = max of A
+ *
+ * The loops are written over contiguous arrays with no dependencies
+ * between iterations (or with several independent accumulators for the
+ * reductions) so that the compiler can vectorize them.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "alarm.h"
+#include "dbDefs.h"
+#include "dbAccess.h"
+#include "dbFldTypes.h"
+#include "recGbl.h"
+#include "registryFunction.h"
+#include "aSubRecord.h"
+#include "epicsExport.h"
+
+#define ARG(prec, i) ((&(prec)->a)[i])
+#define FT(prec, i) ((&(prec)->fta)[i])
+
+/* Value of the first element of a scalar argument as a double */
+static double scalarArg(aSubRecord *prec, int i)
+{
+    const void *p = ARG(prec, i);
+
+    switch (FT(prec, i)) {
+    case DBF_CHAR:   return *(const epicsInt8 *) p;
+    case DBF_UCHAR:  return *(const epicsUInt8 *) p;
+    case DBF_SHORT:  return *(const epicsInt16 *) p;
+    case DBF_USHORT:
+    case DBF_ENUM:   return *(const epicsUInt16 *) p;
+    case DBF_LONG:   return *(const epicsInt32 *) p;
+    case DBF_ULONG:  return *(const epicsUInt32 *) p;
+    case DBF_INT64:  return (double) *(const epicsInt64 *) p;
+    case DBF_UINT64: return (double) *(const epicsUInt64 *) p;
+    case DBF_FLOAT:  return *(const epicsFloat32 *) p;
+    case DBF_DOUBLE: return *(const epicsFloat64 *) p;
+    default:         return 0.0;
+    }
+}
+
+/* Type of the output, or -1 unless it is DOUBLE or FLOAT */
+static int outputType(aSubRecord *prec)
+{
+    int type = prec->ftva;
+
+    return (type == DBF_DOUBLE || type == DBF_FLOAT) ? type : -1;
+}
+
+static epicsUInt32 minCount(epicsUInt32 a, epicsUInt32 b)
+{
+    return a < b ? a : b;
+}
+
+/* Kernels, instantiated once for each floating point type */
+
+#define AXPY(T) \
+static void axpy_##T(T *y, const T *x, const T *c, T a, epicsUInt32 n) \
+{ \
+    epicsUInt32 i; \
+    for (i = 0; i < n; i++) \
+        y[i] = a * x[i] + c[i]; \
+}
+
+#define LINEAR(T) \
+static void linear_##T(T *y, const T *x, T m, T c, epicsUInt32 n) \
+{ \
+    epicsUInt32 i; \
+    for (i = 0; i < n; i++) \
+        y[i] = x[i] * m + c; \
+}
+
+/* Horner's rule, coefficients outermost so the element loop vectorizes */
+#define POLY(T) \
+static void poly_##T(T *y, const T *x, const T *coef, epicsUInt32 ncoef, \
+    epicsUInt32 n) \
+{ \
+    epicsUInt32 i, k; \
+    for (i = 0; i < n; i++) \
+        y[i] = coef[ncoef - 1]; \
+    for (k = ncoef - 1; k-- > 0; ) { \
+        T ck = coef[k]; \
+        for (i = 0; i < n; i++) \
+            y[i] = y[i] * x[i] + ck; \
+    } \
+}
+
+#define CLIP(T) \
+static void clip_##T(T *y, const T *x, T lo, T hi, epicsUInt32 n) \
+{ \
+    epicsUInt32 i; \
+    for (i = 0; i < n; i++) { \
+        T v = x[i] < lo ? lo : x[i]; \
+        y[i] = v > hi ? hi : v; \
+    } \
+}
+
+#define THRESHOLD(T) \
+static void threshold_##T(T *y, const T *x, T level, T other, epicsUInt32 n) \
+{ \
+    epicsUInt32 i; \
+    for (i = 0; i < n; i++) \
+        y[i] = x[i] >= level ? x[i] : other; \
+}
+
+/* Running sum; the sum is kept in double to limit rounding drift */
+#define MOVAVG(T) \
+static void movavg_##T(T *y, const T *x, epicsUInt32 width, epicsUInt32 n) \
+{ \
+    double sum = 0.0; \
+    epicsUInt32 i; \
+    for (i = 0; i < n && i < width; i++) { \
+        sum += x[i]; \
+        y[i] = (T) (sum / (i + 1)); \
+    } \
+    for (; i < n; i++) { \
+        sum += (double) x[i] - x[i - width]; \
+        y[i] = (T) (sum / width); \
+    } \
+}
+
+#define DOT(T) \
+static double dot_##T(const T *x, const T *z, epicsUInt32 n) \
+{ \
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0; \
+    epicsUInt32 i; \
+    for (i = 0; i + 4 <= n; i += 4) { \
+        s0 += (double) x[i]     * z[i]; \
+        s1 += (double) x[i + 1] * z[i + 1]; \
+        s2 += (double) x[i + 2] * z[i + 2]; \
+        s3 += (double) x[i + 3] * z[i + 3]; \
+    } \
+    for (; i < n; i++) \
+        s0 += (double) x[i] * z[i]; \
+    return (s0 + s1) + (s2 + s3); \
+}
+
+#define REDUCE(T) \
+static void reduce_##T(const T *x, epicsUInt32 n, double *psum, \
+    double *pmin, double *pmax) \
+{ \
+    double s0 = 0.0, s1 = 0.0; \
+    T lo0 = x[0], lo1 = x[0], hi0 = x[0], hi1 = x[0]; \
+    epicsUInt32 i; \
+    for (i = 0; i + 2 <= n; i += 2) { \
+        s0 += x[i]; \
+        s1 += x[i + 1]; \
+        if (x[i] < lo0) lo0 = x[i]; \
+        if (x[i + 1] < lo1) lo1 = x[i + 1]; \
+        if (x[i] > hi0) hi0 = x[i]; \
+        if (x[i + 1] > hi1) hi1 = x[i + 1]; \
+    } \
+    if (i < n) { \
+        s0 += x[i]; \
+        if (x[i] < lo0) lo0 = x[i]; \
+        if (x[i] > hi0) hi0 = x[i]; \
+    } \
+    *psum = s0 + s1; \
+    *pmin = lo1 < lo0 ? lo1 : lo0; \
+    *pmax = hi1 > hi0 ? hi1 : hi0; \
+}
+
+#define KERNELS(T) \
+    AXPY(T) LINEAR(T) POLY(T) CLIP(T) THRESHOLD(T) MOVAVG(T) DOT(T) REDUCE(T)
+
+KERNELS(epicsFloat64)
+KERNELS(epicsFloat32)
+
+/* Dispatch to the kernel for the output type */
+#define DISPATCH(type, CALL64, CALL32) \
+    switch (type) { \
+    case DBF_DOUBLE: CALL64; break; \
+    case DBF_FLOAT:  CALL32; break; \
+    default: return -1; \
+    }
+
+#define F64(p) ((epicsFloat64 *) (p))
+#define F32(p) ((epicsFloat32 *) (p))
+
+static long aSubAxpy(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    double a = scalarArg(prec, 0);
+    epicsUInt32 n = minCount(minCount(prec->neb, prec->nec), prec->nova);
+
+    if (prec->ftb != type || prec->ftc != type)
+        return -1;
+
+    DISPATCH(type,
+        axpy_epicsFloat64(F64(prec->vala), F64(prec->b), F64(prec->c), a, n),
+        axpy_epicsFloat32(F32(prec->vala), F32(prec->b), F32(prec->c),
+            (epicsFloat32) a, n))
+    prec->neva = n;
+    return 0;
+}
+
+static long aSubLinear(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    double m = scalarArg(prec, 1);
+    double c = scalarArg(prec, 2);
+    epicsUInt32 n = minCount(prec->nea, prec->nova);
+
+    if (prec->fta != type)
+        return -1;
+
+    DISPATCH(type,
+        linear_epicsFloat64(F64(prec->vala), F64(prec->a), m, c, n),
+        linear_epicsFloat32(F32(prec->vala), F32(prec->a),
+            (epicsFloat32) m, (epicsFloat32) c, n))
+    prec->neva = n;
+    return 0;
+}
+
+static long aSubPolynomial(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    epicsUInt32 n = minCount(prec->nea, prec->nova);
+
+    if (prec->fta != type || prec->ftb != type || prec->neb < 1)
+        return -1;
+
+    DISPATCH(type,
+        poly_epicsFloat64(F64(prec->vala), F64(prec->a), F64(prec->b),
+            prec->neb, n),
+        poly_epicsFloat32(F32(prec->vala), F32(prec->a), F32(prec->b),
+            prec->neb, n))
+    prec->neva = n;
+    return 0;
+}
+
+static long aSubClip(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    double lo = scalarArg(prec, 1);
+    double hi = scalarArg(prec, 2);
+    epicsUInt32 n = minCount(prec->nea, prec->nova);
+
+    if (prec->fta != type)
+        return -1;
+
+    DISPATCH(type,
+        clip_epicsFloat64(F64(prec->vala), F64(prec->a), lo, hi, n),
+        clip_epicsFloat32(F32(prec->vala), F32(prec->a),
+            (epicsFloat32) lo, (epicsFloat32) hi, n))
+    prec->neva = n;
+    return 0;
+}
+
+static long aSubThreshold(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    double level = scalarArg(prec, 1);
+    double other = scalarArg(prec, 2);
+    epicsUInt32 n = minCount(prec->nea, prec->nova);
+
+    if (prec->fta != type)
+        return -1;
+
+    DISPATCH(type,
+        threshold_epicsFloat64(F64(prec->vala), F64(prec->a), level, other, n),
+        threshold_epicsFloat32(F32(prec->vala), F32(prec->a),
+            (epicsFloat32) level, (epicsFloat32) other, n))
+    prec->neva = n;
+    return 0;
+}
+
+static long aSubMovingAverage(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    double width = scalarArg(prec, 1);
+    epicsUInt32 n = minCount(prec->nea, prec->nova);
+
+    if (prec->fta != type)
+        return -1;
+
+    /* the window must hold at least one element and fit in A */
+    if (!(width >= 1.0) || width > prec->nea) {
+        recGblSetSevr(prec, SOFT_ALARM, INVALID_ALARM);
+        return -1;
+    }
+
+    DISPATCH(type,
+        movavg_epicsFloat64(F64(prec->vala), F64(prec->a),
+            (epicsUInt32) width, n),
+        movavg_epicsFloat32(F32(prec->vala), F32(prec->a),
+            (epicsUInt32) width, n))
+    prec->neva = n;
+    return 0;
+}
+
+static long aSubDot(aSubRecord *prec)
+{
+    int type = outputType(prec);
+    epicsUInt32 n = minCount(prec->nea, prec->neb);
+    double dot;
+
+    if (prec->fta != type || prec->ftb != type || prec->nova < 1)
+        return -1;
+
+    DISPATCH(type,
+        dot = dot_epicsFloat64(F64(prec->a), F64(prec->b), n),
+        dot = dot_epicsFloat32(F32(prec->a), F32(prec->b), n))
+    if (type == DBF_DOUBLE)
+        *F64(prec->vala) = dot;
+    else
+        *F32(prec->vala) = (epicsFloat32) dot;
+    prec->neva = 1;
+    return 0;
+}
+
+/* Store a double result into the first element of output i */
+static void putResult(aSubRecord *prec, int i, double value)
+{
+    void *p = (&prec->vala)[i];
+
+    if ((&prec->nova)[i] < 1)
+        return;
+    if ((&prec->ftva)[i] == DBF_DOUBLE)
+        *F64(p) = value;
+    else if ((&prec->ftva)[i] == DBF_FLOAT)
+        *F32(p) = (epicsFloat32) value;
+    else
+        return;
+    (&prec->neva)[i] = 1;
+}
+
+static long aSubReduce(aSubRecord *prec)
+{
+    epicsUInt32 n = prec->nea;
+    double sum, lo, hi;
+
+    if (n < 1)
+        return -1;
+
+    switch (prec->fta) {
+    case DBF_DOUBLE:
+        reduce_epicsFloat64(F64(prec->a), n, &sum, &lo, &hi);
+        break;
+    case DBF_FLOAT:
+        reduce_epicsFloat32(F32(prec->a), n, &sum, &lo, &hi);
+        break;
+    default:
+        return -1;
+    }
+
+    putResult(prec, 0, sum);
+    putResult(prec, 1, sum / n);
+    putResult(prec, 2, lo);
+    putResult(prec, 3, hi);
+    return 0;
+}
+
+static registryFunctionRef aSubArrayRef[] = {
+    {"aSubAxpy", (REGISTRYFUNCTION) aSubAxpy},
+    {"aSubLinear", (REGISTRYFUNCTION) aSubLinear},
+    {"aSubPolynomial", (REGISTRYFUNCTION) aSubPolynomial},
+    {"aSubClip", (REGISTRYFUNCTION) aSubClip},
+    {"aSubThreshold", (REGISTRYFUNCTION) aSubThreshold},
+    {"aSubMovingAverage", (REGISTRYFUNCTION) aSubMovingAverage},
+    {"aSubDot", (REGISTRYFUNCTION) aSubDot},
+    {"aSubReduce", (REGISTRYFUNCTION) aSubReduce}
+};
+
+static void aSubArray(void)
+{
+    registryFunctionRefAdd(aSubArrayRef, NELEMENTS(aSubArrayRef));
+}
+epicsExportRegistrar(aSubArray);
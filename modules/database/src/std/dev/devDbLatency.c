@@ -0,0 +1,165 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *   Device support giving access to the latency histograms of the scan
+ *   tasks and queues, see dbLatency.h
+ *
+ *   ai INP "@<histogram> <figure>" where figure is one of COUNT, MEAN,
+ *   P50, P90, P99 or MAX.  The times are in seconds.
+ *
+ *   bo OUT "@<pattern>" clears the histograms whose names match the
+ *   glob pattern when written with 1.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "alarm.h"
+#include "cantProceed.h"
+#include "dbDefs.h"
+#include "dbAccess.h"
+#include "dbLatency.h"
+#include "epicsAtomic.h"
+#include "recGbl.h"
+#include "devSup.h"
+#include "epicsString.h"
+
+#include "aiRecord.h"
+#include "boRecord.h"
+#include "epicsExport.h"
+
+
+/********* ai record **********/
+enum ai_figure {COUNT, MEAN, P50, P90, P99, MAX};
+
+static const char * const ai_figures[] = {
+    "COUNT", "MEAN", "P50", "P90", "P99", "MAX"
+};
+
+struct ai_channel {
+    char name[40];
+    enum ai_figure figure;
+    dbLatencyHist *phist;   /* found on first read, the scan tasks
+                             * are started after the records */
+};
+
+static long init_ai(dbCommon *pcommon)
+{
+    aiRecord *prec = (aiRecord *)pcommon;
+    struct ai_channel *pchan;
+    char name[40];
+    char figure[8];
+    int i;
+
+    if (prec->inp.type != INST_IO) {
+        recGblRecordError(S_db_badField, (void *)prec,
+                          "devAiDbLatency::init_ai: Illegal INP field");
+        prec->pact = TRUE;
+        return S_db_badField;
+    }
+
+    if (sscanf(prec->inp.value.instio.string, "%39s %7s", name, figure) != 2) {
+        recGblRecordError(S_db_badField, (void *)prec,
+                          "devAiDbLatency::init_ai: Bad parm");
+        prec->pact = TRUE;
+        return S_db_badField;
+    }
+
+    for (i = 0; i < NELEMENTS(ai_figures); i++) {
+        if (!epicsStrCaseCmp(figure, ai_figures[i])) {
+            pchan = callocMustSucceed(1, sizeof(*pchan), "devAiDbLatency");
+            strcpy(pchan->name, name);
+            pchan->figure = i;
+            prec->dpvt = pchan;
+            return 0;
+        }
+    }
+
+    recGblRecordError(S_db_badField, (void *)prec,
+                      "devAiDbLatency::init_ai: Bad figure");
+    prec->pact = TRUE;
+    return S_db_badField;
+}
+
+static long read_ai(aiRecord *prec)
+{
+    struct ai_channel *pchan = (struct ai_channel *)prec->dpvt;
+    dbLatencyHist *phist;
+
+    if (!pchan) return -1;
+
+    if (!pchan->phist)
+        pchan->phist = dbLatencyFind(pchan->name);
+    phist = pchan->phist;
+    if (!phist) {
+        recGblSetSevr(prec, READ_ALARM, INVALID_ALARM);
+        return -1;
+    }
+
+    switch (pchan->figure) {
+    case COUNT:
+        prec->val = (double)epicsAtomicGetSizeT(&phist->count);
+        break;
+    case MEAN: {
+        size_t count = epicsAtomicGetSizeT(&phist->count);
+
+        prec->val = count ?
+            epicsAtomicGetSizeT(&phist->total) * 1e-6 / count : 0.0;
+        break;
+    }
+    case P50:
+        prec->val = dbLatencyPercentile(phist, 0.5);
+        break;
+    case P90:
+        prec->val = dbLatencyPercentile(phist, 0.9);
+        break;
+    case P99:
+        prec->val = dbLatencyPercentile(phist, 0.99);
+        break;
+    case MAX:
+        prec->val = epicsAtomicGetSizeT(&phist->max) * 1e-6;
+        break;
+    }
+    prec->udf = FALSE;
+    return 2;
+}
+
+aidset devAiDbLatency = {
+    {6, NULL, NULL, init_ai, NULL},
+    read_ai,  NULL
+};
+epicsExportAddress(dset, devAiDbLatency);
+
+
+/********* bo record **********/
+static long init_bo(dbCommon *pcommon)
+{
+    boRecord *prec = (boRecord *)pcommon;
+
+    if (prec->out.type != INST_IO) {
+        recGblRecordError(S_db_badField, (void *)prec,
+                          "devBoDbLatency::init_bo: Illegal OUT field");
+        prec->pact = TRUE;
+        return S_db_badField;
+    }
+    prec->mask = 0;
+    return 2;
+}
+
+static long write_bo(boRecord *prec)
+{
+    if (prec->val)
+        dbLatencyReset(prec->out.value.instio.string);
+    return 0;
+}
+
+bodset devBoDbLatency = {
+    {5, NULL, NULL, init_bo, NULL},
+    write_bo
+};
+epicsExportAddress(dset, devBoDbLatency);
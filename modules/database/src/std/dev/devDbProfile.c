@@ -0,0 +1,198 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *   Device support giving access to the per-record processing time
+ *   accounting, see dbProfile.h
+ *
+ *   ai INP "@<record> <figure>" where figure is one of COUNT, TIME,
+ *   SELF, MEAN, MAX, LOCK or LINK.  The times are in seconds.
+ *
+ *   bo OUT "@ENABLE" enables or disables profiling, and OUT "@RESET"
+ *   clears the figures of every record when written with 1.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "alarm.h"
+#include "cantProceed.h"
+#include "dbDefs.h"
+#include "dbAccess.h"
+#include "dbProfile.h"
+#include "recGbl.h"
+#include "devSup.h"
+#include "epicsString.h"
+
+#include "aiRecord.h"
+#include "boRecord.h"
+#include "epicsExport.h"
+
+
+/********* ai record **********/
+enum ai_figure {COUNT, TIME, SELF, MEAN, MAX, LOCK, LINK};
+
+static const char * const ai_figures[] = {
+    "COUNT", "TIME", "SELF", "MEAN", "MAX", "LOCK", "LINK"
+};
+
+struct ai_channel {
+    dbCommon *ptarget;
+    enum ai_figure figure;
+};
+
+static long init_ai(dbCommon *pcommon)
+{
+    aiRecord *prec = (aiRecord *)pcommon;
+    struct ai_channel *pchan;
+    char name[PVNAME_STRINGSZ];
+    char figure[8];
+    DBADDR addr;
+    int i;
+
+    if (prec->inp.type != INST_IO) {
+        recGblRecordError(S_db_badField, (void *)prec,
+                          "devAiDbProfile::init_ai: Illegal INP field");
+        prec->pact = TRUE;
+        return S_db_badField;
+    }
+
+    if (sscanf(prec->inp.value.instio.string, "%60s %7s", name, figure) != 2 ||
+        dbNameToAddr(name, &addr)) {
+        recGblRecordError(S_db_badField, (void *)prec,
+                          "devAiDbProfile::init_ai: Bad parm");
+        prec->pact = TRUE;
+        return S_db_badField;
+    }
+
+    for (i = 0; i < NELEMENTS(ai_figures); i++) {
+        if (!epicsStrCaseCmp(figure, ai_figures[i])) {
+            pchan = mallocMustSucceed(sizeof(*pchan), "devAiDbProfile");
+            pchan->ptarget = addr.precord;
+            pchan->figure = i;
+            prec->dpvt = pchan;
+            return 0;
+        }
+    }
+
+    recGblRecordError(S_db_badField, (void *)prec,
+                      "devAiDbProfile::init_ai: Bad figure");
+    prec->pact = TRUE;
+    return S_db_badField;
+}
+
+static long read_ai(aiRecord *prec)
+{
+    struct ai_channel *pchan = (struct ai_channel *)prec->dpvt;
+    dbProfileStats stats;
+
+    if (!pchan) return -1;
+
+    dbProfileGet(pchan->ptarget, &stats);
+    switch (pchan->figure) {
+    case COUNT:
+        prec->val = (double)stats.nProcess;
+        break;
+    case TIME:
+        prec->val = stats.processTime * 1e-9;
+        break;
+    case SELF:
+        prec->val = stats.processTime > stats.linkTime ?
+            (stats.processTime - stats.linkTime) * 1e-9 : 0.0;
+        break;
+    case MEAN:
+        prec->val = stats.nProcess ?
+            stats.processTime * 1e-9 / stats.nProcess : 0.0;
+        break;
+    case MAX:
+        prec->val = stats.processMax * 1e-9;
+        break;
+    case LOCK:
+        prec->val = stats.lockWait * 1e-9;
+        break;
+    case LINK:
+        prec->val = stats.linkTime * 1e-9;
+        break;
+    }
+    prec->udf = FALSE;
+    return 2;
+}
+
+aidset devAiDbProfile = {
+    {6, NULL, NULL, init_ai, NULL},
+    read_ai,  NULL
+};
+epicsExportAddress(dset, devAiDbProfile);
+
+
+/********* bo record **********/
+static void enableProfile(int val)
+{
+    dbProfileEnable(val);
+}
+
+static void resetProfile(int val)
+{
+    if (val)
+        dbProfileReset();
+}
+
+static struct bo_channel {
+    char *name;
+    void (*put)(int);
+} bo_channels[] = {
+    {"ENABLE", enableProfile},
+    {"RESET", resetProfile},
+};
+
+static long init_bo(dbCommon *pcommon)
+{
+    boRecord *prec = (boRecord *)pcommon;
+    int i;
+
+    if (prec->out.type != INST_IO) {
+        recGblRecordError(S_db_badField, (void *)prec,
+                          "devBoDbProfile::init_bo: Illegal OUT field");
+        prec->pact = TRUE;
+        return S_db_badField;
+    }
+
+    for (i = 0; i < NELEMENTS(bo_channels); i++) {
+        struct bo_channel *pchan = &bo_channels[i];
+        if (!epicsStrCaseCmp(prec->out.value.instio.string, pchan->name)) {
+            prec->dpvt = pchan;
+            prec->mask = 0;
+            if (pchan->put == enableProfile) {
+                prec->val = !!dbProfileIsEnabled();
+                prec->udf = FALSE;
+            }
+            return 2;
+        }
+    }
+
+    recGblRecordError(S_db_badField, (void *)prec,
+                      "devBoDbProfile::init_bo: Bad parm");
+    prec->pact = TRUE;
+    prec->dpvt = NULL;
+    return S_db_badField;
+}
+
+static long write_bo(boRecord *prec)
+{
+    struct bo_channel *pchan = (struct bo_channel *)prec->dpvt;
+
+    if (!pchan) return -1;
+
+    pchan->put(prec->val);
+    return 0;
+}
+
+bodset devBoDbProfile = {
+    {5, NULL, NULL, init_bo, NULL},
+    write_bo
+};
+epicsExportAddress(dset, devBoDbProfile);
@@ -12,6 +12,7 @@
  *      Author:     Janet Anderson
  *      Date:       07/02/91
  */
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -47,8 +48,44 @@ static long init_record(dbCommon *pcommon)
     return 0;
 }
 
+/* Work buffer for reading array inputs, kept in DPVT */
+typedef struct {
+    long nelm;
+    double buf[1];
+} histBuf;
+
+static long read_array(histogramRecord *prec, long nelements)
+{
+    histBuf *pbuf = (histBuf *)prec->dpvt;
+    long nRequest = nelements;
+
+    if (!pbuf || pbuf->nelm < nelements) {
+        free(pbuf);
+        pbuf = malloc(offsetof(histBuf, buf) + nelements * sizeof(double));
+        prec->dpvt = pbuf;
+        if (!pbuf)
+            return 2; /*don't add count*/
+        pbuf->nelm = nelements;
+    }
+
+    if (dbGetLink(&prec->svl, DBR_DOUBLE, pbuf->buf, 0, &nRequest) ||
+        nRequest <= 0)
+        return 2; /*don't add count*/
+
+    prec->sgnl = pbuf->buf[nRequest - 1];
+    histogramAddSamples(prec, pbuf->buf, nRequest);
+    return 2; /*already added*/
+}
+
 static long read_histogram(histogramRecord *prec)
 {
+    long nelements = 0;
+
+    if (!dbLinkIsConstant(&prec->svl) &&
+        !dbGetNelements(&prec->svl, &nelements) &&
+        nelements > 1)
+        return read_array(prec, nelements);
+
     dbGetLink(&prec->svl, DBR_DOUBLE, &prec->sgnl, 0, 0);
     return 0; /*add count*/
 }
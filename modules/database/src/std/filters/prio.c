@@ -0,0 +1,92 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Sets the priority class of the subscriptions made through a channel,
+ *  see db_add_event_class()
+ */
+
+#include <stdio.h>
+
+#include "freeList.h"
+#include "dbEvent.h"
+#include "chfPlugin.h"
+#include "epicsExport.h"
+
+typedef struct myStruct {
+    int evClass;
+} myStruct;
+
+static void *myStructFreeList;
+
+static const
+chfPluginEnumType classEnum[] = {
+    {"high", DB_EVENT_CLASS_HIGH},
+    {"normal", DB_EVENT_CLASS_NORMAL},
+    {"low", DB_EVENT_CLASS_LOW},
+    {NULL, 0}
+};
+
+static const
+chfPluginArgDef opts[] = {
+    chfEnum(myStruct, evClass, "c", 1, 0, classEnum),
+    chfPluginArgEnd
+};
+
+static void * allocPvt(void)
+{
+    myStruct *my = (myStruct*) freeListCalloc(myStructFreeList);
+    return (void *) my;
+}
+
+static void freePvt(void *pvt)
+{
+    freeListFree(myStructFreeList, pvt);
+}
+
+static long channel_open(dbChannel *chan, void *pvt)
+{
+    myStruct *my = (myStruct*) pvt;
+
+    chan->ev_class = (unsigned char) my->evClass;
+    return 0;
+}
+
+static void channel_report(dbChannel *chan, void *pvt, int level, const unsigned short indent)
+{
+    myStruct *my = (myStruct*) pvt;
+    printf("%*sPriority (prio): class=%s\n", indent, "",
+           chfPluginEnumString(classEnum, my->evClass, "n/a"));
+}
+
+static chfPluginIf pif = {
+    allocPvt,
+    freePvt,
+
+    NULL, /* parse_error, */
+    NULL, /* parse_ok, */
+
+    channel_open,
+    NULL, /* channelRegisterPre, */
+    NULL, /* channelRegisterPost, */
+    channel_report,
+    NULL /* channel_close */
+};
+
+static void prioInitialize(void)
+{
+    static int firstTime = 1;
+
+    if (!firstTime) return;
+    firstTime = 0;
+
+    if (!myStructFreeList)
+        freeListInitPvt(&myStructFreeList, sizeof(myStruct), 64);
+
+    chfPluginRegister("prio", &pif, opts);
+}
+
+epicsExportRegistrar(prioInitialize);
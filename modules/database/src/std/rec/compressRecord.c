@@ -137,21 +137,99 @@ static void put_value(compressRecord *prec, double *psource, int n)
 }
 
 
-/* qsort comparison function (for median calculation) */
-static int compare(const void *arg1, const void *arg2)
+/* The N to 1 reductions below keep four independent partial results
+ * so that the inner loops have no serial dependency between successive
+ * elements.  This lets the compiler keep several samples in flight and
+ * use packed SIMD instructions without requiring -ffast-math.
+ */
+static double lowest_value(const double *psource, epicsInt32 n)
+{
+    double v0 = psource[0], v1 = v0, v2 = v0, v3 = v0;
+    epicsInt32 j;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+        if (psource[j]     < v0) v0 = psource[j];
+        if (psource[j + 1] < v1) v1 = psource[j + 1];
+        if (psource[j + 2] < v2) v2 = psource[j + 2];
+        if (psource[j + 3] < v3) v3 = psource[j + 3];
+    }
+    for (; j < n; j++) {
+        if (psource[j] < v0) v0 = psource[j];
+    }
+    if (v1 < v0) v0 = v1;
+    if (v3 < v2) v2 = v3;
+    return v2 < v0 ? v2 : v0;
+}
+
+static double highest_value(const double *psource, epicsInt32 n)
+{
+    double v0 = psource[0], v1 = v0, v2 = v0, v3 = v0;
+    epicsInt32 j;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+        if (psource[j]     > v0) v0 = psource[j];
+        if (psource[j + 1] > v1) v1 = psource[j + 1];
+        if (psource[j + 2] > v2) v2 = psource[j + 2];
+        if (psource[j + 3] > v3) v3 = psource[j + 3];
+    }
+    for (; j < n; j++) {
+        if (psource[j] > v0) v0 = psource[j];
+    }
+    if (v1 > v0) v0 = v1;
+    if (v3 > v2) v2 = v3;
+    return v2 > v0 ? v2 : v0;
+}
+
+static double average_value(const double *psource, epicsInt32 n)
 {
-    double a = *(double *)arg1;
-    double b = *(double *)arg2;
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    epicsInt32 j;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+        s0 += psource[j];
+        s1 += psource[j + 1];
+        s2 += psource[j + 2];
+        s3 += psource[j + 3];
+    }
+    for (; j < n; j++)
+        s0 += psource[j];
+    return ((s0 + s1) + (s2 + s3)) / n;
+}
 
-    if      ( a <  b ) return -1;
-    else if ( a == b ) return  0;
-    else               return  1;
+/* Return the k-th smallest of the n elements in pwork (Hoare's
+ * selection algorithm, expected O(n)).  Partially reorders pwork.
+ */
+static double select_nth(double *pwork, epicsInt32 n, epicsInt32 k)
+{
+    epicsInt32 left = 0;
+    epicsInt32 right = n - 1;
+
+    while (left < right) {
+        double pivot = pwork[k];
+        epicsInt32 i = left;
+        epicsInt32 j = right;
+
+        do {
+            while (pwork[i] < pivot) i++;
+            while (pivot < pwork[j]) j--;
+            if (i <= j) {
+                double tmp = pwork[i];
+                pwork[i] = pwork[j];
+                pwork[j] = tmp;
+                i++;
+                j--;
+            }
+        } while (i <= j);
+        if (j < k) left = i;
+        if (k < i) right = j;
+    }
+    return pwork[k];
 }
 
 static int compress_array(compressRecord *prec,
     double *psource, int no_elements)
 {
-    epicsInt32 i,j;
+    epicsInt32 i;
     epicsInt32 n, nnew;
     epicsInt32 nsam = prec->nsam;
     double value;
@@ -179,43 +257,31 @@ static int compress_array(compressRecord *prec,
     switch (prec->alg){
     case compressALG_N_to_1_Low_Value:
         /* compress N to 1 keeping the lowest value */
-        for (i = 0; i < nnew; i++) {
-            value = *psource++;
-            for (j = 1; j < n; j++, psource++) {
-                if (value > *psource)
-                    value = *psource;
-            }
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = lowest_value(psource, n);
             put_value(prec, &value, 1);
         }
         break;
     case compressALG_N_to_1_High_Value:
         /* compress N to 1 keeping the highest value */
-        for (i = 0; i < nnew; i++){
-            value = *psource++;
-            for (j = 1; j < n; j++, psource++) {
-                if (value < *psource)
-                    value = *psource;
-            }
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = highest_value(psource, n);
             put_value(prec, &value, 1);
         }
         break;
     case compressALG_N_to_1_Average:
         /* compress N to 1 keeping the average value */
-        for (i = 0; i < nnew; i++) {
-            value = 0;
-            for (j = 0; j < n; j++, psource++)
-                value += *psource;
-            value /= n;
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = average_value(psource, n);
             put_value(prec, &value, 1);
         }
         break;
 
     case compressALG_N_to_1_Median:
         /* compress N to 1 keeping the median value */
-        /* note: sorts source array (OK; it's a work pointer) */
-        for (i = 0; i < nnew; i++, psource += nnew) {
-            qsort(psource, n, sizeof(double), compare);
-            value = psource[n / 2];
+        /* note: reorders source array (OK; it's a work pointer) */
+        for (i = 0; i < nnew; i++, psource += n) {
+            value = select_nth(psource, n, n / 2);
             put_value(prec, &value, 1);
         }
         break;
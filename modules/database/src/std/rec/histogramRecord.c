@@ -317,15 +317,8 @@ static long get_array_info(DBADDR *paddr, long *no_elements, long *offset)
     return 0;
 }
 
-static long add_count(histogramRecord *prec)
+static int check_limits(histogramRecord *prec)
 {
-    double temp;
-    epicsUInt32 *pdest;
-    int i;
-
-    if (prec->csta == FALSE)
-        return 0;
-
     if (prec->llim >= prec->ulim) {
         if (prec->nsev < INVALID_ALARM) {
             prec->stat = SOFT_ALARM;
@@ -333,21 +326,77 @@ static long add_count(histogramRecord *prec)
             return -1;
         }
     }
-    if (prec->sgnl < prec->llim ||
-        prec->sgnl >= prec->ulim)
+    return 0;
+}
+
+/* Increment the bin that value falls into; values outside the
+ * range [LLIM, ULIM) are ignored.  Returns 1 if a bin was counted.
+ */
+static int bin_value(histogramRecord *prec, double value)
+{
+    double temp;
+    epicsUInt32 *pdest;
+    epicsInt32 nelm = prec->nelm;
+    epicsInt32 i;
+
+    if (value < prec->llim ||
+        value >= prec->ulim)
         return 0;
 
-    temp = prec->sgnl - prec->llim;
-    for (i = 1; i <= prec->nelm; i++){
-        if (temp <= (double) i * prec->wdth)
-            break;
-    }
+    /* Bin i (counting from 1) is the first with temp <= i * wdth.
+     * Start from the quotient, then correct for rounding so the
+     * boundaries match a linear search exactly.
+     */
+    temp = value - prec->llim;
+    i = (prec->wdth > 0) ? (epicsInt32) (temp / prec->wdth) : 1;
+    if (i < 1)
+        i = 1;
+    if (i > nelm)
+        i = nelm;
+    while (i > 1 && temp <= (double) (i - 1) * prec->wdth)
+        i--;
+    while (i < nelm && temp > (double) i * prec->wdth)
+        i++;
+
     pdest = prec->bptr + i - 1;
     if (*pdest == (epicsUInt32) UINT_MAX)
         *pdest = 0;
     (*pdest)++;
-    prec->mcnt++;
+    return 1;
+}
+
+static long add_count(histogramRecord *prec)
+{
+    if (prec->csta == FALSE)
+        return 0;
+
+    if (check_limits(prec))
+        return -1;
+
+    prec->mcnt += bin_value(prec, prec->sgnl);
+    return 0;
+}
+
+long histogramAddSamples(histogramRecord *prec, const double *samples,
+    long count)
+{
+    epicsInt32 added = 0;
+    long i;
+
+    if (prec->csta == FALSE || count <= 0)
+        return 0;
+
+    if (check_limits(prec))
+        return -1;
+
+    for (i = 0; i < count; i++)
+        added += bin_value(prec, samples[i]);
 
+    /* MCNT is only compared against MDEL, so saturate it */
+    if (added > SHRT_MAX - prec->mcnt)
+        prec->mcnt = SHRT_MAX;
+    else
+        prec->mcnt += added;
     return 0;
 }
 
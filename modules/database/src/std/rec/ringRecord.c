@@ -0,0 +1,333 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* ringRecord.c - Record Support Routines for Ring Buffer records */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "dbDefs.h"
+#include "epicsPrint.h"
+#include "alarm.h"
+#include "dbAccess.h"
+#include "dbEvent.h"
+#include "dbFldTypes.h"
+#include "errMdef.h"
+#include "recSup.h"
+#include "recGbl.h"
+#include "special.h"
+#include "cantProceed.h"
+
+#define GEN_SIZE_OFFSET
+#include "ringRecord.h"
+#undef  GEN_SIZE_OFFSET
+#include "epicsExport.h"
+
+#define indexof(field) ringRecord##field
+
+/* Create RSET - Record Support Entry Table*/
+#define report NULL
+#define initialize NULL
+static long init_record(struct dbCommon *, int);
+static long process(struct dbCommon *);
+static long special(DBADDR *, int);
+#define get_value NULL
+static long cvt_dbaddr(DBADDR *);
+static long get_array_info(DBADDR *, long *, long *);
+static long put_array_info(DBADDR *, long);
+static long get_units(DBADDR *, char *);
+static long get_precision(const DBADDR *, long *);
+#define get_enum_str NULL
+#define get_enum_strs NULL
+#define put_enum_str NULL
+static long get_graphic_double(DBADDR *, struct dbr_grDouble *);
+static long get_control_double(DBADDR *, struct dbr_ctrlDouble *);
+#define get_alarm_double NULL
+
+rset ringRSET = {
+    RSETNUMBER,
+    report,
+    initialize,
+    init_record,
+    process,
+    special,
+    get_value,
+    cvt_dbaddr,
+    get_array_info,
+    put_array_info,
+    get_units,
+    get_precision,
+    get_enum_str,
+    get_enum_strs,
+    put_enum_str,
+    get_graphic_double,
+    get_control_double,
+    get_alarm_double
+};
+epicsExportAddress(rset,ringRSET);
+
+
+static void reset(ringRecord *prec)
+{
+    prec->nuse = 0;
+    prec->off = 0;
+    prec->tot = 0;
+}
+
+/* Copy n samples into the window after the newest one.  If more than
+ * NSAM samples are appended only the last NSAM are kept.
+ */
+static void append(ringRecord *prec, const char *psource, epicsUInt32 n)
+{
+    size_t size = dbValueSize(prec->ftvl);
+    epicsUInt32 nsam = prec->nsam;
+    epicsUInt32 off = prec->off;
+    char *pwin = prec->wptr;
+
+    prec->tot += n;
+    if (n > nsam) {
+        psource += (n - nsam) * size;
+        n = nsam;
+    }
+
+    prec->nuse += n;
+    if (prec->nuse > nsam)
+        prec->nuse = nsam;
+
+    /* at most two contiguous copies */
+    while (n) {
+        epicsUInt32 ncopy = nsam - off;
+
+        if (ncopy > n)
+            ncopy = n;
+        memcpy(pwin + off * size, psource, ncopy * size);
+        psource += ncopy * size;
+        n -= ncopy;
+        off = (off + ncopy) % nsam;
+    }
+    prec->off = off;
+}
+
+static void monitor(ringRecord *prec, epicsUInt32 nord, epicsUInt32 nuse,
+    epicsUInt32 nNew)
+{
+    unsigned short monitor_mask = recGblResetAlarms(prec);
+
+    if (prec->nord != nord)
+        db_post_events(prec, &prec->nord, DBE_VALUE | DBE_LOG);
+    if (prec->nuse != nuse)
+        db_post_events(prec, &prec->nuse, DBE_VALUE | DBE_LOG);
+
+    if (nNew > 0) {
+        monitor_mask |= DBE_VALUE | DBE_LOG;
+        db_post_events(prec, &prec->tot, DBE_VALUE | DBE_LOG);
+        db_post_events(prec, prec->wptr, monitor_mask);
+    }
+
+    if (monitor_mask)
+        db_post_events(prec, prec->bptr, monitor_mask);
+}
+
+/*Beginning of record support routines*/
+static long init_record(struct dbCommon *pcommon, int pass)
+{
+    ringRecord *prec = (ringRecord *)pcommon;
+
+    if (pass == 0) {
+        if (prec->nelm <= 0)
+            prec->nelm = 1;
+        if (prec->nsam <= 0)
+            prec->nsam = 1;
+        if (prec->ftvl > DBF_ENUM)
+            prec->ftvl = DBF_DOUBLE;
+        prec->bptr = callocMustSucceed(prec->nelm, dbValueSize(prec->ftvl),
+            "ring calloc failed");
+        prec->wptr = callocMustSucceed(prec->nsam, dbValueSize(prec->ftvl),
+            "ring calloc failed");
+        prec->nord = 0;
+        reset(prec);
+    }
+    return 0;
+}
+
+static long process(struct dbCommon *pcommon)
+{
+    ringRecord *prec = (ringRecord *)pcommon;
+    epicsUInt32 nord = prec->nord;
+    epicsUInt32 nuse = prec->nuse;
+    epicsUInt32 nNew;
+
+    prec->pact = TRUE;
+
+    if (!dbLinkIsConstant(&prec->inp)) {
+        long nRequest = prec->nelm;
+
+        if (dbGetLink(&prec->inp, prec->ftvl, prec->bptr, 0, &nRequest)) {
+            recGblSetSevr(prec, LINK_ALARM, INVALID_ALARM);
+            nRequest = 0;
+        }
+        prec->nord = nRequest;
+        nNew = prec->nord;
+    }
+    else {
+        /* only samples written to VAL since the last process are new */
+        nNew = prec->newv ? prec->nord : 0;
+    }
+    prec->newv = FALSE;
+
+    append(prec, prec->bptr, nNew);
+
+    prec->udf = FALSE;
+    recGblGetTimeStamp(prec);
+    monitor(prec, nord, nuse, nNew);
+    recGblFwdLink(prec);
+
+    prec->pact = FALSE;
+    return 0;
+}
+
+static long special(DBADDR *paddr, int after)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    if (!after)
+        return 0;
+
+    if (paddr->special == SPC_RESET) {
+        reset(prec);
+        db_post_events(prec, &prec->nuse, DBE_VALUE | DBE_LOG);
+        db_post_events(prec, &prec->tot, DBE_VALUE | DBE_LOG);
+        return 0;
+    }
+
+    recGblDbaddrError(S_db_badChoice, paddr, "ring: special");
+    return S_db_badChoice;
+}
+
+static long cvt_dbaddr(DBADDR *paddr)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    if (dbGetFieldIndex(paddr) == indexof(WIN)) {
+        paddr->pfield = prec->wptr;
+        paddr->no_elements = prec->nsam;
+        paddr->special = SPC_NOMOD;
+    }
+    else {
+        paddr->pfield = prec->bptr;
+        paddr->no_elements = prec->nelm;
+    }
+    paddr->field_type = prec->ftvl;
+    paddr->field_size = dbValueSize(prec->ftvl);
+    paddr->dbr_field_type = prec->ftvl;
+    return 0;
+}
+
+static long get_array_info(DBADDR *paddr, long *no_elements, long *offset)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    if (dbGetFieldIndex(paddr) == indexof(WIN)) {
+        epicsUInt32 nsam = prec->nsam;
+
+        /* OFF is where the next sample goes, the oldest is NUSE before */
+        *no_elements = prec->nuse;
+        *offset = (prec->off + nsam - prec->nuse) % nsam;
+    }
+    else {
+        *no_elements = prec->nord;
+        *offset = 0;
+    }
+    return 0;
+}
+
+static long put_array_info(DBADDR *paddr, long nNew)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    prec->nord = nNew;
+    if (prec->nord > prec->nelm)
+        prec->nord = prec->nelm;
+    prec->newv = TRUE;
+    return 0;
+}
+
+static long get_units(DBADDR *paddr, char *units)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    switch (dbGetFieldIndex(paddr)) {
+    case indexof(VAL):
+    case indexof(WIN):
+        if (prec->ftvl == DBF_STRING || prec->ftvl == DBF_ENUM)
+            break;
+    case indexof(HOPR):
+    case indexof(LOPR):
+        strncpy(units, prec->egu, DB_UNITS_SIZE);
+    }
+    return 0;
+}
+
+static long get_precision(const DBADDR *paddr, long *precision)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+    int fieldIndex = dbGetFieldIndex(paddr);
+
+    *precision = prec->prec;
+    if (fieldIndex != indexof(VAL) && fieldIndex != indexof(WIN))
+        recGblGetPrec(paddr, precision);
+    return 0;
+}
+
+static long get_graphic_double(DBADDR *paddr, struct dbr_grDouble *pgd)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    switch (dbGetFieldIndex(paddr)) {
+    case indexof(VAL):
+    case indexof(WIN):
+        pgd->upper_disp_limit = prec->hopr;
+        pgd->lower_disp_limit = prec->lopr;
+        break;
+    case indexof(NORD):
+        pgd->upper_disp_limit = prec->nelm;
+        pgd->lower_disp_limit = 0;
+        break;
+    case indexof(NUSE):
+        pgd->upper_disp_limit = prec->nsam;
+        pgd->lower_disp_limit = 0;
+        break;
+    default:
+        recGblGetGraphicDouble(paddr, pgd);
+    }
+    return 0;
+}
+
+static long get_control_double(DBADDR *paddr, struct dbr_ctrlDouble *pcd)
+{
+    ringRecord *prec = (ringRecord *) paddr->precord;
+
+    switch (dbGetFieldIndex(paddr)) {
+    case indexof(VAL):
+    case indexof(WIN):
+        pcd->upper_ctrl_limit = prec->hopr;
+        pcd->lower_ctrl_limit = prec->lopr;
+        break;
+    case indexof(NORD):
+        pcd->upper_ctrl_limit = prec->nelm;
+        pcd->lower_ctrl_limit = 0;
+        break;
+    case indexof(NUSE):
+        pcd->upper_ctrl_limit = prec->nsam;
+        pcd->lower_ctrl_limit = 0;
+        break;
+    default:
+        recGblGetControlDouble(paddr, pcd);
+    }
+    return 0;
+}
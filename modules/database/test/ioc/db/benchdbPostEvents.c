@@ -0,0 +1,223 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Scaling of db_post_events() with the number of threads posting, each
+ *  to its own record which is monitored through its own event task.
+ *
+ *  To place the threads, set BENCH_CPUS to a CPU list for each thread,
+ *  separated by spaces, e.g. "0 16 1 17" to alternate between sockets.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cantProceed.h"
+#include "dbAccess.h"
+#include "dbChannel.h"
+#include "dbEvent.h"
+#include "dbUnitTest.h"
+#include "epicsAtomic.h"
+#include "epicsEvent.h"
+#include "epicsMath.h"
+#include "epicsThread.h"
+#include "epicsTime.h"
+#include "errlog.h"
+
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+#define MAX_THREADS 8
+
+typedef struct {
+    struct dbChannel *chan;
+    dbEventCtx ctx;
+    dbEventSubscription sub;
+    size_t delivered;
+    char cpus[32];
+    epicsEventId start;
+    epicsEventId done;
+    size_t niter;
+    double seconds;
+} worker;
+
+static worker *workers[MAX_THREADS];
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void countEvent(void *user_arg, struct dbChannel *chan,
+    int eventsRemaining, struct db_field_log *pfl)
+{
+    worker *w = user_arg;
+
+    epicsAtomicIncrSizeT(&w->delivered);
+}
+
+static void postLoop(void *arg)
+{
+    worker *w = arg;
+    dbCommon *prec = dbChannelRecord(w->chan);
+    void *pfield = dbChannelField(w->chan);
+    epicsUInt64 start;
+    size_t i;
+
+    epicsEventMustWait(w->start);
+    start = epicsMonotonicGet();
+    for (i = 0; i < w->niter; i++) {
+        dbScanLock(prec);
+        db_post_events(prec, pfield, DBE_VALUE);
+        dbScanUnlock(prec);
+    }
+    w->seconds = (epicsMonotonicGet() - start) * 1e-9;
+    epicsEventMustTrigger(w->done);
+}
+
+static void setupWorkers(void)
+{
+    const char *cpus = getenv("BENCH_CPUS");
+    unsigned i;
+
+    for (i = 0; i < MAX_THREADS; i++) {
+        worker *w = callocMustSucceed(1, sizeof(*w), "setupWorkers");
+        char name[16];
+
+        if (cpus) {
+            size_t len;
+
+            cpus += strspn(cpus, " ");
+            len = strcspn(cpus, " ");
+            if (len >= sizeof(w->cpus))
+                len = sizeof(w->cpus) - 1;
+            memcpy(w->cpus, cpus, len);
+            cpus += len;
+        }
+
+        sprintf(name, "bench%u.VAL", i);
+        w->chan = dbChannelCreate(name);
+        if (!w->chan || dbChannelOpen(w->chan))
+            testAbort("Can't open %s", name);
+        w->ctx = db_init_events();
+        if (!w->ctx || db_start_events(w->ctx, "benchEvents", NULL, NULL,
+                epicsThreadPriorityMedium))
+            testAbort("Can't start event task");
+        w->sub = db_add_event(w->ctx, w->chan, countEvent, w, DBE_VALUE);
+        if (!w->sub)
+            testAbort("Can't subscribe to %s", name);
+        db_event_enable(w->sub);
+        w->start = epicsEventMustCreate(epicsEventEmpty);
+        w->done = epicsEventMustCreate(epicsEventEmpty);
+        workers[i] = w;
+    }
+}
+
+static void cleanupWorkers(void)
+{
+    unsigned i;
+
+    for (i = 0; i < MAX_THREADS; i++) {
+        worker *w = workers[i];
+
+        db_cancel_event(w->sub);
+        db_close_events(w->ctx);
+        dbChannelDelete(w->chan);
+        epicsEventDestroy(w->start);
+        epicsEventDestroy(w->done);
+        free(w);
+    }
+}
+
+static void runBench(unsigned nthreads, size_t niter, unsigned nrep)
+{
+    epicsThreadId tid[MAX_THREADS];
+    unsigned rep, i;
+    double sum = 0, sum2 = 0, mean;
+
+    testDiag("%u thread%s posting %lu events each, %u reps",
+             nthreads, nthreads == 1 ? "" : "s",
+             (unsigned long)niter, nrep);
+
+    for (rep = 0; rep < nrep; rep++) {
+        size_t posted = nthreads * niter, delivered = 0;
+        epicsUInt64 start;
+        double seconds, slowest = 0;
+
+        for (i = 0; i < nthreads; i++) {
+            epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+            worker *w = workers[i];
+
+            opts.priority = epicsThreadPriorityMedium;
+            opts.joinable = 1;
+            if (w->cpus[0])
+                opts.affinity = w->cpus;
+            w->niter = niter;
+            epicsAtomicSetSizeT(&w->delivered, 0);
+            tid[i] = epicsThreadCreateOpt("benchPost", postLoop, w, &opts);
+            if (!tid[i])
+                testAbort("Can't create thread");
+        }
+
+        start = epicsMonotonicGet();
+        for (i = 0; i < nthreads; i++)
+            epicsEventMustTrigger(workers[i]->start);
+        for (i = 0; i < nthreads; i++) {
+            epicsEventMustWait(workers[i]->done);
+            epicsThreadMustJoin(tid[i]);
+            if (workers[i]->seconds > slowest)
+                slowest = workers[i]->seconds;
+        }
+        seconds = (epicsMonotonicGet() - start) * 1e-9;
+
+        /* let the event tasks drain their queues */
+        epicsThreadSleep(0.1);
+        for (i = 0; i < nthreads; i++)
+            delivered += epicsAtomicGetSizeT(&workers[i]->delivered);
+
+        testDiag("%.3f s, %.0f posts/s, %.0f per thread, %.1f%% delivered",
+                 seconds, posted / seconds, niter / slowest,
+                 100.0 * delivered / posted);
+
+        sum += posted / seconds;
+        sum2 += (posted / seconds) * (posted / seconds);
+    }
+
+    mean = sum / nrep;
+    testDiag("Final: %u thread%s %.0f +- %.0f posts/s",
+             nthreads, nthreads == 1 ? "" : "s",
+             mean, sqrt(sum2 / nrep - mean * mean));
+}
+
+MAIN(benchdbPostEvents)
+{
+    unsigned i;
+
+    testPlan(0);
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    for (i = 0; i < MAX_THREADS; i++) {
+        char macros[16];
+
+        sprintf(macros, "N=%u", i);
+        testdbReadDatabase("benchdbPostEvents.db", NULL, macros);
+    }
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    setupWorkers();
+    testDiag("%u CPUs", epicsThreadGetCPUs());
+    for (i = 1; i <= MAX_THREADS; i *= 2)
+        runBench(i, 200000, 5);
+    cleanupWorkers();
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
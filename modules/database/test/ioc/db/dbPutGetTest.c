@@ -6,13 +6,17 @@
 
 #include <string.h>
 
+#include <epicsStdio.h>
 #include <errlog.h>
 #include <dbAccess.h>
+#include <dbLock.h>
 #include <dbStaticLib.h>
 #include <dbStaticPvt.h>
 #include <dbUnitTest.h>
 #include <testMain.h>
 
+#include "xRecord.h"
+
 static
 void testdbGetStringEqual(const char *pv, const char *expected)
 {
@@ -139,11 +143,125 @@ void testPutArr(void)
     testdbGetArrFieldEqual("arr", DBR_LONG, 4, 3, buf);
 }
 
+static epicsInt32 manyProcVal[3];
+static int manyProcCount[3];
+
+static
+void manyProc(xRecord *prec)
+{
+    int i = prec->name[4] - '1';
+
+    manyProcVal[i] = prec->val;
+    manyProcCount[i]++;
+}
+
+static
+void testPutGetMany(void)
+{
+    static const char *names[] = {
+        "many1.VAL", "many2.VAL", "many1.PROC", "many3.PROC",
+        "many1.PROC", "manydisp.VAL", "many3.VAL"
+    };
+    epicsInt32 vals[] = {1, 2, 1, 1, 1, 5, 3};
+    dbFieldRequest req[NELEMENTS(names)];
+    DBADDR addr[NELEMENTS(names)];
+    epicsInt32 got[3];
+    long status;
+    size_t i;
+
+    testDiag("testPutGetMany()");
+
+    testOk(dbLockGetLockId(testdbRecordPtr("many1")) ==
+        dbLockGetLockId(testdbRecordPtr("many3")),
+        "many1 and many3 share a lock set");
+
+    for (i = 0; i < 3; i++) {
+        char name[8];
+
+        epicsSnprintf(name, sizeof(name), "many%u", (unsigned)i + 1);
+        ((xRecord *)testdbRecordPtr(name))->clbk = &manyProc;
+    }
+
+    for (i = 0; i < NELEMENTS(names); i++) {
+        if (dbNameToAddr(names[i], &addr[i]))
+            testAbort("Missing record %s", names[i]);
+        req[i].paddr = &addr[i];
+        req[i].dbrType = DBR_LONG;
+        req[i].pbuffer = &vals[i];
+        req[i].nRequest = 1;
+    }
+
+    status = dbPutFieldMany(req, NELEMENTS(req));
+    testOk(status == S_db_putDisabled,
+        "dbPutFieldMany() -> %ld (first failure)", status);
+    for (i = 0; i < NELEMENTS(names); i++)
+        testOk(req[i].status == (i == 5 ? S_db_putDisabled : 0),
+            "%s status %ld", names[i], req[i].status);
+
+    testOk(manyProcCount[0] == 2 && manyProcCount[1] == 0 &&
+        manyProcCount[2] == 1, "processed %d, %d, %d times",
+        manyProcCount[0], manyProcCount[1], manyProcCount[2]);
+    testOk(manyProcVal[0] == 1 && manyProcVal[2] == 0,
+        "processed in request order, VAL %d, %d",
+        manyProcVal[0], manyProcVal[2]);
+    testdbGetFieldEqual("manydisp.VAL", DBR_LONG, 0);
+
+    for (i = 0; i < 3; i++) {
+        got[i] = -1;
+        req[i].paddr = &addr[i == 2 ? 6 : i];
+        req[i].pbuffer = &got[i];
+        req[i].options = 0;
+        req[i].nRequest = 1;
+    }
+    status = dbGetFieldMany(req, 3);
+    testOk(status == 0, "dbGetFieldMany() -> %ld", status);
+    testOk(got[0] == 1 && got[1] == 2 && got[2] == 3,
+        "values %d, %d, %d", got[0], got[1], got[2]);
+    testOk(req[0].nRequest == 1 && req[2].nRequest == 1,
+        "nRequest %ld, %ld", req[0].nRequest, req[2].nRequest);
+
+    testDiag("An empty batch is a no-op");
+    testOk1(dbPutFieldMany(req, 0) == 0);
+}
+
+static
+void testPutManyDisable(void)
+{
+    static const char *names[] = {
+        "manydisp2.DISP", "manydisp2.VAL", "many2.VAL"
+    };
+    epicsInt32 vals[] = {1, 7, 8};
+    dbFieldRequest req[NELEMENTS(names)];
+    DBADDR addr[NELEMENTS(names)];
+    long status;
+    size_t i;
+
+    testDiag("testPutManyDisable()");
+
+    for (i = 0; i < NELEMENTS(names); i++) {
+        if (dbNameToAddr(names[i], &addr[i]))
+            testAbort("Missing record %s", names[i]);
+        req[i].paddr = &addr[i];
+        req[i].dbrType = DBR_LONG;
+        req[i].pbuffer = &vals[i];
+        req[i].nRequest = 1;
+    }
+
+    status = dbPutFieldMany(req, NELEMENTS(req));
+    testOk(status == S_db_putDisabled,
+        "dbPutFieldMany() -> %ld (first failure)", status);
+    testOk(req[0].status == 0 && req[1].status == S_db_putDisabled &&
+        req[2].status == 0, "DISP set by an earlier put, status %ld, %ld, %ld",
+        req[0].status, req[1].status, req[2].status);
+    testdbGetFieldEqual("manydisp2.VAL", DBR_LONG, 0);
+    testdbGetFieldEqual("many2.VAL", DBR_LONG, 8);
+}
+
 void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
 
 MAIN(dbPutGet)
 {
-    testPlan(44);
+    testPlan(64);
     testdbPrepare();
 
     testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
@@ -164,6 +282,9 @@ MAIN(dbPutGet)
 
     testPutArr();
 
+    testPutGetMany();
+    testPutManyDisable();
+
     testIocShutdownOk();
 
     testdbCleanup();
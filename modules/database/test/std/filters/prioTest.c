@@ -0,0 +1,188 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <string.h>
+
+#include "dbStaticLib.h"
+#include "dbAccess.h"
+#include "db_field_log.h"
+#include "dbCommon.h"
+#include "dbChannel.h"
+#include "dbEvent.h"
+#include "registry.h"
+#include "chfPlugin.h"
+#include "errlog.h"
+#include "dbmf.h"
+#include "epicsAtomic.h"
+#include "epicsEvent.h"
+#include "epicsThread.h"
+#include "epicsUnitTest.h"
+#include "dbUnitTest.h"
+#include "testMain.h"
+
+void filterTest_registerRecordDeviceDriver(struct dbBase *);
+
+typedef struct {
+    unsigned evClass;
+    dbEventSubscription es;
+    int count;
+} subscription;
+
+static unsigned order[8];
+static int nDelivered;
+static epicsEventId delivered;
+
+static void evCallback(void *user_arg, struct dbChannel *chan,
+    int eventsRemaining, struct db_field_log *pfl)
+{
+    subscription *sub = (subscription *) user_arg;
+    int n = epicsAtomicGetIntT(&nDelivered);
+
+    if (n < NELEMENTS(order))
+        order[n] = sub->evClass;
+    epicsAtomicIncrIntT(&sub->count);
+    epicsAtomicIncrIntT(&nDelivered);
+    epicsEventMustTrigger(delivered);
+}
+
+static void subscribe(dbEventCtx evtctx, subscription *sub, dbChannel *pch,
+    unsigned evClass)
+{
+    memset(sub, 0, sizeof(*sub));
+    sub->es = db_add_event_class(evtctx, pch, evCallback, sub, DBE_VALUE,
+        evClass);
+    if (!sub->es)
+        testAbort("db_add_event_class failed");
+    sub->evClass = db_event_class(sub->es);
+    db_event_enable(sub->es);
+}
+
+static void waitFor(int n)
+{
+    int i;
+
+    for (i = 0; i < 50 && epicsAtomicGetIntT(&nDelivered) < n; i++)
+        epicsEventWaitWithTimeout(delivered, 0.1);
+}
+
+MAIN(prioTest)
+{
+    dbChannel *pchLow, *pchPlain;
+    const chFilterPlugin *plug;
+    char myname[] = "prio";
+    dbEventCtx evtctx;
+    subscription low, normal, high;
+    dbCommon *prec;
+
+    testPlan(22);
+
+    testdbPrepare();
+
+    testdbReadDatabase("filterTest.dbd", NULL, NULL);
+
+    filterTest_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("xRecord.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    delivered = epicsEventMustCreate(epicsEventEmpty);
+    evtctx = db_init_events();
+
+    testOk(!!(plug = dbFindFilter(myname, strlen(myname))),
+        "plugin '%s' registered correctly", myname);
+
+    /* Bad parms */
+    testOk(!dbChannelCreate("x.VAL{\"prio\":{}}"),
+           "dbChannel with prio (no parm) failed");
+    testOk(!dbChannelCreate("x.VAL{\"prio\":{\"c\":\"urgent\"}}"),
+           "dbChannel with prio (c=urgent) failed");
+
+    testOk(!!(pchLow = dbChannelCreate("x.VAL{\"prio\":{\"c\":\"low\"}}")),
+           "dbChannel with plugin prio (c=low) created");
+    testOk(!(dbChannelOpen(pchLow)), "dbChannel with plugin prio opened");
+    testOk(pchLow->ev_class == DB_EVENT_CLASS_LOW,
+           "channel has class %u", pchLow->ev_class);
+    testOk((ellCount(&pchLow->pre_chain) == 0 &&
+            ellCount(&pchLow->post_chain) == 0),
+           "prio has no filter in pre or post chain");
+
+    testOk(!!(pchPlain = dbChannelCreate("x.VAL")), "plain dbChannel created");
+    testOk(!(dbChannelOpen(pchPlain)), "plain dbChannel opened");
+    prec = dbChannelRecord(pchPlain);
+
+    testDiag("Subscription classes");
+
+    subscribe(evtctx, &low, pchLow, DB_EVENT_CLASS_DEFAULT);
+    subscribe(evtctx, &normal, pchPlain, DB_EVENT_CLASS_DEFAULT);
+    subscribe(evtctx, &high, pchPlain, DB_EVENT_CLASS_HIGH);
+    testOk(low.evClass == DB_EVENT_CLASS_LOW,
+           "class from filter is %s", db_event_class_name(low.evClass));
+    testOk(normal.evClass == DB_EVENT_CLASS_NORMAL,
+           "default class is %s", db_event_class_name(normal.evClass));
+    testOk(high.evClass == DB_EVENT_CLASS_HIGH,
+           "given class is %s", db_event_class_name(high.evClass));
+
+    testDiag("Delivery order");
+
+    /* queued before the event task starts, lowest class first */
+    dbScanLock(prec);
+    db_post_events(prec, NULL, DBE_VALUE);
+    dbScanUnlock(prec);
+
+    testOk(!db_start_events(evtctx, "prioTest", NULL, NULL,
+           epicsThreadPriorityMedium), "event task started");
+    waitFor(3);
+    testOk(nDelivered == 3, "3 events delivered (%d)", nDelivered);
+    testOk(order[0] == DB_EVENT_CLASS_HIGH && order[1] == DB_EVENT_CLASS_NORMAL &&
+           order[2] == DB_EVENT_CLASS_LOW,
+           "delivered in order %s, %s, %s", db_event_class_name(order[0]),
+           db_event_class_name(order[1]), db_event_class_name(order[2]));
+
+    testDiag("Rate limit");
+
+    db_cancel_event(normal.es);
+    db_cancel_event(high.es);
+
+    testOk(db_event_class_rate(DB_EVENT_CLASS_DEFAULT, 1.0) == DB_EVENT_ERROR,
+           "no rate limit for the default class");
+    testOk(db_event_class_rate(DB_EVENT_CLASS_LOW, -1.0) == DB_EVENT_ERROR,
+           "no negative rate limit");
+    testOk(dbEventClassRate("low", 2.0) == DB_EVENT_OK,
+           "low class limited to 2 events/sec");
+
+    epicsAtomicSetIntT(&nDelivered, 0);
+    dbScanLock(prec);
+    db_post_events(prec, NULL, DBE_VALUE);
+    db_post_events(prec, NULL, DBE_VALUE);
+    db_post_events(prec, NULL, DBE_VALUE);
+    dbScanUnlock(prec);
+
+    epicsThreadSleep(0.2);
+    testOk(nDelivered >= 1 && nDelivered < 3,
+           "%d of 3 events delivered at once", nDelivered);
+    waitFor(3);
+    testOk(nDelivered == 3, "3 events delivered later (%d)", nDelivered);
+
+    testOk(dbEventClassRate("low", 0.0) == DB_EVENT_OK,
+           "low class rate limit removed");
+    testOk(dbEventClassRate("bulk", 0.0) == DB_EVENT_ERROR,
+           "unknown class name rejected");
+
+    db_cancel_event(low.es);
+    db_close_events(evtctx);
+    dbChannelDelete(pchLow);
+    dbChannelDelete(pchPlain);
+    epicsEventDestroy(delivered);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    return testDone();
+}
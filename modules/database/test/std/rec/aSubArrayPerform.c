@@ -0,0 +1,164 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Compare the time taken by the aSub array math subroutines with
+ * straightforward scalar loops doing the same work.
+ */
+
+#include <stdlib.h>
+
+#include "dbUnitTest.h"
+#include "testMain.h"
+#include "dbLock.h"
+#include "errlog.h"
+#include "dbAccess.h"
+#include "epicsStdio.h"
+#include "epicsTime.h"
+
+#include "aSubRecord.h"
+
+#define NELEM 1000000
+#define NLOOPS 20
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+/* Naive versions of the same algorithms */
+
+static void naiveLinear(aSubRecord *prec)
+{
+    double *x = prec->a, *y = prec->vala;
+    double m = *(double *) prec->b, c = *(double *) prec->c;
+    epicsUInt32 i;
+
+    for (i = 0; i < prec->nea; i++)
+        y[i] = x[i] * m + c;
+    prec->neva = prec->nea;
+}
+
+static void naivePoly(aSubRecord *prec)
+{
+    double *x = prec->a, *coef = prec->b, *y = prec->vala;
+    epicsUInt32 i, k;
+
+    for (i = 0; i < prec->nea; i++) {
+        double sum = 0.0, xk = 1.0;
+
+        for (k = 0; k < prec->neb; k++) {
+            sum += coef[k] * xk;
+            xk *= x[i];
+        }
+        y[i] = sum;
+    }
+    prec->neva = prec->nea;
+}
+
+static void naiveDot(aSubRecord *prec)
+{
+    double *x = prec->a, *z = prec->b, sum = 0.0;
+    epicsUInt32 i;
+
+    for (i = 0; i < prec->nea; i++)
+        sum += x[i] * z[i];
+    *(double *) prec->vala = sum;
+}
+
+static void naiveReduce(aSubRecord *prec)
+{
+    double *x = prec->a, sum = 0.0, lo = x[0], hi = x[0];
+    epicsUInt32 i;
+
+    for (i = 0; i < prec->nea; i++) {
+        sum += x[i];
+        if (x[i] < lo) lo = x[i];
+        if (x[i] > hi) hi = x[i];
+    }
+    *(double *) prec->vala = sum;
+    *(double *) prec->valb = sum / prec->nea;
+    *(double *) prec->valc = lo;
+    *(double *) prec->vald = hi;
+}
+
+static const struct {
+    const char *name;
+    void (*naive)(aSubRecord *prec);
+} algs[] = {
+    {"linear", naiveLinear},
+    {"poly", naivePoly},
+    {"dot", naiveDot},
+    {"reduce", naiveReduce},
+};
+
+static void fill(double *p, epicsUInt32 n)
+{
+    epicsUInt32 i;
+
+    for (i = 0; i < n; i++)
+        p[i] = rand() / (RAND_MAX + 1.0) - 0.5;
+}
+
+MAIN(aSubArrayPerform)
+{
+    char macros[20];
+    unsigned i, j;
+
+    testPlan(0);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    epicsSnprintf(macros, sizeof(macros), "N=%d", NELEM);
+    testdbReadDatabase("aSubArrayPerform.db", NULL, macros);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testDiag("%d elements, %d loops", NELEM, NLOOPS);
+    testDiag("%10s %14s %14s", "function", "aSub (us)", "naive (us)");
+
+    for (i = 0; i < NELEMENTS(algs); i++) {
+        aSubRecord *prec = (aSubRecord *)testdbRecordPtr(algs[i].name);
+        epicsUInt64 tsub = 0, tnaive = 0;
+
+        dbScanLock((dbCommon *)prec);
+        fill(prec->a, NELEM);
+        if (prec->nob > 1)
+            fill(prec->b, prec->nob);
+        prec->nea = NELEM;
+        prec->neb = prec->nob;
+        /* touch the output buffers before timing */
+        algs[i].naive(prec);
+
+        for (j = 0; j < NLOOPS; j++) {
+            epicsUInt64 start;
+
+            /* call the subroutine directly, as process() would */
+            prec->nea = NELEM;
+            prec->neb = prec->nob;
+            start = epicsMonotonicGet();
+            ((long (*)(aSubRecord *))prec->sadr)(prec);
+            tsub += epicsMonotonicGet() - start;
+
+            start = epicsMonotonicGet();
+            algs[i].naive(prec);
+            tnaive += epicsMonotonicGet() - start;
+        }
+        dbScanUnlock((dbCommon *)prec);
+
+        testDiag("%10s %14.1f %14.1f", algs[i].name,
+            tsub * 1e-3 / NLOOPS, tnaive * 1e-3 / NLOOPS);
+    }
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    return testDone();
+}
@@ -0,0 +1,96 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include "dbUnitTest.h"
+#include "testMain.h"
+#include "dbAccess.h"
+#include "errlog.h"
+#include "alarm.h"
+#include "epicsStdio.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static
+void testArray(const char *rec, short dbrType, unsigned long cnt,
+    const void *expect)
+{
+    char field[40];
+
+    testDiag("%s", rec);
+    epicsSnprintf(field, sizeof(field), "%s.PROC", rec);
+    testdbPutFieldOk(field, DBF_LONG, 1);
+    epicsSnprintf(field, sizeof(field), "%s.VALA", rec);
+    testdbGetArrFieldEqual(field, dbrType, cnt + 1, cnt, expect);
+}
+
+MAIN(aSubArrayTest)
+{
+    static const epicsFloat64 x[] = {-2, -1, 0, 1, 2, 3};
+    static const epicsFloat32 xf[] = {-2, -1, 0, 1, 2, 3};
+    static const epicsFloat64 y[] = {1, 1, 1, 1, 1, 1};
+    static const epicsFloat64 coef[] = {1, 0, 2};
+
+    static const epicsFloat64 axpy[] = {-3, -1, 1, 3, 5, 7};
+    static const epicsFloat32 linear[] = {0, 0.5, 1, 1.5, 2, 2.5};
+    static const epicsFloat64 poly[] = {9, 3, 1, 3, 9, 19};
+    static const epicsFloat64 clip[] = {-1, -1, 0, 1, 2, 2};
+    static const epicsFloat64 thresh[] = {0, 0, 0, 0, 2, 3};
+    static const epicsFloat64 movavg[] = {-2, -1.5, -0.5, 0.5, 1.5, 2.5};
+    static const epicsFloat64 dot[] = {3};
+
+    testPlan(32);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("aSubArrayTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testdbPutArrFieldOk("x", DBF_DOUBLE, NELEMENTS(x), x);
+    testdbPutArrFieldOk("xf", DBF_FLOAT, NELEMENTS(xf), xf);
+    testdbPutArrFieldOk("y", DBF_DOUBLE, NELEMENTS(y), y);
+    testdbPutArrFieldOk("coef", DBF_DOUBLE, NELEMENTS(coef), coef);
+
+    testArray("axpy", DBF_DOUBLE, NELEMENTS(axpy), axpy);
+    testArray("linear", DBF_FLOAT, NELEMENTS(linear), linear);
+    testArray("poly", DBF_DOUBLE, NELEMENTS(poly), poly);
+    testArray("clip", DBF_DOUBLE, NELEMENTS(clip), clip);
+    testArray("thresh", DBF_DOUBLE, NELEMENTS(thresh), thresh);
+    testArray("movavg", DBF_DOUBLE, NELEMENTS(movavg), movavg);
+    testArray("dot", DBF_DOUBLE, NELEMENTS(dot), dot);
+
+    testDiag("reduce");
+    testdbPutFieldOk("reduce.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("reduce.VALA", DBF_DOUBLE, 3.0);
+    testdbGetFieldEqual("reduce.VALB", DBF_DOUBLE, 0.5);
+    testdbGetFieldEqual("reduce.VALC", DBF_DOUBLE, -2.0);
+    testdbGetFieldEqual("reduce.VALD", DBF_DOUBLE, 3.0);
+
+    testDiag("Unsupported array type");
+    testdbPutFieldOk("badtype.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("badtype.SEVR", DBF_LONG, INVALID_ALARM);
+    testdbGetFieldEqual("badtype.VAL", DBF_LONG, -1);
+
+    testDiag("Moving average width out of range");
+    testdbPutFieldOk("movavgzero.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("movavgzero.SEVR", DBF_LONG, INVALID_ALARM);
+    testdbGetFieldEqual("movavgzero.VAL", DBF_LONG, -1);
+    testdbPutFieldOk("movavgwide.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("movavgwide.SEVR", DBF_LONG, INVALID_ALARM);
+    testdbGetFieldEqual("movavgwide.VAL", DBF_LONG, -1);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    return testDone();
+}
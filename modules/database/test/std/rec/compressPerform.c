@@ -0,0 +1,114 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Measure the time taken by one process() of the compress record's
+ * N to 1 algorithms for input arrays of 1k to 10M samples.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dbUnitTest.h"
+#include "testMain.h"
+#include "dbLock.h"
+#include "errlog.h"
+#include "dbAccess.h"
+#include "epicsStdio.h"
+#include "epicsTime.h"
+
+#include "waveformRecord.h"
+#include "compressRecord.h"
+
+#define NSAM 1000
+#define MAXELEM 10000000
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static const char * const algs[] = {"low", "high", "avg", "med"};
+
+static
+double timeProcess(waveformRecord *wrec, compressRecord *crec,
+    const double *src, long nelem, unsigned nloops)
+{
+    epicsUInt64 elapsed = 0;
+    unsigned i;
+
+    for (i = 0; i < nloops; i++) {
+        epicsUInt64 start;
+
+        /* the median reorders its work array, so refill the source */
+        memcpy(wrec->bptr, src, nelem * sizeof(double));
+        wrec->nord = nelem;
+
+        start = epicsMonotonicGet();
+        dbProcess((dbCommon *)crec);
+        elapsed += epicsMonotonicGet() - start;
+    }
+    return elapsed * 1e-3 / nloops;
+}
+
+MAIN(compressPerform)
+{
+    char macros[40];
+    waveformRecord *wrec;
+    double *src;
+    long nelem;
+    unsigned i;
+
+    testPlan(0);
+
+    src = malloc(MAXELEM * sizeof(double));
+    if (!src)
+        testAbort("Can't allocate %d samples", MAXELEM);
+    for (i = 0; i < MAXELEM; i++)
+        src[i] = rand() / (RAND_MAX + 1.0);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    epicsSnprintf(macros, sizeof(macros), "NELM=%d,NSAM=%d", MAXELEM, NSAM);
+    testdbReadDatabase("compressPerform.db", NULL, macros);
+
+    wrec = (waveformRecord *)testdbRecordPtr("wf");
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testDiag("%10s %12s %12s %12s %12s", "samples",
+        "low (us)", "high (us)", "avg (us)", "med (us)");
+
+    for (nelem = 1000; nelem <= MAXELEM; nelem *= 10) {
+        epicsInt32 n = nelem > NSAM ? nelem / NSAM : 1;
+        unsigned nloops = nelem >= 1000000 ? 10 : 100;
+        double usec[NELEMENTS(algs)];
+
+        for (i = 0; i < NELEMENTS(algs); i++) {
+            compressRecord *crec = (compressRecord *)testdbRecordPtr(algs[i]);
+
+            dbScanLock((dbCommon *)crec);
+            crec->n = n;
+            /* first pass sizes the work buffer */
+            timeProcess(wrec, crec, src, nelem, 1);
+            usec[i] = timeProcess(wrec, crec, src, nelem, nloops);
+            dbScanUnlock((dbCommon *)crec);
+        }
+
+        testDiag("%10ld %12.1f %12.1f %12.1f %12.1f", nelem,
+            usec[0], usec[1], usec[2], usec[3]);
+    }
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    free(src);
+    return testDone();
+}
@@ -11,6 +11,7 @@
 #include "errlog.h"
 #include "dbAccess.h"
 #include "epicsMath.h"
+#include "epicsStdio.h"
 
 #include "aiRecord.h"
 #include "compressRecord.h"
@@ -346,10 +347,52 @@ void testLIFOCirc(void)
     testdbCleanup();
 }
 
+static
+void testNto1Array(const char *alg, double a, double b, double c, double d)
+{
+    /* 4 bins of 5 samples, out of order to exercise the median */
+    static const double input[20] = {
+         3.0,  1.0,  2.0,  5.0,  4.0,
+        -7.0,  9.0,  8.0,  6.0, 10.0,
+        15.0, 11.0, 14.0, 12.0, 13.0,
+         0.5,  0.25, 0.0, -0.5, -0.25,
+    };
+    char macros[80];
+
+    testDiag("Test %s with array input", alg);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    epicsSnprintf(macros, sizeof(macros),
+        "ALG=%s,BALG=FIFO Buffer,NSAM=4,N=5", alg);
+    testdbReadDatabase("compressTest.db", NULL, macros);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testdbPutArrFieldOk("wf", DBF_DOUBLE, NELEMENTS(input), input);
+    testdbPutFieldOk("compwf.PROC", DBF_LONG, 1);
+
+    checkArrD("compwf", 4, a, b, c, d);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
 MAIN(compressTest)
 {
-    testPlan(116);
+    testPlan(128);
     testFIFOCirc();
     testLIFOCirc();
+    testNto1Array("N to 1 Low Value", 1.0, -7.0, 11.0, -0.5);
+    testNto1Array("N to 1 High Value", 5.0, 10.0, 15.0, 0.5);
+    testNto1Array("N to 1 Average", 3.0, 5.2, 13.0, 0.0);
+    testNto1Array("N to 1 Median", 3.0, 8.0, 13.0, 0.0);
     return testDone();
 }
@@ -203,6 +203,7 @@
 #include <registryIocRegister.h>
 #include <registryJLinks.h>
 #include <registryRecordType.h>
+#include <ringRecord.h>
 #ifdef __cplusplus
 #  include <resourceLib.h>
 #endif
@@ -0,0 +1,154 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <math.h>
+
+#include "dbUnitTest.h"
+#include "testMain.h"
+#include "dbAccess.h"
+#include "dbLatency.h"
+#include "dbScan.h"
+#include "callback.h"
+#include "alarm.h"
+#include "epicsEvent.h"
+#include "epicsThread.h"
+#include "errlog.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static
+void testHistogram(void)
+{
+    dbLatencyHist hist;
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    dbLatencyRegister(&hist, "test");
+    testOk1(dbLatencyFind("test") == &hist);
+    testOk1(dbLatencyFind("tes") == NULL);
+    testOk1(dbLatencyPercentile(&hist, 0.5) == 0.0);
+
+    dbLatencyAdd(&hist, 500);           /* < 1us */
+    dbLatencyAdd(&hist, 1500);          /* 1us */
+    dbLatencyAdd(&hist, 3000);          /* 2..4us */
+    dbLatencyAdd(&hist, 3999);          /* 2..4us */
+    dbLatencyAdd(&hist, 100000);        /* 64..128us */
+
+    testOk(hist.count == 5, "count %lu", (unsigned long)hist.count);
+    testOk(hist.total == 107, "total %lu", (unsigned long)hist.total);
+    testOk(hist.max == 100, "max %lu", (unsigned long)hist.max);
+    testOk1(hist.bucket[0] == 1);
+    testOk1(hist.bucket[1] == 1);
+    testOk1(hist.bucket[2] == 2);
+    testOk1(hist.bucket[7] == 1);
+    testOk(dbLatencyPercentile(&hist, 0.5) == 4e-6, "median %g",
+        dbLatencyPercentile(&hist, 0.5));
+    testOk(fabs(dbLatencyPercentile(&hist, 0.99) - 100e-6) < 1e-12, "99%% %g",
+        dbLatencyPercentile(&hist, 0.99));
+
+    dbLatencyAdd(&hist, 1000000000000ull);
+    testOk1(hist.bucket[DB_LATENCY_BUCKETS - 1] == 1);
+
+    dbLatencyReset("te*");
+    testOk1(hist.count == 0 && hist.max == 0 && hist.bucket[2] == 0);
+
+    dbLatencyUnregister(&hist);
+    testOk1(dbLatencyFind("test") == NULL);
+}
+
+static epicsEventId onceDone;
+
+static
+void onceComplete(void *usr, struct dbCommon *prec)
+{
+    epicsEventMustTrigger(onceDone);
+}
+
+static
+void callbackDone(epicsCallback *pcallback)
+{
+    epicsEventMustTrigger(onceDone);
+}
+
+static
+void testScan(void)
+{
+    dbLatencyHist *phist;
+    epicsCallback cb;
+    int i;
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    onceDone = epicsEventMustCreate(epicsEventEmpty);
+
+    testOk1(dbLatencyFind("cbLow") != NULL);
+    testOk1(dbLatencyFind("ioHigh") != NULL);
+
+    testOk1(!scanOnceCallback(testdbRecordPtr("once"), onceComplete, NULL));
+    epicsEventMustWait(onceDone);
+    phist = dbLatencyFind("scanOnce");
+    testOk(phist && phist->count == 1, "scanOnce delay recorded");
+
+    callbackSetCallback(callbackDone, &cb);
+    callbackSetPriority(priorityLow, &cb);
+    testOk1(!callbackRequest(&cb));
+    epicsEventMustWait(onceDone);
+    phist = dbLatencyFind("cbLow");
+    testOk(phist && phist->count >= 1, "callback delay recorded");
+
+    for (i = 0; i < 50; i++) {
+        phist = dbLatencyFind("scan-0.1-exec");
+        if (phist && phist->count >= 2)
+            break;
+        epicsThreadSleep(0.1);
+    }
+    testOk(phist && phist->count >= 2, "periodic scan timed");
+    phist = dbLatencyFind("scan-0.1-wake");
+    testOk(phist && phist->count >= 1, "periodic wake up timed");
+
+    testdbPutFieldOk("execCount.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("execCount.SEVR", DBF_LONG, NO_ALARM);
+    testdbPutFieldOk("onceMax.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("onceMax.UDF", DBF_LONG, 0);
+    testdbPutFieldFail(-1, "missing.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("missing.SEVR", DBF_LONG, INVALID_ALARM);
+
+    testdbPutFieldOk("resetCb", DBF_LONG, 1);
+    phist = dbLatencyFind("cbLow");
+    testOk(phist && phist->count == 0, "callback delays cleared");
+
+    testDiag("Report");
+    dbLatencyShow("scan*", 1);
+
+    epicsEventDestroy(onceDone);
+}
+
+MAIN(dbLatencyTest)
+{
+    testPlan(31);
+
+    testHistogram();
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("dbLatencyTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testScan();
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    return testDone();
+}
@@ -0,0 +1,107 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include "dbUnitTest.h"
+#include "testMain.h"
+#include "dbAccess.h"
+#include "dbCommon.h"
+#include "dbProfile.h"
+#include "errlog.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static
+void testDisabled(void)
+{
+    dbProfileStats stats;
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    testOk1(!dbProfileIsEnabled());
+    testdbGetFieldEqual("enable", DBF_LONG, 0);
+    testdbGetFieldEqual("bad.PACT", DBF_LONG, 1);
+
+    testdbPutFieldOk("target.PROC", DBF_LONG, 1);
+    dbProfileGet(testdbRecordPtr("target"), &stats);
+    testOk(stats.nProcess == 0 && stats.processTime == 0,
+        "Nothing counted while disabled");
+}
+
+static
+void testEnabled(void)
+{
+    dbCommon *ptarget = testdbRecordPtr("target");
+    dbProfileStats stats;
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    testdbPutFieldOk("enable", DBF_LONG, 1);
+    testOk1(dbProfileIsEnabled());
+
+    testdbPutFieldOk("target.PROC", DBF_LONG, 1);
+    testdbPutFieldOk("target.PROC", DBF_LONG, 1);
+    testdbPutFieldOk("target.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("fwd", DBF_LONG, 4);
+
+    dbProfileGet(ptarget, &stats);
+    testOk(stats.nProcess == 3, "Processed %llu times",
+        (unsigned long long)stats.nProcess);
+    testOk1(stats.processTime > 0);
+    testOk1(stats.processMax > 0 && stats.processMax <= stats.processTime);
+    testOk1(stats.linkTime > 0 && stats.linkTime <= stats.processTime);
+
+    dbProfileGet(testdbRecordPtr("fwd"), &stats);
+    testOk(stats.nProcess == 3, "Forward linked record processed %llu times",
+        (unsigned long long)stats.nProcess);
+
+    testdbPutFieldOk("count.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("count", DBF_DOUBLE, 3.0);
+    testdbPutFieldOk("time.PROC", DBF_LONG, 1);
+    testdbPutFieldOk("link.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("time.UDF", DBF_LONG, 0);
+    testdbGetFieldEqual("link.UDF", DBF_LONG, 0);
+
+    testDiag("Reports");
+    dbProfileReport(3, "self");
+    dbProfileTypeReport(0);
+
+    testdbPutFieldOk("reset", DBF_LONG, 1);
+    dbProfileGet(ptarget, &stats);
+    testOk(stats.nProcess == 0 && stats.processTime == 0 &&
+        stats.linkTime == 0, "Figures cleared");
+
+    testdbPutFieldOk("enable", DBF_LONG, 0);
+    testOk1(!dbProfileIsEnabled());
+    testdbPutFieldOk("target.PROC", DBF_LONG, 1);
+    dbProfileGet(ptarget, &stats);
+    testOk1(stats.nProcess == 0);
+}
+
+MAIN(dbProfileTest)
+{
+    testPlan(28);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("dbProfileTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testDisabled();
+    testEnabled();
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    return testDone();
+}
@@ -15,6 +15,10 @@
 
 int analogMonitorTest(void);
 int compressTest(void);
+int ringTest(void);
+int dbProfileTest(void);
+int dbLatencyTest(void);
+int aSubArrayTest(void);
 int recMiscTest(void);
 int arrayOpTest(void);
 int asTest(void);
@@ -33,6 +37,14 @@ void epicsRunRecordTests(void)
 
     runTest(compressTest);
 
+    runTest(ringTest);
+
+    runTest(dbProfileTest);
+
+    runTest(dbLatencyTest);
+
+    runTest(aSubArrayTest);
+
     runTest(recMiscTest);
 
     runTest(arrayOpTest);
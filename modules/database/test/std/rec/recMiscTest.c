@@ -60,11 +60,31 @@ void testint64AfterInit(void)
     testdbGetFieldEqual("in64", DBF_UINT64, 0x22345678abcdef00ULL);
 }
 
+static
+void testHistogram(void)
+{
+    static const double samples[] = {0.0, 1.0, 1.5, 2.0, 2.5, 3.9, 4.0, -1.0};
+    static const epicsUInt32 scalar[] = {0, 1, 0, 0};
+    static const epicsUInt32 array[] = {2, 2, 1, 1};
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    testdbPutFieldOk("histai", DBF_DOUBLE, 2.0);
+    testdbPutFieldOk("histsc.PROC", DBF_LONG, 1);
+    testdbGetArrFieldEqual("histsc", DBF_ULONG, 4, 4, scalar);
+
+    /* every element of an array input is counted */
+    testdbPutArrFieldOk("histwf", DBF_DOUBLE, NELEMENTS(samples), samples);
+    testdbPutFieldOk("histarr.PROC", DBF_LONG, 1);
+    testdbGetArrFieldEqual("histarr", DBF_ULONG, 4, 4, array);
+    testdbGetFieldEqual("histarr.SGNL", DBF_DOUBLE, -1.0);
+}
+
 void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
 
 MAIN(recMiscTest)
 {
-    testPlan(12);
+    testPlan(19);
 
     testdbPrepare();
 
@@ -91,6 +111,8 @@ MAIN(recMiscTest)
 
     testint64AfterInit();
 
+    testHistogram();
+
     testIocShutdownOk();
 
     testdbCleanup();
@@ -0,0 +1,111 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include "dbUnitTest.h"
+#include "testMain.h"
+#include "dbAccess.h"
+#include "errlog.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static
+void testAppendLink(void)
+{
+    static const double first[] = {1.0, 2.0, 3.0};
+    static const double second[] = {4.0, 5.0, 6.0, 7.0};
+    static const double window2[] = {3.0, 4.0, 5.0, 6.0, 7.0};
+    static const double third[] = {10, 11, 12, 13, 14, 15, 16, 17};
+    static const double window3[] = {13, 14, 15, 16, 17};
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    testdbGetFieldEqual("ring.NUSE", DBF_ULONG, 0);
+    testdbGetArrFieldEqual("ring.WIN", DBF_DOUBLE, 5, 0, NULL);
+
+    testdbPutArrFieldOk("src", DBF_DOUBLE, NELEMENTS(first), first);
+    testdbPutFieldOk("ring.PROC", DBF_LONG, 1);
+
+    testdbGetArrFieldEqual("ring", DBF_DOUBLE, 8, 3, first);
+    testdbGetArrFieldEqual("ring.WIN", DBF_DOUBLE, 5, 3, first);
+    testdbGetFieldEqual("ring.TOT", DBF_UINT64, 3ULL);
+
+    testDiag("Wrap around, VAL only has the new samples");
+    testdbPutArrFieldOk("src", DBF_DOUBLE, NELEMENTS(second), second);
+    testdbPutFieldOk("ring.PROC", DBF_LONG, 1);
+
+    testdbGetArrFieldEqual("ring", DBF_DOUBLE, 8, 4, second);
+    testdbGetArrFieldEqual("ring.WIN", DBF_DOUBLE, 5, 5, window2);
+    testdbGetFieldEqual("ring.NUSE", DBF_ULONG, 5);
+    testdbGetFieldEqual("ring.OFF", DBF_ULONG, 2);
+    testdbGetFieldEqual("ring.TOT", DBF_UINT64, 7ULL);
+
+    testDiag("Append more than the window holds");
+    testdbPutArrFieldOk("src", DBF_DOUBLE, NELEMENTS(third), third);
+    testdbPutFieldOk("ring.PROC", DBF_LONG, 1);
+
+    testdbGetArrFieldEqual("ring", DBF_DOUBLE, 8, 8, third);
+    testdbGetArrFieldEqual("ring.WIN", DBF_DOUBLE, 5, 5, window3);
+    testdbGetFieldEqual("ring.TOT", DBF_UINT64, 15ULL);
+
+    eltc(0);
+    testdbPutFieldFail(S_db_noMod, "ring.WIN", DBF_DOUBLE, 1.0);
+    eltc(1);
+
+    testDiag("Reset");
+    testdbPutFieldOk("ring.RES", DBF_LONG, 1);
+    testdbGetFieldEqual("ring.NUSE", DBF_ULONG, 0);
+    testdbGetFieldEqual("ring.TOT", DBF_UINT64, 0ULL);
+    testdbGetArrFieldEqual("ring.WIN", DBF_DOUBLE, 5, 0, NULL);
+}
+
+static
+void testAppendPut(void)
+{
+    static const epicsInt32 first[] = {1, 2, 3, 4};
+    static const epicsInt32 second[] = {5, 6, 7};
+    static const epicsInt32 window[] = {2, 3, 4, 5, 6, 7};
+
+    testDiag("In %s", EPICS_FUNCTION);
+
+    testdbPutArrFieldOk("ringput", DBF_LONG, NELEMENTS(first), first);
+    testdbGetArrFieldEqual("ringput.WIN", DBF_LONG, 6, 4, first);
+
+    testdbPutArrFieldOk("ringput", DBF_LONG, NELEMENTS(second), second);
+    testdbGetArrFieldEqual("ringput", DBF_LONG, 4, 3, second);
+    testdbGetArrFieldEqual("ringput.WIN", DBF_LONG, 6, 6, window);
+    testdbGetFieldEqual("ringput.TOT", DBF_UINT64, 7ULL);
+
+    testDiag("Processing again does not append VAL twice");
+    testdbPutFieldOk("ringput.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("ringput.TOT", DBF_UINT64, 7ULL);
+    testdbGetArrFieldEqual("ringput.WIN", DBF_LONG, 6, 6, window);
+}
+
+MAIN(ringTest)
+{
+    testPlan(33);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("ringTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testAppendLink();
+    testAppendPut();
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    return testDone();
+}
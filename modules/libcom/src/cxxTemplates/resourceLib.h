@@ -172,7 +172,133 @@ private:
 };
 
 //
-// Some ID classes that work with the above template
+// class openResTable <T, ID>
+//
+// An alternative to resTable with the same interface and the same
+// requirements on classes T and ID, but which stores pointers to the
+// entries, along with their full hash values, in one contiguous array
+// using open addressing with linear probing. A lookup usually touches
+// a single cache line of the table, and the entry itself only when
+// its hash value matches, whereas resTable must chase the singly linked
+// bucket list through the entries. This pays off when there are a very
+// large number of entries and lookups dominate.
+//
+// NOTES:
+// 1)   Collisions are resolved with Robin Hood linear probing, which keeps
+//      the variance of the probe length low and allows unsuccessful
+//      lookups to stop early. Entries are deleted by shifting the
+//      remainder of the cluster backwards, so there are no tombstones.
+//
+// 2)   The table doubles in size, reinserting all entries, when it
+//      becomes 3/4 full. Unlike resTable the cost of this is proportional
+//      to the number of entries, so call setTableSize() prior to
+//      installing a large number of entries if that latency matters.
+//
+// 3)   As with resTable, the least significant bits of the hash select
+//      the home slot.
+//
+template < class T, class ID > class openResTableIter;
+template < class T, class ID > class openResTableIterConst;
+
+template <class T, class ID>
+class openResTable {
+public:
+    openResTable ();
+    virtual ~openResTable();
+    // Call " void T::show (unsigned level)" for each entry
+    void show ( unsigned level ) const;
+    void verify () const;
+    int add ( T & res ); // returns -1 (id exists in table), 0 (success)
+    T * remove ( const ID &idIn ); // remove entry
+    void removeAll ( tsSLList<T> & destination ); // remove all entries
+    T * lookup ( const ID &idIn ) const; // locate entry
+    // Call (pT->*pCB) () for each entry, the callback may remove
+    // the entry that it is called for
+    void traverse ( void (T::*pCB)() );
+    void traverseConst ( void (T::*pCB)() const ) const;
+    unsigned numEntriesInstalled () const;
+    void setTableSize ( const unsigned newTableSize );
+    typedef openResTableIter < T, ID > iterator;
+    typedef openResTableIterConst < T, ID > iteratorConst;
+    iterator firstIter ();
+    iteratorConst firstIter () const;
+private:
+    struct slot {
+        resTableIndex hash;
+        T * pItem;
+    };
+    slot * pTable;
+    unsigned hashIxMask;
+    unsigned logBaseTwoTableSize;
+    unsigned nInUse;
+    unsigned tableSize () const;
+    unsigned loadLimit () const;
+    static unsigned probeLength ( const slot & s,
+        const unsigned index, const unsigned mask );
+    static void insert ( slot * pTable, const unsigned mask, slot entry );
+    slot * find ( const ID & idIn, const resTableIndex hash ) const;
+    bool setTableSizePrivate ( unsigned logBaseTwoTableSize );
+    void removeSlot ( const unsigned index );
+    openResTable ( const openResTable & );
+    openResTable & operator = ( const openResTable & );
+    friend class openResTableIter < T, ID >;
+    friend class openResTableIterConst < T, ID >;
+};
+
+//
+// class openResTableIter
+//
+// an iterator for the open addressing resource table class
+//
+template < class T, class ID >
+class openResTableIter {
+public:
+    openResTableIter ();
+    bool valid () const;
+    bool operator == ( const openResTableIter < T,ID > & rhs ) const;
+    bool operator != ( const openResTableIter < T,ID > & rhs ) const;
+    openResTableIter < T, ID > & operator = ( const openResTableIter < T, ID > & );
+    T & operator * () const;
+    T * operator -> () const;
+    openResTableIter < T, ID > & operator ++ ();
+    openResTableIter < T, ID > operator ++ ( int );
+    T * pointer ();
+private:
+    unsigned index;
+    openResTable < T,ID > * pResTable;
+    openResTableIter ( openResTable < T,ID > & tableIn );
+    void findNextEntry ( unsigned start );
+    friend class openResTable < T, ID >;
+};
+
+//
+// class openResTableIterConst
+//
+// an iterator for a const open addressing resource table class
+//
+template < class T, class ID >
+class openResTableIterConst {
+public:
+    openResTableIterConst ();
+    bool valid () const;
+    bool operator == ( const openResTableIterConst < T,ID > & rhs ) const;
+    bool operator != ( const openResTableIterConst < T,ID > & rhs ) const;
+    openResTableIterConst < T, ID > & operator = ( const openResTableIterConst < T, ID > & );
+    const T & operator * () const;
+    const T * operator -> () const;
+    openResTableIterConst < T, ID > & operator ++ ();
+    openResTableIterConst < T, ID > operator ++ ( int );
+    const T * pointer () const;
+private:
+    unsigned index;
+    const openResTable < T,ID > * pResTable;
+    openResTableIterConst ( const openResTable < T,ID > & tableIn );
+    void findNextEntry ( unsigned start );
+    friend class openResTable < T, ID >;
+};
+
+//
+// Some ID classes that work with the above templates
 //
 
 //
@@ -234,6 +360,25 @@ private:
     chronIntIdResTable & operator = ( const chronIntIdResTable & );
 };
 
+//
+// class chronIntIdOpenResTable <ITEM>
+//
+// same as chronIntIdResTable, but based on openResTable
+//
+// NOTE: ITEM must public inherit from chronIntIdRes <ITEM>
+//
+template <class ITEM>
+class chronIntIdOpenResTable : public openResTable<ITEM, chronIntId> {
+public:
+    chronIntIdOpenResTable ();
+    virtual ~chronIntIdOpenResTable ();
+    void idAssignAdd ( ITEM & item );
+private:
+    unsigned allocId;
+    chronIntIdOpenResTable ( const chronIntIdOpenResTable & );
+    chronIntIdOpenResTable & operator = ( const chronIntIdOpenResTable & );
+};
+
 //
 // class chronIntIdRes<ITEM>
 //
@@ -247,6 +392,7 @@ private:
     void setId (unsigned newId);
     chronIntIdRes (const chronIntIdRes & );
     friend class chronIntIdResTable<ITEM>;
+    friend class chronIntIdOpenResTable<ITEM>;
 };
 
 //
@@ -972,6 +1118,651 @@ inline void chronIntIdResTable<ITEM>::idAssignAdd (ITEM &item)
     while (status);
 }
 
+//////////////////////////////////////////////////
+// openResTable<class T, class ID> member functions
+//////////////////////////////////////////////////
+
+template <class T, class ID>
+inline openResTable<T,ID>::openResTable () :
+    pTable ( 0 ), hashIxMask ( 0 ), logBaseTwoTableSize ( 0 ),
+    nInUse ( 0 ) {}
+
+template <class T, class ID>
+openResTable<T,ID>::~openResTable ()
+{
+    operator delete ( this->pTable );
+}
+
+template <class T, class ID>
+inline unsigned openResTable<T,ID>::tableSize () const
+{
+    if ( this->pTable ) {
+        return this->hashIxMask + 1u;
+    }
+    return 0u;
+}
+
+//
+// openResTable<T,ID>::loadLimit ()
+//
+// the table is grown when it becomes 3/4 full
+//
+template <class T, class ID>
+inline unsigned openResTable<T,ID>::loadLimit () const
+{
+    const unsigned N = this->tableSize ();
+    return ( N >> 1u ) + ( N >> 2u );
+}
+
+//
+// openResTable<T,ID>::probeLength ()
+//
+// distance of the entry at index from its home slot
+//
+template <class T, class ID>
+inline unsigned openResTable<T,ID>::probeLength ( const slot & s,
+    const unsigned index, const unsigned mask )
+{
+    return ( index - static_cast < unsigned > ( s.hash ) ) & mask;
+}
+
+template <class T, class ID>
+inline unsigned openResTable<T,ID>::numEntriesInstalled () const
+{
+    return this->nInUse;
+}
+
+//
+// openResTable<T,ID>::find ()
+//
+// The entries along a probe sequence are ordered by decreasing
+// distance from their home slot, so the search stops at the first
+// entry which is closer to home than the one sought would be. The
+// entry itself is only touched when its hash matches.
+//
+template <class T, class ID>
+inline typename openResTable<T,ID>::slot *
+    openResTable<T,ID>::find ( const ID & idIn, const resTableIndex h ) const
+{
+    const unsigned mask = this->hashIxMask;
+    unsigned index = static_cast < unsigned > ( h ) & mask;
+    unsigned dist = 0u;
+    while ( true ) {
+        slot & s = this->pTable[index];
+        if ( ! s.pItem || probeLength ( s, index, mask ) < dist ) {
+            return 0;
+        }
+        if ( s.hash == h ) {
+            const ID & idOfItem = *s.pItem;
+            if ( idOfItem == idIn ) {
+                return & s;
+            }
+        }
+        index = ( index + 1u ) & mask;
+        dist++;
+    }
+}
+
+template <class T, class ID>
+inline T * openResTable<T,ID>::lookup ( const ID & idIn ) const
+{
+    if ( this->pTable ) {
+        slot * pSlot = this->find ( idIn, idIn.hash () );
+        if ( pSlot ) {
+            return pSlot->pItem;
+        }
+    }
+    return 0;
+}
+
+//
+// openResTable<T,ID>::insert ()
+//
+// Robin Hood insertion, an entry further from its home slot
+// displaces an entry which is closer to home
+//
+template <class T, class ID>
+void openResTable<T,ID>::insert ( slot * pTableIn,
+    const unsigned mask, slot entry )
+{
+    unsigned index = static_cast < unsigned > ( entry.hash ) & mask;
+    unsigned dist = 0u;
+    while ( true ) {
+        slot & s = pTableIn[index];
+        if ( ! s.pItem ) {
+            s = entry;
+            return;
+        }
+        const unsigned sDist = probeLength ( s, index, mask );
+        if ( sDist < dist ) {
+            const slot tmp = s;
+            s = entry;
+            entry = tmp;
+            dist = sDist;
+        }
+        index = ( index + 1u ) & mask;
+        dist++;
+    }
+}
+
+template <class T, class ID>
+int openResTable<T,ID>::add ( T & res )
+{
+    if ( ! this->pTable ) {
+        this->setTableSizePrivate ( 10 );
+    }
+    const ID & idIn = res;
+    const resTableIndex h = idIn.hash ();
+    if ( this->find ( idIn, h ) ) {
+        return -1;
+    }
+    if ( this->nInUse >= this->loadLimit () ) {
+        // if the table cant grow then keep filling it for as
+        // long as at least one empty slot remains
+        bool success = this->setTableSizePrivate (
+            this->logBaseTwoTableSize + 1u );
+        if ( ! success && this->nInUse + 2u > this->tableSize () ) {
+            throw std::bad_alloc ();
+        }
+    }
+    slot entry;
+    entry.hash = h;
+    entry.pItem = & res;
+    insert ( this->pTable, this->hashIxMask, entry );
+    this->nInUse++;
+    return 0;
+}
+
+template <class T, class ID>
+T * openResTable<T,ID>::remove ( const ID & idIn )
+{
+    if ( this->pTable ) {
+        slot * pSlot = this->find ( idIn, idIn.hash () );
+        if ( pSlot ) {
+            T * pItem = pSlot->pItem;
+            this->removeSlot ( static_cast < unsigned > ( pSlot - this->pTable ) );
+            return pItem;
+        }
+    }
+    return 0;
+}
+
+//
+// openResTable<T,ID>::removeSlot ()
+//
+// Close the hole by shifting back the entries which follow it,
+// up to the first that is empty or already in its home slot, so
+// that there are no tombstones and lookups do not degrade with
+// churn.
+//
+template <class T, class ID>
+void openResTable<T,ID>::removeSlot ( const unsigned index )
+{
+    const unsigned mask = this->hashIxMask;
+    unsigned hole = index;
+    while ( true ) {
+        const unsigned next = ( hole + 1u ) & mask;
+        const slot & s = this->pTable[next];
+        if ( ! s.pItem || probeLength ( s, next, mask ) == 0u ) {
+            break;
+        }
+        this->pTable[hole] = s;
+        hole = next;
+    }
+    this->pTable[hole].pItem = 0;
+    this->nInUse--;
+}
+
+template <class T, class ID>
+void openResTable<T,ID>::removeAll ( tsSLList<T> & destination )
+{
+    const unsigned N = this->tableSize ();
+    for ( unsigned i = 0u; i < N; i++ ) {
+        if ( T * pItem = this->pTable[i].pItem ) {
+            destination.add ( *pItem );
+            this->pTable[i].pItem = 0;
+        }
+    }
+    this->nInUse = 0;
+}
+
+template <class T, class ID>
+void openResTable<T,ID>::setTableSize ( const unsigned newTableSize )
+{
+    if ( newTableSize == 0u ) {
+        return;
+    }
+
+    //
+    // find the smallest power of two table which will
+    // hold this many entries without growing
+    //
+    unsigned nbits = 4u;
+    while ( nbits < sizeof ( newTableSize ) * CHAR_BIT - 1u ) {
+        const unsigned N = 1u << nbits;
+        if ( ( N >> 1u ) + ( N >> 2u ) >= newTableSize ) {
+            break;
+        }
+        nbits++;
+    }
+    this->setTableSizePrivate ( nbits );
+}
+
+template <class T, class ID>
+bool openResTable<T,ID>::setTableSizePrivate ( unsigned logBaseTwoTableSizeIn )
+{
+    // dont shrink
+    if ( this->pTable && this->logBaseTwoTableSize >= logBaseTwoTableSizeIn ) {
+        return true;
+    }
+
+    // dont allow ridiculously small tables
+    if ( logBaseTwoTableSizeIn < 4 ) {
+        logBaseTwoTableSizeIn = 4;
+    }
+
+    const unsigned newTableSize = 1u << logBaseTwoTableSizeIn;
+    const unsigned newMask = newTableSize - 1u;
+
+    slot * pNewTable;
+    try {
+        pNewTable = static_cast < slot * >
+            ( ::operator new ( newTableSize * sizeof ( slot ) ) );
+    }
+    catch ( ... ) {
+        if ( ! this->pTable ) {
+            throw;
+        }
+        return false;
+    }
+    for ( unsigned i = 0u; i < newTableSize; i++ ) {
+        pNewTable[i].hash = 0u;
+        pNewTable[i].pItem = 0;
+    }
+
+    // the full hash is stored so the entries need not be touched
+    const unsigned oldTableSize = this->tableSize ();
+    for ( unsigned i = 0u; i < oldTableSize; i++ ) {
+        if ( this->pTable[i].pItem ) {
+            insert ( pNewTable, newMask, this->pTable[i] );
+        }
+    }
+
+    operator delete ( this->pTable );
+    this->pTable = pNewTable;
+    this->hashIxMask = newMask;
+    this->logBaseTwoTableSize = logBaseTwoTableSizeIn;
+
+    return true;
+}
+
+//
+// openResTable<T,ID>::traverse
+//
+// Traversal starts just past an empty slot so that no cluster wraps
+// around the starting point. When the callback removes its entry,
+// an entry that has not been visited yet may be shifted back into
+// the current slot, so the slot is then visited again.
+//
+template <class T, class ID>
+void openResTable<T,ID>::traverse ( void (T::*pCB)() )
+{
+    const unsigned N = this->tableSize ();
+    if ( N == 0u ) {
+        return;
+    }
+    unsigned start = 0u;
+    while ( this->pTable[start].pItem ) {
+        start++;
+    }
+    unsigned n = 1u;
+    while ( n < N ) {
+        const unsigned index = ( start + n ) & this->hashIxMask;
+        T * pItem = this->pTable[index].pItem;
+        if ( pItem ) {
+            ( pItem->*pCB ) ();
+            if ( this->pTable[index].pItem == pItem ) {
+                n++;
+            }
+        }
+        else {
+            n++;
+        }
+    }
+}
+
+template <class T, class ID>
+void openResTable<T,ID>::traverseConst ( void (T::*pCB)() const ) const
+{
+    const unsigned N = this->tableSize ();
+    for ( unsigned i = 0u; i < N; i++ ) {
+        const T * pItem = this->pTable[i].pItem;
+        if ( pItem ) {
+            ( pItem->*pCB ) ();
+        }
+    }
+}
+
+//
+// openResTable<T,ID>::show
+//
+template <class T, class ID>
+void openResTable<T,ID>::show ( unsigned level ) const
+{
+    const unsigned N = this->tableSize ();
+
+    printf ( "Open addressing hash table with %u slots and %u items of type %s installed\n",
+        N, this->nInUse, typeid(T).name() );
+
+    if ( level >= 1u && N ) {
+        double X = 0.0;
+        double XX = 0.0;
+        unsigned maxProbes = 0u;
+        unsigned count = 0u;
+        for ( unsigned i = 0u; i < N; i++ ) {
+            const slot & s = this->pTable[i];
+            if ( ! s.pItem ) {
+                continue;
+            }
+            if ( level >= 2u ) {
+                s.pItem->show ( level - 2u );
+            }
+            const unsigned probes = probeLength ( s, i, this->hashIxMask ) + 1u;
+            X += probes;
+            XX += probes * probes;
+            if ( probes > maxProbes ) {
+                maxProbes = probes;
+            }
+            count++;
+        }
+        if ( count ) {
+            double mean = X / count;
+            double stdDev = sqrt( XX / count - mean * mean );
+            printf (
+        "probes per entry: mean = %f std dev = %f max = %u\n",
+                mean, stdDev, maxProbes );
+        }
+        if ( count != this->nInUse ) {
+            printf ("this->nInUse didnt match items counted which was %u????\n", count );
+        }
+    }
+}
+
+// self test
+template <class T, class ID>
+void openResTable<T,ID>::verify () const
+{
+    const unsigned N = this->tableSize ();
+
+    if ( this->pTable ) {
+        assert ( this->hashIxMask );
+        assert ( this->logBaseTwoTableSize );
+        assert ( N == 1u << this->logBaseTwoTableSize );
+        assert ( this->nInUse < N );
+    }
+    else {
+        assert ( this->hashIxMask == 0 );
+        assert ( this->logBaseTwoTableSize == 0 );
+        assert ( this->nInUse == 0 );
+    }
+
+    unsigned total = 0u;
+    for ( unsigned i = 0u; i < N; i++ ) {
+        const slot & s = this->pTable[i];
+        if ( ! s.pItem ) {
+            continue;
+        }
+        const ID & idOfItem = *s.pItem;
+        assert ( idOfItem.hash () == s.hash );
+        // no empty slot between an entry and its home slot, and
+        // no entry which is further from home than its predecessor
+        if ( probeLength ( s, i, this->hashIxMask ) ) {
+            const unsigned prev = ( i - 1u ) & this->hashIxMask;
+            assert ( this->pTable[prev].pItem );
+            assert ( probeLength ( this->pTable[prev], prev, this->hashIxMask ) + 1u
+                >= probeLength ( s, i, this->hashIxMask ) );
+        }
+        total++;
+    }
+    assert ( total == this->nInUse );
+}
+
+template <class T, class ID>
+inline openResTableIterConst < T, ID > openResTable<T,ID>::firstIter () const
+{
+    return openResTableIterConst < T, ID > ( *this );
+}
+
+template <class T, class ID>
+inline openResTableIter < T, ID > openResTable<T,ID>::firstIter ()
+{
+    return openResTableIter < T, ID > ( *this );
+}
+
+//////////////////////////////////////////////
+// openResTableIter<T,ID> member functions
+//////////////////////////////////////////////
+
+template < class T, class ID >
+inline openResTableIter<T,ID>::openResTableIter ( openResTable < T,ID > & tableIn ) :
+    index ( 0 ), pResTable ( & tableIn )
+{
+    this->findNextEntry ( 0u );
+}
+
+template < class T, class ID >
+inline openResTableIter<T,ID>::openResTableIter () :
+    index ( 0 ), pResTable ( 0 )
+{
+}
+
+template < class T, class ID >
+inline void openResTableIter<T,ID>::findNextEntry ( unsigned start )
+{
+    if ( this->pResTable ) {
+        const unsigned N = this->pResTable->tableSize ();
+        while ( start < N && ! this->pResTable->pTable[start].pItem ) {
+            start++;
+        }
+        this->index = start;
+    }
+}
+
+template < class T, class ID >
+inline bool openResTableIter<T,ID>::valid () const
+{
+    return this->pResTable
+        && this->index < this->pResTable->tableSize ();
+}
+
+template < class T, class ID >
+inline bool openResTableIter<T,ID>::operator ==
+    ( const openResTableIter < T,ID > & rhs ) const
+{
+    return ( this->pResTable == rhs.pResTable
+             && this->index  == rhs.index );
+}
+
+template < class T, class ID >
+inline bool openResTableIter<T,ID>::operator !=
+    ( const openResTableIter < T,ID > & rhs ) const
+{
+    return ! this->operator == ( rhs );
+}
+
+template < class T, class ID >
+inline openResTableIter < T, ID > & openResTableIter<T,ID>::operator =
+    ( const openResTableIter < T, ID > & rhs )
+{
+    this->pResTable = rhs.pResTable;
+    this->index  = rhs.index;
+    return *this;
+}
+
+template < class T, class ID >
+inline T & openResTableIter<T,ID>::operator * () const
+{
+    return * this->pResTable->pTable[this->index].pItem;
+}
+
+template < class T, class ID >
+inline T * openResTableIter<T,ID>::operator -> () const
+{
+    return this->pResTable->pTable[this->index].pItem;
+}
+
+template < class T, class ID >
+inline openResTableIter<T,ID> & openResTableIter<T,ID>::operator ++ ()
+{
+    this->findNextEntry ( this->index + 1u );
+    return *this;
+}
+
+template < class T, class ID >
+inline openResTableIter<T,ID> openResTableIter<T,ID>::operator ++ ( int )
+{
+    openResTableIter<T,ID> tmp = *this;
+    this->operator ++ ();
+    return tmp;
+}
+
+template < class T, class ID >
+inline T * openResTableIter<T,ID>::pointer ()
+{
+    if ( this->valid () ) {
+        return this->pResTable->pTable[this->index].pItem;
+    }
+    return 0;
+}
+
+//////////////////////////////////////////////
+// openResTableIterConst<T,ID> member functions
+//////////////////////////////////////////////
+
+template < class T, class ID >
+inline openResTableIterConst<T,ID>::openResTableIterConst (
+        const openResTable < T,ID > & tableIn ) :
+    index ( 0 ), pResTable ( & tableIn )
+{
+    this->findNextEntry ( 0u );
+}
+
+template < class T, class ID >
+inline openResTableIterConst<T,ID>::openResTableIterConst () :
+    index ( 0 ), pResTable ( 0 )
+{
+}
+
+template < class T, class ID >
+inline void openResTableIterConst<T,ID>::findNextEntry ( unsigned start )
+{
+    if ( this->pResTable ) {
+        const unsigned N = this->pResTable->tableSize ();
+        while ( start < N && ! this->pResTable->pTable[start].pItem ) {
+            start++;
+        }
+        this->index = start;
+    }
+}
+
+template < class T, class ID >
+inline bool openResTableIterConst<T,ID>::valid () const
+{
+    return this->pResTable
+        && this->index < this->pResTable->tableSize ();
+}
+
+template < class T, class ID >
+inline bool openResTableIterConst<T,ID>::operator ==
+    ( const openResTableIterConst < T,ID > & rhs ) const
+{
+    return ( this->pResTable == rhs.pResTable
+             && this->index  == rhs.index );
+}
+
+template < class T, class ID >
+inline bool openResTableIterConst<T,ID>::operator !=
+    ( const openResTableIterConst < T,ID > & rhs ) const
+{
+    return ! this->operator == ( rhs );
+}
+
+template < class T, class ID >
+inline openResTableIterConst < T, ID > & openResTableIterConst<T,ID>::operator =
+    ( const openResTableIterConst < T, ID > & rhs )
+{
+    this->pResTable = rhs.pResTable;
+    this->index = rhs.index;
+    return *this;
+}
+
+template < class T, class ID >
+inline const T & openResTableIterConst<T,ID>::operator * () const
+{
+    return * this->pResTable->pTable[this->index].pItem;
+}
+
+template < class T, class ID >
+inline const T * openResTableIterConst<T,ID>::operator -> () const
+{
+    return this->pResTable->pTable[this->index].pItem;
+}
+
+template < class T, class ID >
+inline openResTableIterConst<T,ID> & openResTableIterConst<T,ID>::operator ++ ()
+{
+    this->findNextEntry ( this->index + 1u );
+    return *this;
+}
+
+template < class T, class ID >
+inline openResTableIterConst<T,ID> openResTableIterConst<T,ID>::operator ++ ( int )
+{
+    openResTableIterConst<T,ID> tmp = *this;
+    this->operator ++ ();
+    return tmp;
+}
+
+template < class T, class ID >
+inline const T * openResTableIterConst<T,ID>::pointer () const
+{
+    if ( this->valid () ) {
+        return this->pResTable->pTable[this->index].pItem;
+    }
+    return 0;
+}
+
+//////////////////////////////////////////////
+// chronIntIdOpenResTable<ITEM> member functions
+//////////////////////////////////////////////
+
+template <class ITEM>
+inline chronIntIdOpenResTable<ITEM>::chronIntIdOpenResTable () :
+    openResTable<ITEM, chronIntId> (), allocId(1u) {}
+
+//
+// chronIntIdOpenResTable<ITEM>::~chronIntIdOpenResTable()
+// (not inline because it is virtual)
+//
+template <class ITEM>
+chronIntIdOpenResTable<ITEM>::~chronIntIdOpenResTable() {}
+
+//
+// chronIntIdOpenResTable<ITEM>::idAssignAdd()
+//
+// skips ids which are still in use after the id wraps around
+//
+template <class ITEM>
+inline void chronIntIdOpenResTable<ITEM>::idAssignAdd (ITEM &item)
+{
+    int status;
+    do {
+        item.chronIntIdRes<ITEM>::setId (allocId++);
+        status = this->openResTable<ITEM,chronIntId>::add (item);
+    }
+    while (status);
+}
+
 /////////////////////////////////////////////////
 // chronIntIdRes<ITEM> member functions
 /////////////////////////////////////////////////
@@ -0,0 +1,153 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS Base is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Compares chronIntIdResTable and chronIntIdOpenResTable when they
+ * are used as the CA client library uses them, ids allocated in
+ * sequence and then looked up in the (random) order that responses
+ * arrive in. The sparse runs skip a random number of ids between
+ * entries, as happens when channels are created and destroyed over
+ * the life of a client, and their add times include the skipped ids.
+ * Optional arguments are the number of entries and the number of
+ * lookups per entry.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "epicsAssert.h"
+#include "resourceLib.h"
+
+/*
+ * gnuc does not provide this under sunos4
+ */
+#if !defined(CLOCKS_PER_SEC) && defined(SUNOS4)
+#   define CLOCKS_PER_SEC 1000000
+#endif
+
+// roughly the size of a CA client channel
+class chan : public chronIntIdRes < chan > {
+public:
+    chan () {}
+    void show ( unsigned ) const {}
+private:
+    char payload[160];
+};
+
+static unsigned lcg ( unsigned & seed )
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8u;
+}
+
+static double elapsed ( clock_t start, unsigned count )
+{
+    double delay = clock () - start;
+    delay /= CLOCKS_PER_SEC;
+    return delay * 1e9 / count;
+}
+
+template < class TABLE >
+static void bench ( const char * pName, chan ** ppChan,
+    unsigned * pOrder, unsigned nChan, unsigned nPasses, unsigned skip )
+{
+    TABLE tbl;
+    chan dummy;
+    unsigned seed = 1u;
+    clock_t start;
+    unsigned i, j;
+
+    start = clock ();
+    for ( i = 0u; i < nChan; i++ ) {
+        if ( skip ) {
+            for ( j = lcg ( seed ) % skip; j > 0u; j-- ) {
+                tbl.idAssignAdd ( dummy );
+                tbl.remove ( dummy.getId () );
+            }
+        }
+        tbl.idAssignAdd ( *ppChan[i] );
+    }
+    const double add = elapsed ( start, nChan );
+
+    start = clock ();
+    for ( j = 0u; j < nPasses; j++ ) {
+        for ( i = 0u; i < nChan; i++ ) {
+            chan * pChan = ppChan[pOrder[i]];
+            assert ( tbl.lookup ( pChan->getId () ) == pChan );
+        }
+    }
+    const double hit = elapsed ( start, nChan * nPasses );
+
+    start = clock ();
+    for ( i = 0u; i < nChan; i++ ) {
+        assert ( tbl.lookup ( ppChan[pOrder[i]]->getId () + ( skip + 1u ) * nChan ) == 0 );
+    }
+    const double miss = elapsed ( start, nChan );
+
+    start = clock ();
+    for ( i = 0u; i < nChan; i++ ) {
+        chan * pChan = ppChan[pOrder[i]];
+        assert ( tbl.remove ( pChan->getId () ) == pChan );
+    }
+    const double remove = elapsed ( start, nChan );
+
+    printf ( "%-24s %-6s add %7.1f  lookup %7.1f  miss %7.1f  remove %7.1f nS\n",
+        pName, skip ? "sparse" : "dense", add, hit, miss, remove );
+}
+
+int main ( int argc, char ** argv )
+{
+    unsigned nChan = 1000000u;
+    unsigned nPasses = 4u;
+    unsigned seed = 1u;
+    unsigned i;
+
+    if ( argc > 1 ) {
+        nChan = strtoul ( argv[1], 0, 0 );
+    }
+    if ( argc > 2 ) {
+        nPasses = strtoul ( argv[2], 0, 0 );
+    }
+    assert ( nChan > 0u && nPasses > 0u );
+
+    chan ** ppChan = new chan * [nChan];
+    unsigned * pOrder = new unsigned [nChan];
+    for ( i = 0u; i < nChan; i++ ) {
+        ppChan[i] = new chan;
+        pOrder[i] = i;
+    }
+    // scatter the entries in memory, as happens in a long running client
+    for ( i = nChan - 1u; i > 0u; i-- ) {
+        unsigned j = lcg ( seed ) % ( i + 1u );
+        chan * pTmp = ppChan[i];
+        ppChan[i] = ppChan[j];
+        ppChan[j] = pTmp;
+    }
+    for ( i = nChan - 1u; i > 0u; i-- ) {
+        unsigned j = lcg ( seed ) % ( i + 1u );
+        unsigned tmp = pOrder[i];
+        pOrder[i] = pOrder[j];
+        pOrder[j] = tmp;
+    }
+
+    printf ( "%u entries, %u lookup passes\n", nChan, nPasses );
+    for ( i = 0u; i < 4u; i++ ) {
+        const unsigned skip = ( i & 1u ) ? 8u : 0u;
+        bench < chronIntIdResTable < chan > >
+            ( "chronIntIdResTable", ppChan, pOrder, nChan, nPasses, skip );
+        bench < chronIntIdOpenResTable < chan > >
+            ( "chronIntIdOpenResTable", ppChan, pOrder, nChan, nPasses, skip );
+    }
+
+    for ( i = 0u; i < nChan; i++ ) {
+        delete ppChan[i];
+    }
+    delete [] ppChan;
+    delete [] pOrder;
+
+    return 0;
+}
@@ -53,9 +53,14 @@ LIBCOM_API extern const ENV_PARAM EPICS_CA_MAX_ARRAY_BYTES;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_AUTO_ARRAY_BYTES;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_MAX_SEARCH_PERIOD;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_NAME_SERVERS;
+LIBCOM_API extern const ENV_PARAM EPICS_CA_NAME_SERVER_FIRST;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_MCAST_TTL;
+LIBCOM_API extern const ENV_PARAM EPICS_CA_IO_THREADS;
+LIBCOM_API extern const ENV_PARAM EPICS_CA_MCAST_GROUP;
+LIBCOM_API extern const ENV_PARAM EPICS_CA_MCAST_BEACON_PORT;
 LIBCOM_API extern const ENV_PARAM EPICS_CAS_INTF_ADDR_LIST;
 LIBCOM_API extern const ENV_PARAM EPICS_CAS_IGNORE_ADDR_LIST;
+LIBCOM_API extern const ENV_PARAM EPICS_CAS_NAME_SERVERS;
 LIBCOM_API extern const ENV_PARAM EPICS_CAS_AUTO_BEACON_ADDR_LIST;
 LIBCOM_API extern const ENV_PARAM EPICS_CAS_BEACON_ADDR_LIST;
 LIBCOM_API extern const ENV_PARAM EPICS_CAS_SERVER_PORT;
@@ -68,6 +73,10 @@ LIBCOM_API extern const ENV_PARAM EPICS_BUILD_TARGET_ARCH;
 LIBCOM_API extern const ENV_PARAM EPICS_TZ;
 LIBCOM_API extern const ENV_PARAM EPICS_TS_NTP_INET;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_IGNORE_SERVERS;
+LIBCOM_API extern const ENV_PARAM EPICS_THREAD_AFFINITY_SCAN;
+LIBCOM_API extern const ENV_PARAM EPICS_THREAD_AFFINITY_CALLBACK;
+LIBCOM_API extern const ENV_PARAM EPICS_THREAD_AFFINITY_CAS;
+LIBCOM_API extern const ENV_PARAM EPICS_THREAD_AFFINITY_CAC;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_LOG_PORT;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_LOG_INET;
 LIBCOM_API extern const ENV_PARAM EPICS_IOC_LOG_FILE_LIMIT;
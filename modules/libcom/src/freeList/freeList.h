@@ -20,6 +20,10 @@ extern "C" {
 #endif
 
 LIBCOM_API void epicsStdCall freeListInitPvt(void **ppvt,int size,int nmalloc);
+/* As freeListInitPvt(), but each item starts on an align byte boundary,
+ * where align is a power of two, and no two items share an align block */
+LIBCOM_API void epicsStdCall freeListInitAligned(void **ppvt,int size,
+    int nmalloc,int align);
 LIBCOM_API void * epicsStdCall freeListCalloc(void *pvt);
 LIBCOM_API void * epicsStdCall freeListMalloc(void *pvt);
 LIBCOM_API void epicsStdCall freeListFree(void *pvt,void*pmem);
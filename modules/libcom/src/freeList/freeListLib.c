@@ -33,6 +33,8 @@ typedef struct allocMem {
 }allocMem;
 typedef struct {
     int         size;
+    int         stride;     /* item spacing, a multiple of align */
+    int         align;
     int         nmalloc;
     void        *head;
     allocMem    *mallochead;
@@ -42,11 +44,22 @@ typedef struct {
 
 LIBCOM_API void epicsStdCall 
     freeListInitPvt(void **ppvt,int size,int nmalloc)
+{
+    freeListInitAligned(ppvt, size, nmalloc, 1);
+}
+
+LIBCOM_API void epicsStdCall
+    freeListInitAligned(void **ppvt,int size,int nmalloc,int align)
 {
     FREELISTPVT *pfl;
 
+    if(align < 1 || (align & (align - 1)))
+        cantProceed("freeListInitAligned: align %d not a power of two\n",
+            align);
     pfl = callocMustSucceed(1,sizeof(FREELISTPVT), "freeListInitPvt");
     pfl->size = adjustToWorstCaseAlignment(size);
+    pfl->stride = (pfl->size + REDZONE + align - 1) & ~(align - 1);
+    pfl->align = align;
     pfl->nmalloc = nmalloc;
     pfl->head = NULL;
     pfl->mallochead = NULL;
@@ -87,12 +100,13 @@ LIBCOM_API void * epicsStdCall freeListMalloc(void *pvt)
     if(ptemp==0) {
         /* layout of each block. nmalloc+1 REDZONEs for nmallocs.
          * The first sizeof(void*) bytes are used to store a pointer
-         * to the next free block.
+         * to the next free block.  Items are a stride apart, their
+         * size and a REDZONE rounded up to the alignment.
          *
          * | RED | size0 ------ | RED | size1 | ... | RED |
          * |     | next | ----- |
          */
-        ptemp = (void *)malloc(pfl->nmalloc*(pfl->size+REDZONE)+REDZONE);
+        ptemp = (void *)malloc(pfl->nmalloc*pfl->stride+REDZONE+pfl->align-1);
         if(ptemp==0) {
             epicsMutexUnlock(pfl->lock);
             return(0);
@@ -104,7 +118,10 @@ LIBCOM_API void * epicsStdCall freeListMalloc(void *pvt)
             return(0);
         }
         pallocmem->memory = ptemp; /* real allocation */
-        ptemp = REDZONE + (char *) ptemp; /* skip first REDZONE */
+        /* skip first REDZONE, then up to the alignment */
+        ptemp = REDZONE + (char *) ptemp;
+        ptemp = (char *) ptemp +
+            (pfl->align - (size_t) ptemp % pfl->align) % pfl->align;
         if(pfl->mallochead)
             pallocmem->next = pfl->mallochead;
         pfl->mallochead = pallocmem;
@@ -113,7 +130,7 @@ LIBCOM_API void * epicsStdCall freeListMalloc(void *pvt)
             VALGRIND_MEMPOOL_ALLOC(pfl, ptemp, sizeof(void*));
             *ppnext = pfl->head;
             pfl->head = ptemp;
-            ptemp = ((char *)ptemp) + pfl->size+REDZONE;
+            ptemp = ((char *)ptemp) + pfl->stride;
         }
         ptemp = pfl->head;
         pfl->nBlocksAvailable += pfl->nmalloc;
@@ -259,6 +259,33 @@ static void epicsThreadShowAllCallFunc(const iocshArgBuf *args)
     epicsThreadShowAll(args[0].ival);
 }
 
+/* epicsThreadSetAffinity */
+static const iocshArg epicsThreadSetAffinityArg0 = { "name pattern",iocshArgString};
+static const iocshArg epicsThreadSetAffinityArg1 = { "cpulist",iocshArgString};
+static const iocshArg * const epicsThreadSetAffinityArgs[2] =
+    {&epicsThreadSetAffinityArg0,&epicsThreadSetAffinityArg1};
+static const iocshFuncDef epicsThreadSetAffinityFuncDef =
+    {"epicsThreadSetAffinity",2,epicsThreadSetAffinityArgs};
+static void epicsThreadSetAffinityCallFunc(const iocshArgBuf *args)
+{
+    int count;
+
+    if (!args[0].sval) {
+        fprintf(stderr, "Missing thread name pattern\n");
+        iocshSetError(-1);
+        return;
+    }
+    count = epicsThreadSetAffinityMatching(args[0].sval, args[1].sval);
+    if (count < 0) {
+        fprintf(stderr, "Unable to set CPU affinity\n");
+        iocshSetError(-1);
+    }
+    else if (count == 0)
+        fprintf(stderr, "No thread name matches '%s'\n", args[0].sval);
+    else
+        printf("Set CPU affinity of %d thread%s\n", count, count == 1 ? "" : "s");
+}
+
 /* epicsThreadShow */
 static const iocshArg threadArg0 = { "[-level] [thread ...]", iocshArgArgv};
 static const iocshArg * const threadArgs[1] = { &threadArg0 };
@@ -326,6 +353,37 @@ static void epicsMutexShowAllCallFunc(const iocshArgBuf *args)
     epicsMutexShowAll(args[0].ival,args[1].ival);
 }
 
+/* epicsMutexContentionEnable */
+static const iocshArg epicsMutexContentionEnableArg0 = { "enable",iocshArgInt};
+static const iocshArg * const epicsMutexContentionEnableArgs[1] =
+    {&epicsMutexContentionEnableArg0};
+static const iocshFuncDef epicsMutexContentionEnableFuncDef =
+    {"epicsMutexContentionEnable",1,epicsMutexContentionEnableArgs};
+static void epicsMutexContentionEnableCallFunc(const iocshArgBuf *args)
+{
+    epicsMutexContentionEnable(args[0].ival);
+}
+
+/* epicsMutexContentionReport */
+static const iocshArg epicsMutexContentionReportArg0 = { "count",iocshArgInt};
+static const iocshArg epicsMutexContentionReportArg1 = { "level",iocshArgInt};
+static const iocshArg * const epicsMutexContentionReportArgs[2] =
+    {&epicsMutexContentionReportArg0,&epicsMutexContentionReportArg1};
+static const iocshFuncDef epicsMutexContentionReportFuncDef =
+    {"epicsMutexContentionReport",2,epicsMutexContentionReportArgs};
+static void epicsMutexContentionReportCallFunc(const iocshArgBuf *args)
+{
+    epicsMutexContentionReport(args[0].ival, args[1].ival);
+}
+
+/* epicsMutexContentionReset */
+static const iocshFuncDef epicsMutexContentionResetFuncDef =
+    {"epicsMutexContentionReset",0,NULL};
+static void epicsMutexContentionResetCallFunc(const iocshArgBuf *args)
+{
+    epicsMutexContentionReset();
+}
+
 /* epicsThreadSleep */
 static const iocshArg epicsThreadSleepArg0 = { "seconds",iocshArgDouble};
 static const iocshArg * const epicsThreadSleepArgs[1] = {&epicsThreadSleepArg0};
@@ -420,9 +478,13 @@ void epicsStdCall libComRegister(void)
     iocshRegister(&iocLogPrefixFuncDef, iocLogPrefixCallFunc);
 
     iocshRegister(&epicsThreadShowAllFuncDef,epicsThreadShowAllCallFunc);
+    iocshRegister(&epicsThreadSetAffinityFuncDef,epicsThreadSetAffinityCallFunc);
     iocshRegister(&threadFuncDef, threadCallFunc);
     iocshRegister(&taskwdShowFuncDef,taskwdShowCallFunc);
     iocshRegister(&epicsMutexShowAllFuncDef,epicsMutexShowAllCallFunc);
+    iocshRegister(&epicsMutexContentionEnableFuncDef,epicsMutexContentionEnableCallFunc);
+    iocshRegister(&epicsMutexContentionReportFuncDef,epicsMutexContentionReportCallFunc);
+    iocshRegister(&epicsMutexContentionResetFuncDef,epicsMutexContentionResetCallFunc);
     iocshRegister(&epicsThreadSleepFuncDef,epicsThreadSleepCallFunc);
     iocshRegister(&epicsThreadResumeFuncDef,epicsThreadResumeCallFunc);
 
@@ -16,6 +16,12 @@
  * it slows down the system at run time, anfd because its not
  * currently safe to convert a thread id to a thread name because
  * the thread may have exited making the thread id invalid.
+ * 2) The contention statistics enabled by epicsMutexContentionEnable()
+ * are kept in two places. Acquisition counts and the hold time maxima
+ * are in the epicsMutexParm, where only the thread owning the mutex
+ * modifies them, so they need no atomic operations. Waits only occur
+ * when the fast path try-lock fails, and they are added to the creation
+ * site with atomic operations.
  */
 
 #include <new>
@@ -30,6 +36,9 @@
 #include "valgrind/valgrind.h"
 #include "ellLib.h"
 #include "errlog.h"
+#include "epicsAtomic.h"
+#include "epicsString.h"
+#include "epicsTime.h"
 #include "epicsMutex.h"
 #include "epicsThread.h"
 
@@ -37,6 +46,25 @@ static epicsThreadOnceId epicsMutexOsiOnce = EPICS_THREAD_ONCE_INIT;
 static ELLLIST mutexList;
 static ELLLIST freeList;
 
+/* all of the mutexes created at one source location */
+struct epicsMutexSite {
+    epicsMutexSite * pNext;
+    const char * pFileName;
+    int lineno;
+    unsigned nMutexes;
+    /* totals from destroyed mutexes */
+    size_t nLockRetired;
+    epicsUInt64 holdMaxRetired;
+    /* totals from live mutexes, while collecting */
+    size_t nLockLive;
+    epicsUInt64 holdMaxLive;
+    /* updated atomically after a wait */
+    size_t nContended;
+    size_t waitSumMicroSec;
+    size_t waitMaxMicroSec;
+    size_t waitBins[EPICS_MUTEX_WAIT_BINS];
+};
+
 struct epicsMutexParm {
     ELLNODE node;
     epicsMutexOSD * id;
@@ -45,8 +73,19 @@ struct epicsMutexParm {
 #   endif
     const char *pFileName;
     int lineno;
+    /* contention statistics, modified only by the owner */
+    epicsMutexSite * pSite;
+    epicsUInt64 holdBegin;
+    epicsUInt64 holdMax;
+    size_t nLock;
+    unsigned holdDepth;
 };
 
+static const unsigned siteTableSize = 256u;
+static epicsMutexSite * siteTable[siteTableSize];
+static unsigned nSites;
+static int contentionEnabled;
+
 static epicsMutexOSD * epicsMutexGlobalLock;
 
 
@@ -82,6 +121,31 @@ static void epicsMutexOsiInit(void *) {
     epicsMutexGlobalLock = epicsMutexOsdCreate();
 }
 
+/* called with epicsMutexGlobalLock held */
+static epicsMutexSite * epicsMutexSiteFind(const char *pFileName, int lineno)
+{
+    if (!pFileName)
+        pFileName = "<unknown>";
+    unsigned index = epicsStrHash(pFileName, (unsigned) lineno) % siteTableSize;
+    epicsMutexSite *pSite = siteTable[index];
+    while (pSite) {
+        if (pSite->lineno == lineno &&
+                (pSite->pFileName == pFileName ||
+                 strcmp(pSite->pFileName, pFileName) == 0))
+            return pSite;
+        pSite = pSite->pNext;
+    }
+    pSite = static_cast < epicsMutexSite * > ( calloc(1, sizeof(epicsMutexSite)) );
+    if (pSite) {
+        pSite->pFileName = pFileName;
+        pSite->lineno = lineno;
+        pSite->pNext = siteTable[index];
+        siteTable[index] = pSite;
+        nSites++;
+    }
+    return pSite;
+}
+
 epicsMutexId epicsStdCall epicsMutexOsiCreate(
     const char *pFileName,int lineno)
 {
@@ -111,6 +175,13 @@ epicsMutexId epicsStdCall epicsMutexOsiCreate(
 #   endif
     pmutexNode->pFileName = pFileName;
     pmutexNode->lineno = lineno;
+    pmutexNode->pSite = epicsMutexSiteFind(pFileName, lineno);
+    if (pmutexNode->pSite)
+        pmutexNode->pSite->nMutexes++;
+    pmutexNode->holdBegin = 0;
+    pmutexNode->holdMax = 0;
+    pmutexNode->nLock = 0;
+    pmutexNode->holdDepth = 0;
     ellAdd(&mutexList,&pmutexNode->node);
     epicsMutexOsdUnlock(epicsMutexGlobalLock);
     return(pmutexNode);
@@ -130,6 +201,13 @@ void epicsStdCall epicsMutexDestroy(epicsMutexId pmutexNode)
         epicsMutexOsdLock(epicsMutexGlobalLock);
     assert ( lockStat == epicsMutexLockOK );
     ellDelete(&mutexList,&pmutexNode->node);
+    epicsMutexSite *pSite = pmutexNode->pSite;
+    if (pSite) {
+        pSite->nMutexes--;
+        pSite->nLockRetired += pmutexNode->nLock;
+        if (pmutexNode->holdMax > pSite->holdMaxRetired)
+            pSite->holdMaxRetired = pmutexNode->holdMax;
+    }
     epicsMutexOsdDestroy(pmutexNode->id);
     VALGRIND_MEMPOOL_FREE(&freeList, pmutexNode);
     VALGRIND_MEMPOOL_ALLOC(&freeList, &pmutexNode->node, sizeof(pmutexNode->node));
@@ -137,16 +215,72 @@ void epicsStdCall epicsMutexDestroy(epicsMutexId pmutexNode)
     epicsMutexOsdUnlock(epicsMutexGlobalLock);
 }
 
+static unsigned epicsMutexWaitBin(size_t microSec)
+{
+    unsigned bin = 0u;
+    while (microSec && bin < EPICS_MUTEX_WAIT_BINS - 1u) {
+        microSec >>= 1u;
+        bin++;
+    }
+    return bin;
+}
+
+static void epicsMutexWaitNotify(epicsMutexSite *pSite, epicsUInt64 delay)
+{
+    size_t microSec = static_cast < size_t > ( delay / 1000u );
+    epicsAtomicIncrSizeT(&pSite->nContended);
+    epicsAtomicAddSizeT(&pSite->waitSumMicroSec, microSec);
+    epicsAtomicIncrSizeT(&pSite->waitBins[epicsMutexWaitBin(microSec)]);
+    size_t prev = epicsAtomicGetSizeT(&pSite->waitMaxMicroSec);
+    while (microSec > prev) {
+        size_t cur = epicsAtomicCmpAndSwapSizeT(&pSite->waitMaxMicroSec,
+            prev, microSec);
+        if (cur == prev)
+            break;
+        prev = cur;
+    }
+}
+
+/* called by the owner after each acquisition */
+static inline void epicsMutexLockNotify(epicsMutexId pmutexNode)
+{
+    pmutexNode->nLock++;
+    if (pmutexNode->holdDepth++ == 0u)
+        pmutexNode->holdBegin = epicsMonotonicGet();
+}
+
 void epicsStdCall epicsMutexUnlock(epicsMutexId pmutexNode)
 {
+    /* also when disabled while held, to unwind the depth count */
+    if (pmutexNode->holdDepth) {
+        if (--pmutexNode->holdDepth == 0u) {
+            epicsUInt64 held = epicsMonotonicGet() - pmutexNode->holdBegin;
+            if (held > pmutexNode->holdMax)
+                pmutexNode->holdMax = held;
+        }
+    }
     epicsMutexOsdUnlock(pmutexNode->id);
 }
 
 epicsMutexLockStatus epicsStdCall epicsMutexLock(
     epicsMutexId pmutexNode)
 {
-    epicsMutexLockStatus status =
-        epicsMutexOsdLock(pmutexNode->id);
+    epicsMutexLockStatus status;
+    if (contentionEnabled && pmutexNode->pSite) {
+        status = epicsMutexOsdTryLock(pmutexNode->id);
+        if (status == epicsMutexLockTimeout) {
+            epicsUInt64 begin = epicsMonotonicGet();
+            status = epicsMutexOsdLock(pmutexNode->id);
+            if (status == epicsMutexLockOK)
+                epicsMutexWaitNotify(pmutexNode->pSite,
+                    epicsMonotonicGet() - begin);
+        }
+        if (status == epicsMutexLockOK)
+            epicsMutexLockNotify(pmutexNode);
+    }
+    else {
+        status = epicsMutexOsdLock(pmutexNode->id);
+    }
 #   ifdef LOG_LAST_OWNER
         if ( status == epicsMutexLockOK ) {
             pmutexNode->lastOwner = epicsThreadGetIdSelf();
@@ -160,6 +294,9 @@ epicsMutexLockStatus epicsStdCall epicsMutexTryLock(
 {
     epicsMutexLockStatus status =
         epicsMutexOsdTryLock(pmutexNode->id);
+    if (contentionEnabled && pmutexNode->pSite &&
+            status == epicsMutexLockOK)
+        epicsMutexLockNotify(pmutexNode);
 #   ifdef LOG_LAST_OWNER
         if ( status == epicsMutexLockOK ) {
             pmutexNode->lastOwner = epicsThreadGetIdSelf();
@@ -246,6 +383,180 @@ void epicsStdCall epicsMutexShowAll(int onlyLocked,unsigned  int level)
     epicsMutexOsdUnlock(epicsMutexGlobalLock);
 }
 
+void epicsStdCall epicsMutexContentionEnable(int enable)
+{
+    contentionEnabled = enable;
+}
+
+/* called with epicsMutexGlobalLock held, totals the live mutexes */
+static void epicsMutexContentionCollect(void)
+{
+    for (unsigned i = 0u; i < siteTableSize; i++) {
+        for (epicsMutexSite *pSite = siteTable[i]; pSite; pSite = pSite->pNext) {
+            pSite->nLockLive = 0;
+            pSite->holdMaxLive = 0;
+        }
+    }
+    epicsMutexParm *pmutexNode =
+        reinterpret_cast < epicsMutexParm * > ( ellFirst(&mutexList) );
+    while (pmutexNode) {
+        epicsMutexSite *pSite = pmutexNode->pSite;
+        if (pSite) {
+            pSite->nLockLive += pmutexNode->nLock;
+            if (pmutexNode->holdMax > pSite->holdMaxLive)
+                pSite->holdMaxLive = pmutexNode->holdMax;
+        }
+        pmutexNode =
+            reinterpret_cast < epicsMutexParm * > ( ellNext(&pmutexNode->node) );
+    }
+}
+
+static void epicsMutexSiteStats(const epicsMutexSite *pSite,
+    epicsMutexContentionStats *pStats)
+{
+    pStats->pFileName = pSite->pFileName;
+    pStats->lineno = pSite->lineno;
+    pStats->nMutexes = pSite->nMutexes;
+    pStats->nLock = pSite->nLockRetired + pSite->nLockLive;
+    pStats->nContended = epicsAtomicGetSizeT(&pSite->nContended);
+    pStats->waitTotal =
+        epicsAtomicGetSizeT(&pSite->waitSumMicroSec) * 1e-6;
+    pStats->waitMax =
+        epicsAtomicGetSizeT(&pSite->waitMaxMicroSec) * 1e-6;
+    epicsUInt64 holdMax = pSite->holdMaxRetired > pSite->holdMaxLive ?
+        pSite->holdMaxRetired : pSite->holdMaxLive;
+    pStats->holdMax = holdMax * 1e-9;
+    for (unsigned i = 0u; i < EPICS_MUTEX_WAIT_BINS; i++)
+        pStats->waitBins[i] = epicsAtomicGetSizeT(&pSite->waitBins[i]);
+}
+
+int epicsStdCall epicsMutexContentionGet(epicsMutexId pmutexNode,
+    epicsMutexContentionStats *pStats)
+{
+    if (!pmutexNode->pSite)
+        return -1;
+    epicsMutexLockStatus lockStat =
+        epicsMutexOsdLock(epicsMutexGlobalLock);
+    assert ( lockStat == epicsMutexLockOK );
+    epicsMutexContentionCollect();
+    epicsMutexSiteStats(pmutexNode->pSite, pStats);
+    epicsMutexOsdUnlock(epicsMutexGlobalLock);
+    return 0;
+}
+
+void epicsStdCall epicsMutexContentionReset(void)
+{
+    if (epicsMutexOsiOnce == EPICS_THREAD_ONCE_INIT)
+        return;
+
+    epicsMutexLockStatus lockStat =
+        epicsMutexOsdLock(epicsMutexGlobalLock);
+    assert ( lockStat == epicsMutexLockOK );
+    for (unsigned i = 0u; i < siteTableSize; i++) {
+        for (epicsMutexSite *pSite = siteTable[i]; pSite; pSite = pSite->pNext) {
+            pSite->nLockRetired = 0;
+            pSite->holdMaxRetired = 0;
+            epicsAtomicSetSizeT(&pSite->nContended, 0);
+            epicsAtomicSetSizeT(&pSite->waitSumMicroSec, 0);
+            epicsAtomicSetSizeT(&pSite->waitMaxMicroSec, 0);
+            for (unsigned j = 0u; j < EPICS_MUTEX_WAIT_BINS; j++)
+                epicsAtomicSetSizeT(&pSite->waitBins[j], 0);
+        }
+    }
+    /* the owners may be updating these, so the reset is approximate */
+    epicsMutexParm *pmutexNode =
+        reinterpret_cast < epicsMutexParm * > ( ellFirst(&mutexList) );
+    while (pmutexNode) {
+        pmutexNode->nLock = 0;
+        pmutexNode->holdMax = 0;
+        pmutexNode =
+            reinterpret_cast < epicsMutexParm * > ( ellNext(&pmutexNode->node) );
+    }
+    epicsMutexOsdUnlock(epicsMutexGlobalLock);
+}
+
+extern "C" {
+static int epicsMutexWaitCompare(const void *pA, const void *pB)
+{
+    const epicsMutexContentionStats *a =
+        static_cast < const epicsMutexContentionStats * > ( pA );
+    const epicsMutexContentionStats *b =
+        static_cast < const epicsMutexContentionStats * > ( pB );
+    if (a->waitTotal != b->waitTotal)
+        return a->waitTotal < b->waitTotal ? 1 : -1;
+    if (a->nContended != b->nContended)
+        return a->nContended < b->nContended ? 1 : -1;
+    if (a->nLock != b->nLock)
+        return a->nLock < b->nLock ? 1 : -1;
+    return 0;
+}
+}
+
+void epicsStdCall epicsMutexContentionReport(unsigned count, unsigned level)
+{
+    if (epicsMutexOsiOnce == EPICS_THREAD_ONCE_INIT)
+        return;
+
+    epicsMutexLockStatus lockStat =
+        epicsMutexOsdLock(epicsMutexGlobalLock);
+    assert ( lockStat == epicsMutexLockOK );
+    unsigned n = 0u;
+    epicsMutexContentionStats *pStats = static_cast < epicsMutexContentionStats * >
+        ( malloc((nSites ? nSites : 1u) * sizeof(epicsMutexContentionStats)) );
+    if (pStats) {
+        epicsMutexContentionCollect();
+        for (unsigned i = 0u; i < siteTableSize; i++) {
+            for (epicsMutexSite *pSite = siteTable[i]; pSite; pSite = pSite->pNext) {
+                epicsMutexSiteStats(pSite, &pStats[n]);
+                if (pStats[n].nLock || pStats[n].nContended)
+                    n++;
+            }
+        }
+    }
+    epicsMutexOsdUnlock(epicsMutexGlobalLock);
+
+    if (!pStats) {
+        printf("epicsMutexContentionReport: out of memory\n");
+        return;
+    }
+
+    if (!contentionEnabled)
+        printf("Contention statistics are disabled, "
+            "see epicsMutexContentionEnable\n");
+    qsort(pStats, n, sizeof(*pStats), epicsMutexWaitCompare);
+    if (count == 0u || count > n)
+        count = n;
+
+    printf("%10s %12s %10s %6s %10s %9s %9s %9s  %s\n",
+        "wait ms", "locks", "contended", "%", "mean us", "max us",
+        "hold max", "mutexes", "created at");
+    for (unsigned i = 0u; i < count; i++) {
+        const epicsMutexContentionStats *p = &pStats[i];
+        printf("%10.3f %12lu %10lu %6.2f %10.1f %9.0f %9.0f %9u  %s:%d\n",
+            p->waitTotal * 1e3,
+            (unsigned long) p->nLock, (unsigned long) p->nContended,
+            p->nLock ? 100.0 * p->nContended / p->nLock : 0.0,
+            p->nContended ? p->waitTotal * 1e6 / p->nContended : 0.0,
+            p->waitMax * 1e6, p->holdMax * 1e6, p->nMutexes,
+            p->pFileName, p->lineno);
+        if (level > 0u && p->nContended) {
+            printf("%10s wait us:", "");
+            for (unsigned j = 0u; j < EPICS_MUTEX_WAIT_BINS; j++) {
+                if (!p->waitBins[j])
+                    continue;
+                if (j == EPICS_MUTEX_WAIT_BINS - 1u)
+                    printf(" >=%lu:%lu", 1ul << (j - 1u),
+                        (unsigned long) p->waitBins[j]);
+                else
+                    printf(" <%lu:%lu", 1ul << j,
+                        (unsigned long) p->waitBins[j]);
+            }
+            printf("\n");
+        }
+    }
+    free(pStats);
+}
+
 #if !defined(__GNUC__) || __GNUC__<4 || (__GNUC__==4 && __GNUC_MINOR__<8)
 epicsMutex :: epicsMutex () :
     id ( epicsMutexCreate () )
@@ -299,6 +610,52 @@ void epicsMutex :: show ( unsigned level ) const
     epicsMutexShow ( this->id, level );
 }
 
+#if !defined(__GNUC__) || __GNUC__<4 || (__GNUC__==4 && __GNUC_MINOR__<8)
+epicsFastMutex :: epicsFastMutex () :
+    id ( epicsMutexCreateFast () )
+{
+    if ( this->id == 0 ) {
+        throw epicsMutex::mutexCreateFailed ();
+    }
+}
+#endif
+
+epicsFastMutex :: epicsFastMutex ( const char *pFileName, int lineno ) :
+    id ( epicsFastMutexOsiCreate (pFileName, lineno) )
+{
+    if ( this->id == 0 ) {
+        throw epicsMutex::mutexCreateFailed ();
+    }
+}
+
+epicsFastMutex ::~epicsFastMutex ()
+{
+    epicsFastMutexDestroy ( this->id );
+}
+
+void epicsFastMutex::lock ()
+{
+    epicsMutexLockStatus status = epicsFastMutexLock ( this->id );
+    if ( status != epicsMutexLockOK ) {
+        throw epicsMutex::invalidMutex ();
+    }
+}
+
+bool epicsFastMutex::tryLock ()
+{
+    return epicsFastMutexTryLock ( this->id ) == epicsMutexLockOK;
+}
+
+void epicsFastMutex::unlock ()
+{
+    epicsFastMutexUnlock ( this->id );
+}
+
+void epicsFastMutex :: show ( unsigned level ) const
+{
+    epicsFastMutexShow ( this->id, level );
+}
+
 static epicsThreadPrivate < epicsDeadlockDetectMutex >
     * pCurrentMutexLevel = 0;
 
@@ -41,6 +41,8 @@
 #ifndef epicsMutexh
 #define epicsMutexh
 
+#include <stddef.h>
+
 #include "epicsAssert.h"
 
 #include "libComAPI.h"
@@ -48,6 +50,9 @@
 /**\brief An identifier for an epicsMutex for use with the C API */
 typedef struct epicsMutexParm *epicsMutexId;
 
+/**\brief An identifier for an epicsFastMutex, see epicsMutexCreateFast() */
+typedef struct epicsFastMutexOSD *epicsFastMutexId;
+
 /** Return status from some C API routines. */
 typedef enum {
     epicsMutexLockOK = 0,
@@ -155,6 +160,32 @@ private:
     epicsDeadlockDetectMutex & operator = ( const epicsDeadlockDetectMutex & );
 };
 
+/**\brief The C++ API for an epicsFastMutex, see epicsMutexCreateFast().
+ *
+ * This must never be locked recursively.
+ */
+class LIBCOM_API epicsFastMutex {
+public:
+    typedef epicsGuard<epicsFastMutex> guard_t;
+    typedef epicsGuard<epicsFastMutex> release_t;
+
+#if !defined(__GNUC__) || __GNUC__<4 || (__GNUC__==4 && __GNUC_MINOR__<8)
+    epicsFastMutex ();
+    epicsFastMutex ( const char *pFileName, int lineno );
+#else
+    epicsFastMutex ( const char *pFileName = __builtin_FILE(), int lineno = __builtin_LINE() );
+#endif
+    ~epicsFastMutex ();
+    void show ( unsigned level ) const;
+    void lock (); /* blocks until success */
+    void unlock ();
+    bool tryLock (); /* true if successful */
+private:
+    epicsFastMutexId id;
+    epicsFastMutex ( const epicsFastMutex & );
+    epicsFastMutex & operator = ( const epicsFastMutex & );
+};
+
 #endif /*__cplusplus*/
 
 #ifdef __cplusplus
@@ -247,6 +278,155 @@ LIBCOM_API void epicsStdCall epicsMutexShow(
 LIBCOM_API void epicsStdCall epicsMutexShowAll(
     int onlyLocked,unsigned  int level);
 
+/** Number of wait time histogram bins. Bin 0 counts waits below 1
+ * microsecond, bin n waits below 2^n microseconds, and the last bin
+ * all longer waits. */
+#define EPICS_MUTEX_WAIT_BINS 20
+
+/**\brief Contention statistics for the mutexes created at one source
+ * location, see epicsMutexContentionGet().
+ **/
+typedef struct epicsMutexContentionStats {
+    /** Source location of the creation call */
+    const char *pFileName;
+    int lineno;
+    /** Number of mutexes from this location which currently exist */
+    unsigned nMutexes;
+    /** Acquisitions, and those which had to wait for another owner */
+    size_t nLock;
+    size_t nContended;
+    /** Total and longest wait, and longest hold time, in seconds */
+    double waitTotal;
+    double waitMax;
+    double holdMax;
+    /** Wait time histogram, see EPICS_MUTEX_WAIT_BINS */
+    size_t waitBins[EPICS_MUTEX_WAIT_BINS];
+} epicsMutexContentionStats;
+
+/**\brief Enable or disable the collection of contention statistics.
+ *
+ * When enabled, each epicsMutexLock() first tries to take the mutex
+ * without blocking, and only an acquisition which has to wait is timed.
+ * Hold times are measured from the outermost lock to the matching
+ * unlock. The statistics are combined for all of the mutexes created at
+ * the same source location. They are disabled by default.
+ * \param enable Non-zero to enable.
+ **/
+LIBCOM_API void epicsStdCall epicsMutexContentionEnable(int enable);
+
+/**\brief Fetch the contention statistics for the source location where
+ * a mutex was created.
+ * \param id The mutex identifier.
+ * \param pStats Receives the statistics.
+ * \return 0, or -1 if there are no statistics for this mutex.
+ **/
+LIBCOM_API int epicsStdCall epicsMutexContentionGet(
+    epicsMutexId id, epicsMutexContentionStats *pStats);
+
+/**\brief Print the contention statistics of each mutex creation site,
+ * sorted by decreasing total wait time.
+ * \param count Number of sites to print, or 0 for all.
+ * \param level Non-zero to also print the wait time histograms.
+ **/
+LIBCOM_API void epicsStdCall epicsMutexContentionReport(
+    unsigned count, unsigned level);
+
+/**\brief Clear the contention statistics. */
+LIBCOM_API void epicsStdCall epicsMutexContentionReset(void);
+
+/**\brief Create a fast mutex for use from C code.
+ *
+ * A fast mutex is for short critical sections which never take the
+ * same lock again, and which are only entered by threads of the same
+ * priority. It is not recursive and does not implement priority
+ * inheritance, and takes no system call when it is not contended. A
+ * thread which finds it locked spins for a while (on a multi-core
+ * machine) before blocking, adapting how long to spin to how long the
+ * mutex has recently been held.
+ *
+ * Without priority inheritance a high priority thread waiting for a fast
+ * mutex can be held up by medium priority threads which preempt a low
+ * priority holder. Use an epicsMutex instead where threads of different
+ * priorities share a lock, as with the free lists, hash tables and
+ * database event queues which are used from threads of every priority.
+ *
+ * A thread which locks a fast mutex that it already holds deadlocks,
+ * unless debugging has been enabled with epicsFastMutexDebug().
+ *
+ * Fast mutexes do not appear in epicsMutexShowAll() or the contention
+ * statistics.
+ *
+ * This macro stores the source location of the creation call in the mutex.
+ * \return An identifier for the mutex, or NULL if one could not be created.
+ **/
+#define epicsMutexCreateFast() epicsFastMutexOsiCreate(__FILE__,__LINE__)
+/**\brief Internal API, used by epicsMutexCreateFast(). */
+LIBCOM_API epicsFastMutexId epicsStdCall epicsFastMutexOsiCreate(
+    const char *pFileName,int lineno);
+
+/**\brief Create a fast mutex, see epicsMutexCreateFast().
+ *
+ * The routine does not return if the object could not be created.
+ * \return An identifier for the mutex.
+ **/
+#define epicsMutexMustCreateFast() epicsFastMutexOsiMustCreate(__FILE__,__LINE__)
+/**\brief Internal API, used by epicsMutexMustCreateFast(). */
+LIBCOM_API epicsFastMutexId epicsStdCall epicsFastMutexOsiMustCreate(
+    const char *pFileName,int lineno);
+
+/**\brief Destroy a fast mutex.
+ * \param id The mutex identifier.
+ **/
+LIBCOM_API void epicsStdCall epicsFastMutexDestroy(epicsFastMutexId id);
+
+/**\brief Claim a fast mutex, waiting until it's free.
+ * \param id The mutex identifier.
+ * \return \c epicsMutexLockOK, or \c epicsMutexLockError if debugging is
+ * enabled and the caller already holds the mutex.
+ **/
+LIBCOM_API epicsMutexLockStatus epicsStdCall epicsFastMutexLock(
+    epicsFastMutexId id);
+
+/**\brief Claim a fast mutex (see epicsFastMutexLock()).
+ *
+ * This routine does not return if the lock fails.
+ * \param ID The mutex identifier.
+ **/
+#define epicsFastMutexMustLock(ID) {                        \
+    epicsMutexLockStatus status = epicsFastMutexLock(ID);   \
+    assert(status == epicsMutexLockOK);                     \
+}
+
+/**\brief Claim a fast mutex only if it's free.
+ * \return \c epicsMutexLockOK if the mutex is now owned by the caller.
+ * \return \c epicsMutexLockTimeout if it is already owned, including
+ * by the caller.
+ **/
+LIBCOM_API epicsMutexLockStatus epicsStdCall epicsFastMutexTryLock(
+    epicsFastMutexId id);
+
+/**\brief Release a fast mutex.
+ * \param id The mutex identifier.
+ **/
+LIBCOM_API void epicsStdCall epicsFastMutexUnlock(epicsFastMutexId id);
+
+/**\brief Display information about a fast mutex.
+ * \param id The mutex identifier.
+ * \param level Desired information level to report
+ **/
+LIBCOM_API void epicsStdCall epicsFastMutexShow(
+    epicsFastMutexId id,unsigned int level);
+
+/**\brief Enable or disable fast mutex debugging.
+ *
+ * While enabled, each fast mutex records its owner, so that a
+ * recursive lock is reported and fails with \c epicsMutexLockError
+ * instead of deadlocking, and an unlock by a thread which is not the
+ * owner is reported. Only locks taken while enabled are checked.
+ * \param enable Non-zero to enable.
+ **/
+LIBCOM_API void epicsStdCall epicsFastMutexDebug(int enable);
+
 /**@privatesection
  * The following are interfaces to the OS dependent
  * implementation and should NOT be called directly by
@@ -157,6 +157,11 @@ typedef struct epicsThreadOpts {
      * If joinable=1, then epicsThreadMustJoin() must be called for cleanup thread resources.
      */
     unsigned int joinable;
+    /** CPUs on which the thread may run, as a list such as "0-3,8".
+     * NULL (the default) applies the default for the class of the
+     * thread, cf. epicsThreadSetAffinity().
+     */
+    const char *affinity;
 } epicsThreadOpts;
 
 /** Default initial values for epicsThreadOpts
@@ -166,7 +171,7 @@ typedef struct epicsThreadOpts {
  * might break if these rules are not followed.
  */
 #define EPICS_THREAD_OPTS_INIT { \
-    epicsThreadPriorityLow, epicsThreadStackMedium, 0}
+    epicsThreadPriorityLow, epicsThreadStackMedium, 0, NULL}
 
 /** \brief Allocate and start a new OS thread.
  * \param name A name describing this thread.  Appears in various log and error message.
@@ -257,6 +262,31 @@ LIBCOM_API epicsThreadId epicsStdCall epicsThreadGetId(const char *name);
  */
 LIBCOM_API int epicsThreadGetCPUs(void);
 
+/** Restrict a thread to a set of CPUs.
+ *
+ * \param id The thread.
+ * \param cpulist Comma separated CPU numbers and ranges, eg. "0-3,8".
+ *        NULL or an empty string allows all CPUs.
+ * \return 0 on success, -1 if the list is not valid or the target
+ *         does not support CPU affinity (currently only Linux does).
+ *
+ * Threads which are created without an explicit
+ * epicsThreadOpts::affinity take a default from the environment
+ * according to their name:
+ * - scan threads "scan*" from EPICS_THREAD_AFFINITY_SCAN
+ * - callback threads "cb*" from EPICS_THREAD_AFFINITY_CALLBACK
+ * - CA server threads "CAS-*" from EPICS_THREAD_AFFINITY_CAS
+ * - CA client threads "CAC-*" from EPICS_THREAD_AFFINITY_CAC
+ */
+LIBCOM_API int epicsThreadSetAffinity(epicsThreadId id, const char *cpulist);
+
+/** Call epicsThreadSetAffinity() for every EPICS thread with a name
+ *  matching the glob pattern.
+ * \return The number of threads changed, or -1 on error.
+ */
+LIBCOM_API int epicsThreadSetAffinityMatching(const char *pattern,
+    const char *cpulist);
+
 /** Return the name of the current thread.
  *
  * \return Never NULL.  Storage lifetime tied to epicsThreadId.
@@ -0,0 +1,223 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Fast mutex for Linux.
+ *
+ * The three state futex mutex from U. Drepper, "Futexes Are Tricky":
+ * the state is 0 when free, 1 when locked and 2 when locked and some
+ * thread may be sleeping on it, so that unlock only makes a system call
+ * when somebody has to be woken.  On a multi-core machine a locker
+ * spins before sleeping, for up to twice as long as the mutex needed
+ * to become free recently.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "cantProceed.h"
+#include "epicsMutex.h"
+#include "epicsThread.h"
+#include "errlog.h"
+
+#define MAX_SPIN 1000
+
+typedef struct epicsFastMutexOSD {
+    int             state;
+    int             spin;       /* recent spin count, adapted when contended */
+    epicsThreadId   owner;      /* only while debugging */
+    const char     *pFileName;
+    int             lineno;
+} epicsFastMutexOSD;
+
+static int fastMutexDebug;
+static int multiCore = -1;
+
+/*
+ * spin and owner are also read and written by threads which do not
+ * hold the mutex, so they are only accessed atomically.  A lost update
+ * of spin just makes the estimate a little less accurate.
+ */
+static inline int
+getSpin(epicsFastMutexOSD *pmutex)
+{
+    return __atomic_load_n(&pmutex->spin, __ATOMIC_RELAXED);
+}
+
+static inline void
+adaptSpin(epicsFastMutexOSD *pmutex, int n)
+{
+    int spin = getSpin(pmutex);
+
+    __atomic_store_n(&pmutex->spin, spin + (n - spin) / 8, __ATOMIC_RELAXED);
+}
+
+static inline epicsThreadId
+getOwner(epicsFastMutexOSD *pmutex)
+{
+    return __atomic_load_n(&pmutex->owner, __ATOMIC_RELAXED);
+}
+
+static inline void
+setOwner(epicsFastMutexOSD *pmutex, epicsThreadId owner)
+{
+    __atomic_store_n(&pmutex->owner, owner, __ATOMIC_RELAXED);
+}
+
+static void
+futexWait(int *addr, int val)
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static void
+futexWake(int *addr, int count)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+static inline void
+cpuRelax(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__ ("yield");
+#endif
+}
+
+epicsFastMutexId epicsStdCall
+epicsFastMutexOsiCreate(const char *pFileName, int lineno)
+{
+    epicsFastMutexOSD *pmutex = calloc(1, sizeof(*pmutex));
+
+    if (!pmutex)
+        return NULL;
+    if (multiCore < 0)
+        multiCore = epicsThreadGetCPUs() > 1;
+    pmutex->pFileName = pFileName;
+    pmutex->lineno = lineno;
+    return pmutex;
+}
+
+epicsFastMutexId epicsStdCall
+epicsFastMutexOsiMustCreate(const char *pFileName, int lineno)
+{
+    epicsFastMutexId ret = epicsFastMutexOsiCreate(pFileName, lineno);
+    if (!ret)
+        cantProceed("epicsMutexMustCreateFast: epicsMutexCreateFast failed.");
+    return ret;
+}
+
+void epicsStdCall
+epicsFastMutexDestroy(epicsFastMutexId pmutex)
+{
+    free(pmutex);
+}
+
+static epicsMutexLockStatus
+lockContended(epicsFastMutexOSD *pmutex)
+{
+    int c;
+
+    if (fastMutexDebug && getOwner(pmutex) == epicsThreadGetIdSelf()) {
+        errlogPrintf("epicsFastMutex created at %s:%d locked recursively\n",
+            pmutex->pFileName, pmutex->lineno);
+        return epicsMutexLockError;
+    }
+
+    if (multiCore) {
+        int maxSpin = 2 * getSpin(pmutex) + 10;
+        int n;
+
+        if (maxSpin > MAX_SPIN)
+            maxSpin = MAX_SPIN;
+        for (n = 0; n < maxSpin; n++) {
+            c = 0;
+            if (__atomic_load_n(&pmutex->state, __ATOMIC_RELAXED) == 0 &&
+                __atomic_compare_exchange_n(&pmutex->state, &c, 1, 0,
+                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                adaptSpin(pmutex, n);
+                return epicsMutexLockOK;
+            }
+            cpuRelax();
+        }
+        adaptSpin(pmutex, maxSpin);
+    }
+
+    c = __atomic_exchange_n(&pmutex->state, 2, __ATOMIC_ACQUIRE);
+    while (c != 0) {
+        futexWait(&pmutex->state, 2);
+        c = __atomic_exchange_n(&pmutex->state, 2, __ATOMIC_ACQUIRE);
+    }
+    return epicsMutexLockOK;
+}
+
+epicsMutexLockStatus epicsStdCall
+epicsFastMutexLock(epicsFastMutexId pmutex)
+{
+    int c = 0;
+    epicsMutexLockStatus status = epicsMutexLockOK;
+
+    if (!__atomic_compare_exchange_n(&pmutex->state, &c, 1, 0,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        status = lockContended(pmutex);
+    if (fastMutexDebug && status == epicsMutexLockOK)
+        setOwner(pmutex, epicsThreadGetIdSelf());
+    return status;
+}
+
+epicsMutexLockStatus epicsStdCall
+epicsFastMutexTryLock(epicsFastMutexId pmutex)
+{
+    int c = 0;
+
+    if (!__atomic_compare_exchange_n(&pmutex->state, &c, 1, 0,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return epicsMutexLockTimeout;
+    if (fastMutexDebug)
+        setOwner(pmutex, epicsThreadGetIdSelf());
+    return epicsMutexLockOK;
+}
+
+void epicsStdCall
+epicsFastMutexUnlock(epicsFastMutexId pmutex)
+{
+    epicsThreadId owner = getOwner(pmutex);
+
+    if (owner) {
+        if (owner != epicsThreadGetIdSelf())
+            errlogPrintf("epicsFastMutex created at %s:%d unlocked by "
+                "a thread which is not the owner\n",
+                pmutex->pFileName, pmutex->lineno);
+        setOwner(pmutex, 0);
+    }
+    if (__atomic_exchange_n(&pmutex->state, 0, __ATOMIC_RELEASE) == 2)
+        futexWake(&pmutex->state, 1);
+}
+
+void epicsStdCall
+epicsFastMutexShow(epicsFastMutexId pmutex, unsigned int level)
+{
+    int state = __atomic_load_n(&pmutex->state, __ATOMIC_RELAXED);
+
+    printf("epicsFastMutexId %p source %s line %d %s\n",
+        (void *)pmutex, pmutex->pFileName, pmutex->lineno,
+        state == 0 ? "free" : state == 1 ? "locked" : "locked, contended");
+    if (level > 0)
+        printf("    spin %d owner %p\n", getSpin(pmutex),
+            (void *)getOwner(pmutex));
+}
+
+void epicsStdCall
+epicsFastMutexDebug(int enable)
+{
+    fastMutexDebug = enable;
+}
@@ -0,0 +1,418 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS Base is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Lock-free message queue for Linux.
+ *
+ * A bounded multi-producer multi-consumer ring after D. Vyukov.  Each
+ * slot holds a sequence number which tells a sender or receiver whether
+ * the slot is ready for it in the current lap of the ring, so that a
+ * position is claimed with a single compare and swap.  Threads which
+ * block wait on a futex, which is only touched when some thread is
+ * waiting.
+ *
+ * Unlike the default implementation, a sender which finds space does
+ * not defer to senders which are already blocked.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "epicsMessageQueue.h"
+#include "epicsTime.h"
+#include "epicsTypes.h"
+
+#define CACHE_LINE_SIZE 64
+
+/*
+ * A message slot, followed by the message
+ */
+struct slot {
+    epicsUInt64     seq;
+    unsigned int    size;
+};
+
+/*
+ * Threads waiting for space (senders) or messages (receivers)
+ */
+struct waitQueue {
+    int             futex;      /* changed when waiters should try again */
+    int             waiters;
+    int             waking;     /* a wakeup is on its way */
+};
+
+struct epicsMessageQueueOSD {
+    /* Next position to send, only written by senders */
+    epicsUInt64     sendPos;
+    char            pad0[CACHE_LINE_SIZE - sizeof(epicsUInt64)];
+    /* Next position to receive, only written by receivers */
+    epicsUInt64     recvPos;
+    char            pad1[CACHE_LINE_SIZE - sizeof(epicsUInt64)];
+
+    waitQueue       senders;
+    waitQueue       receivers;
+
+    unsigned long   capacity;
+    unsigned long   maxMessageSize;
+    size_t          slotSize;
+    char           *buf;
+};
+
+static inline slot *
+getSlot(epicsMessageQueueId pmsg, epicsUInt64 pos)
+{
+    return (slot *)(pmsg->buf + (size_t)(pos % pmsg->capacity) * pmsg->slotSize);
+}
+
+static int
+futexWait(int *addr, int val, const struct timespec *rel)
+{
+    return syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, rel, NULL, 0);
+}
+
+static void
+futexWake(int *addr, int count)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+LIBCOM_API epicsMessageQueueId epicsStdCall epicsMessageQueueCreate(
+    unsigned int capacity,
+    unsigned int maxMessageSize)
+{
+    epicsMessageQueueId pmsg;
+    void *mem;
+    unsigned long i;
+
+    if(capacity == 0)
+        return NULL;
+
+    if(posix_memalign(&mem, CACHE_LINE_SIZE, sizeof(*pmsg)))
+        return NULL;
+    pmsg = (epicsMessageQueueId)mem;
+    memset(pmsg, 0, sizeof(*pmsg));
+
+    pmsg->capacity = capacity;
+    pmsg->maxMessageSize = maxMessageSize;
+    pmsg->slotSize = (sizeof(slot) + maxMessageSize + sizeof(epicsUInt64) - 1)
+        & ~(sizeof(epicsUInt64) - 1);
+
+    pmsg->buf = (char *)calloc(capacity, pmsg->slotSize);
+    if(!pmsg->buf) {
+        free(pmsg);
+        return NULL;
+    }
+    for (i = 0; i < capacity; i++)
+        getSlot(pmsg, i)->seq = i;
+    return pmsg;
+}
+
+LIBCOM_API void epicsStdCall
+epicsMessageQueueDestroy(epicsMessageQueueId pmsg)
+{
+    free(pmsg->buf);
+    free(pmsg);
+}
+
+/*
+ * Copy a message into the next free slot, returns false if full.
+ */
+static bool
+tryPush(epicsMessageQueueId pmsg, const void *message, unsigned int size)
+{
+    epicsUInt64 pos = __atomic_load_n(&pmsg->sendPos, __ATOMIC_RELAXED);
+
+    while (true) {
+        slot *ps = getSlot(pmsg, pos);
+        epicsUInt64 seq = __atomic_load_n(&ps->seq, __ATOMIC_ACQUIRE);
+        epicsInt64 dif = (epicsInt64)(seq - pos);
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&pmsg->sendPos, &pos, pos + 1,
+                    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                ps->size = size;
+                memcpy(ps + 1, message, size);
+                __atomic_store_n(&ps->seq, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            /* pos now holds the current sendPos */
+        }
+        else if (dif < 0) {
+            /* the receivers have not emptied this slot yet */
+            return false;
+        }
+        else {
+            pos = __atomic_load_n(&pmsg->sendPos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/*
+ * Take the oldest message.  Returns its size, -1 if empty,
+ * or -2 if it was too large for the buffer and has been discarded.
+ */
+static int
+tryPop(epicsMessageQueueId pmsg, void *message, unsigned int size)
+{
+    epicsUInt64 pos = __atomic_load_n(&pmsg->recvPos, __ATOMIC_RELAXED);
+
+    while (true) {
+        slot *ps = getSlot(pmsg, pos);
+        epicsUInt64 seq = __atomic_load_n(&ps->seq, __ATOMIC_ACQUIRE);
+        epicsInt64 dif = (epicsInt64)(seq - (pos + 1));
+
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&pmsg->recvPos, &pos, pos + 1,
+                    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                int ret = -2;
+
+                if (ps->size <= size) {
+                    memcpy(message, ps + 1, ps->size);
+                    ret = ps->size;
+                }
+                /* free for the sender one lap later */
+                __atomic_store_n(&ps->seq, pos + pmsg->capacity,
+                    __ATOMIC_RELEASE);
+                return ret;
+            }
+        }
+        else if (dif < 0) {
+            return -1;
+        }
+        else {
+            pos = __atomic_load_n(&pmsg->recvPos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/*
+ * Called after a push or pop, wake one thread waiting for it.
+ * The fence orders the slot update before reading the count of
+ * waiters, which each waiter increments before trying again.
+ *
+ * Only one wakeup is sent until a waiter has run, which clears
+ * waking.  A waiter which then finds more work passes the wakeup on
+ * with wakeMore(), so that a burst of messages costs one system call
+ * rather than one each.
+ */
+static inline void
+wakeOne(waitQueue *pq)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pq->waiters, __ATOMIC_RELAXED) > 0 &&
+        !__atomic_load_n(&pq->waking, __ATOMIC_RELAXED) &&
+        !__atomic_exchange_n(&pq->waking, 1, __ATOMIC_SEQ_CST)) {
+        __atomic_add_fetch(&pq->futex, 1, __ATOMIC_SEQ_CST);
+        futexWake(&pq->futex, 1);
+    }
+}
+
+static inline void
+wakeMore(epicsMessageQueueId pmsg, waitQueue *pq, bool haveMessages)
+{
+    epicsUInt64 recvPos = __atomic_load_n(&pmsg->recvPos, __ATOMIC_ACQUIRE);
+    epicsUInt64 sendPos = __atomic_load_n(&pmsg->sendPos, __ATOMIC_ACQUIRE);
+
+    if (haveMessages ? sendPos != recvPos : sendPos - recvPos < pmsg->capacity)
+        wakeOne(pq);
+}
+
+/*
+ * Sleep until woken or the deadline (in epicsMonotonicGet() ns) passes.
+ * Returns false once the deadline has passed.
+ */
+static bool
+waitUntil(waitQueue *pq, int val, double timeout, epicsUInt64 deadline)
+{
+    struct timespec rel;
+
+    if (timeout < 0) {
+        futexWait(&pq->futex, val, NULL);
+        return true;
+    }
+    epicsUInt64 now = epicsMonotonicGet();
+    if (now >= deadline)
+        return false;
+    rel.tv_sec = (deadline - now) / 1000000000u;
+    rel.tv_nsec = (deadline - now) % 1000000000u;
+    futexWait(&pq->futex, val, &rel);
+    return true;
+}
+
+static epicsUInt64
+getDeadline(double timeout)
+{
+    if (timeout <= 0)
+        return 0;
+    if (timeout > 1e9)
+        timeout = 1e9;
+    return epicsMonotonicGet() + (epicsUInt64)(timeout * 1e9);
+}
+
+static int
+mySend(epicsMessageQueueId pmsg, void *message, unsigned int size,
+    double timeout)
+{
+    if(size > pmsg->maxMessageSize)
+        return -1;
+
+    if (tryPush(pmsg, message, size)) {
+        wakeOne(&pmsg->receivers);
+        return 0;
+    }
+
+    /*
+     * Return if not allowed to wait. NB -1 means wait forever.
+     */
+    if (timeout == 0)
+        return -1;
+
+    epicsUInt64 deadline = getDeadline(timeout);
+    bool waiting = true;
+
+    while (waiting) {
+        int val = __atomic_load_n(&pmsg->senders.futex, __ATOMIC_SEQ_CST);
+        bool sent;
+
+        __atomic_add_fetch(&pmsg->senders.waiters, 1, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&pmsg->senders.waking, 0, __ATOMIC_SEQ_CST);
+        sent = tryPush(pmsg, message, size);
+        if (!sent) {
+            waiting = waitUntil(&pmsg->senders, val, timeout, deadline);
+            __atomic_store_n(&pmsg->senders.waking, 0, __ATOMIC_SEQ_CST);
+        }
+        __atomic_sub_fetch(&pmsg->senders.waiters, 1, __ATOMIC_SEQ_CST);
+
+        /* a wakeup may arrive just as the timeout expires */
+        if (sent || (!waiting && tryPush(pmsg, message, size))) {
+            wakeOne(&pmsg->receivers);
+            wakeMore(pmsg, &pmsg->senders, false);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueueTrySend(epicsMessageQueueId pmsg, void *message,
+    unsigned int size)
+{
+    return mySend(pmsg, message, size, 0);
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueueSend(epicsMessageQueueId pmsg, void *message,
+    unsigned int size)
+{
+    return mySend(pmsg, message, size, -1);
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueueSendWithTimeout(epicsMessageQueueId pmsg, void *message,
+    unsigned int size, double timeout)
+{
+    return mySend(pmsg, message, size, timeout);
+}
+
+static int
+myReceive(epicsMessageQueueId pmsg, void *message, unsigned int size,
+    double timeout)
+{
+    int ret = tryPop(pmsg, message, size);
+
+    if (ret != -1) {
+        wakeOne(&pmsg->senders);
+        return ret < 0 ? -1 : ret;
+    }
+
+    /*
+     * Return if not allowed to wait. NB -1 means wait forever.
+     */
+    if (timeout == 0)
+        return -1;
+
+    epicsUInt64 deadline = getDeadline(timeout);
+    bool waiting = true;
+
+    while (waiting) {
+        int val = __atomic_load_n(&pmsg->receivers.futex, __ATOMIC_SEQ_CST);
+
+        __atomic_add_fetch(&pmsg->receivers.waiters, 1, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&pmsg->receivers.waking, 0, __ATOMIC_SEQ_CST);
+        ret = tryPop(pmsg, message, size);
+        if (ret == -1) {
+            waiting = waitUntil(&pmsg->receivers, val, timeout, deadline);
+            __atomic_store_n(&pmsg->receivers.waking, 0, __ATOMIC_SEQ_CST);
+        }
+        __atomic_sub_fetch(&pmsg->receivers.waiters, 1, __ATOMIC_SEQ_CST);
+
+        /* a wakeup may arrive just as the timeout expires */
+        if (ret == -1 && !waiting)
+            ret = tryPop(pmsg, message, size);
+        if (ret != -1) {
+            wakeOne(&pmsg->senders);
+            wakeMore(pmsg, &pmsg->receivers, true);
+            return ret < 0 ? -1 : ret;
+        }
+    }
+    return -1;
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueueTryReceive(epicsMessageQueueId pmsg, void *message,
+    unsigned int size)
+{
+    return myReceive(pmsg, message, size, 0);
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueueReceive(epicsMessageQueueId pmsg, void *message,
+    unsigned int size)
+{
+    return myReceive(pmsg, message, size, -1);
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueueReceiveWithTimeout(epicsMessageQueueId pmsg, void *message,
+    unsigned int size, double timeout)
+{
+    return myReceive(pmsg, message, size, timeout);
+}
+
+LIBCOM_API int epicsStdCall
+epicsMessageQueuePending(epicsMessageQueueId pmsg)
+{
+    /* read recvPos first, so that the difference is never negative */
+    epicsUInt64 recvPos = __atomic_load_n(&pmsg->recvPos, __ATOMIC_ACQUIRE);
+    epicsUInt64 sendPos = __atomic_load_n(&pmsg->sendPos, __ATOMIC_ACQUIRE);
+    epicsUInt64 nmsg = sendPos - recvPos;
+
+    /* includes messages which are still being copied in */
+    if (nmsg > pmsg->capacity)
+        nmsg = pmsg->capacity;
+    return (int)nmsg;
+}
+
+LIBCOM_API void epicsStdCall
+epicsMessageQueueShow(epicsMessageQueueId pmsg, int level)
+{
+    printf("Message Queue Used:%d  Slots:%lu",
+        epicsMessageQueuePending(pmsg), pmsg->capacity);
+    if (level >= 1)
+        printf("  Maximum size:%lu", pmsg->maxMessageSize);
+    if (level >= 2)
+        printf("  Waiting senders:%d receivers:%d",
+            __atomic_load_n(&pmsg->senders.waiters, __ATOMIC_RELAXED),
+            __atomic_load_n(&pmsg->receivers.waiters, __ATOMIC_RELAXED));
+    printf("\n");
+}
@@ -38,6 +38,7 @@ typedef struct epicsThreadOSD {
     int                isOnThreadList;
     unsigned int       osiPriority;
     int                joinable;
+    char              *affinity;    /* from epicsThreadOpts, or NULL */
     char               name[1];     /* actually larger */
 } epicsThreadOSD;
 
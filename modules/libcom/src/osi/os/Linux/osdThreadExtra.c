@@ -13,12 +13,18 @@
 
 /* This differs from the posix implementation of epicsThread by:
  * - printing the Linux LWP ID instead of the POSIX thread ID in the show routines
+ * - printing the current CPU, and at level 1 the affinity and migrations
  * - installing a default thread start hook, that sets the Linux thread name to the
- *   EPICS thread name to make it visible on OS level, and discovers the LWP ID */
+ *   EPICS thread name to make it visible on OS level, and discovers the LWP ID
+ * - supporting CPU affinity */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
 #include <unistd.h>
 #include <signal.h>
 #include <string.h>
+#include <sched.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/prctl.h>
@@ -27,12 +33,154 @@
 #include "ellLib.h"
 #include "epicsEvent.h"
 #include "epicsThread.h"
+#include "errlog.h"
+
+/* Parse a list like "0-3,8".  NULL or "" selects all CPUs. */
+static int parseCpuList(const char *cpulist, cpu_set_t *set)
+{
+    const char *cp = cpulist;
+
+    CPU_ZERO(set);
+    if (!cp || !*cp) {
+        int cpu;
+
+        for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            CPU_SET(cpu, set);
+        return 0;
+    }
+    while (*cp) {
+        unsigned long first, last;
+        char *end;
+
+        first = last = strtoul(cp, &end, 10);
+        if (end == cp)
+            return -1;
+        if (*end == '-') {
+            cp = end + 1;
+            last = strtoul(cp, &end, 10);
+            if (end == cp)
+                return -1;
+        }
+        if (last < first || last >= CPU_SETSIZE)
+            return -1;
+        for (; first <= last; first++)
+            CPU_SET(first, set);
+
+        cp = end;
+        if (*cp == ',')
+            cp++;
+        else if (*cp)
+            return -1;
+    }
+    return 0;
+}
+
+static void formatCpuList(const cpu_set_t *set, char *buf, size_t size)
+{
+    int cpu = 0;
+    size_t len = 0;
+
+    buf[0] = '\0';
+    while (cpu < CPU_SETSIZE && len < size) {
+        int last;
+
+        if (!CPU_ISSET(cpu, set)) {
+            cpu++;
+            continue;
+        }
+        for (last = cpu; last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set); )
+            last++;
+        if (last == cpu)
+            len += snprintf(buf + len, size - len, "%s%d", len ? "," : "", cpu);
+        else
+            len += snprintf(buf + len, size - len, "%s%d-%d", len ? "," : "",
+                cpu, last);
+        cpu = last + 1;
+    }
+}
+
+int osdThreadSetAffinity(epicsThreadId pthreadInfo, const char *cpulist)
+{
+    cpu_set_t set;
+    int status;
+
+    if (parseCpuList(cpulist, &set)) {
+        errlogPrintf("epicsThreadSetAffinity: invalid CPU list \"%s\"\n",
+            cpulist);
+        return -1;
+    }
+    /* tid may not be stored yet when a new thread sets its own
+     * affinity, and it is zero for the main thread
+     */
+    if (pthreadInfo == epicsThreadGetIdSelf())
+        status = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    else if (pthreadInfo->tid)
+        status = pthread_setaffinity_np(pthreadInfo->tid, sizeof(set), &set);
+    else if (pthreadInfo->lwpId)
+        status = sched_setaffinity(pthreadInfo->lwpId, sizeof(set), &set) ?
+            errno : 0;
+    else
+        status = ESRCH;
+    if (status) {
+        errlogPrintf("epicsThreadSetAffinity: %s: %s\n",
+            pthreadInfo->name, strerror(status));
+        return -1;
+    }
+    return 0;
+}
+
+/* The CPU which last ran the thread, field 39 of /proc/.../stat */
+static int lastCpu(pid_t lwpId)
+{
+    char buf[512];
+    const char *cp;
+    FILE *fp;
+    int field, cpu = -1;
+
+    sprintf(buf, "/proc/self/task/%ld/stat", (long)lwpId);
+    fp = fopen(buf, "r");
+    if (!fp)
+        return -1;
+    if (fgets(buf, sizeof(buf), fp) && (cp = strrchr(buf, ')')) != NULL) {
+        /* the name in field 2 may contain spaces */
+        for (field = 3; field <= 39 && cp; field++)
+            cp = strchr(cp + 1, ' ');
+        if (cp)
+            cpu = atoi(cp + 1);
+    }
+    fclose(fp);
+    return cpu;
+}
+
+/* Needs a kernel with CONFIG_SCHED_DEBUG, otherwise -1 */
+static long migrations(pid_t lwpId)
+{
+    char buf[128];
+    FILE *fp;
+    long count = -1;
+
+    sprintf(buf, "/proc/self/task/%ld/sched", (long)lwpId);
+    fp = fopen(buf, "r");
+    if (!fp)
+        return -1;
+    while (fgets(buf, sizeof(buf), fp)) {
+        if (strncmp(buf, "se.nr_migrations", 16) == 0) {
+            const char *cp = strchr(buf, ':');
+
+            if (cp)
+                count = atol(cp + 1);
+            break;
+        }
+    }
+    fclose(fp);
+    return count;
+}
 
 void epicsThreadShowInfo(epicsThreadId pthreadInfo, unsigned int level)
 {
     if (!pthreadInfo) {
         fprintf(epicsGetStdout(), "            NAME       EPICS ID   "
-            "LWP ID   OSIPRI  OSSPRI  STATE\n");
+            "LWP ID   OSIPRI  OSSPRI  STATE  CPU\n");
     } else {
         struct sched_param param;
         int priority = 0;
@@ -45,11 +193,22 @@ void epicsThreadShowInfo(epicsThreadId pthreadInfo, unsigned int level)
             if (!status)
                 priority = param.sched_priority;
         }
-        fprintf(epicsGetStdout(),"%16.16s %14p %8lu    %3d%8d %8.8s\n",
+        fprintf(epicsGetStdout(),"%16.16s %14p %8lu    %3d%8d %8.8s %4d\n",
              pthreadInfo->name,(void *)
              pthreadInfo,(unsigned long)pthreadInfo->lwpId,
              pthreadInfo->osiPriority,priority,
-             pthreadInfo->isSuspended ? "SUSPEND" : "OK");
+             pthreadInfo->isSuspended ? "SUSPEND" : "OK",
+             pthreadInfo->lwpId ? lastCpu(pthreadInfo->lwpId) : -1);
+
+        if (level > 0 && pthreadInfo->lwpId) {
+            cpu_set_t set;
+            char cpus[128] = "?";
+
+            if (sched_getaffinity(pthreadInfo->lwpId, sizeof(set), &set) == 0)
+                formatCpuList(&set, cpus, sizeof(cpus));
+            fprintf(epicsGetStdout(), "%16s affinity %s, migrations %ld\n",
+                "", cpus, migrations(pthreadInfo->lwpId));
+        }
     }
 }
 
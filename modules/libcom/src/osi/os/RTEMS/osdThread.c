@@ -868,3 +868,15 @@ LIBCOM_API int epicsThreadGetCPUs(void)
     return 1;
 #endif
 }
+
+LIBCOM_API int epicsThreadSetAffinity(epicsThreadId id, const char *cpulist)
+{
+    /* not implemented */
+    return -1;
+}
+
+LIBCOM_API int epicsThreadSetAffinityMatching(const char *pattern,
+    const char *cpulist)
+{
+    return -1;
+}
@@ -1121,6 +1121,21 @@ LIBCOM_API int epicsThreadGetCPUs ( void )
     return 1;
 }
 
+/*
+ * epicsThreadSetAffinity ()
+ */
+LIBCOM_API int epicsThreadSetAffinity ( epicsThreadId id, const char *cpulist )
+{
+    /* not implemented */
+    return -1;
+}
+
+LIBCOM_API int epicsThreadSetAffinityMatching ( const char *pattern,
+    const char *cpulist )
+{
+    return -1;
+}
+
 #ifdef TEST_CODES
 void testPriorityMapping ()
 {
@@ -0,0 +1,206 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Default fast mutex, using epicsAtomic and an epicsEvent.
+ *
+ * The state is 0 when free, 1 when locked and 2 when locked and some
+ * thread may be waiting for the event, so that unlock only signals the
+ * event when somebody may have to be woken.  Since the event is binary
+ * a waiter may wake when the mutex is still taken, and then just waits
+ * again.  On a multi-core machine a locker spins before waiting, for up
+ * to twice as long as the mutex needed to become free recently.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "cantProceed.h"
+#include "epicsAtomic.h"
+#include "epicsEvent.h"
+#include "epicsMutex.h"
+#include "epicsThread.h"
+#include "errlog.h"
+
+#define MAX_SPIN 1000
+
+typedef struct epicsFastMutexOSD {
+    int             state;
+    int             spin;       /* recent spin count, adapted when contended */
+    epicsThreadId   owner;      /* only while debugging */
+    epicsEventId    wakeup;
+    const char     *pFileName;
+    int             lineno;
+} epicsFastMutexOSD;
+
+static int fastMutexDebug;
+static int multiCore = -1;
+
+/*
+ * spin and owner are also read and written by threads which do not
+ * hold the mutex, so they are only accessed atomically.  A lost update
+ * of spin just makes the estimate a little less accurate.
+ */
+static int
+getSpin(epicsFastMutexOSD *pmutex)
+{
+    return epicsAtomicGetIntT(&pmutex->spin);
+}
+
+static void
+adaptSpin(epicsFastMutexOSD *pmutex, int n)
+{
+    int spin = getSpin(pmutex);
+
+    epicsAtomicSetIntT(&pmutex->spin, spin + (n - spin) / 8);
+}
+
+static epicsThreadId
+getOwner(epicsFastMutexOSD *pmutex)
+{
+    return (epicsThreadId) epicsAtomicGetPtrT((EpicsAtomicPtrT *) &pmutex->owner);
+}
+
+static void
+setOwner(epicsFastMutexOSD *pmutex, epicsThreadId owner)
+{
+    epicsAtomicSetPtrT((EpicsAtomicPtrT *) &pmutex->owner,
+        (EpicsAtomicPtrT) owner);
+}
+
+static int
+exchange(int *pState, int val)
+{
+    int prev = epicsAtomicGetIntT(pState);
+    int cur;
+
+    while ((cur = epicsAtomicCmpAndSwapIntT(pState, prev, val)) != prev)
+        prev = cur;
+    return prev;
+}
+
+epicsFastMutexId epicsStdCall
+epicsFastMutexOsiCreate(const char *pFileName, int lineno)
+{
+    epicsFastMutexOSD *pmutex = calloc(1, sizeof(*pmutex));
+
+    if (!pmutex)
+        return NULL;
+    pmutex->wakeup = epicsEventCreate(epicsEventEmpty);
+    if (!pmutex->wakeup) {
+        free(pmutex);
+        return NULL;
+    }
+    if (multiCore < 0)
+        multiCore = epicsThreadGetCPUs() > 1;
+    pmutex->pFileName = pFileName;
+    pmutex->lineno = lineno;
+    return pmutex;
+}
+
+epicsFastMutexId epicsStdCall
+epicsFastMutexOsiMustCreate(const char *pFileName, int lineno)
+{
+    epicsFastMutexId ret = epicsFastMutexOsiCreate(pFileName, lineno);
+    if (!ret)
+        cantProceed("epicsMutexMustCreateFast: epicsMutexCreateFast failed.");
+    return ret;
+}
+
+void epicsStdCall
+epicsFastMutexDestroy(epicsFastMutexId pmutex)
+{
+    epicsEventDestroy(pmutex->wakeup);
+    free(pmutex);
+}
+
+static epicsMutexLockStatus
+lockContended(epicsFastMutexOSD *pmutex)
+{
+    if (fastMutexDebug && getOwner(pmutex) == epicsThreadGetIdSelf()) {
+        errlogPrintf("epicsFastMutex created at %s:%d locked recursively\n",
+            pmutex->pFileName, pmutex->lineno);
+        return epicsMutexLockError;
+    }
+
+    if (multiCore) {
+        int maxSpin = 2 * getSpin(pmutex) + 10;
+        int n;
+
+        if (maxSpin > MAX_SPIN)
+            maxSpin = MAX_SPIN;
+        for (n = 0; n < maxSpin; n++) {
+            if (epicsAtomicGetIntT(&pmutex->state) == 0 &&
+                epicsAtomicCmpAndSwapIntT(&pmutex->state, 0, 1) == 0) {
+                adaptSpin(pmutex, n);
+                return epicsMutexLockOK;
+            }
+        }
+        adaptSpin(pmutex, maxSpin);
+    }
+
+    while (exchange(&pmutex->state, 2) != 0)
+        epicsEventMustWait(pmutex->wakeup);
+    return epicsMutexLockOK;
+}
+
+epicsMutexLockStatus epicsStdCall
+epicsFastMutexLock(epicsFastMutexId pmutex)
+{
+    epicsMutexLockStatus status = epicsMutexLockOK;
+
+    if (epicsAtomicCmpAndSwapIntT(&pmutex->state, 0, 1) != 0)
+        status = lockContended(pmutex);
+    if (fastMutexDebug && status == epicsMutexLockOK)
+        setOwner(pmutex, epicsThreadGetIdSelf());
+    return status;
+}
+
+epicsMutexLockStatus epicsStdCall
+epicsFastMutexTryLock(epicsFastMutexId pmutex)
+{
+    if (epicsAtomicCmpAndSwapIntT(&pmutex->state, 0, 1) != 0)
+        return epicsMutexLockTimeout;
+    if (fastMutexDebug)
+        setOwner(pmutex, epicsThreadGetIdSelf());
+    return epicsMutexLockOK;
+}
+
+void epicsStdCall
+epicsFastMutexUnlock(epicsFastMutexId pmutex)
+{
+    epicsThreadId owner = getOwner(pmutex);
+
+    if (owner) {
+        if (owner != epicsThreadGetIdSelf())
+            errlogPrintf("epicsFastMutex created at %s:%d unlocked by "
+                "a thread which is not the owner\n",
+                pmutex->pFileName, pmutex->lineno);
+        setOwner(pmutex, 0);
+    }
+    if (exchange(&pmutex->state, 0) == 2)
+        epicsEventMustTrigger(pmutex->wakeup);
+}
+
+void epicsStdCall
+epicsFastMutexShow(epicsFastMutexId pmutex, unsigned int level)
+{
+    int state = epicsAtomicGetIntT(&pmutex->state);
+
+    printf("epicsFastMutexId %p source %s line %d %s\n",
+        (void *)pmutex, pmutex->pFileName, pmutex->lineno,
+        state == 0 ? "free" : state == 1 ? "locked" : "locked, contended");
+    if (level > 0)
+        printf("    spin %d owner %p\n", getSpin(pmutex),
+            (void *)getOwner(pmutex));
+}
+
+void epicsStdCall
+epicsFastMutexDebug(int enable)
+{
+    fastMutexDebug = enable;
+}
@@ -29,6 +29,7 @@
 #endif
 
 #include "epicsStdio.h"
+#include "dbDefs.h"
 #include "ellLib.h"
 #include "epicsEvent.h"
 #include "epicsMutex.h"
@@ -39,8 +40,10 @@
 #include "epicsAssert.h"
 #include "epicsExit.h"
 #include "epicsAtomic.h"
+#include "envDefs.h"
 
 LIBCOM_API void epicsThreadShowInfo(epicsThreadOSD *pthreadInfo, unsigned int level);
+int osdThreadSetAffinity(epicsThreadOSD *pthreadInfo, const char *cpulist);
 LIBCOM_API void osdThreadHooksRun(epicsThreadId id);
 LIBCOM_API void osdThreadHooksRunMain(epicsThreadId id);
 
@@ -175,7 +178,7 @@ static epicsThreadOSD * create_threadInfo(const char *name)
 static epicsThreadOSD * init_threadInfo(const char *name,
     unsigned int priority, unsigned int stackSize,
     EPICSTHREADFUNC funptr,void *parm,
-    unsigned joinable)
+    unsigned joinable, const char *affinity)
 {
     epicsThreadOSD *pthreadInfo;
     int status;
@@ -186,6 +189,15 @@ static epicsThreadOSD * init_threadInfo(const char *name,
     pthreadInfo->createFunc = funptr;
     pthreadInfo->createArg = parm;
     pthreadInfo->joinable = !!joinable; /* ensure 0 or 1 for later atomic compare+swap */
+    if(affinity) {
+        pthreadInfo->affinity = malloc(strlen(affinity) + 1);
+        if(!pthreadInfo->affinity) {
+            epicsEventDestroy(pthreadInfo->suspendEvent);
+            free(pthreadInfo);
+            return NULL;
+        }
+        strcpy(pthreadInfo->affinity, affinity);
+    }
     status = pthread_attr_init(&pthreadInfo->attr);
     checkStatusOnce(status,"pthread_attr_init");
     if(status) return 0;
@@ -220,6 +232,7 @@ static void free_threadInfo(epicsThreadOSD *pthreadInfo)
     epicsEventDestroy(pthreadInfo->suspendEvent);
     status = pthread_attr_destroy(&pthreadInfo->attr);
     checkStatusQuit(status,"pthread_attr_destroy","free_threadInfo");
+    free(pthreadInfo->affinity);
     free(pthreadInfo);
 }
 
@@ -374,7 +387,7 @@ static void once(void)
     if(errVerbose) fprintf(stderr,"task priorities are not implemented\n");
 #endif /* _POSIX_THREAD_PRIORITY_SCHEDULING */
 
-    pthreadInfo = init_threadInfo("_main_",0,epicsThreadGetStackSize(epicsThreadStackSmall),0,0,0);
+    pthreadInfo = init_threadInfo("_main_",0,epicsThreadGetStackSize(epicsThreadStackSmall),0,0,0,NULL);
     assert(pthreadInfo!=NULL);
     status = pthread_setspecific(getpthreadInfo,(void *)pthreadInfo);
     checkStatusOnceQuit(status,"pthread_setspecific","epicsThreadInit");
@@ -390,6 +403,33 @@ static void once(void)
     epicsThreadOnceCalled = 1;
 }
 
+/* Default CPU affinity of threads by name, used when
+ * epicsThreadOpts::affinity was not given.
+ */
+static const struct {
+    const char *pattern;
+    const ENV_PARAM *param;
+} affinityClass[] = {
+    {"scan*", &EPICS_THREAD_AFFINITY_SCAN},
+    {"cb*", &EPICS_THREAD_AFFINITY_CALLBACK},
+    {"CAS-*", &EPICS_THREAD_AFFINITY_CAS},
+    {"CAC-*", &EPICS_THREAD_AFFINITY_CAC},
+};
+
+static void setInitialAffinity(epicsThreadOSD *pthreadInfo)
+{
+    const char *cpulist = pthreadInfo->affinity;
+    size_t i;
+
+    for(i = 0; !cpulist && i < NELEMENTS(affinityClass); i++) {
+        if(epicsStrGlobMatch(pthreadInfo->name, affinityClass[i].pattern))
+            cpulist = envGetConfigParamPtr(affinityClass[i].param);
+    }
+    if(cpulist && osdThreadSetAffinity(pthreadInfo, cpulist))
+        errlogPrintf("%s: unable to set CPU affinity \"%s\"\n",
+            pthreadInfo->name, cpulist);
+}
+
 static void * start_routine(void *arg)
 {
     epicsThreadOSD *pthreadInfo = (epicsThreadOSD *)arg;
@@ -406,6 +446,7 @@ static void * start_routine(void *arg)
     pthreadInfo->isOnThreadList = 1;
     status = pthread_mutex_unlock(&listLock);
     checkStatusQuit(status,"pthread_mutex_unlock","start_routine");
+    setInitialAffinity(pthreadInfo);
     osdThreadHooksRun(pthreadInfo);
 
     (*pthreadInfo->createFunc)(pthreadInfo->createArg);
@@ -550,7 +591,7 @@ epicsThreadCreateOpt(const char * name,
     pthread_sigmask(SIG_SETMASK, &blockAllSig, &oldSig);
 
     pthreadInfo = init_threadInfo(name, opts->priority, stackSize, funptr,
-        parm, opts->joinable);
+        parm, opts->joinable, opts->affinity);
     if (pthreadInfo==0)
         return 0;
 
@@ -570,7 +611,7 @@ epicsThreadCreateOpt(const char * name,
         free_threadInfo(pthreadInfo);
 
         pthreadInfo = init_threadInfo(name, opts->priority, stackSize,
-            funptr, parm, opts->joinable);
+            funptr, parm, opts->joinable, opts->affinity);
         if (pthreadInfo==0)
             return 0;
 
@@ -881,6 +922,40 @@ LIBCOM_API void epicsThreadMap(EPICS_THREAD_HOOK_ROUTINE func)
     checkStatus(status, "pthread_mutex_unlock epicsThreadMap");
 }
 
+LIBCOM_API int epicsThreadSetAffinity(epicsThreadId id, const char *cpulist)
+{
+    epicsThreadInit();
+    return osdThreadSetAffinity(id, cpulist);
+}
+
+LIBCOM_API int epicsThreadSetAffinityMatching(const char *pattern,
+    const char *cpulist)
+{
+    epicsThreadOSD *pthreadInfo;
+    int status;
+    int count = 0;
+
+    epicsThreadInit();
+    status = mutexLock(&listLock);
+    checkStatus(status,"pthread_mutex_lock epicsThreadSetAffinityMatching");
+    if(status)
+        return -1;
+    pthreadInfo=(epicsThreadOSD *)ellFirst(&pthreadList);
+    while(pthreadInfo) {
+        if(epicsStrGlobMatch(pthreadInfo->name, pattern)) {
+            if(osdThreadSetAffinity(pthreadInfo, cpulist)) {
+                count = -1;
+                break;
+            }
+            count++;
+        }
+        pthreadInfo=(epicsThreadOSD *)ellNext(&pthreadInfo->node);
+    }
+    status = pthread_mutex_unlock(&listLock);
+    checkStatus(status,"pthread_mutex_unlock epicsThreadSetAffinityMatching");
+    return count;
+}
+
 LIBCOM_API void epicsStdCall epicsThreadShowAll(unsigned int level)
 {
     epicsThreadOSD *pthreadInfo;
@@ -43,3 +43,9 @@ void epicsThreadShowInfo(epicsThreadOSD *pthreadInfo, unsigned int level)
     }
 }
 
+
+int osdThreadSetAffinity(epicsThreadOSD *pthreadInfo, const char *cpulist)
+{
+    /* not supported by this target */
+    return -1;
+}
@@ -23,6 +23,7 @@
 #define S_pool_paused    (M_pool| 4) /*Pool not currently accepting jobs*/
 #define S_pool_noThreads (M_pool| 5) /*Can't create worker thread*/
 #define S_pool_timeout   (M_pool| 6) /*Pool still busy after timeout*/
+#define S_pool_noMemory  (M_pool| 7) /*Unable to allocate tasks*/
 
 #ifdef __cplusplus
 extern "C" {
@@ -147,6 +148,61 @@ LIBCOM_API int epicsJobQueue(epicsJob*);
 LIBCOM_API int epicsJobUnqueue(epicsJob*);
 
 
+/* Fork-join task groups
+ *
+ * A task is a single call of a function, which is run once and cannot
+ * be cancelled.  Tasks are not kept on the run queue of epicsJob.
+ * Each worker has its own deque of tasks, and a worker which runs out
+ * of tasks steals them from the others.  Tasks queued from a running
+ * task or job go onto the deque of that worker.  Tasks queued by other
+ * threads are handed to the workers in batches.
+ *
+ * The epicsThreadPoolControl() options only apply to epicsJob.  All of
+ * the groups of a pool must have been waited for before it is destroyed.
+ */
+typedef void (*epicsTaskFunction)(void *arg);
+
+typedef struct epicsJobGroup epicsJobGroup;
+
+/* Returns a new group, or NULL on error. */
+LIBCOM_API epicsJobGroup* epicsJobGroupCreate(epicsThreadPool *pool);
+
+/* The group must not have any tasks which have not been waited for. */
+LIBCOM_API void epicsJobGroupDestroy(epicsJobGroup *group);
+
+/* Queue func(arg) to run on the pool.
+ * Safe to call from a running task or job.
+ * returns 0 for success, non-zero on error.
+ */
+LIBCOM_API int epicsJobGroupAdd(epicsJobGroup *group,
+                                epicsTaskFunction func, void *arg);
+
+/* Queue func(args[0]) ... func(args[n-1]) with one allocation.
+ * If args is NULL the argument of each task is NULL.
+ * Safe to call from a running task or job.
+ * returns 0 for success, non-zero on error.
+ */
+LIBCOM_API int epicsJobGroupAddBatch(epicsJobGroup *group,
+                                     epicsTaskFunction func,
+                                     void * const *args, size_t n);
+
+/* Block until all of the tasks queued to the group have run.
+ * The caller runs queued tasks, which may belong to other groups,
+ * while it waits.  A task must not wait for its own group, but may
+ * wait for a group of tasks which it queued.
+ * The group may be used again afterwards.
+ */
+LIBCOM_API void epicsJobGroupWait(epicsJobGroup *group);
+
+/* Run func(args[0]) ... func(args[n-1]) on the pool, and
+ * wait for all of them to finish.
+ * returns 0 for success, non-zero on error.
+ */
+LIBCOM_API int epicsThreadPoolRunAll(epicsThreadPool *pool,
+                                     epicsTaskFunction func,
+                                     void * const *args, size_t n);
+
+
 /* Mostly useful for debugging */
 
 LIBCOM_API void epicsThreadPoolReport(epicsThreadPool *pool, FILE *fd);
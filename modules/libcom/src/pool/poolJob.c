@@ -18,6 +18,7 @@
 #include "epicsMutex.h"
 #include "epicsEvent.h"
 #include "epicsInterrupt.h"
+#include "epicsAtomic.h"
 
 #include "epicsThreadPool.h"
 #include "poolPriv.h"
@@ -27,8 +28,12 @@ void *epicsJobArgSelfMagic = &epicsJobArgSelfMagic;
 static
 void workerMain(void *arg)
 {
-    epicsThreadPool *pool = arg;
+    epicsThreadPoolWorker *self = arg;
+    epicsThreadPool *pool = self->pool;
     unsigned int nrun, ocnt;
+    size_t ntasks;
+
+    poolWorkerSetSelf(self);
 
     /* workers are created with counts
      * in the running, sleeping, and (possibly) waking counters
@@ -37,18 +42,21 @@ void workerMain(void *arg)
     epicsMutexMustLock(pool->guard);
     pool->threadsAreAwake++;
     pool->threadsSleeping--;
+    epicsAtomicDecrIntT(&pool->threadsIdle);
 
     while (1) {
         ELLNODE *cur;
 
         pool->threadsAreAwake--;
         pool->threadsSleeping++;
+        epicsAtomicIncrIntT(&pool->threadsIdle);
         epicsMutexUnlock(pool->guard);
 
         epicsEventMustWait(pool->workerWakeup);
 
         epicsMutexMustLock(pool->guard);
         pool->threadsSleeping--;
+        epicsAtomicDecrIntT(&pool->threadsIdle);
         pool->threadsAreAwake++;
 
         if (pool->threadsWaking==0)
@@ -61,39 +69,46 @@ void workerMain(void *arg)
         if (pool->shutdown)
             break;
 
-        if (pool->pauserun)
-            continue;
-
         /* more threads to wakeup */
-        if (pool->threadsWaking) {
+        if (pool->threadsWaking && !pool->pauserun) {
             epicsEventSignal(pool->workerWakeup);
         }
 
-        while ((cur=ellGet(&pool->jobs)) != NULL) {
-            epicsJob *job = CONTAINER(cur, epicsJob, jobnode);
-
-            assert(job->queued && !job->running);
-
-            job->queued=0;
-            job->running=1;
+        do {
+            /* pauserun only holds back jobs, not tasks */
+            while (!pool->pauserun && (cur=ellGet(&pool->jobs)) != NULL) {
+                epicsJob *job = CONTAINER(cur, epicsJob, jobnode);
+
+                assert(job->queued && !job->running);
+
+                job->queued=0;
+                job->running=1;
+
+                epicsMutexUnlock(pool->guard);
+                (*job->func)(job->arg, epicsJobModeRun);
+                epicsMutexMustLock(pool->guard);
+
+                if (job->freewhendone) {
+                    job->dead=1;
+                    free(job);
+                }
+                else {
+                    job->running=0;
+                    /* job may be re-queued from within callback */
+                    if (job->queued)
+                        ellAdd(&pool->jobs, &job->jobnode);
+                    else
+                        ellAdd(&pool->owned, &job->jobnode);
+                }
+            }
 
             epicsMutexUnlock(pool->guard);
-            (*job->func)(job->arg, epicsJobModeRun);
+            ntasks = poolRunTasks(self);
             epicsMutexMustLock(pool->guard);
 
-            if (job->freewhendone) {
-                job->dead=1;
-                free(job);
-            }
-            else {
-                job->running=0;
-                /* job may be re-queued from within callback */
-                if (job->queued)
-                    ellAdd(&pool->jobs, &job->jobnode);
-                else
-                    ellAdd(&pool->owned, &job->jobnode);
-            }
-        }
+            /* a job or task may have queued more work */
+        } while (ntasks || epicsAtomicGetSizeT(&pool->ninject) ||
+                 (!pool->pauserun && ellCount(&pool->jobs)));
 
         if (pool->observerCount)
             epicsEventSignal(pool->observerWakeup);
@@ -117,18 +132,38 @@ void workerMain(void *arg)
 
 int createPoolThread(epicsThreadPool *pool)
 {
+    epicsThreadPoolWorker *worker;
     epicsThreadId tid;
+    int n = pool->nworkers;
+
+    if (n >= (int)pool->conf.maxThreads)
+        return S_pool_noThreads;
+
+    worker = poolWorkerCreate(pool);
+    if (!worker)
+        return S_pool_noThreads;
+
+    /* counted before the worker can run */
+    pool->threadsRunning++;
+    pool->threadsSleeping++;
+    epicsAtomicIncrIntT(&pool->threadsIdle);
 
     tid = epicsThreadCreate("PoolWorker",
                             pool->conf.workerPriority,
                             pool->conf.workerStack,
                             &workerMain,
-                            pool);
-    if (!tid)
+                            worker);
+    if (!tid) {
+        pool->threadsRunning--;
+        pool->threadsSleeping--;
+        epicsAtomicDecrIntT(&pool->threadsIdle);
+        poolWorkerDestroy(worker);
         return S_pool_noThreads;
+    }
 
-    pool->threadsRunning++;
-    pool->threadsSleeping++;
+    /* thieves read the entries below nworkers without the guard */
+    epicsAtomicSetPtrT((EpicsAtomicPtrT*)&pool->workers[n], worker);
+    epicsAtomicSetIntT(&pool->nworkers, n + 1);
     return 0;
 }
 
@@ -15,6 +15,26 @@
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 
+/* A bounded work stealing deque of task pointers (Chase and Lev).
+ * Only the owning worker pushes and pops at the bottom, any other
+ * thread may steal from the top.
+ */
+typedef struct {
+    size_t top;
+    size_t bottom;
+    size_t mask; /* capacity-1, capacity is a power of 2 */
+    void **buf;
+} poolDeque;
+
+typedef struct epicsThreadPoolWorker {
+    epicsThreadPool *pool;
+    poolDeque tasks;
+    unsigned int seed; /* for victim selection */
+    /* statistics, only written by this worker */
+    size_t nrun;
+    size_t nstolen;
+} epicsThreadPoolWorker;
+
 struct epicsThreadPool {
     ELLNODE sharedNode;
     size_t sharedCount;
@@ -22,6 +42,19 @@ struct epicsThreadPool {
     ELLLIST jobs; /* run queue */
     ELLLIST owned; /* unqueued jobs. */
 
+    /* Tasks queued by threads which are not workers of this pool.
+     * Workers move them onto their own deques in batches.
+     */
+    ELLLIST inject;
+    size_t ninject; /* ellCount(&inject), read without injectGuard */
+    epicsMutexId injectGuard;
+
+    /* conf.maxThreads entries, of which the first nworkers
+     * may be read without the guard
+     */
+    epicsThreadPoolWorker **workers;
+    int nworkers;
+
     /* Worker state counters.
      * The life cycle of a worker is
      *   Wakeup -> Awake -> Sleeping
@@ -36,6 +69,8 @@ struct epicsThreadPool {
     unsigned int threadsSleeping;
     /* # of threads started and not stopped */
     unsigned int threadsRunning;
+    /* threadsSleeping, read without the guard */
+    int threadsIdle;
 
     /* # of observers waiting on pool events */
     unsigned int observerCount;
@@ -95,12 +130,46 @@ struct epicsJob {
     unsigned int dead:1; /* flag to catch use of freed objects */
 };
 
+/* A task is queued once, and may not be cancelled.  The tasks
+ * queued together are allocated in one block, which is freed
+ * when the last of them has run.
+ */
+typedef struct epicsPoolTask {
+    ELLNODE node; /* while in the inject list */
+    epicsTaskFunction func;
+    void *arg;
+    epicsJobGroup *group;
+    struct poolTaskBlock *block;
+} epicsPoolTask;
+
+typedef struct poolTaskBlock {
+    size_t remaining;
+    epicsPoolTask tasks[1];
+} poolTaskBlock;
+
+struct epicsJobGroup {
+    epicsThreadPool *pool;
+    /* # of tasks which have not finished, plus one held by
+     * the group until epicsJobGroupWait()
+     */
+    size_t pending;
+    epicsEventId done;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 int createPoolThread(epicsThreadPool *pool);
 
+/* for workers of this pool, NULL for other threads */
+epicsThreadPoolWorker* poolWorkerSelf(epicsThreadPool *pool);
+void poolWorkerSetSelf(epicsThreadPoolWorker *worker);
+epicsThreadPoolWorker* poolWorkerCreate(epicsThreadPool *pool);
+void poolWorkerDestroy(epicsThreadPoolWorker *worker);
+/* run tasks until none can be found, returns the number run */
+size_t poolRunTasks(epicsThreadPoolWorker *self);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,403 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dbDefs.h"
+#include "errlog.h"
+#include "ellLib.h"
+#include "epicsAtomic.h"
+#include "epicsThread.h"
+#include "epicsMutex.h"
+#include "epicsEvent.h"
+#include "epicsAssert.h"
+
+#include "epicsThreadPool.h"
+#include "poolPriv.h"
+
+/* per worker deque capacity, tasks beyond this go to the inject list */
+#define DEQUE_SIZE 1024u
+/* most tasks a worker moves from the inject list at one time */
+#define INJECT_BATCH 256u
+
+static epicsThreadOnceId poolTaskOnce = EPICS_THREAD_ONCE_INIT;
+static epicsThreadPrivateId poolWorkerId;
+
+static
+void poolTaskInit(void *unused)
+{
+    poolWorkerId = epicsThreadPrivateCreate();
+}
+
+epicsThreadPoolWorker* poolWorkerSelf(epicsThreadPool *pool)
+{
+    epicsThreadPoolWorker *self;
+
+    epicsThreadOnce(&poolTaskOnce, &poolTaskInit, NULL);
+    self = epicsThreadPrivateGet(poolWorkerId);
+    return (self && self->pool == pool) ? self : NULL;
+}
+
+void poolWorkerSetSelf(epicsThreadPoolWorker *worker)
+{
+    epicsThreadOnce(&poolTaskOnce, &poolTaskInit, NULL);
+    epicsThreadPrivateSet(poolWorkerId, worker);
+}
+
+epicsThreadPoolWorker* poolWorkerCreate(epicsThreadPool *pool)
+{
+    epicsThreadPoolWorker *worker = calloc(1, sizeof(*worker));
+
+    if (!worker)
+        return NULL;
+    worker->tasks.buf = calloc(DEQUE_SIZE, sizeof(void*));
+    if (!worker->tasks.buf) {
+        free(worker);
+        return NULL;
+    }
+    worker->tasks.mask = DEQUE_SIZE - 1u;
+    worker->pool = pool;
+    worker->seed = (unsigned int)(size_t)worker | 1u;
+    return worker;
+}
+
+void poolWorkerDestroy(epicsThreadPoolWorker *worker)
+{
+    if (!worker)
+        return;
+    free(worker->tasks.buf);
+    free(worker);
+}
+
+/* owner only, returns non-zero if the deque is full */
+static
+int dequePush(poolDeque *deque, void *item)
+{
+    size_t b = deque->bottom;
+    size_t t = epicsAtomicGetSizeT(&deque->top);
+
+    if (b - t > deque->mask)
+        return 1;
+    epicsAtomicSetPtrT(&deque->buf[b & deque->mask], item);
+    epicsAtomicSetSizeT(&deque->bottom, b + 1u);
+    return 0;
+}
+
+/* owner only, takes the most recently pushed item */
+static
+void* dequePop(poolDeque *deque)
+{
+    /* a full barrier, so that the thieves see the claim on this
+     * item before top is read
+     */
+    size_t b = epicsAtomicSubSizeT(&deque->bottom, 1u);
+    size_t t = epicsAtomicGetSizeT(&deque->top);
+    void *item;
+
+    if ((ptrdiff_t)(b - t) < 0) {
+        /* empty */
+        epicsAtomicSetSizeT(&deque->bottom, t);
+        return NULL;
+    }
+    item = epicsAtomicGetPtrT((EpicsAtomicPtrT*)&deque->buf[b & deque->mask]);
+    if (b != t)
+        return item;
+
+    /* the last item, which a thief may also be taking */
+    if (epicsAtomicCmpAndSwapSizeT(&deque->top, t, t + 1u) != t)
+        item = NULL;
+    epicsAtomicSetSizeT(&deque->bottom, t + 1u);
+    return item;
+}
+
+/* any thread, takes the oldest item.  Sets *pRetry if
+ * another thread took that item first.
+ */
+static
+void* dequeSteal(poolDeque *deque, int *pRetry)
+{
+    size_t t = epicsAtomicGetSizeT(&deque->top);
+    size_t b = epicsAtomicGetSizeT(&deque->bottom);
+    void *item;
+
+    if ((ptrdiff_t)(b - t) <= 0)
+        return NULL;
+    item = epicsAtomicGetPtrT((EpicsAtomicPtrT*)&deque->buf[t & deque->mask]);
+    if (epicsAtomicCmpAndSwapSizeT(&deque->top, t, t + 1u) != t) {
+        *pRetry = 1;
+        return NULL;
+    }
+    return item;
+}
+
+/* take a task from the inject list.  A worker also moves a share
+ * of the list onto its deque, where the other workers can steal it.
+ */
+static
+epicsPoolTask* poolTakeInjected(epicsThreadPool *pool,
+                                epicsThreadPoolWorker *self)
+{
+    ELLNODE *cur;
+    epicsPoolTask *task = NULL;
+
+    if (!epicsAtomicGetSizeT(&pool->ninject))
+        return NULL;
+
+    epicsMutexMustLock(pool->injectGuard);
+    cur = ellGet(&pool->inject);
+    if (cur) {
+        task = CONTAINER(cur, epicsPoolTask, node);
+
+        if (self) {
+            size_t nworkers = epicsAtomicGetIntT(&pool->nworkers);
+            size_t n = ellCount(&pool->inject) / (nworkers ? nworkers : 1u);
+
+            if (n > INJECT_BATCH)
+                n = INJECT_BATCH;
+            while (n-- && (cur = ellFirst(&pool->inject)) != NULL) {
+                if (dequePush(&self->tasks, CONTAINER(cur, epicsPoolTask, node)))
+                    break;
+                ellDelete(&pool->inject, cur);
+            }
+        }
+    }
+    epicsAtomicSetSizeT(&pool->ninject, ellCount(&pool->inject));
+    epicsMutexUnlock(pool->injectGuard);
+    return task;
+}
+
+static
+epicsPoolTask* poolSteal(epicsThreadPool *pool, epicsThreadPoolWorker *self)
+{
+    int nworkers = epicsAtomicGetIntT(&pool->nworkers);
+    int retry = 1;
+    unsigned int start = 0u;
+
+    if (self) {
+        /* xorshift, to spread the thieves over the victims */
+        self->seed ^= self->seed << 13;
+        self->seed ^= self->seed >> 17;
+        self->seed ^= self->seed << 5;
+        start = self->seed;
+    }
+
+    while (nworkers > 0 && retry) {
+        int i;
+
+        retry = 0;
+        for (i = 0; i < nworkers; i++) {
+            unsigned int v = (start + (unsigned int)i) % (unsigned int)nworkers;
+            epicsThreadPoolWorker *victim =
+                epicsAtomicGetPtrT((EpicsAtomicPtrT*)&pool->workers[v]);
+            epicsPoolTask *task;
+
+            if (victim == self)
+                continue;
+            task = dequeSteal(&victim->tasks, &retry);
+            if (task) {
+                if (self)
+                    self->nstolen++;
+                return task;
+            }
+        }
+    }
+    return NULL;
+}
+
+static
+epicsPoolTask* poolFindTask(epicsThreadPool *pool, epicsThreadPoolWorker *self)
+{
+    epicsPoolTask *task = NULL;
+
+    if (self)
+        task = dequePop(&self->tasks);
+    if (!task)
+        task = poolTakeInjected(pool, self);
+    if (!task)
+        task = poolSteal(pool, self);
+    return task;
+}
+
+static
+void poolRunTask(epicsThreadPoolWorker *self, epicsPoolTask *task)
+{
+    epicsJobGroup *group = task->group;
+    poolTaskBlock *block = task->block;
+
+    (*task->func)(task->arg);
+
+    if (self)
+        self->nrun++;
+    if (epicsAtomicDecrSizeT(&block->remaining) == 0u)
+        free(block);
+    /* the group may be destroyed once pending reaches zero */
+    if (epicsAtomicDecrSizeT(&group->pending) == 0u)
+        epicsEventMustTrigger(group->done);
+}
+
+size_t poolRunTasks(epicsThreadPoolWorker *self)
+{
+    epicsPoolTask *task;
+    size_t n = 0u;
+
+    while ((task = poolFindTask(self->pool, self)) != NULL) {
+        poolRunTask(self, task);
+        n++;
+    }
+    return n;
+}
+
+/* wake or create up to n workers for new tasks */
+static
+void poolWakeForTasks(epicsThreadPool *pool, size_t n)
+{
+    epicsMutexMustLock(pool->guard);
+    while (n) {
+        if (pool->threadsWaking < pool->threadsSleeping) {
+            pool->threadsWaking++;
+            epicsEventSignal(pool->workerWakeup);
+        }
+        else if (pool->threadsRunning < pool->conf.maxThreads &&
+                 !pool->shutdown) {
+            if (createPoolThread(pool))
+                break; /* the waiting thread runs the tasks */
+            pool->threadsWaking++;
+            epicsEventSignal(pool->workerWakeup);
+        }
+        else
+            break; /* the running workers will find the tasks */
+        n--;
+    }
+    CHECKCOUNT(pool);
+    epicsMutexUnlock(pool->guard);
+}
+
+static
+int poolGroupInit(epicsJobGroup *group, epicsThreadPool *pool)
+{
+    group->pool = pool;
+    group->pending = 1u;
+    group->done = epicsEventCreate(epicsEventEmpty);
+    return group->done ? 0 : S_pool_noMemory;
+}
+
+epicsJobGroup* epicsJobGroupCreate(epicsThreadPool *pool)
+{
+    epicsJobGroup *group = calloc(1, sizeof(*group));
+
+    if (!group)
+        return NULL;
+    if (poolGroupInit(group, pool)) {
+        free(group);
+        return NULL;
+    }
+    return group;
+}
+
+void epicsJobGroupDestroy(epicsJobGroup *group)
+{
+    if (!group)
+        return;
+    assert(group->pending == 1u);
+    epicsEventDestroy(group->done);
+    free(group);
+}
+
+int epicsJobGroupAdd(epicsJobGroup *group, epicsTaskFunction func, void *arg)
+{
+    return epicsJobGroupAddBatch(group, func, &arg, 1u);
+}
+
+int epicsJobGroupAddBatch(epicsJobGroup *group, epicsTaskFunction func,
+                          void * const *args, size_t n)
+{
+    epicsThreadPool *pool = group->pool;
+    epicsThreadPoolWorker *self;
+    poolTaskBlock *block;
+    ELLLIST overflow;
+    size_t i;
+
+    if (n == 0u)
+        return 0;
+
+    block = malloc(offsetof(poolTaskBlock, tasks) + n * sizeof(epicsPoolTask));
+    if (!block)
+        return S_pool_noMemory;
+    block->remaining = n;
+
+    epicsAtomicAddSizeT(&group->pending, n);
+
+    ellInit(&overflow);
+    self = poolWorkerSelf(pool);
+    for (i = 0u; i < n; i++) {
+        epicsPoolTask *task = &block->tasks[i];
+
+        task->func = func;
+        task->arg = args ? args[i] : NULL;
+        task->group = group;
+        task->block = block;
+        /* a running worker keeps its own tasks */
+        if (!self || dequePush(&self->tasks, task))
+            ellAdd(&overflow, &task->node);
+    }
+
+    if (ellCount(&overflow)) {
+        epicsMutexMustLock(pool->injectGuard);
+        ellConcat(&pool->inject, &overflow);
+        epicsAtomicSetSizeT(&pool->ninject, ellCount(&pool->inject));
+        epicsMutexUnlock(pool->injectGuard);
+    }
+
+    /* other threads wake workers, which then sleep only once the
+     * inject list is empty.  A worker wakes others only if some are
+     * idle, and otherwise runs its tasks itself.
+     */
+    if (!self || epicsAtomicGetIntT(&pool->threadsIdle) > 0)
+        poolWakeForTasks(pool, n);
+
+    return 0;
+}
+
+void epicsJobGroupWait(epicsJobGroup *group)
+{
+    epicsThreadPoolWorker *self = poolWorkerSelf(group->pool);
+
+    /* drop the reference held by the group */
+    if (epicsAtomicDecrSizeT(&group->pending) != 0u) {
+        /* help until no task can be found, at which point the
+         * remaining tasks of the group are running
+         */
+        while (epicsAtomicGetSizeT(&group->pending) != 0u) {
+            epicsPoolTask *task = poolFindTask(group->pool, self);
+
+            if (!task)
+                break;
+            poolRunTask(self, task);
+        }
+        /* triggered by whichever thread finished the last task */
+        epicsEventMustWait(group->done);
+    }
+    epicsAtomicSetSizeT(&group->pending, 1u);
+}
+
+int epicsThreadPoolRunAll(epicsThreadPool *pool, epicsTaskFunction func,
+                          void * const *args, size_t n)
+{
+    epicsJobGroup group;
+    int ret;
+
+    if (n == 0u)
+        return 0;
+    ret = poolGroupInit(&group, pool);
+    if (ret)
+        return ret;
+    ret = epicsJobGroupAddBatch(&group, func, args, n);
+    epicsJobGroupWait(&group);
+    epicsEventDestroy(group.done);
+    return ret;
+}
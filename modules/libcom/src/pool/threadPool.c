@@ -19,6 +19,7 @@
 #include "epicsEvent.h"
 #include "epicsInterrupt.h"
 #include "cantProceed.h"
+#include "epicsAtomic.h"
 
 #include "epicsThreadPool.h"
 #include "poolPriv.h"
@@ -62,13 +63,17 @@ epicsThreadPool* epicsThreadPoolCreate(epicsThreadPoolConfig *opts)
     pool->shutdownEvent = epicsEventCreate(epicsEventEmpty);
     pool->observerWakeup = epicsEventCreate(epicsEventEmpty);
     pool->guard = epicsMutexCreate();
+    pool->injectGuard = epicsMutexCreate();
+    pool->workers = calloc(pool->conf.maxThreads, sizeof(*pool->workers));
 
     if (!pool->workerWakeup || !pool->shutdownEvent ||
-       !pool->observerWakeup || !pool->guard)
+       !pool->observerWakeup || !pool->guard ||
+       !pool->injectGuard || !pool->workers)
         goto cleanup;
 
     ellInit(&pool->jobs);
     ellInit(&pool->owned);
+    ellInit(&pool->inject);
 
     epicsMutexMustLock(pool->guard);
 
@@ -100,7 +105,10 @@ cleanup:
         epicsEventDestroy(pool->observerWakeup);
     if (pool->guard)
         epicsMutexDestroy(pool->guard);
+    if (pool->injectGuard)
+        epicsMutexDestroy(pool->injectGuard);
 
+    free(pool->workers);
     free(pool);
     return NULL;
 }
@@ -202,6 +210,7 @@ void epicsThreadPoolDestroy(epicsThreadPool *pool)
     unsigned int nThr;
     ELLLIST notify;
     ELLNODE *cur;
+    int i;
 
     if (!pool)
         return;
@@ -259,7 +268,11 @@ void epicsThreadPoolDestroy(epicsThreadPool *pool)
     epicsEventDestroy(pool->shutdownEvent);
     epicsEventDestroy(pool->observerWakeup);
     epicsMutexDestroy(pool->guard);
+    epicsMutexDestroy(pool->injectGuard);
 
+    for (i = 0; i < pool->nworkers; i++)
+        poolWorkerDestroy(pool->workers[i]);
+    free(pool->workers);
     free(pool);
 }
 
@@ -267,6 +280,7 @@ void epicsThreadPoolDestroy(epicsThreadPool *pool)
 void epicsThreadPoolReport(epicsThreadPool *pool, FILE *fd)
 {
     ELLNODE *cur;
+    int i;
     epicsMutexMustLock(pool->guard);
 
     fprintf(fd, "Thread Pool with %u/%u threads\n"
@@ -275,6 +289,15 @@ void epicsThreadPoolReport(epicsThreadPool *pool, FILE *fd)
             pool->conf.maxThreads,
             ellCount(&pool->jobs),
             pool->threadsAreAwake);
+    fprintf(fd, " %u tasks waiting for a worker\n",
+            (unsigned int)epicsAtomicGetSizeT(&pool->ninject));
+    for (i = 0; i < pool->nworkers; i++) {
+        epicsThreadPoolWorker *worker = pool->workers[i];
+
+        fprintf(fd, "  worker %d ran %lu tasks, stole %lu\n", i,
+                (unsigned long)worker->nrun,
+                (unsigned long)worker->nstolen);
+    }
     if (pool->pauseadd)
         fprintf(fd, "  Inhibit queueing\n");
     if (pool->pauserun)
@@ -18,6 +18,7 @@
 #include "epicsMessageQueue.h"
 #include "epicsThread.h"
 #include "epicsExit.h"
+#include "epicsTime.h"
 #include "epicsEvent.h"
 #include "epicsAssert.h"
 #include "epicsUnitTest.h"
@@ -240,6 +241,149 @@ sender(void *arg)
     testDiag("%s exiting, sent %d messages", epicsThreadGetNameSelf(), i);
 }
 
+/*
+ * Throughput and latency benchmarks
+ */
+#define BENCH_MESSAGES 200000
+#define BENCH_THREADS 4
+
+struct benchMsg {
+    int             sender;
+    int             seq;
+    epicsUInt64     sent;
+};
+
+struct benchPriv {
+    epicsMessageQueue *q;
+    epicsMessageQueue *reply;
+    int             id;
+    int             count;
+    int             errors;
+    epicsUInt64     latency;
+};
+
+extern "C" void
+benchSender(void *arg)
+{
+    benchPriv *priv = (benchPriv *)arg;
+    benchMsg msg;
+
+    msg.sender = priv->id;
+    for (msg.seq = 0; msg.seq < priv->count; msg.seq++) {
+        msg.sent = epicsMonotonicGet();
+        priv->q->send(&msg, sizeof msg);
+    }
+}
+
+extern "C" void
+benchReceiver(void *arg)
+{
+    benchPriv *priv = (benchPriv *)arg;
+    int expect[BENCH_THREADS] = {0};
+    benchMsg msg;
+    int i;
+
+    for (i = 0; i < priv->count; i++) {
+        if (priv->q->receive(&msg, sizeof msg) != sizeof msg ||
+            msg.sender < 0 || msg.sender >= BENCH_THREADS) {
+            priv->errors++;
+            continue;
+        }
+        /* messages from one sender must arrive in order */
+        if (msg.seq < expect[msg.sender])
+            priv->errors++;
+        expect[msg.sender] = msg.seq + 1;
+        priv->latency += epicsMonotonicGet() - msg.sent;
+    }
+}
+
+extern "C" void
+benchEcho(void *arg)
+{
+    benchPriv *priv = (benchPriv *)arg;
+    benchMsg msg;
+    int i;
+
+    for (i = 0; i < priv->count; i++) {
+        priv->q->receive(&msg, sizeof msg);
+        priv->reply->send(&msg, sizeof msg);
+    }
+}
+
+static void
+benchStream(int nthreads)
+{
+    epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    epicsThreadId tx[BENCH_THREADS], rx[BENCH_THREADS];
+    benchPriv txPriv[BENCH_THREADS], rxPriv[BENCH_THREADS];
+    epicsMessageQueue q(64, sizeof(benchMsg));
+    epicsUInt64 start, latency = 0;
+    int i, errors = 0;
+
+    opts.priority = epicsThreadPriorityMedium;
+    opts.joinable = 1;
+    start = epicsMonotonicGet();
+    for (i = 0; i < nthreads; i++) {
+        rxPriv[i].q = txPriv[i].q = &q;
+        rxPriv[i].count = txPriv[i].count = BENCH_MESSAGES / nthreads;
+        rxPriv[i].errors = 0;
+        rxPriv[i].latency = 0;
+        txPriv[i].id = i;
+        rx[i] = epicsThreadCreateOpt("benchRx", benchReceiver, &rxPriv[i], &opts);
+        tx[i] = epicsThreadCreateOpt("benchTx", benchSender, &txPriv[i], &opts);
+        if (!rx[i] || !tx[i])
+            testAbort("epicsThreadCreate failed");
+    }
+    for (i = 0; i < nthreads; i++) {
+        epicsThreadMustJoin(tx[i]);
+        epicsThreadMustJoin(rx[i]);
+        errors += rxPriv[i].errors;
+        latency += rxPriv[i].latency;
+    }
+    double elapsed = (epicsMonotonicGet() - start) * 1e-9;
+
+    testOk(errors == 0 && q.pending() == 0,
+        "%d senders and receivers, %d errors", nthreads, errors);
+    testDiag("%d:%d  %.0f messages/s, mean latency %.2f us",
+        nthreads, nthreads, BENCH_MESSAGES / elapsed,
+        latency * 1e-3 / BENCH_MESSAGES);
+}
+
+static void
+benchPingPong(void)
+{
+    epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    epicsMessageQueue q(1, sizeof(benchMsg)), reply(1, sizeof(benchMsg));
+    benchPriv priv;
+    benchMsg msg;
+    epicsThreadId echo;
+    epicsUInt64 start;
+    int i, errors = 0;
+    const int count = BENCH_MESSAGES / 10;
+
+    priv.q = &q;
+    priv.reply = &reply;
+    priv.count = count;
+    opts.priority = epicsThreadPriorityMedium;
+    opts.joinable = 1;
+    echo = epicsThreadCreateOpt("benchEcho", benchEcho, &priv, &opts);
+    if (!echo)
+        testAbort("epicsThreadCreate failed");
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < count; i++) {
+        msg.seq = i;
+        q.send(&msg, sizeof msg);
+        if (reply.receive(&msg, sizeof msg) != sizeof msg || msg.seq != i)
+            errors++;
+    }
+    double elapsed = (epicsMonotonicGet() - start) * 1e-9;
+    epicsThreadMustJoin(echo);
+
+    testOk(errors == 0, "Ping-pong, %d errors", errors);
+    testDiag("Ping-pong round trip %.2f us", elapsed * 1e6 / count);
+}
+
 #define NUM_SENDERS 4
 extern "C" void messageQueueTest(void *parm)
 {
@@ -440,6 +584,11 @@ extern "C" void messageQueueTest(void *parm)
     }
     recvExit = 1;
     epicsThreadMustJoin(rxThread);
+
+    testDiag("Throughput and latency benchmarks:");
+    benchStream(1);
+    benchStream(BENCH_THREADS);
+    benchPingPong();
 }
 
 MAIN(epicsMessageQueueTest)
@@ -451,7 +600,7 @@ MAIN(epicsMessageQueueTest)
     };
     epicsThreadId testThread;
 
-    testPlan(70 + NUM_SENDERS);
+    testPlan(73 + NUM_SENDERS);
 
     testThread = epicsThreadCreateOpt("messageQueueTest",
         messageQueueTest, NULL, &opts);
@@ -198,6 +198,87 @@ void epicsMutexPerformance ()
     delay /= N * 100u; // convert to delay per lock pair
     delay *= 1e6; // convert to micro seconds
     testDiag("lock()*4/unlock()*4 takes %f microseconds", delay);
+
+    // test a single lock pair with contention statistics enabled
+    epicsMutexContentionEnable ( 1 );
+    begin = epicsTime::getMonotonic ();
+    for ( i = 0; i < N; i++ ) {
+        tenLockPairsSquared ( mutex );
+    }
+    delay = epicsTime::getMonotonic () -  begin;
+    epicsMutexContentionEnable ( 0 );
+    delay /= N * 100u; // convert to delay per lock pair
+    delay *= 1e6; // convert to micro seconds
+    testDiag("lock()*1/unlock()*1 with contention statistics takes %f microseconds",
+        delay);
+}
+
+struct verifyContention {
+    epicsMutexId mutex;
+    epicsEventId locked;
+};
+
+extern "C" void verifyContentionThread ( void *pArg )
+{
+    struct verifyContention *pVerify =
+        ( struct verifyContention * ) pArg;
+
+    epicsMutexMustLock ( pVerify->mutex );
+    epicsEventSignal ( pVerify->locked );
+    epicsThreadSleep ( 0.1 );
+    epicsMutexUnlock ( pVerify->mutex );
+}
+
+void verifyContention ()
+{
+    struct verifyContention verify;
+    epicsMutexContentionStats stats;
+    size_t binTotal = 0;
+    unsigned i;
+
+    epicsMutexContentionReset ();
+    epicsMutexContentionEnable ( 1 );
+
+    verify.mutex = epicsMutexMustCreate ();
+    verify.locked = epicsEventMustCreate ( epicsEventEmpty );
+
+    // recursive locks are counted, and timed only from the outermost
+    epicsMutexMustLock ( verify.mutex );
+    epicsMutexMustLock ( verify.mutex );
+    epicsMutexUnlock ( verify.mutex );
+    epicsMutexUnlock ( verify.mutex );
+
+    epicsThreadCreate ( "verifyContentionThread", 40,
+        epicsThreadGetStackSize(epicsThreadStackSmall),
+        verifyContentionThread, &verify );
+    testOk1(epicsEventWait ( verify.locked ) == epicsEventWaitOK);
+    epicsMutexMustLock ( verify.mutex );
+    epicsMutexUnlock ( verify.mutex );
+
+    epicsMutexContentionEnable ( 0 );
+
+    testOk1(epicsMutexContentionGet ( verify.mutex, &stats ) == 0);
+    testOk(stats.nMutexes == 1u, "nMutexes %u", stats.nMutexes);
+    testOk(stats.nLock == 4u, "nLock %lu", (unsigned long) stats.nLock);
+    testOk(stats.nContended == 1u, "nContended %lu",
+        (unsigned long) stats.nContended);
+    testOk(stats.waitMax > 0.01 && stats.waitMax <= stats.waitTotal,
+        "waitMax %f, waitTotal %f", stats.waitMax, stats.waitTotal);
+    testOk(stats.holdMax > 0.01, "holdMax %f", stats.holdMax);
+    for ( i = 0; i < EPICS_MUTEX_WAIT_BINS; i++ ) {
+        binTotal += stats.waitBins[i];
+    }
+    testOk(binTotal == stats.nContended, "%lu waits in the histogram",
+        (unsigned long) binTotal);
+
+    // disabled, nothing more is counted
+    epicsMutexMustLock ( verify.mutex );
+    epicsMutexUnlock ( verify.mutex );
+    testOk1(epicsMutexContentionGet ( verify.mutex, &stats ) == 0);
+    testOk(stats.nLock == 4u, "nLock %lu", (unsigned long) stats.nLock);
+
+    epicsMutexDestroy ( verify.mutex );
+    epicsEventDestroy ( verify.locked );
 }
 
 struct verifyTryLock {
@@ -234,6 +315,135 @@ void verifyTryLock ()
     epicsEventDestroy ( verify.done );
 }
 
+struct verifyFastMutex {
+    epicsFastMutexId mutex;
+    epicsEventId done;
+};
+
+extern "C" void verifyFastMutexThread ( void *pArg )
+{
+    struct verifyFastMutex *pVerify =
+        ( struct verifyFastMutex * ) pArg;
+
+    testOk1(epicsFastMutexTryLock(pVerify->mutex) == epicsMutexLockTimeout);
+    epicsEventSignal ( pVerify->done );
+}
+
+void verifyFastMutex ()
+{
+    struct verifyFastMutex verify;
+
+    verify.mutex = epicsMutexMustCreateFast ();
+    verify.done = epicsEventMustCreate ( epicsEventEmpty );
+
+    testOk1(epicsFastMutexTryLock(verify.mutex) == epicsMutexLockOK);
+    // not recursive
+    testOk1(epicsFastMutexTryLock(verify.mutex) == epicsMutexLockTimeout);
+
+    epicsThreadCreate ( "verifyFastMutexThread", 40,
+        epicsThreadGetStackSize(epicsThreadStackSmall),
+        verifyFastMutexThread, &verify );
+
+    testOk1(epicsEventWait ( verify.done ) == epicsEventWaitOK);
+    epicsFastMutexUnlock ( verify.mutex );
+
+    // a recursive lock fails instead of deadlocking when debugging
+    epicsFastMutexDebug ( 1 );
+    testOk1(epicsFastMutexLock(verify.mutex) == epicsMutexLockOK);
+    testDiag("Expect a recursive lock message:");
+    testOk1(epicsFastMutexLock(verify.mutex) == epicsMutexLockError);
+    epicsFastMutexUnlock ( verify.mutex );
+    epicsFastMutexDebug ( 0 );
+
+    {
+        epicsFastMutex cxxMutex;
+        epicsFastMutex::guard_t G ( cxxMutex );
+        testOk1(!cxxMutex.tryLock ());
+    }
+
+    epicsFastMutexDestroy ( verify.mutex );
+    epicsEventDestroy ( verify.done );
+}
+
+template < class T >
+struct contendedCount {
+    T mutex;
+    unsigned count;
+    unsigned nLoops;
+};
+
+template < class T >
+void contendedCountThread ( void *pArg )
+{
+    contendedCount < T > *pCount = static_cast < contendedCount < T > * > ( pArg );
+
+    for ( unsigned i = 0; i < pCount->nLoops; i++ ) {
+        typename T::guard_t G ( pCount->mutex );
+        pCount->count++;
+    }
+}
+
+// time each lock pair with nThreads contending, and check the count
+template < class T >
+double contendedLockPair ( const char *pName, unsigned nThreads )
+{
+    static const unsigned N = 100000;
+    contendedCount < T > count;
+    epicsThreadId id[8];
+    epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    unsigned i;
+
+    count.count = 0;
+    count.nLoops = N;
+    opts.joinable = 1;
+
+    epicsTime begin = epicsTime::getMonotonic ();
+    for ( i = 0; i < nThreads; i++ ) {
+        id[i] = epicsThreadCreateOpt ( pName,
+            contendedCountThread < T >, &count, &opts );
+    }
+    for ( i = 0; i < nThreads; i++ ) {
+        epicsThreadMustJoin ( id[i] );
+    }
+    double delay = epicsTime::getMonotonic () - begin;
+
+    testOk(count.count == N * nThreads, "%s counted %u of %u",
+        pName, count.count, N * nThreads);
+    return delay / ( N * nThreads ) * 1e6;
+}
+
+void epicsFastMutexPerformance ()
+{
+    epicsMutex mutex;
+    epicsFastMutex fastMutex;
+    static const unsigned N = 1000000;
+    unsigned i;
+
+    epicsTime begin = epicsTime::getMonotonic ();
+    for ( i = 0; i < N; i++ ) {
+        mutex.lock ();
+        mutex.unlock ();
+    }
+    double delay = epicsTime::getMonotonic () - begin;
+    delay = delay / N * 1e6;
+
+    begin = epicsTime::getMonotonic ();
+    for ( i = 0; i < N; i++ ) {
+        fastMutex.lock ();
+        fastMutex.unlock ();
+    }
+    double fastDelay = epicsTime::getMonotonic () - begin;
+    fastDelay = fastDelay / N * 1e6;
+
+    testDiag("uncontended lock()/unlock() takes %f microseconds, "
+        "%f with epicsFastMutex", delay, fastDelay);
+
+    delay = contendedLockPair < epicsMutex > ( "contendMutex", 4 );
+    fastDelay = contendedLockPair < epicsFastMutex > ( "contendFastMutex", 4 );
+    testDiag("4 threads contending, lock()/unlock() takes %f microseconds, "
+        "%f with epicsFastMutex", delay, fastDelay);
+}
+
 MAIN(epicsMutexTest)
 {
     const int nthreads = 3;
@@ -247,9 +457,11 @@ MAIN(epicsMutexTest)
     epicsMutexId mutex;
     int status;
 
-    testPlan(5 + nthreads * nrounds);
+    testPlan(24 + nthreads * nrounds);
 
     verifyTryLock ();
+    verifyContention ();
+    verifyFastMutex ();
 
     mutex = epicsMutexMustCreate();
     status = epicsMutexLock(mutex);
@@ -279,6 +491,7 @@ MAIN(epicsMutexTest)
     epicsThreadSleep(2.0 + nrounds);
 
     epicsMutexPerformance ();
+    epicsFastMutexPerformance ();
 
     free(pinfo);
     free(arg);
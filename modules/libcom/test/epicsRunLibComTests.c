@@ -20,6 +20,7 @@
 int aslibtest(void);
 int blockingSockTest(void);
 int epicsAlgorithm(void);
+int openResTableTest(void);
 int epicsAtomicTest(void);
 int epicsCalcTest(void);
 int epicsEllTest(void);
@@ -78,6 +79,7 @@ void epicsRunLibComTests(void)
     runTest(aslibtest);
     runTest(blockingSockTest);
     runTest(epicsAlgorithm);
+    runTest(openResTableTest);
     runTest(epicsAtomicTest);
     runTest(epicsCalcTest);
     runTest(epicsEllTest);
@@ -6,6 +6,8 @@
 * in file LICENSE that is included with this distribution.
 \*************************************************************************/
 
+#include <stdlib.h>
+
 #include "epicsThreadPool.h"
 
 /* included to allow tests to peek */
@@ -18,6 +20,8 @@
 #include "epicsEvent.h"
 #include "epicsMutex.h"
 #include "epicsThread.h"
+#include "epicsAtomic.h"
+#include "epicsTime.h"
 
 /* Do nothing */
 static void nullop(void)
@@ -421,9 +425,164 @@ void testshared(void)
 
 }
 
+static size_t ntaskrun;
+
+static void counttask(void *arg)
+{
+    epicsAtomicIncrSizeT(&ntaskrun);
+}
+
+static
+void testtaskgroup(void)
+{
+    epicsThreadPoolConfig conf;
+    epicsThreadPool *pool;
+    epicsJobGroup *group;
+    int i;
+
+    testDiag("testtaskgroup()");
+
+    epicsThreadPoolConfigDefaults(&conf);
+    conf.initialThreads = conf.maxThreads = 4;
+    pool = epicsThreadPoolCreate(&conf);
+    if (!pool)
+        testAbort("Failed to create pool");
+
+    group = epicsJobGroupCreate(pool);
+    if (!group)
+        testAbort("Failed to create group");
+
+    ntaskrun = 0;
+    /* more than fits in the deque of one worker */
+    testOk1(epicsJobGroupAddBatch(group, &counttask, NULL, 5000)==0);
+    epicsJobGroupWait(group);
+    testOk(ntaskrun==5000, "%lu tasks run", (unsigned long)ntaskrun);
+
+    /* the group may be used again */
+    for (i = 0; i < 10; i++)
+        epicsJobGroupAdd(group, &counttask, NULL);
+    epicsJobGroupWait(group);
+    testOk(ntaskrun==5010, "%lu tasks run", (unsigned long)ntaskrun);
+
+    epicsJobGroupDestroy(group);
+    epicsThreadPoolDestroy(pool);
+}
+
+typedef struct {
+    epicsThreadPool *pool;
+    size_t lo, hi;
+    size_t sum;
+} sumPriv;
+
+/* sum lo to hi-1 by splitting the range in two until it is small */
+static void sumtask(void *arg)
+{
+    sumPriv *priv = arg, part[2];
+    void *args[2];
+
+    if (priv->hi - priv->lo <= 64) {
+        size_t i;
+        priv->sum = 0;
+        for (i = priv->lo; i < priv->hi; i++)
+            priv->sum += i;
+        return;
+    }
+
+    part[0].pool = part[1].pool = priv->pool;
+    part[0].lo = priv->lo;
+    part[0].hi = part[1].lo = priv->lo + (priv->hi - priv->lo) / 2;
+    part[1].hi = priv->hi;
+    args[0] = &part[0];
+    args[1] = &part[1];
+
+    epicsThreadPoolRunAll(priv->pool, &sumtask, args, 2);
+    priv->sum = part[0].sum + part[1].sum;
+}
+
+static
+void testforkjoin(unsigned int nthreads)
+{
+    epicsThreadPoolConfig conf;
+    sumPriv priv;
+    void *arg = &priv;
+
+    testDiag("testforkjoin(%u)", nthreads);
+
+    epicsThreadPoolConfigDefaults(&conf);
+    conf.initialThreads = conf.maxThreads = nthreads;
+    priv.pool = epicsThreadPoolCreate(&conf);
+    if (!priv.pool)
+        testAbort("Failed to create pool");
+
+    priv.lo = 0;
+    priv.hi = 100000;
+    priv.sum = 0;
+    epicsThreadPoolRunAll(priv.pool, &sumtask, &arg, 1);
+    testOk(priv.sum==(size_t)100000*99999/2, "sum %lu",
+           (unsigned long)priv.sum);
+
+    epicsThreadPoolDestroy(priv.pool);
+}
+
+static void countjobonce(void *arg, epicsJobMode mode)
+{
+    if (mode == epicsJobModeRun)
+        epicsAtomicIncrSizeT(&ntaskrun);
+}
+
+#define NBENCH 20000
+
+/* compare the task path with queueing one epicsJob per item */
+static
+void testthroughput(unsigned int nthreads)
+{
+    epicsThreadPoolConfig conf;
+    epicsThreadPool *pool;
+    epicsJob **jobs;
+    epicsTimeStamp start, end;
+    double ttask, tjob;
+    size_t i;
+
+    epicsThreadPoolConfigDefaults(&conf);
+    conf.initialThreads = conf.maxThreads = nthreads;
+    pool = epicsThreadPoolCreate(&conf);
+    jobs = callocMustSucceed(NBENCH, sizeof(*jobs), "testthroughput");
+    if (!pool)
+        testAbort("Failed to create pool");
+
+    ntaskrun = 0;
+    epicsTimeGetCurrent(&start);
+    epicsThreadPoolRunAll(pool, &counttask, NULL, NBENCH);
+    epicsTimeGetCurrent(&end);
+    ttask = epicsTimeDiffInSeconds(&end, &start);
+    testOk(ntaskrun==NBENCH, "%u workers ran %lu tasks", nthreads,
+           (unsigned long)ntaskrun);
+
+    for (i = 0; i < NBENCH; i++)
+        jobs[i] = epicsJobCreate(pool, &countjobonce, NULL);
+
+    ntaskrun = 0;
+    epicsTimeGetCurrent(&start);
+    for (i = 0; i < NBENCH; i++)
+        epicsJobQueue(jobs[i]);
+    epicsThreadPoolWait(pool, -1.0);
+    epicsTimeGetCurrent(&end);
+    tjob = epicsTimeDiffInSeconds(&end, &start);
+
+    testDiag("%2u workers: tasks %.3f us/op, jobs %.3f us/op",
+             nthreads, ttask * 1e6 / NBENCH, tjob * 1e6 / NBENCH);
+
+    for (i = 0; i < NBENCH; i++)
+        epicsJobDestroy(jobs[i]);
+    free(jobs);
+    epicsThreadPoolDestroy(pool);
+}
+
 MAIN(epicsThreadPoolTest)
 {
-    testPlan(171);
+    unsigned int nthreads;
+
+    testPlan(183);
 
     nullop();
     oneop();
@@ -443,6 +602,12 @@ MAIN(epicsThreadPoolTest)
     testreadd();
     testcancel();
     testshared();
+    testtaskgroup();
+    testforkjoin(1);
+    testforkjoin(4);
+    testDiag("Throughput");
+    for (nthreads = 1; nthreads <= 64; nthreads *= 2)
+        testthroughput(nthreads);
 
     return testDone();
 }
@@ -18,6 +18,10 @@
 #include <time.h>
 #include <math.h>
 
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
 #include "epicsThread.h"
 #include "epicsEvent.h"
 #include "epicsTime.h"
@@ -217,10 +221,56 @@ static void testOkToBlock()
     testOk1(infoA.didSomething);
 }
 
+extern "C" {
+static void affinityThread(void *arg)
+{
+#ifdef __linux__
+    *(int *)arg = sched_getcpu();
+#endif
+}
+}
+
+static void testAffinity()
+{
+    epicsThreadId self = epicsThreadGetIdSelf();
+
+    testDiag("testAffinity()");
+
+    eltc(0);
+    testOk(epicsThreadSetAffinity(self, "3-1") == -1, "Reject range 3-1");
+    testOk(epicsThreadSetAffinity(self, "0,x") == -1, "Reject list 0,x");
+    eltc(1);
+
+#ifdef __linux__
+    epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    cpu_set_t allowed;
+    char cpulist[16];
+    int first = 0, cpu = -1;
+
+    // the CPUs of a container need not start from 0
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    while (first < CPU_SETSIZE - 1 && !CPU_ISSET(first, &allowed))
+        first++;
+    sprintf(cpulist, "%d", first);
+
+    opts.joinable = 1;
+    opts.affinity = cpulist;
+    epicsThreadMustJoin(epicsThreadCreateOpt("affinity", affinityThread,
+        &cpu, &opts));
+    testOk(cpu == first, "Thread with affinity %s ran on CPU %d",
+        cpulist, cpu);
+
+    testOk1(epicsThreadSetAffinityMatching("noSuchThread*", cpulist) == 0);
+    testOk1(epicsThreadSetAffinity(self, NULL) == 0);
+#else
+    testSkip(3, "CPU affinity not supported");
+#endif
+}
+
 
 MAIN(epicsThreadTest)
 {
-    testPlan(15);
+    testPlan(20);
 
     unsigned int ncpus = epicsThreadGetCPUs();
     testDiag("System has %u CPUs", ncpus);
@@ -230,6 +280,7 @@ MAIN(epicsThreadTest)
     testJoining(); // Do this first, ~epicsThread() uses it...
     testMyThread();
     testOkToBlock();
+    testAffinity();
 
     // attempt to self-join from a non-EPICS thread
     // to make sure it does nothing as expected
@@ -0,0 +1,197 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+// openResTableTest.cpp
+//  Checks the open addressing resource table against resTable
+
+#include "resourceLib.h"
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+// a poor hash so that long clusters form, and wrap around the table
+class clashId {
+public:
+    clashId ( unsigned idIn ) : id ( idIn ) {}
+    bool operator == ( const clashId & rhs ) const { return id == rhs.id; }
+    resTableIndex hash () const { return ( id & 0x3u ) + 0xfffd; }
+    unsigned getId () const { return id; }
+private:
+    unsigned id;
+};
+
+class clash : public clashId, public tsSLNode < clash > {
+public:
+    clash ( openResTable < clash, clashId > & tblIn, unsigned idIn ) :
+        clashId ( idIn ), tbl ( tblIn ) {}
+    void destroy ()
+    {
+        if ( tbl.remove ( *this ) == this ) {
+            nDestroyed++;
+        }
+        delete this;
+    }
+    void show ( unsigned ) const {}
+    static unsigned nDestroyed;
+private:
+    openResTable < clash, clashId > & tbl;
+};
+
+unsigned clash::nDestroyed;
+
+class chan : public chronIntIdRes < chan > {
+public:
+    void show ( unsigned ) const {}
+};
+
+static unsigned lcg ( unsigned & seed )
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8u;
+}
+
+static void testEmpty ()
+{
+    openResTable < clash, clashId > tbl;
+    tbl.verify ();
+    testOk1 ( tbl.lookup ( 1u ) == 0 );
+    testOk1 ( tbl.remove ( 1u ) == 0 );
+    testOk1 ( ! tbl.firstIter ().valid () );
+    testOk1 ( tbl.numEntriesInstalled () == 0u );
+}
+
+static void testClusters ()
+{
+    static const unsigned N = 2000u;
+    openResTable < clash, clashId > tbl;
+    clash * pClash[N];
+    unsigned i;
+
+    testDiag ( "Colliding hashes" );
+    for ( i = 0u; i < N; i++ ) {
+        pClash[i] = new clash ( tbl, i );
+        tbl.add ( *pClash[i] );
+    }
+    tbl.verify ();
+    testOk1 ( tbl.numEntriesInstalled () == N );
+    testOk1 ( tbl.add ( *pClash[N/2] ) == -1 );
+
+    bool ok = true;
+    for ( i = 0u; i < N; i++ ) {
+        ok = ok && tbl.lookup ( i ) == pClash[i];
+    }
+    testOk ( ok, "all entries found" );
+    testOk1 ( tbl.lookup ( N ) == 0 );
+
+    unsigned count = 0u;
+    openResTable < clash, clashId >::iterator iter = tbl.firstIter ();
+    while ( iter.valid () ) {
+        ok = ok && tbl.lookup ( iter->getId () ) == iter.pointer ();
+        count++;
+        iter++;
+    }
+    testOk ( ok && count == N, "iterated over %u entries", count );
+
+    ok = true;
+    for ( i = 0u; i < N; i += 3u ) {
+        ok = ok && tbl.remove ( i ) == pClash[i];
+    }
+    tbl.verify ();
+    for ( i = 0u; i < N; i++ ) {
+        ok = ok && tbl.lookup ( i ) == ( i % 3u ? pClash[i] : 0 );
+    }
+    testOk ( ok, "lookup after removing every third entry" );
+
+    for ( i = 0u; i < N; i += 3u ) {
+        tbl.add ( *pClash[i] );
+    }
+    tbl.verify ();
+    testOk1 ( tbl.numEntriesInstalled () == N );
+
+    tbl.traverse ( & clash::destroy );
+    testOk ( clash::nDestroyed == N,
+        "traverse visited all %u entries removed by the callback",
+        clash::nDestroyed );
+    testOk1 ( tbl.numEntriesInstalled () == 0u );
+    tbl.verify ();
+}
+
+static void testAgainstResTable ()
+{
+    static const unsigned N = 4096u;
+    chronIntIdOpenResTable < chan > openTbl;
+    chronIntIdResTable < chan > chainTbl;
+    chan * pChan = new chan [N];
+    bool installed[N];
+    unsigned seed = 1u;
+    unsigned i;
+
+    testDiag ( "Random churn compared with resTable" );
+    for ( i = 0u; i < N; i++ ) {
+        openTbl.idAssignAdd ( pChan[i] );
+        installed[i] = true;
+    }
+    for ( i = 0u; i < N; i++ ) {
+        chainTbl.add ( pChan[i] );
+    }
+
+    bool ok = true;
+    for ( unsigned j = 0u; j < 100000u; j++ ) {
+        unsigned k = lcg ( seed ) % N;
+        if ( installed[k] ) {
+            ok = ok && openTbl.remove ( pChan[k].getId () ) == & pChan[k];
+            ok = ok && chainTbl.remove ( pChan[k].getId () ) == & pChan[k];
+        }
+        else {
+            ok = ok && openTbl.add ( pChan[k] ) == 0;
+            ok = ok && chainTbl.add ( pChan[k] ) == 0;
+        }
+        installed[k] = ! installed[k];
+        k = lcg ( seed ) % N;
+        ok = ok && openTbl.lookup ( pChan[k].getId () ) ==
+            chainTbl.lookup ( pChan[k].getId () );
+    }
+    openTbl.verify ();
+    testOk ( ok, "tables agree" );
+    testOk1 ( openTbl.numEntriesInstalled () ==
+        chainTbl.numEntriesInstalled () );
+
+    // both tables would link the entries through the same tsSLNode
+    const unsigned nInstalled = chainTbl.numEntriesInstalled ();
+    tsSLList < chan > list;
+    chainTbl.removeAll ( list );
+    while ( list.get () ) {
+    }
+    openTbl.removeAll ( list );
+    unsigned count = 0u;
+    while ( list.get () ) {
+        count++;
+    }
+    testOk1 ( count == nInstalled );
+    testOk1 ( openTbl.numEntriesInstalled () == 0u );
+    openTbl.verify ();
+
+    openTbl.setTableSize ( N );
+    openTbl.verify ();
+    for ( i = 0u; i < N; i++ ) {
+        openTbl.add ( pChan[i] );
+    }
+    openTbl.verify ();
+    ok = true;
+    for ( i = 0u; i < N; i++ ) {
+        ok = ok && openTbl.lookup ( pChan[i].getId () ) == & pChan[i];
+    }
+    testOk ( ok, "lookup after presizing" );
+
+    delete [] pChan;
+}
+
+MAIN(openResTableTest)
+{
+    testPlan(18);
+    testEmpty ();
+    testClusters ();
+    testAgainstResTable ();
+    return testDone();
+}